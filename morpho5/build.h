@@ -124,6 +124,9 @@
 /** @brief Limits size of statically allocated arrays on the C stack */
 #define MORPHO_MAXIMUMSTACKALLOC 256
 
+/** @brief Longest string, in bytes, that is interned when created at runtime */
+#define MORPHO_INTERNMAXLENGTH 64
+
 /** @brief Avoid using global variables (suitable for small programs only) */
 //#define MORPHO_NOGLOBALS
 
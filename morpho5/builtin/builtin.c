@@ -13,6 +13,19 @@
 #include "builtin.h"
 #include "matrix.h"
 #include "cmplx.h"
+#include "buffer.h"
+#include "ndarray.h"
+#include "factorization.h"
+#include "matrixf.h"
+#include "complexmatrix.h"
+#include "symmatrix.h"
+#include "bandmatrix.h"
+#include "record.h"
+#include "priorityqueue.h"
+#include "sorted.h"
+#include "set.h"
+#include "stringbuilder.h"
+#include "iterator.h"
 #include "sparse.h"
 #include "mesh.h"
 #include "selection.h"
@@ -292,6 +305,19 @@ void builtin_initialize(void) {
     file_initialize();
     system_initialize();
     matrix_initialize();
+    factorization_initialize();
+    matrixf_initialize();
+    complexmatrix_initialize();
+    symmatrix_initialize();
+    bandmatrix_initialize();
+    buffer_initialize();
+    ndarray_initialize();
+    record_initialize();
+    priorityqueue_initialize();
+    sorted_initialize();
+    set_initialize();
+    stringbuilder_initialize();
+    iterator_initialize();
     sparse_initialize();
     mesh_initialize();
     selection_initialize();
@@ -310,6 +336,7 @@ void builtin_finalize(void) {
     varray_valueclear(&builtin_objects);
     
     functional_finalize();
+    matrix_finalize();
     file_finalize();
     system_finalize();
 }
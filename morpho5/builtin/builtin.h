@@ -20,7 +20,16 @@
 /** Flags that describe properties of the built in function */
 typedef unsigned int builtinfunctionflags;
 
-#define BUILTIN_FLAGSEMPTY  0
+#define BUILTIN_FLAGSEMPTY       0
+
+/** Function always returns a Float if called with Int or Float arguments */
+#define BUILTIN_FLAGSNUMERIC     (1<<0)
+
+/** Function constructs an instance of the builtin class of the same name, or raises an error */
+#define BUILTIN_FLAGSCONSTRUCTOR (1<<1)
+
+/** Function has no side effects and its result depends only on its arguments; a returned object (e.g. a Complex) is new and isn't changed in place afterwards */
+#define BUILTIN_FLAGSPURE        (1<<2)
 
 /** Type of C function that implements a built in Morpho function */
 typedef value (*builtinfunction) (vm *v, int nargs, value *args);
@@ -11,6 +11,7 @@
 #include "morpho.h"
 #include "common.h"
 #include "veneer.h"
+#include "stringbuilder.h"
 #include <stdio.h>
 #include <limits.h>
 
@@ -302,7 +303,7 @@ value File_readchar(vm *v, int nargs, value *args) {
     return MORPHO_NIL;
 }
 
-/** Write to a file  */
+/** Write strings or the contents of StringBuilders to a file, each followed by a newline */
 value File_write(vm *v, int nargs, value *args) {
     FILE *f=file_getfile(MORPHO_SELF(args));
     if (f) {
@@ -310,8 +311,10 @@ value File_write(vm *v, int nargs, value *args) {
             if (MORPHO_ISSTRING(MORPHO_GETARG(args, i))) {
                 char *line = MORPHO_GETCSTRING(MORPHO_GETARG(args, i));
                 if (fputs(line, f)==EOF) MORPHO_RAISE(v, FILE_WRITEFAIL);
-                if (fputc('\n', f)==EOF) MORPHO_RAISE(v, FILE_WRITEFAIL);
+            } else if (MORPHO_ISSTRINGBUILDER(MORPHO_GETARG(args, i))) {
+                if (!stringbuilder_write(MORPHO_GETSTRINGBUILDER(MORPHO_GETARG(args, i)), f)) MORPHO_RAISE(v, FILE_WRITEFAIL);
             } else MORPHO_RAISE(v, FILE_WRITEARGS);
+            if (fputc('\n', f)==EOF) MORPHO_RAISE(v, FILE_WRITEFAIL);
         }
     }
     
@@ -75,7 +75,7 @@ typedef struct {
 #define FILE_MODE_MSG                     "Second argument to File should be 'read', 'write' or 'append'."
 
 #define FILE_WRITEARGS                    "FlWrtArgs"
-#define FILE_WRITEARGS_MSG                "Arguments to File.write must be strings."
+#define FILE_WRITEARGS_MSG                "Arguments to File.write must be strings or StringBuilders."
 
 #define FILE_WRITEFAIL                    "FlWrtFld"
 #define FILE_WRITEFAIL_MSG                "Write to file failed."
@@ -89,6 +89,7 @@ typedef struct {
 bool file_getsize(FILE *f, size_t *s);
 
 void file_setworkingdirectory(const char *script);
+void file_relativepath(const char *fname, varray_char *name);
 
 FILE *file_openrelative(const char *fname, const char *mode);
 
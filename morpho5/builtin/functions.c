@@ -584,13 +584,13 @@ value builtin_clock(vm *v, int nargs, value *args) {
 }
 
 #define BUILTIN_MATH(function) \
-    builtin_addfunction(#function, builtin_##function, BUILTIN_FLAGSEMPTY);
+    builtin_addfunction(#function, builtin_##function, BUILTIN_FLAGSNUMERIC | BUILTIN_FLAGSPURE);
 
 #define BUILTIN_MATH_BOOL(function) \
-    builtin_addfunction(#function, builtin_##function, BUILTIN_FLAGSEMPTY);
+    builtin_addfunction(#function, builtin_##function, BUILTIN_FLAGSPURE);
 
 #define BUILTIN_TYPECHECK(function) \
-    builtin_addfunction(#function, builtin_##function, BUILTIN_FLAGSEMPTY);
+    builtin_addfunction(#function, builtin_##function, BUILTIN_FLAGSPURE);
 
 void functions_initialize(void) {
     builtin_addfunction(FUNCTION_CLOCK, builtin_clock, BUILTIN_FLAGSEMPTY);
@@ -599,9 +599,9 @@ void functions_initialize(void) {
     builtin_addfunction(FUNCTION_RANDOMNORMAL, builtin_randomnormal, BUILTIN_FLAGSEMPTY);
     
     builtin_addfunction(FUNCTION_SYSTEM, builtin_system, BUILTIN_FLAGSEMPTY);
-    builtin_addfunction(FUNCTION_ARCTAN, builtin_arctan, BUILTIN_FLAGSEMPTY);
+    builtin_addfunction(FUNCTION_ARCTAN, builtin_arctan, BUILTIN_FLAGSNUMERIC | BUILTIN_FLAGSPURE);
     
-    builtin_addfunction(FUNCTION_ABS, builtin_fabs, BUILTIN_FLAGSEMPTY);
+    builtin_addfunction(FUNCTION_ABS, builtin_fabs, BUILTIN_FLAGSNUMERIC | BUILTIN_FLAGSPURE);
     
     BUILTIN_MATH(exp)
     BUILTIN_MATH(log)
@@ -616,7 +616,7 @@ void functions_initialize(void) {
     BUILTIN_MATH(sinh)
     BUILTIN_MATH(cosh)
     BUILTIN_MATH(tanh)
-    BUILTIN_MATH(sqrt)
+    builtin_addfunction("sqrt", builtin_sqrt, BUILTIN_FLAGSPURE); // Negative arguments give a Complex result
 
     BUILTIN_MATH(floor)
     BUILTIN_MATH(ceil)
@@ -644,24 +644,24 @@ void functions_initialize(void) {
     BUILTIN_TYPECHECK(isselection)
     BUILTIN_TYPECHECK(isfield)
 
-    builtin_addfunction(FUNCTION_REAL,builtin_real,BUILTIN_FLAGSEMPTY);
-    builtin_addfunction(FUNCTION_IMAG,builtin_imag,BUILTIN_FLAGSEMPTY);
-    builtin_addfunction(FUNCTION_ANGLE,builtin_angle,BUILTIN_FLAGSEMPTY);
-    builtin_addfunction(FUNCTION_CONJ,builtin_conj,BUILTIN_FLAGSEMPTY);
+    builtin_addfunction(FUNCTION_REAL,builtin_real,BUILTIN_FLAGSPURE);
+    builtin_addfunction(FUNCTION_IMAG,builtin_imag,BUILTIN_FLAGSPURE);
+    builtin_addfunction(FUNCTION_ANGLE,builtin_angle,BUILTIN_FLAGSPURE);
+    builtin_addfunction(FUNCTION_CONJ,builtin_conj,BUILTIN_FLAGSPURE);
     
     builtin_addfunction(FUNCTION_ISCALLABLE, builtin_iscallablefunction, BUILTIN_FLAGSEMPTY);
     
-    builtin_addfunction(FUNCTION_INT, builtin_int, BUILTIN_FLAGSEMPTY);
-    builtin_addfunction(FUNCTION_FLOAT, builtin_float, BUILTIN_FLAGSEMPTY);
-    builtin_addfunction(FUNCTION_BOOL, builtin_bool, BUILTIN_FLAGSEMPTY);
+    builtin_addfunction(FUNCTION_INT, builtin_int, BUILTIN_FLAGSPURE);
+    builtin_addfunction(FUNCTION_FLOAT, builtin_float, BUILTIN_FLAGSNUMERIC | BUILTIN_FLAGSPURE);
+    builtin_addfunction(FUNCTION_BOOL, builtin_bool, BUILTIN_FLAGSPURE);
     
-    builtin_addfunction(FUNCTION_MOD, builtin_mod, BUILTIN_FLAGSEMPTY);
+    builtin_addfunction(FUNCTION_MOD, builtin_mod, BUILTIN_FLAGSPURE);
     
     builtin_addfunction(FUNCTION_BOUNDS, builtin_bounds, BUILTIN_FLAGSEMPTY);
-    builtin_addfunction(FUNCTION_MIN, builtin_min, BUILTIN_FLAGSEMPTY);
-    builtin_addfunction(FUNCTION_MAX, builtin_max, BUILTIN_FLAGSEMPTY);
+    builtin_addfunction(FUNCTION_MIN, builtin_min, BUILTIN_FLAGSPURE);
+    builtin_addfunction(FUNCTION_MAX, builtin_max, BUILTIN_FLAGSPURE);
     
-    builtin_addfunction(FUNCTION_SIGN, builtin_sign, BUILTIN_FLAGSEMPTY);
+    builtin_addfunction(FUNCTION_SIGN, builtin_sign, BUILTIN_FLAGSPURE);
 
     builtin_addfunction(FUNCTION_APPLY, builtin_apply, BUILTIN_FLAGSEMPTY);
     
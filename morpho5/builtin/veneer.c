@@ -4,11 +4,14 @@
  *  @brief Veneer classes over built in objects
  */
 
+#include <limits.h>
 #include "morpho.h"
 #include "veneer.h"
 #include "object.h"
 #include "common.h"
 #include "parse.h"
+#include "functional.h"
+#include "iterator.h"
 
 /* **********************************************************************
  * Object
@@ -286,7 +289,7 @@ bool string_tonumber(objectstring *string, value *out) {
             *out = MORPHO_INTEGER((int) i);
             return true;
         } else if (tok.type==TOKEN_NUMBER) {
-            double f = strtod(tok.start, NULL);
+            double f = parse_tokentofloat(tok.start, tok.length);
             if (minus) f=-f;
             *out = MORPHO_FLOAT(f);
             return true;
@@ -306,6 +309,16 @@ int string_countchars(objectstring *s) {
     return n;
 }
 
+/** Creates a new string from a character array, sharing an existing copy if the string is interned */
+static value string_internfromcstring(vm *v, const char *in, size_t length) {
+    value str = object_stringfromcstring(in, length);
+    if (MORPHO_ISNIL(str)) return str;
+
+    value out = morpho_internnewstring(v, str);
+    if (!MORPHO_ISSAME(out, str)) object_free(MORPHO_GETOBJECT(str));
+    return out;
+}
+
 /** Get a pointer to the i'th character of a string */
 char *string_index(objectstring *s, int i) {
     int n=0;
@@ -415,7 +428,7 @@ value String_split(vm *v, int nargs, value *args) {
             for (char *s = split->string; *s!='\0';) { // Loop over split chars
                 int nbytes = morpho_utf8numberofbytes((uint8_t *) s);
                 if (strncmp(c, s, nbytes)==0) {
-                    value newstring = object_stringfromcstring(last, c-last);
+                    value newstring = string_internfromcstring(v, last, c-last);
                     if (MORPHO_ISNIL(newstring)) morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
                     list_append(new, newstring);
                     last=c+nbytes;
@@ -424,7 +437,7 @@ value String_split(vm *v, int nargs, value *args) {
             }
         }
 
-        value newstring = object_stringfromcstring(last, slf->string+slf->length-last);
+        value newstring = string_internfromcstring(v, last, slf->string+slf->length-last);
         if (MORPHO_ISNIL(newstring)) morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
         list_append(new, newstring);
 
@@ -1011,43 +1024,228 @@ bool list_getelement(objectlist *list, int i, value *out) {
     return true;
 }
 
+/** Ranges shorter than this are finished with an insertion sort */
+#define LIST_SORTINSERTIONTHRESHOLD 16
+
+/** Insertion sort for short ranges; elements are moved by swapping so that data holds every value whenever cmp is called */
+static void list_insertionsort(value *data, int n, list_comparefn cmp, void *ref) {
+    for (int i=1; i<n; i++) {
+        for (int j=i; j>0 && cmp(data[j], data[j-1], ref)<0; j--) {
+            value swp=data[j]; data[j]=data[j-1]; data[j-1]=swp;
+        }
+    }
+}
+
+/** Merges the sorted runs data[0...mid] and data[mid...n] into tmp and copies the result back.
+    data is only written once merging is complete, so it holds every value whenever cmp is called;
+    cmp may call into morpho and trigger garbage collection, which doesn't see tmp. */
+static void list_merge(value *data, int mid, int n, value *tmp, list_comparefn cmp, void *ref) {
+    int i=0, j=mid, k=0;
+    while (i<mid && j<n) {
+        if (cmp(data[j], data[i], ref)<0) tmp[k++]=data[j++];
+        else tmp[k++]=data[i++];
+    }
+    while (i<mid) tmp[k++]=data[i++];
+
+    memcpy(data, tmp, k*sizeof(value)); // Any remainder of the second run is already in place
+}
+
+/** Stable merge sort; tmp must have space for n values */
+static void list_mergesort(value *data, int n, value *tmp, list_comparefn cmp, void *ref) {
+    if (n<2) return;
+
+    int mid=n/2;
+    list_mergesort(data, mid, tmp, cmp, ref);
+    list_mergesort(data+mid, n-mid, tmp, cmp, ref);
+
+    list_merge(data, mid, n, tmp, cmp, ref);
+}
+
+/** Reverses n values in place */
+static void list_reverse(value *data, int n) {
+    for (int i=0; i<n/2; i++) {
+        value swp=data[i]; data[i]=data[n-1-i]; data[n-1-i]=swp;
+    }
+}
+
+/** Merges the sorted runs data[0...mid] and data[mid...n] in place by rotation, without scratch space. Values are
+    only ever swapped, so data holds every value whenever cmp is called. */
+static void list_mergeinplace(value *data, int mid, int n, list_comparefn cmp, void *ref) {
+    if (mid==0 || mid==n) return;
+    if (n==2) {
+        if (cmp(data[1], data[0], ref)<0) { value swp=data[0]; data[0]=data[1]; data[1]=swp; }
+        return;
+    }
+
+    /* Cut the longer run in half and find where its middle value falls in the other run, keeping equal values of the first run first */
+    int i, j, lo, hi;
+    if (mid>n-mid) {
+        i=mid/2;
+        for (lo=mid, hi=n; lo<hi; ) { int m=lo+(hi-lo)/2; if (cmp(data[m], data[i], ref)<0) lo=m+1; else hi=m; }
+        j=lo;
+    } else {
+        j=mid+(n-mid)/2;
+        for (lo=0, hi=mid; lo<hi; ) { int m=lo+(hi-lo)/2; if (cmp(data[j], data[m], ref)<0) hi=m; else lo=m+1; }
+        i=lo;
+    }
+
+    /* Rotate data[i...mid] past data[mid...j] and merge the two halves that result */
+    list_reverse(data+i, mid-i);
+    list_reverse(data+mid, j-mid);
+    list_reverse(data+i, j-i);
+    int newmid=i+(j-mid);
+
+    list_mergeinplace(data, i, newmid, cmp, ref);
+    list_mergeinplace(data+newmid, j-newmid, n-newmid, cmp, ref);
+}
+
+/** Stable merge sort that needs no scratch space, used if none can be allocated */
+static void list_mergesortinplace(value *data, int n, list_comparefn cmp, void *ref) {
+    if (n<=LIST_SORTINSERTIONTHRESHOLD) { list_insertionsort(data, n, cmp, ref); return; }
+
+    int mid=n/2;
+    list_mergesortinplace(data, mid, cmp, ref);
+    list_mergesortinplace(data+mid, n-mid, cmp, ref);
+
+    list_mergeinplace(data, mid, n, cmp, ref);
+}
+
+/** Checks whether values are already sorted, reversing them if they are in strictly descending
+    order; the scan usually ends after a few comparisons for unordered input */
+static bool list_presorted(value *data, unsigned int n, list_comparefn cmp, void *ref) {
+    unsigned int i=1;
+    while (i<n && cmp(data[i], data[i-1], ref)>=0) i++;
+    if (i>=n) return true;
+    if (i>1) return false;
+
+    while (i<n && cmp(data[i], data[i-1], ref)<0) i++;
+    if (i<n) return false;
+
+    list_reverse(data, (int) n);
+    return true;
+}
+
+/** Lists shorter than this are sorted using scratch space on the stack */
+#define LIST_SORTSTACKSIZE 256
+
+/** Sorts an array of values in place with a given comparison function. The sort uses no
+    global state, so it may be used reentrantly, e.g. from within a comparison function.
+    A stable merge sort is used because it makes fewer comparisons than quicksort, which matters
+    when each comparison calls into morpho. It needs scratch space for n values, which is taken
+    from the stack for short arrays and otherwise allocated; if allocation fails the values are
+    merged in place instead, which is slower but equally stable.
+ * @param[in] data - values to sort
+ * @param[in] n - number of values
+ * @param[in] cmp - comparison function
+ * @param[in] ref - reference passed to the comparison function */
+void list_sortvalues(value *data, unsigned int n, list_comparefn cmp, void *ref) {
+    if (list_presorted(data, n, cmp, ref)) return;
+
+    value stack[LIST_SORTSTACKSIZE];
+    value *tmp = (n<=LIST_SORTSTACKSIZE ? stack : MORPHO_MALLOC(n*sizeof(value)));
+
+    if (tmp) {
+        list_mergesort(data, (int) n, tmp, cmp, ref);
+        if (tmp!=stack) MORPHO_FREE(tmp);
+    } else list_mergesortinplace(data, (int) n, cmp, ref);
+}
+
+static value list_keyoption;
+
 /** Sort function for list_sort */
-int list_sortfunction(const void *a, const void *b) {
-    value l=*(value *) a, r=*(value *) b;
-    MORPHO_CMPPROMOTETYPE(l, r);
-    return -morpho_comparevalue(l, r);
+static int list_sortfunction(value a, value b, void *ref) {
+    MORPHO_CMPPROMOTETYPE(a, b);
+    return -morpho_comparevalue(a, b);
 }
 
 /** Sort the contents of a list */
 void list_sort(objectlist *list) {
-    qsort(list->val.data, list->val.count, sizeof(value), list_sortfunction);
+    list_sortvalues(list->val.data, list->val.count, list_sortfunction, NULL);
 }
 
-static vm *list_sortwithfn_vm;
-static value list_sortwithfn_fn;
-static bool list_sortwithfn_err;
-
-/** Sort function for list_sort */
-int list_sortfunctionwfn(const void *a, const void *b) {
-    value args[2] = {*(value *) a, *(value *) b};
+/** State for sorting with a morpho comparison function */
+typedef struct {
+    vm *v;
+    value fn;
+    bool err;
+} listsortwithfnref;
+
+/** Sort function for list_sortwithfn; once an error has occurred no further calls are made */
+static int list_sortfunctionwfn(value a, value b, void *ref) {
+    listsortwithfnref *r = (listsortwithfnref *) ref;
+    value args[2] = {a, b};
     value ret;
 
-    if (morpho_call(list_sortwithfn_vm, list_sortwithfn_fn, 2, args, &ret)) {
+    if (r->err) return 0;
+
+    if (morpho_call(r->v, r->fn, 2, args, &ret)) {
         if (MORPHO_ISINTEGER(ret)) return MORPHO_GETINTEGERVALUE(ret);
         if (MORPHO_ISFLOAT(ret)) return morpho_comparevalue(MORPHO_FLOAT(0), ret);
     }
 
-    list_sortwithfn_err=true;
+    r->err=true;
     return 0;
 }
 
 /** Sort the contents of a list */
 bool list_sortwithfn(vm *v, value fn, objectlist *list) {
-    list_sortwithfn_vm=v;
-    list_sortwithfn_fn=fn;
-    list_sortwithfn_err=false;
-    qsort(list->val.data, list->val.count, sizeof(value), list_sortfunctionwfn);
-    return !list_sortwithfn_err;
+    listsortwithfnref ref = { .v=v, .fn=fn, .err=false };
+    list_sortvalues(list->val.data, list->val.count, list_sortfunctionwfn, &ref);
+    return !ref.err;
+}
+
+/** Sort function for list_sortwithkey; a and b are indices into the array of keys and
+    ties are broken by index so that the sort is stable */
+static int list_sortfunctionwkey(value a, value b, void *ref) {
+    value *keys = (value *) ref;
+    int i=MORPHO_GETINTEGERVALUE(a), j=MORPHO_GETINTEGERVALUE(b);
+    value l=keys[i], r=keys[j];
+    MORPHO_CMPPROMOTETYPE(l, r);
+    int c=-morpho_comparevalue(l, r);
+    return (c ? c : i-j);
+}
+
+/** Sorts the contents of a list by keys obtained by calling a function once on each element
+ * @param[in] v - virtual machine to use
+ * @param[in] fn - key function
+ * @param[in] list - list to sort
+ * @returns true on success; the list is unchanged if the key function fails */
+bool list_sortwithkey(vm *v, value fn, objectlist *list) {
+    unsigned int n=list->val.count;
+    if (n<2) return true;
+
+    /* Keys are held in a list so that they remain alive if the key function triggers collection */
+    objectlist *keylist = object_newlist(n, NULL);
+    value *order = MORPHO_MALLOC(n*sizeof(value));
+    if (!keylist || !order || keylist->val.capacity<n) {
+        if (keylist) object_free((object *) keylist);
+        if (order) MORPHO_FREE(order);
+        morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+        return false;
+    }
+
+    value keyval = MORPHO_OBJECT(keylist);
+    morpho_bindobjects(v, 1, &keyval);
+    int handle=morpho_retainobjects(v, 1, &keyval);
+
+    value *keys = keylist->val.data;
+    bool success=true;
+    for (unsigned int i=0; success && i<n; i++) {
+        value arg=list->val.data[i];
+        success=morpho_call(v, fn, 1, &arg, &keys[i]);
+        if (success) keylist->val.count++;
+        order[i]=MORPHO_INTEGER(i);
+    }
+
+    if (success) {
+        list_sortvalues(order, n, list_sortfunctionwkey, keys);
+        for (unsigned int i=0; i<n; i++) order[i]=list->val.data[MORPHO_GETINTEGERVALUE(order[i])];
+        memcpy(list->val.data, order, n*sizeof(value));
+    }
+
+    morpho_releaseobjects(v, handle);
+    MORPHO_FREE(order);
+    return success;
 }
 
 /** Sort function for list_order */
@@ -1094,6 +1292,84 @@ bool list_ismember(objectlist *list, value v) {
     return false;
 }
 
+/** Number of n-tuples (or n-sets if mode is MORPHO_SETMODE) drawn from nval values, or -1 if there are too many to enumerate */
+static long list_counttuples(unsigned int nval, unsigned int n, tuplemode mode) {
+    double c=1.0;
+
+    if (mode==MORPHO_SETMODE) {
+        if (n>nval) return 0;
+        for (unsigned int i=0; i<n; i++) c=c*(nval-i)/(i+1);
+    } else for (unsigned int i=0; i<n; i++) c*=nval;
+
+    return (c>INT_MAX ? -1 : (long) (c+0.5));
+}
+
+/** Generates the i'th tuple or set for an iterator. The workspace holds the counters used by morpho_tuples,
+    followed by the length of the list when the iterator was created. */
+static bool list_tupleelement(vm *v, objectiterator *it, unsigned int i, value *out, tuplemode mode) {
+    objectlist *list = MORPHO_GETLIST(it->source);
+    unsigned int n=it->param, nval=it->work[2*n];
+    value tuple[n];
+
+    if (list->val.count!=nval) return false;
+
+    if (it->indx<0 || i!=(unsigned int) it->indx+1) { // Restart and skip to the requested element
+        morpho_tuplesinit(nval, n, it->work, mode);
+        for (unsigned int k=0; k<i; k++) {
+            if (!morpho_tuples(nval, list->val.data, n, it->work, mode, tuple)) return false;
+        }
+    }
+
+    if (!morpho_tuples(nval, list->val.data, n, it->work, mode, tuple)) return false;
+
+    objectlist *el = object_newlist(n, tuple);
+    if (!el) {
+        morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+        return false;
+    }
+
+    *out=MORPHO_OBJECT(el);
+    morpho_bindobjects(v, 1, out);
+    return true;
+}
+
+static bool list_tupleiteratorfn(vm *v, objectiterator *it, unsigned int i, value *out) {
+    return list_tupleelement(v, it, i, out, MORPHO_TUPLEMODE);
+}
+
+static bool list_setiteratorfn(vm *v, objectiterator *it, unsigned int i, value *out) {
+    return list_tupleelement(v, it, i, out, MORPHO_SETMODE);
+}
+
+/** Creates an iterator that generates n-tuples or n-sets from a list one at a time */
+static value list_tupleiterator(vm *v, value list, int nargs, value *args, tuplemode mode) {
+    unsigned int n=2, nval=MORPHO_GETLIST(list)->val.count;
+
+    if (nargs>0 && MORPHO_ISINTEGER(MORPHO_GETARG(args, 0))) {
+        n=MORPHO_GETINTEGERVALUE(MORPHO_GETARG(args, 0));
+        if (n<2) n=2;
+        if (mode==MORPHO_SETMODE && n>nval) n=nval; // As for sets(), ask for too many and get the whole list
+    }
+
+    long count=list_counttuples(nval, n, mode);
+    if (count<0) MORPHO_RAISE(v, ITERATOR_TOOLONG);
+
+    value out=iterator_new(v, list, (unsigned int) count, (mode==MORPHO_SETMODE ? list_setiteratorfn : list_tupleiteratorfn), n, 2*n+1);
+    if (MORPHO_ISITERATOR(out)) MORPHO_GETITERATOR(out)->work[2*n]=nval;
+
+    return out;
+}
+
+/** Generate n-tuples from a list on demand */
+value List_itertuples(vm *v, int nargs, value *args) {
+    return list_tupleiterator(v, MORPHO_SELF(args), nargs, args, MORPHO_TUPLEMODE);
+}
+
+/** Generate n-sets from a list on demand */
+value List_itersets(vm *v, int nargs, value *args) {
+    return list_tupleiterator(v, MORPHO_SELF(args), nargs, args, MORPHO_SETMODE);
+}
+
 /** Clones a list */
 objectlist *list_clone(objectlist *list) {
     return object_newlist(list->val.count, list->val.data);
@@ -1335,10 +1611,20 @@ value List_enumerate(vm *v, int nargs, value *args) {
 value List_sort(vm *v, int nargs, value *args) {
     objectlist *slf = MORPHO_GETLIST(MORPHO_SELF(args));
 
-    if (nargs==0) {
+    value key=MORPHO_NIL;
+    int nfixed;
+
+    if (!builtin_options(v, nargs, args, &nfixed, 1, list_keyoption, &key)) return MORPHO_NIL;
+
+    if (!MORPHO_ISNIL(key)) {
+        if (nfixed==0 && MORPHO_ISCALLABLE(key)) {
+            list_sortwithkey(v, key, slf);
+        } else morpho_runtimeerror(v, LIST_SRTKEY);
+    } else if (nfixed==0) {
         list_sort(slf);
-    } else if (nargs==1 && MORPHO_ISCALLABLE(MORPHO_GETARG(args, 0))) {
-        if (!list_sortwithfn(v, MORPHO_GETARG(args, 0), slf)) {
+    } else if (nfixed==1 && MORPHO_ISCALLABLE(MORPHO_GETARG(args, 0))) {
+        if (!list_sortwithfn(v, MORPHO_GETARG(args, 0), slf) &&
+            ERROR_SUCCEEDED(*morpho_geterror(v))) {
             morpho_runtimeerror(v, LIST_SRTFN);
         }
     }
@@ -1465,6 +1751,23 @@ value List_add(vm *v, int nargs, value *args) {
     return out;
 }
 
+/** Higher order functions */
+value List_map(vm *v, int nargs, value *args) {
+    return veneer_map(v, MORPHO_SELF(args), nargs, args);
+}
+
+value List_filter(vm *v, int nargs, value *args) {
+    return veneer_filter(v, MORPHO_SELF(args), nargs, args);
+}
+
+value List_reduce(vm *v, int nargs, value *args) {
+    return veneer_reduce(v, MORPHO_SELF(args), nargs, args);
+}
+
+value List_parallelmap(vm *v, int nargs, value *args) {
+    return veneer_parallelmap(v, MORPHO_SELF(args), nargs, args);
+}
+
 MORPHO_BEGINCLASS(List)
 MORPHO_METHOD(MORPHO_APPEND_METHOD, List_append, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(LIST_REMOVE_METHOD, List_remove, BUILTIN_FLAGSEMPTY),
@@ -1478,12 +1781,18 @@ MORPHO_METHOD(MORPHO_ENUMERATE_METHOD, List_enumerate, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(MORPHO_COUNT_METHOD, List_count, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(LIST_TUPLES_METHOD, List_tuples, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(LIST_SETS_METHOD, List_sets, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(LIST_ITERTUPLES_METHOD, List_itertuples, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(LIST_ITERSETS_METHOD, List_itersets, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(MORPHO_CLONE_METHOD, List_clone, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(MORPHO_ADD_METHOD, List_add, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(LIST_SORT_METHOD, List_sort, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(LIST_ORDER_METHOD, List_order, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(LIST_ISMEMBER_METHOD, List_ismember, BUILTIN_FLAGSEMPTY),
-MORPHO_METHOD(MORPHO_CONTAINS_METHOD, List_ismember, BUILTIN_FLAGSEMPTY)
+MORPHO_METHOD(MORPHO_CONTAINS_METHOD, List_ismember, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(COLLECTION_MAP_METHOD, List_map, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(COLLECTION_FILTER_METHOD, List_filter, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(COLLECTION_REDUCE_METHOD, List_reduce, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(COLLECTION_PARALLELMAP_METHOD, List_parallelmap, BUILTIN_FLAGSEMPTY)
 MORPHO_ENDCLASS
 
 /* **********************************************************************
@@ -1499,7 +1808,7 @@ value dictionary_constructor(vm *v, int nargs, value *args) {
         out=MORPHO_OBJECT(new);
 
         for (unsigned int i=0; i+1<nargs; i+=2) {
-            dictionary_insert(&new->dict, MORPHO_GETARG(args, i), MORPHO_GETARG(args, i+1));
+            dictionary_insert(&new->dict, morpho_internstring(v, MORPHO_GETARG(args, i)), MORPHO_GETARG(args, i+1));
         }
 
         morpho_bindobjects(v, 1, &out);
@@ -1529,7 +1838,7 @@ value Dictionary_setindex(vm *v, int nargs, value *args) {
     if (nargs==2) {
         unsigned int capacity = slf->dict.capacity;
 
-        dictionary_insert(&slf->dict, MORPHO_GETARG(args, 0), MORPHO_GETARG(args, 1));
+        dictionary_insert(&slf->dict, morpho_internstring(v, MORPHO_GETARG(args, 0)), MORPHO_GETARG(args, 1));
 
         if (slf->dict.capacity!=capacity) morpho_resizeobject(v, (object *) slf, capacity*sizeof(dictionaryentry)+sizeof(objectdictionary), slf->dict.capacity*sizeof(dictionaryentry)+sizeof(objectdictionary));
     } else morpho_runtimeerror(v, SETINDEX_ARGS);
@@ -1590,15 +1899,11 @@ value Dictionary_count(vm *v, int nargs, value *args) {
     return MORPHO_INTEGER(slf->dict.count);
 }
 
-/** Iterates over dictionary; current implementation returns a sequence of keys */
+/** Iterates over dictionary; current implementation returns a sequence of keys. Successive calls
+    with n, n+1, ... resume from the slot found by the previous call. */
 value dictionary_iterate(objectdictionary *dict, unsigned int n) {
-    unsigned int k=0;
-    for (unsigned int i=0; i<dict->dict.capacity; i++) {
-        if (!MORPHO_ISNIL(dict->dict.contents[i].key)) {
-            if (k==n) return dict->dict.contents[i].key;
-            k++;
-        }
-    }
+    unsigned int slot;
+    if (dictionary_nthentry(&dict->dict, n, &dict->cursor, &slot)) return dict->dict.contents[slot].key;
     return MORPHO_NIL;
 }
 
@@ -1617,6 +1922,22 @@ value Dictionary_enumerate(vm *v, int nargs, value *args) {
     return out;
 }
 
+/** Generates the i'th key for an iterator */
+static bool dictionary_keyiteratorfn(vm *v, objectiterator *it, unsigned int i, value *out) {
+    dictionary *dict = &MORPHO_GETDICTIONARY(it->source)->dict;
+    unsigned int slot;
+
+    if (!dictionary_nthentry(dict, i, &it->cursor, &slot)) return false;
+    *out=dict->contents[slot].key;
+    return true;
+}
+
+/** Gets an iterator over the keys */
+value Dictionary_iterkeys(vm *v, int nargs, value *args) {
+    objectdictionary *slf = MORPHO_GETDICTIONARY(MORPHO_SELF(args));
+    return iterator_new(v, MORPHO_SELF(args), slf->dict.count, dictionary_keyiteratorfn, 0, 0);
+}
+
 /** Gets a list of keys */
 value Dictionary_keys(vm *v, int nargs, value *args) {
     objectdictionary *slf = MORPHO_GETDICTIONARY(MORPHO_SELF(args));
@@ -1691,6 +2012,7 @@ MORPHO_METHOD(MORPHO_PRINT_METHOD, Dictionary_print, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(MORPHO_COUNT_METHOD, Dictionary_count, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(MORPHO_ENUMERATE_METHOD, Dictionary_enumerate, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(DICTIONARY_KEYS_METHOD, Dictionary_keys, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(DICTIONARY_ITERKEYS_METHOD, Dictionary_iterkeys, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(MORPHO_CLONE_METHOD, Dictionary_clone, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(MORPHO_UNION_METHOD, Dictionary_union, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(MORPHO_INTERSECTION_METHOD, Dictionary_intersection, BUILTIN_FLAGSEMPTY),
@@ -1807,14 +2129,244 @@ value Range_clone(vm *v, int nargs, value *args) {
     return out;
 }
 
+/** Higher order functions */
+value Range_map(vm *v, int nargs, value *args) {
+    return veneer_map(v, MORPHO_SELF(args), nargs, args);
+}
+
+value Range_filter(vm *v, int nargs, value *args) {
+    return veneer_filter(v, MORPHO_SELF(args), nargs, args);
+}
+
+value Range_reduce(vm *v, int nargs, value *args) {
+    return veneer_reduce(v, MORPHO_SELF(args), nargs, args);
+}
+
+value Range_parallelmap(vm *v, int nargs, value *args) {
+    return veneer_parallelmap(v, MORPHO_SELF(args), nargs, args);
+}
+
 MORPHO_BEGINCLASS(Range)
 MORPHO_METHOD(MORPHO_GETINDEX_METHOD, Range_getindex, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(MORPHO_PRINT_METHOD, Object_print, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(MORPHO_ENUMERATE_METHOD, Range_enumerate, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(MORPHO_COUNT_METHOD, Range_count, BUILTIN_FLAGSEMPTY),
-MORPHO_METHOD(MORPHO_CLONE_METHOD, Range_clone, BUILTIN_FLAGSEMPTY)
+MORPHO_METHOD(MORPHO_CLONE_METHOD, Range_clone, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(COLLECTION_MAP_METHOD, Range_map, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(COLLECTION_FILTER_METHOD, Range_filter, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(COLLECTION_REDUCE_METHOD, Range_reduce, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(COLLECTION_PARALLELMAP_METHOD, Range_parallelmap, BUILTIN_FLAGSEMPTY)
 MORPHO_ENDCLASS
 
+/* **********************************************************************
+ * Higher order functions
+ * ********************************************************************** */
+
+/** Prepares a List, Range or Matrix for traversal. Matrices are traversed by column,
+ *  so they're replaced by a List of their columns that is retained until released with the handle. */
+static bool veneer_items(vm *v, value collection, value *items, int *count, int *handle) {
+    *items=collection;
+    *handle=-1;
+
+    if (MORPHO_ISLIST(collection)) {
+        *count=MORPHO_GETLIST(collection)->val.count;
+    } else if (MORPHO_ISRANGE(collection)) {
+        *count=range_count(MORPHO_GETRANGE(collection));
+    } else if (MORPHO_ISMATRIX(collection)) {
+        objectmatrix *m=MORPHO_GETMATRIX(collection);
+        objectlist *lst=object_newlist(0, NULL);
+        if (!lst || (m->ncols && !list_resize(lst, m->ncols))) {
+            if (lst) object_free((object *) lst);
+            morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+            return false;
+        }
+
+        for (unsigned int i=0; i<m->ncols; i++) {
+            objectmatrix *col=object_matrixfromfloats(m->nrows, 1, m->elements+i*m->nrows);
+            if (!col) {
+                for (unsigned int j=0; j<i; j++) object_free(MORPHO_GETOBJECT(lst->val.data[j]));
+                object_free((object *) lst);
+                morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+                return false;
+            }
+            lst->val.data[lst->val.count++]=MORPHO_OBJECT(col);
+        }
+
+        // Bind the columns before the List that holds them
+        morpho_bindobjects(v, lst->val.count, lst->val.data);
+        value out=MORPHO_OBJECT(lst);
+        morpho_bindobjects(v, 1, &out);
+
+        *items=out;
+        *count=m->ncols;
+        *handle=morpho_retainobjects(v, 1, items);
+    } else return false;
+
+    return true;
+}
+
+/** Gets the ith item from a collection prepared by veneer_items */
+static inline value veneer_item(value items, int i) {
+    if (MORPHO_ISLIST(items)) return MORPHO_GETLIST(items)->val.data[i];
+    return range_iterate(MORPHO_GETRANGE(items), i);
+}
+
+/** Creates a new List to hold results, bound to the VM and retained */
+static objectlist *veneer_newresults(vm *v, int count, value *out, int *handle) {
+    objectlist *new=object_newlist(0, NULL);
+
+    if (new && count && !list_resize(new, count)) {
+        object_free((object *) new);
+        new=NULL;
+    }
+
+    if (new) {
+        *out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, out);
+        *handle=morpho_retainobjects(v, 1, out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+
+    return new;
+}
+
+/** Releases objects retained during a traversal; handles are released in reverse order of creation */
+static void veneer_releaseitems(vm *v, int itemhandle, int outhandle) {
+    morpho_releaseobjects(v, (itemhandle>=0 ? itemhandle : outhandle));
+}
+
+/** Maps a function over the elements of a List or Range, or the columns of a Matrix, returning a List of results */
+value veneer_map(vm *v, value collection, int nargs, value *args) {
+    value fn=(nargs==1 ? MORPHO_GETARG(args, 0) : MORPHO_NIL);
+    value items, out=MORPHO_NIL;
+    int n, handle, outhandle=-1;
+
+    if (!MORPHO_ISCALLABLE(fn)) MORPHO_RAISE(v, COLLECTION_MAPFN);
+    if (!veneer_items(v, collection, &items, &n, &handle)) return MORPHO_NIL;
+
+    objectlist *new=veneer_newresults(v, n, &out, &outhandle);
+    if (new) for (int i=0; i<n; i++) {
+        value item=veneer_item(items, i), ret;
+        if (!morpho_call(v, fn, 1, &item, &ret)) { out=MORPHO_NIL; break; }
+        new->val.data[new->val.count++]=ret;
+    }
+
+    veneer_releaseitems(v, handle, outhandle);
+    return out;
+}
+
+/** Returns a List of the elements, or Matrix columns, for which a function returns true */
+value veneer_filter(vm *v, value collection, int nargs, value *args) {
+    value fn=(nargs==1 ? MORPHO_GETARG(args, 0) : MORPHO_NIL);
+    value items, out=MORPHO_NIL;
+    int n, handle, outhandle=-1;
+
+    if (!MORPHO_ISCALLABLE(fn)) MORPHO_RAISE(v, COLLECTION_MAPFN);
+    if (!veneer_items(v, collection, &items, &n, &handle)) return MORPHO_NIL;
+
+    objectlist *new=veneer_newresults(v, n, &out, &outhandle);
+    if (new) for (int i=0; i<n; i++) {
+        value item=veneer_item(items, i), ret;
+        if (!morpho_call(v, fn, 1, &item, &ret)) { out=MORPHO_NIL; break; }
+        if (MORPHO_ISTRUE(ret)) new->val.data[new->val.count++]=item;
+    }
+
+    veneer_releaseitems(v, handle, outhandle);
+    return out;
+}
+
+/** Combines the elements, or Matrix columns, of a collection pairwise with a function, starting
+ *  from an optional initial value, i.e. fn(fn(fn(init, x0), x1), x2)... */
+value veneer_reduce(vm *v, value collection, int nargs, value *args) {
+    value fn=(nargs>=1 ? MORPHO_GETARG(args, 0) : MORPHO_NIL);
+    value items, acc=MORPHO_NIL;
+    int n, handle, i=0;
+
+    if (!MORPHO_ISCALLABLE(fn) || nargs>2) MORPHO_RAISE(v, COLLECTION_MAPFN);
+    if (!veneer_items(v, collection, &items, &n, &handle)) return MORPHO_NIL;
+
+    if (nargs==2) {
+        acc=MORPHO_GETARG(args, 1);
+    } else if (n>0) {
+        acc=veneer_item(items, i++);
+    } else morpho_runtimeerror(v, COLLECTION_REDUCEEMPTY);
+
+    for (; i<n; i++) {
+        value pair[2] = { acc, veneer_item(items, i) };
+        if (!morpho_call(v, fn, 2, pair, &acc)) { acc=MORPHO_NIL; break; }
+    }
+
+    if (handle>=0) morpho_releaseobjects(v, handle);
+    return acc;
+}
+
+/** A contiguous chunk of a parallel map, executed by a subkernel on a worker thread */
+typedef struct {
+    vm *v; /* Subkernel that executes this chunk */
+    value fn; /* Function to call */
+    value items; /* Collection prepared by veneer_items */
+    int start, end; /* Range of items to process */
+    value *out; /* Results, indexed like the items */
+    _MORPHO_PADDING;
+} veneer_maptask;
+
+/** Worker function for parallelmap. Objects created by the function stay with the subkernel
+ *  until it is released, so results survive to be collected by the calling VM. */
+static bool veneer_mapworker(void *arg) {
+    veneer_maptask *task = (veneer_maptask *) arg;
+
+    for (int i=task->start; i<task->end; i++) {
+        value item=veneer_item(task->items, i);
+        if (!morpho_call(task->v, task->fn, 1, &item, task->out+i)) return false;
+    }
+
+    return true;
+}
+
+/** Maps a function over a collection in parallel, dividing it into chunks that are executed on the
+ *  functional threadpool. The function must be pure: it may only read shared state. */
+value veneer_parallelmap(vm *v, value collection, int nargs, value *args) {
+    value fn=(nargs==1 ? MORPHO_GETARG(args, 0) : MORPHO_NIL);
+    value items, out=MORPHO_NIL;
+    int n, handle, outhandle=-1;
+    int ntask=morpho_threadnumber();
+
+    if (!MORPHO_ISCALLABLE(fn)) MORPHO_RAISE(v, COLLECTION_MAPFN);
+    if (!ntask) return veneer_map(v, collection, nargs, args);
+    if (!veneer_items(v, collection, &items, &n, &handle)) return MORPHO_NIL;
+    if (ntask>n) ntask=n;
+
+    objectlist *new=veneer_newresults(v, n, &out, &outhandle);
+    if (new && ntask>0) {
+        for (int i=0; i<n; i++) new->val.data[i]=MORPHO_NIL;
+        new->val.count=n;
+
+        vm *subkernels[ntask];
+        veneer_maptask task[ntask];
+
+        if (vm_subkernels(v, ntask, subkernels)) {
+            for (int i=0; i<ntask; i++) {
+                task[i].v=subkernels[i];
+                task[i].fn=fn;
+                task[i].items=items;
+                task[i].start=(int) (((long) n*i)/ntask);
+                task[i].end=(int) (((long) n*(i+1))/ntask);
+                task[i].out=new->val.data;
+                threadpool_add_task(&functional_pool, veneer_mapworker, (void *) &task[i]);
+            }
+            threadpool_fence(&functional_pool);
+
+            for (int i=0; i<ntask; i++) vm_releasesubkernel(subkernels[i]);
+            if (!ERROR_SUCCEEDED(*morpho_geterror(v))) out=MORPHO_NIL;
+        } else {
+            morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+            out=MORPHO_NIL;
+        }
+    }
+
+    veneer_releaseitems(v, handle, outhandle);
+    return out;
+}
+
 /* **********************************************************************
  * Closure
  * ********************************************************************** */
@@ -2031,7 +2583,7 @@ void veneer_initialize(void) {
     object_setveneerclass(OBJECT_ARRAY, arrayclass);
 
     /* List */
-    builtin_addfunction(LIST_CLASSNAME, list_constructor, BUILTIN_FLAGSEMPTY);
+    builtin_addfunction(LIST_CLASSNAME, list_constructor, BUILTIN_FLAGSCONSTRUCTOR);
     value listclass=builtin_addclass(LIST_CLASSNAME, MORPHO_GETCLASSDEFINITION(List), objclass);
     object_setveneerclass(OBJECT_LIST, listclass);
 
@@ -2060,6 +2612,7 @@ void veneer_initialize(void) {
     
     /* Error */
     builtin_addclass(ERROR_CLASSNAME, MORPHO_GETCLASSDEFINITION(Error), objclass);
+    list_keyoption=builtin_internsymbolascstring(LIST_KEY_OPTION);
     error_tagproperty=builtin_internsymbolascstring(ERROR_TAG_PROPERTY);
     error_messageproperty=builtin_internsymbolascstring(ERROR_MESSAGE_PROPERTY);
 
@@ -2079,6 +2632,9 @@ void veneer_initialize(void) {
     morpho_defineerror(LIST_ENTRYNTFND, ERROR_HALT, LIST_ENTRYNTFND_MSG);
     morpho_defineerror(LIST_ADDARGS, ERROR_HALT, LIST_ADDARGS_MSG);
     morpho_defineerror(LIST_SRTFN, ERROR_HALT, LIST_SRTFN_MSG);
+    morpho_defineerror(LIST_SRTKEY, ERROR_HALT, LIST_SRTKEY_MSG);
+    morpho_defineerror(COLLECTION_MAPFN, ERROR_HALT, COLLECTION_MAPFN_MSG);
+    morpho_defineerror(COLLECTION_REDUCEEMPTY, ERROR_HALT, COLLECTION_REDUCEEMPTY_MSG);
     morpho_defineerror(LIST_ARGS, ERROR_HALT, LIST_ARGS_MSG);
     morpho_defineerror(LIST_NUMARGS, ERROR_HALT, LIST_NUMARGS_MSG);
     morpho_defineerror(ERROR_ARGS, ERROR_HALT, ERROR_ARGS_MSG);
@@ -40,8 +40,17 @@
 #define LIST_REMOVE_METHOD "remove"
 #define LIST_TUPLES_METHOD "tuples"
 #define LIST_SETS_METHOD "sets"
+#define LIST_ITERTUPLES_METHOD "itertuples"
+#define LIST_ITERSETS_METHOD "itersets"
+#define LIST_KEY_OPTION "key"
+
+#define COLLECTION_MAP_METHOD "map"
+#define COLLECTION_FILTER_METHOD "filter"
+#define COLLECTION_REDUCE_METHOD "reduce"
+#define COLLECTION_PARALLELMAP_METHOD "parallelmap"
 
 #define DICTIONARY_KEYS_METHOD "keys"
+#define DICTIONARY_ITERKEYS_METHOD "iterkeys"
 #define DICTIONARY_CONTAINS_METHOD "contains"
 #define DICTIONARY_REMOVE_METHOD "remove"
 #define DICTIONARY_CLEAR_METHOD "clear"
@@ -82,12 +91,21 @@
 #define LIST_SRTFN                        "LstSrtFn"
 #define LIST_SRTFN_MSG                    "List sort function must return an integer."
 
+#define LIST_SRTKEY                       "LstSrtKey"
+#define LIST_SRTKEY_MSG                   "List sort key must be a function and cannot be combined with a comparison function."
+
 #define LIST_ARGS                         "LstArgs"
 #define LIST_ARGS_MSG                     "Lists must be called with integer dimensions as arguments."
 
 #define LIST_NUMARGS                      "LstNumArgs"
 #define LIST_NUMARGS_MSG                  "Lists can only be indexed with one argument."
 
+#define COLLECTION_MAPFN                  "MapFn"
+#define COLLECTION_MAPFN_MSG              "Method expects a function to call on each element."
+
+#define COLLECTION_REDUCEEMPTY            "RdcEmpty"
+#define COLLECTION_REDUCEEMPTY_MSG        "Cannot reduce an empty collection without an initial value."
+
 #define STRING_IMMTBL                     "StrngImmtbl"
 #define STRING_IMMTBL_MSG                 "Strings are immutable."
 
@@ -147,11 +165,24 @@ bool list_resize(objectlist *list, int size);
 void list_append(objectlist *list, value v);
 unsigned int list_length(objectlist *list);
 bool list_getelement(objectlist *list, int i, value *out);
+
+/** Comparison function used by list_sortvalues; returns a negative number if a should precede b,
+    a positive number if b should precede a and zero if they are equivalent */
+typedef int (*list_comparefn) (value a, value b, void *ref);
+
+void list_sortvalues(value *data, unsigned int n, list_comparefn cmp, void *ref);
 void list_sort(objectlist *list);
+bool list_sortwithfn(vm *v, value fn, objectlist *list);
+bool list_sortwithkey(vm *v, value fn, objectlist *list);
 objectlist *list_clone(objectlist *list);
 value range_iterate(objectrange *range, unsigned int i);
 int range_count(objectrange *range);
 
+value veneer_map(vm *v, value collection, int nargs, value *args);
+value veneer_filter(vm *v, value collection, int nargs, value *args);
+value veneer_reduce(vm *v, value collection, int nargs, value *args);
+value veneer_parallelmap(vm *v, value collection, int nargs, value *args);
+
 void veneer_initialize(void);
 
 #endif /* veneer_h */
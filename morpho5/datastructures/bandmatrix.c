@@ -0,0 +1,626 @@
+/** @file bandmatrix.c
+ *  @author T J Atherton
+ *
+ *  @brief Veneer class over the objectbandmatrix type, a square matrix whose nonzero elements lie in a band about the diagonal
+ */
+
+#include <string.h>
+#include "object.h"
+#include "matrix.h"
+#include "bandmatrix.h"
+#include "morpho.h"
+#include "builtin.h"
+#include "veneer.h"
+#include "common.h"
+
+/* **********************************************************************
+ * Band matrix objects
+ * ********************************************************************** */
+
+objecttype objectbandmatrixtype;
+
+/** Function object definitions */
+size_t objectbandmatrix_sizefn(object *obj) {
+    objectbandmatrix *m = (objectbandmatrix *) obj;
+    return sizeof(objectbandmatrix)+sizeof(double)*m->n*BANDMATRIX_LD(m);
+}
+
+void objectbandmatrix_printfn(object *obj) {
+    printf("<BandMatrix>");
+}
+
+objecttypedefn objectbandmatrixdefn = {
+    .printfn=objectbandmatrix_printfn,
+    .markfn=NULL,
+    .freefn=NULL,
+    .sizefn=objectbandmatrix_sizefn
+};
+
+/** Creates a band matrix; bandwidths larger than the matrix are reduced to fit */
+objectbandmatrix *object_newbandmatrix(unsigned int n, unsigned int kl, unsigned int ku, bool zero) {
+    if (n>0 && kl>n-1) kl=n-1;
+    if (n>0 && ku>n-1) ku=n-1;
+    unsigned int nel = n*(kl+ku+1);
+    objectbandmatrix *new = (objectbandmatrix *) object_new(sizeof(objectbandmatrix)+nel*sizeof(double), OBJECT_BANDMATRIX);
+
+    if (new) {
+        new->n=n;
+        new->kl=kl;
+        new->ku=ku;
+        new->elements=new->matrixdata;
+        if (zero) memset(new->elements, 0, sizeof(double)*nel);
+    }
+
+    return new;
+}
+
+/** Creates a band matrix from the band of a square matrix; elements outside the band are ignored */
+objectbandmatrix *object_bandmatrixfrommatrix(objectmatrix *m, unsigned int kl, unsigned int ku) {
+    if (m->nrows!=m->ncols) return NULL;
+    objectbandmatrix *new = object_newbandmatrix(m->nrows, kl, ku, true);
+
+    if (new) {
+        for (unsigned int j=0; j<new->n; j++) {
+            unsigned int imin=(j>new->ku ? j-new->ku : 0), imax=(j+new->kl<new->n ? j+new->kl : new->n-1);
+            for (unsigned int i=imin; i<=imax; i++) new->elements[BANDMATRIX_INDEX(new, i, j)]=m->elements[i+j*m->nrows];
+        }
+    }
+
+    return new;
+}
+
+/** Creates a full matrix from a band matrix */
+objectmatrix *object_matrixfrombandmatrix(objectbandmatrix *b) {
+    objectmatrix *new = object_newmatrix(b->n, b->n, true);
+
+    if (new) {
+        for (unsigned int j=0; j<b->n; j++) {
+            unsigned int imin=(j>b->ku ? j-b->ku : 0), imax=(j+b->kl<b->n ? j+b->kl : b->n-1);
+            for (unsigned int i=imin; i<=imax; i++) new->elements[i+j*b->n]=b->elements[BANDMATRIX_INDEX(b, i, j)];
+        }
+    }
+
+    return new;
+}
+
+/** Creates a copy of a band matrix */
+static objectbandmatrix *object_clonebandmatrix(objectbandmatrix *b) {
+    objectbandmatrix *new = object_newbandmatrix(b->n, b->kl, b->ku, false);
+    if (new) memcpy(new->elements, b->elements, sizeof(double)*b->n*BANDMATRIX_LD(b));
+    return new;
+}
+
+/* **********************************************************************
+ * Band matrix operations
+ * ********************************************************************* */
+
+/** Gets element (i, j) of a band matrix, which is zero outside the band; indices must be in range */
+double bandmatrix_get(objectbandmatrix *a, unsigned int i, unsigned int j) {
+    return (BANDMATRIX_INBAND(a, i, j) ? a->elements[BANDMATRIX_INDEX(a, i, j)] : 0.0);
+}
+
+/** Accumulates a multiple of another band matrix in place, a + lambda*b -> a; the band of a must contain that of b */
+objectmatrixerror bandmatrix_accumulate(objectbandmatrix *a, double lambda, objectbandmatrix *b) {
+    if (a->n!=b->n || a->kl<b->kl || a->ku<b->ku) return MATRIX_INCMPTBLDIM;
+
+    if (a->kl==b->kl && a->ku==b->ku) {
+        cblas_daxpy(a->n*BANDMATRIX_LD(a), lambda, b->elements, 1, a->elements, 1);
+    } else {
+        for (unsigned int j=0; j<a->n; j++) {
+            unsigned int imin=(j>b->ku ? j-b->ku : 0), imax=(j+b->kl<b->n ? j+b->kl : b->n-1);
+            cblas_daxpy(imax-imin+1, lambda, b->elements+BANDMATRIX_INDEX(b, imin, j), 1, a->elements+BANDMATRIX_INDEX(a, imin, j), 1);
+        }
+    }
+    return MATRIX_OK;
+}
+
+/** Scales a band matrix in place */
+objectmatrixerror bandmatrix_scale(objectbandmatrix *a, double scale) {
+    cblas_dscal(a->n*BANDMATRIX_LD(a), scale, a->elements, 1);
+    return MATRIX_OK;
+}
+
+/** Multiplies two band matrices, a * b -> out; out must be zero and have at least a->kl+b->kl subdiagonals and a->ku+b->ku superdiagonals, or as many as fit */
+objectmatrixerror bandmatrix_mul(objectbandmatrix *a, objectbandmatrix *b, objectbandmatrix *out) {
+    unsigned int n=a->n;
+    if (b->n!=n || out->n!=n) return MATRIX_INCMPTBLDIM;
+    if (n==0) return MATRIX_OK;
+    if (out->kl<(a->kl+b->kl<n ? a->kl+b->kl : n-1) ||
+        out->ku<(a->ku+b->ku<n ? a->ku+b->ku : n-1)) return MATRIX_INCMPTBLDIM;
+
+    for (unsigned int j=0; j<n; j++) {
+        unsigned int kmin=(j>b->ku ? j-b->ku : 0), kmax=(j+b->kl<n ? j+b->kl : n-1);
+        for (unsigned int k=kmin; k<=kmax; k++) {
+            double bkj=b->elements[BANDMATRIX_INDEX(b, k, j)];
+            unsigned int imin=(k>a->ku ? k-a->ku : 0), imax=(k+a->kl<n ? k+a->kl : n-1);
+            for (unsigned int i=imin; i<=imax; i++) {
+                out->elements[BANDMATRIX_INDEX(out, i, j)]+=a->elements[BANDMATRIX_INDEX(a, i, k)]*bkj;
+            }
+        }
+    }
+    return MATRIX_OK;
+}
+
+/** Multiplies a band matrix by a matrix, a * b -> out, applying dgbmv to each column of b */
+objectmatrixerror bandmatrix_mulmatrix(objectbandmatrix *a, objectmatrix *b, objectmatrix *out) {
+    if (a->n!=b->nrows || out->nrows!=a->n || out->ncols!=b->ncols) return MATRIX_INCMPTBLDIM;
+    for (unsigned int j=0; j<b->ncols; j++) {
+        cblas_dgbmv(CblasColMajor, CblasNoTrans, a->n, a->n, a->kl, a->ku, 1.0, a->elements, BANDMATRIX_LD(a), b->elements+j*b->nrows, 1, 0.0, out->elements+j*out->nrows, 1);
+    }
+    return MATRIX_OK;
+}
+
+/** Multiplies a matrix by a band matrix, a * b -> out; each row of the result is the transpose of b applied to the corresponding row of a */
+objectmatrixerror bandmatrix_matrixmul(objectmatrix *a, objectbandmatrix *b, objectmatrix *out) {
+    if (a->ncols!=b->n || out->nrows!=a->nrows || out->ncols!=b->n) return MATRIX_INCMPTBLDIM;
+    for (unsigned int i=0; i<a->nrows; i++) {
+        cblas_dgbmv(CblasColMajor, CblasTrans, b->n, b->n, b->kl, b->ku, 1.0, b->elements, BANDMATRIX_LD(b), a->elements+i, a->nrows, 0.0, out->elements+i, out->nrows);
+    }
+    return MATRIX_OK;
+}
+
+/** Frobenius inner product */
+objectmatrixerror bandmatrix_inner(objectbandmatrix *a, objectbandmatrix *b, double *out) {
+    if (a->n!=b->n) return MATRIX_INCMPTBLDIM;
+    if (a->kl==b->kl && a->ku==b->ku) {
+        *out=cblas_ddot(a->n*BANDMATRIX_LD(a), a->elements, 1, b->elements, 1);
+        return MATRIX_OK;
+    }
+
+    double sum=0.0;
+    for (unsigned int j=0; j<a->n; j++) {
+        unsigned int imin=(j>a->ku ? j-a->ku : 0), imax=(j+a->kl<a->n ? j+a->kl : a->n-1);
+        for (unsigned int i=imin; i<=imax; i++) sum+=a->elements[BANDMATRIX_INDEX(a, i, j)]*bandmatrix_get(b, i, j);
+    }
+    *out=sum;
+    return MATRIX_OK;
+}
+
+/** Solves a.x = b by LU decomposition with partial pivoting, which preserves the band structure but needs kl additional superdiagonals for fill in
+ * @returns MATRIX_OK, MATRIX_INCMPTBLDIM, MATRIX_SING if a is singular or MATRIX_ALLOC */
+objectmatrixerror bandmatrix_solve(objectbandmatrix *a, objectmatrix *b, objectmatrix *out) {
+    if (a->n!=b->nrows || out->nrows!=b->nrows || out->ncols!=b->ncols) return MATRIX_INCMPTBLDIM;
+    int n=a->n, kl=a->kl, ku=a->ku, nrhs=b->ncols, ldab=2*a->kl+a->ku+1, info;
+    unsigned int ld=BANDMATRIX_LD(a);
+
+    double *ab=MORPHO_MALLOC(sizeof(double)*(n ? n*ldab : 1));
+    int *pivot=MORPHO_MALLOC(sizeof(int)*(n ? n : 1));
+    if (!ab || !pivot) {
+        if (ab) MORPHO_FREE(ab);
+        if (pivot) MORPHO_FREE(pivot);
+        return MATRIX_ALLOC;
+    }
+
+    /* Copy each column below the kl rows reserved for fill in */
+    memset(ab, 0, sizeof(double)*n*ldab);
+    for (int j=0; j<n; j++) memcpy(ab+j*ldab+kl, a->elements+j*ld, sizeof(double)*ld);
+    if (out!=b) cblas_dcopy(b->nrows*b->ncols, b->elements, 1, out->elements, 1);
+
+#ifdef MORPHO_LINALG_USE_LAPACKE
+    info=LAPACKE_dgbsv(LAPACK_COL_MAJOR, n, kl, ku, nrhs, ab, ldab, pivot, out->elements, n);
+#else
+    dgbsv_(&n, &kl, &ku, &nrhs, ab, &ldab, pivot, out->elements, &n, &info);
+#endif
+
+    MORPHO_FREE(ab);
+    MORPHO_FREE(pivot);
+    return (info==0 ? MATRIX_OK : (info>0 ? MATRIX_SING : MATRIX_INVLD));
+}
+
+/** Transposes a band matrix; out must have the subdiagonals and superdiagonals of a interchanged */
+objectmatrixerror bandmatrix_transpose(objectbandmatrix *a, objectbandmatrix *out) {
+    if (a->n!=out->n || a->kl!=out->ku || a->ku!=out->kl) return MATRIX_INCMPTBLDIM;
+    memset(out->elements, 0, sizeof(double)*out->n*BANDMATRIX_LD(out));
+    for (unsigned int j=0; j<a->n; j++) {
+        unsigned int imin=(j>a->ku ? j-a->ku : 0), imax=(j+a->kl<a->n ? j+a->kl : a->n-1);
+        for (unsigned int i=imin; i<=imax; i++) out->elements[BANDMATRIX_INDEX(out, j, i)]=a->elements[BANDMATRIX_INDEX(a, i, j)];
+    }
+    return MATRIX_OK;
+}
+
+/** Sums all elements using Kahan summation; stored positions outside the matrix are zero and do not contribute */
+double bandmatrix_sum(objectbandmatrix *a) {
+    unsigned int nel=a->n*BANDMATRIX_LD(a);
+    double sum=0.0, c=0.0, y, t;
+
+    for (unsigned int i=0; i<nel; i++) {
+        y=a->elements[i]-c;
+        t=sum+y;
+        c=(t-sum)-y;
+        sum=t;
+    }
+    return sum;
+}
+
+/** Frobenius norm */
+double bandmatrix_norm(objectbandmatrix *a) {
+    return cblas_dnrm2(a->n*BANDMATRIX_LD(a), a->elements, 1);
+}
+
+/** Trace */
+double bandmatrix_trace(objectbandmatrix *a) {
+    double sum=0.0;
+    for (unsigned int j=0; j<a->n; j++) sum+=a->elements[BANDMATRIX_INDEX(a, j, j)];
+    return sum;
+}
+
+/** Prints a band matrix in full */
+static void bandmatrix_print(objectbandmatrix *m) {
+    for (unsigned int i=0; i<m->n; i++) {
+        printf("[ ");
+        for (unsigned int j=0; j<m->n; j++) {
+            double v=bandmatrix_get(m, i, j);
+            printf("%g ", (fabs(v)<MORPHO_EPS ? 0 : v));
+        }
+        printf("]%s", (i<m->n-1 ? "\n" : ""));
+    }
+}
+
+/* **********************************************************************
+ * BandMatrix class
+ * ********************************************************************* */
+
+/** Gets a nonnegative integer bandwidth from a value */
+static bool bandmatrix_getwidth(value val, unsigned int *out) {
+    if (!MORPHO_ISINTEGER(val) || MORPHO_GETINTEGERVALUE(val)<0) return false;
+    *out=(unsigned int) MORPHO_GETINTEGERVALUE(val);
+    return true;
+}
+
+/** Constructs a BandMatrix */
+value bandmatrix_constructor(vm *v, int nargs, value *args) {
+    objectbandmatrix *new=NULL;
+    unsigned int n, kl, ku;
+    value out=MORPHO_NIL;
+
+    if (nargs==3 &&
+        bandmatrix_getwidth(MORPHO_GETARG(args, 1), &kl) &&
+        bandmatrix_getwidth(MORPHO_GETARG(args, 2), &ku)) {
+        value arg=MORPHO_GETARG(args, 0);
+        if (bandmatrix_getwidth(arg, &n)) {
+            new=object_newbandmatrix(n, kl, ku, true);
+        } else if (MORPHO_ISMATRIX(arg)) {
+            objectmatrix *m=MORPHO_GETMATRIX(arg);
+            if (m->nrows!=m->ncols) MORPHO_RAISE(v, MATRIX_NOTSQ);
+            new=object_bandmatrixfrommatrix(m, kl, ku);
+        } else MORPHO_RAISE(v, BANDMATRIX_CONSTRUCTOR);
+    } else if (nargs==1 && MORPHO_ISBANDMATRIX(MORPHO_GETARG(args, 0))) {
+        new=object_clonebandmatrix(MORPHO_GETBANDMATRIX(MORPHO_GETARG(args, 0)));
+    } else MORPHO_RAISE(v, BANDMATRIX_CONSTRUCTOR);
+
+    if (new) {
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+
+    return out;
+}
+
+/** Binds a newly created object, or raises an allocation error */
+static value bandmatrix_bind(vm *v, object *new) {
+    value out=MORPHO_NIL;
+    if (new) {
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+    return out;
+}
+
+/** Binds the result of an operation, or frees it and raises the error */
+static value bandmatrix_bindresult(vm *v, object *new, objectmatrixerror err) {
+    if (new && err!=MATRIX_OK) {
+        object_free(new);
+        matrix_raiseerror(v, err);
+        return MORPHO_NIL;
+    }
+    return bandmatrix_bind(v, new);
+}
+
+/** Gets the matrix element with given indices */
+value BandMatrix_getindex(vm *v, int nargs, value *args) {
+    objectbandmatrix *m=MORPHO_GETBANDMATRIX(MORPHO_SELF(args));
+    unsigned int indx[2]={0,0};
+
+    if (nargs>2) MORPHO_RAISE(v, MATRIX_INVLDNUMINDICES);
+    if (!array_valuelisttoindices(nargs, args+1, indx)) MORPHO_RAISE(v, MATRIX_INVLDINDICES);
+    if (indx[0]>=m->n || indx[1]>=m->n) MORPHO_RAISE(v, MATRIX_INDICESOUTSIDEBOUNDS);
+
+    return MORPHO_FLOAT(bandmatrix_get(m, indx[0], indx[1]));
+}
+
+/** Sets the matrix element with given indices; elements outside the band may only be set to zero */
+value BandMatrix_setindex(vm *v, int nargs, value *args) {
+    objectbandmatrix *m=MORPHO_GETBANDMATRIX(MORPHO_SELF(args));
+    unsigned int indx[2]={0,0};
+    double val=0.0;
+
+    if (!array_valuelisttoindices(nargs-1, args+1, indx)) MORPHO_RAISE(v, MATRIX_INVLDINDICES);
+    if (indx[0]>=m->n || indx[1]>=m->n) MORPHO_RAISE(v, MATRIX_INDICESOUTSIDEBOUNDS);
+    morpho_valuetofloat(args[nargs], &val);
+
+    if (BANDMATRIX_INBAND(m, indx[0], indx[1])) {
+        m->elements[BANDMATRIX_INDEX(m, indx[0], indx[1])]=val;
+    } else if (val!=0.0) MORPHO_RAISE(v, BANDMATRIX_OUTSIDEBAND);
+
+    return MORPHO_NIL;
+}
+
+/** Prints a band matrix */
+value BandMatrix_print(vm *v, int nargs, value *args) {
+    value self = MORPHO_SELF(args);
+    if (!MORPHO_ISBANDMATRIX(self)) return Object_print(v, nargs, args);
+
+    bandmatrix_print(MORPHO_GETBANDMATRIX(self));
+    return MORPHO_NIL;
+}
+
+/** Adds or subtracts a BandMatrix, Matrix or number; sign is applied to the argument and, if right is set, the result is negated so that arg - self is computed.
+ *  Adding a number fills the matrix, so the result is then a Matrix. */
+static value bandmatrix_addsub(vm *v, int nargs, value *args, double sign, bool right) {
+    objectbandmatrix *a=MORPHO_GETBANDMATRIX(MORPHO_SELF(args));
+    double val;
+
+    if (nargs!=1) MORPHO_RAISE(v, BANDMATRIX_ARITHARGS);
+    value arg=MORPHO_GETARG(args, 0);
+
+    if (MORPHO_ISBANDMATRIX(arg)) {
+        objectbandmatrix *b=MORPHO_GETBANDMATRIX(arg);
+        if (a->n!=b->n) MORPHO_RAISE(v, MATRIX_INCOMPATIBLEMATRICES);
+        objectbandmatrix *new=object_newbandmatrix(a->n, (a->kl>b->kl ? a->kl : b->kl), (a->ku>b->ku ? a->ku : b->ku), true);
+        if (new) {
+            bandmatrix_accumulate(new, 1.0, a);
+            bandmatrix_accumulate(new, sign, b);
+            if (right) bandmatrix_scale(new, -1.0);
+        }
+        return bandmatrix_bind(v, (object *) new);
+    } else if (MORPHO_ISMATRIX(arg)) {
+        objectmatrix *b=MORPHO_GETMATRIX(arg);
+        if (b->nrows!=a->n || b->ncols!=a->n) MORPHO_RAISE(v, MATRIX_INCOMPATIBLEMATRICES);
+        objectmatrix *new=object_matrixfrombandmatrix(a);
+        if (new) matrix_accumulate(new, sign, b);
+        if (new && right) matrix_scale(new, -1.0);
+        return bandmatrix_bind(v, (object *) new);
+    } else if (morpho_valuetofloat(arg, &val)) {
+        objectmatrix *new=object_matrixfrombandmatrix(a);
+        if (new) {
+            if (right) matrix_scale(new, -1.0);
+            for (unsigned int i=0; i<a->n*a->n; i++) new->elements[i]+=(right ? val : sign*val);
+        }
+        return bandmatrix_bind(v, (object *) new);
+    } else MORPHO_RAISE(v, BANDMATRIX_ARITHARGS);
+
+    return MORPHO_NIL;
+}
+
+value BandMatrix_add(vm *v, int nargs, value *args) {
+    return bandmatrix_addsub(v, nargs, args, 1.0, false);
+}
+
+/** Right add; adding nil returns a copy so that matrices can be summed starting from nil */
+value BandMatrix_addr(vm *v, int nargs, value *args) {
+    if (nargs==1 && MORPHO_ISNIL(MORPHO_GETARG(args, 0))) return bandmatrix_bind(v, (object *) object_clonebandmatrix(MORPHO_GETBANDMATRIX(MORPHO_SELF(args))));
+    return bandmatrix_addsub(v, nargs, args, 1.0, false);
+}
+
+value BandMatrix_sub(vm *v, int nargs, value *args) {
+    return bandmatrix_addsub(v, nargs, args, -1.0, false);
+}
+
+value BandMatrix_subr(vm *v, int nargs, value *args) {
+    return bandmatrix_addsub(v, nargs, args, -1.0, true);
+}
+
+/** Multiplies by a BandMatrix, Matrix or number */
+value BandMatrix_mul(vm *v, int nargs, value *args) {
+    objectbandmatrix *a=MORPHO_GETBANDMATRIX(MORPHO_SELF(args));
+    double scale;
+
+    if (nargs!=1) MORPHO_RAISE(v, BANDMATRIX_ARITHARGS);
+    value arg=MORPHO_GETARG(args, 0);
+
+    if (MORPHO_ISBANDMATRIX(arg)) {
+        objectbandmatrix *b=MORPHO_GETBANDMATRIX(arg);
+        if (b->n!=a->n) MORPHO_RAISE(v, MATRIX_INCOMPATIBLEMATRICES);
+        objectbandmatrix *new=object_newbandmatrix(a->n, a->kl+b->kl, a->ku+b->ku, true);
+        return bandmatrix_bindresult(v, (object *) new, (new ? bandmatrix_mul(a, b, new) : MATRIX_OK));
+    } else if (MORPHO_ISMATRIX(arg)) {
+        objectmatrix *b=MORPHO_GETMATRIX(arg);
+        if (b->nrows!=a->n) MORPHO_RAISE(v, MATRIX_INCOMPATIBLEMATRICES);
+        objectmatrix *new=object_newmatrix(a->n, b->ncols, false);
+        return bandmatrix_bindresult(v, (object *) new, (new ? bandmatrix_mulmatrix(a, b, new) : MATRIX_OK));
+    } else if (morpho_valuetofloat(arg, &scale)) {
+        objectbandmatrix *new=object_clonebandmatrix(a);
+        if (new) bandmatrix_scale(new, scale);
+        return bandmatrix_bind(v, (object *) new);
+    } else MORPHO_RAISE(v, BANDMATRIX_ARITHARGS);
+
+    return MORPHO_NIL;
+}
+
+/** Called when multiplying on the right, i.e. by a Matrix or number on the left */
+value BandMatrix_mulr(vm *v, int nargs, value *args) {
+    objectbandmatrix *b=MORPHO_GETBANDMATRIX(MORPHO_SELF(args));
+
+    if (nargs==1 && MORPHO_ISMATRIX(MORPHO_GETARG(args, 0))) {
+        objectmatrix *a=MORPHO_GETMATRIX(MORPHO_GETARG(args, 0));
+        if (a->ncols!=b->n) MORPHO_RAISE(v, MATRIX_INCOMPATIBLEMATRICES);
+        objectmatrix *new=object_newmatrix(a->nrows, b->n, false);
+        return bandmatrix_bindresult(v, (object *) new, (new ? bandmatrix_matrixmul(a, b, new) : MATRIX_OK));
+    } else if (nargs==1 && MORPHO_ISNUMBER(MORPHO_GETARG(args, 0))) {
+        return BandMatrix_mul(v, nargs, args);
+    } else MORPHO_RAISE(v, BANDMATRIX_ARITHARGS);
+
+    return MORPHO_NIL;
+}
+
+/** Divides by a number */
+value BandMatrix_div(vm *v, int nargs, value *args) {
+    double scale;
+
+    if (nargs==1 && morpho_valuetofloat(MORPHO_GETARG(args, 0), &scale)) {
+        if (fabs(scale)<MORPHO_EPS) MORPHO_RAISE(v, VM_DVZR);
+        objectbandmatrix *new=object_clonebandmatrix(MORPHO_GETBANDMATRIX(MORPHO_SELF(args)));
+        if (new) bandmatrix_scale(new, 1.0/scale);
+        return bandmatrix_bind(v, (object *) new);
+    } else MORPHO_RAISE(v, BANDMATRIX_ARITHARGS);
+
+    return MORPHO_NIL;
+}
+
+/** Called for b/a with a Matrix b; solves a.x = b */
+value BandMatrix_divr(vm *v, int nargs, value *args) {
+    objectbandmatrix *a=MORPHO_GETBANDMATRIX(MORPHO_SELF(args));
+
+    if (nargs==1 && MORPHO_ISMATRIX(MORPHO_GETARG(args, 0))) {
+        objectmatrix *b=MORPHO_GETMATRIX(MORPHO_GETARG(args, 0));
+        if (b->nrows!=a->n) MORPHO_RAISE(v, MATRIX_INCOMPATIBLEMATRICES);
+        objectmatrix *new=object_newmatrix(b->nrows, b->ncols, false);
+        return bandmatrix_bindresult(v, (object *) new, (new ? bandmatrix_solve(a, b, new) : MATRIX_OK));
+    } else MORPHO_RAISE(v, BANDMATRIX_ARITHARGS);
+
+    return MORPHO_NIL;
+}
+
+/** Accumulates a multiple of a BandMatrix, whose band must lie within that of self, in place */
+value BandMatrix_acc(vm *v, int nargs, value *args) {
+    objectbandmatrix *a=MORPHO_GETBANDMATRIX(MORPHO_SELF(args));
+    double lambda;
+
+    if (nargs==2 && morpho_valuetofloat(MORPHO_GETARG(args, 0), &lambda) &&
+        MORPHO_ISBANDMATRIX(MORPHO_GETARG(args, 1))) {
+        objectmatrixerror err=bandmatrix_accumulate(a, lambda, MORPHO_GETBANDMATRIX(MORPHO_GETARG(args, 1)));
+        if (err!=MATRIX_OK) matrix_raiseerror(v, err);
+    } else MORPHO_RAISE(v, BANDMATRIX_ARITHARGS);
+
+    return MORPHO_NIL;
+}
+
+/** Frobenius inner product with a BandMatrix */
+value BandMatrix_inner(vm *v, int nargs, value *args) {
+    objectbandmatrix *a=MORPHO_GETBANDMATRIX(MORPHO_SELF(args));
+    double prod=0.0;
+
+    if (nargs==1 && MORPHO_ISBANDMATRIX(MORPHO_GETARG(args, 0))) {
+        objectmatrixerror err=bandmatrix_inner(a, MORPHO_GETBANDMATRIX(MORPHO_GETARG(args, 0)), &prod);
+        if (err!=MATRIX_OK) {
+            matrix_raiseerror(v, err);
+            return MORPHO_NIL;
+        }
+    } else MORPHO_RAISE(v, BANDMATRIX_ARITHARGS);
+
+    return MORPHO_FLOAT(prod);
+}
+
+/** Sum of the elements */
+value BandMatrix_sum(vm *v, int nargs, value *args) {
+    return MORPHO_FLOAT(bandmatrix_sum(MORPHO_GETBANDMATRIX(MORPHO_SELF(args))));
+}
+
+/** Frobenius norm */
+value BandMatrix_norm(vm *v, int nargs, value *args) {
+    return MORPHO_FLOAT(bandmatrix_norm(MORPHO_GETBANDMATRIX(MORPHO_SELF(args))));
+}
+
+/** Trace */
+value BandMatrix_trace(vm *v, int nargs, value *args) {
+    return MORPHO_FLOAT(bandmatrix_trace(MORPHO_GETBANDMATRIX(MORPHO_SELF(args))));
+}
+
+/** Transpose */
+value BandMatrix_transpose(vm *v, int nargs, value *args) {
+    objectbandmatrix *a=MORPHO_GETBANDMATRIX(MORPHO_SELF(args));
+    objectbandmatrix *new=object_newbandmatrix(a->n, a->ku, a->kl, false);
+    if (new) bandmatrix_transpose(a, new);
+    return bandmatrix_bind(v, (object *) new);
+}
+
+/** Converts to a full Matrix */
+value BandMatrix_tomatrix(vm *v, int nargs, value *args) {
+    return bandmatrix_bind(v, (object *) object_matrixfrombandmatrix(MORPHO_GETBANDMATRIX(MORPHO_SELF(args))));
+}
+
+/** Returns the numbers of subdiagonals and superdiagonals as a list */
+value BandMatrix_bandwidths(vm *v, int nargs, value *args) {
+    objectbandmatrix *a=MORPHO_GETBANDMATRIX(MORPHO_SELF(args));
+    value widths[2] = { MORPHO_INTEGER(a->kl), MORPHO_INTEGER(a->ku) };
+    return bandmatrix_bind(v, (object *) object_newlist(2, widths));
+}
+
+/** Enumerate protocol; elements of the full matrix are enumerated in column-major order as for Matrix */
+value BandMatrix_enumerate(vm *v, int nargs, value *args) {
+    objectbandmatrix *a=MORPHO_GETBANDMATRIX(MORPHO_SELF(args));
+    value out=MORPHO_NIL;
+
+    if (nargs==1 && MORPHO_ISINTEGER(MORPHO_GETARG(args, 0))) {
+        int i=MORPHO_GETINTEGERVALUE(MORPHO_GETARG(args, 0));
+
+        if (i<0) out=MORPHO_INTEGER(a->n*a->n);
+        else if (i<a->n*a->n) out=MORPHO_FLOAT(bandmatrix_get(a, i%a->n, i/a->n));
+    }
+
+    return out;
+}
+
+/** Number of matrix elements */
+value BandMatrix_count(vm *v, int nargs, value *args) {
+    objectbandmatrix *a=MORPHO_GETBANDMATRIX(MORPHO_SELF(args));
+    return MORPHO_INTEGER(a->n*a->n);
+}
+
+/** Matrix dimensions */
+value BandMatrix_dimensions(vm *v, int nargs, value *args) {
+    objectbandmatrix *a=MORPHO_GETBANDMATRIX(MORPHO_SELF(args));
+    value dim[2] = { MORPHO_INTEGER(a->n), MORPHO_INTEGER(a->n) };
+    return bandmatrix_bind(v, (object *) object_newlist(2, dim));
+}
+
+/** Clones a band matrix */
+value BandMatrix_clone(vm *v, int nargs, value *args) {
+    return bandmatrix_bind(v, (object *) object_clonebandmatrix(MORPHO_GETBANDMATRIX(MORPHO_SELF(args))));
+}
+
+MORPHO_BEGINCLASS(BandMatrix)
+MORPHO_METHOD(MORPHO_GETINDEX_METHOD, BandMatrix_getindex, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_SETINDEX_METHOD, BandMatrix_setindex, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_PRINT_METHOD, BandMatrix_print, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_ADD_METHOD, BandMatrix_add, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_ADDR_METHOD, BandMatrix_addr, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_SUB_METHOD, BandMatrix_sub, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_SUBR_METHOD, BandMatrix_subr, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_MUL_METHOD, BandMatrix_mul, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_MULR_METHOD, BandMatrix_mulr, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_DIV_METHOD, BandMatrix_div, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_DIVR_METHOD, BandMatrix_divr, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_ACC_METHOD, BandMatrix_acc, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MATRIX_INNER_METHOD, BandMatrix_inner, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_SUM_METHOD, BandMatrix_sum, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MATRIX_NORM_METHOD, BandMatrix_norm, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MATRIX_TRACE_METHOD, BandMatrix_trace, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MATRIX_TRANSPOSE_METHOD, BandMatrix_transpose, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(BANDMATRIX_TOMATRIX_METHOD, BandMatrix_tomatrix, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(BANDMATRIX_BANDWIDTHS_METHOD, BandMatrix_bandwidths, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_ENUMERATE_METHOD, BandMatrix_enumerate, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_COUNT_METHOD, BandMatrix_count, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MATRIX_DIMENSIONS_METHOD, BandMatrix_dimensions, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_CLONE_METHOD, BandMatrix_clone, BUILTIN_FLAGSEMPTY)
+MORPHO_ENDCLASS
+
+/* **********************************************************************
+ * Initialization
+ * ********************************************************************* */
+
+void bandmatrix_initialize(void) {
+    objectbandmatrixtype=object_addtype(&objectbandmatrixdefn);
+
+    builtin_addfunction(BANDMATRIX_CLASSNAME, bandmatrix_constructor, BUILTIN_FLAGSCONSTRUCTOR);
+
+    objectstring objname = MORPHO_STATICSTRING(OBJECT_CLASSNAME);
+    value objclass = builtin_findclass(MORPHO_OBJECT(&objname));
+
+    value bandmatrixclass=builtin_addclass(BANDMATRIX_CLASSNAME, MORPHO_GETCLASSDEFINITION(BandMatrix), objclass);
+    object_setveneerclass(OBJECT_BANDMATRIX, bandmatrixclass);
+
+    morpho_defineerror(BANDMATRIX_CONSTRUCTOR, ERROR_HALT, BANDMATRIX_CONSTRUCTOR_MSG);
+    morpho_defineerror(BANDMATRIX_ARITHARGS, ERROR_HALT, BANDMATRIX_ARITHARGS_MSG);
+    morpho_defineerror(BANDMATRIX_OUTSIDEBAND, ERROR_HALT, BANDMATRIX_OUTSIDEBAND_MSG);
+}
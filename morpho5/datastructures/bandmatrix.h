@@ -0,0 +1,94 @@
+/** @file bandmatrix.h
+ *  @author T J Atherton
+ *
+ *  @brief Veneer class over the objectbandmatrix type, a square matrix whose nonzero elements lie in a band about the diagonal
+ */
+
+#ifndef bandmatrix_h
+#define bandmatrix_h
+
+#include <stdio.h>
+#include "veneer.h"
+#include "matrix.h"
+
+/* -------------------------------------------------------
+ * Band matrix objects
+ * ------------------------------------------------------- */
+
+extern objecttype objectbandmatrixtype;
+#define OBJECT_BANDMATRIX objectbandmatrixtype
+
+/** Band matrices have kl nonzero subdiagonals and ku nonzero superdiagonals. They are stored in the layout used by the
+    dgb-prefixed BLAS and LAPACK routines: each column of the matrix occupies kl+ku+1 consecutive elements, with element
+    (i, j) at position ku+i-j within column j. Positions that fall outside the matrix are kept zero. */
+typedef struct {
+    object obj;
+    unsigned int n;
+    unsigned int kl;
+    unsigned int ku;
+    double *elements;
+    double matrixdata[];
+} objectbandmatrix;
+
+/** Tests whether an object is a band matrix */
+#define MORPHO_ISBANDMATRIX(val) object_istype(val, OBJECT_BANDMATRIX)
+
+/** Gets the object as a band matrix */
+#define MORPHO_GETBANDMATRIX(val)   ((objectbandmatrix *) MORPHO_GETOBJECT(val))
+
+/** Number of elements stored for each column */
+#define BANDMATRIX_LD(m) ((m)->kl+(m)->ku+1)
+
+/** Tests whether element (i, j) lies within the band */
+#define BANDMATRIX_INBAND(m, i, j) ((i)<=(j)+(m)->kl && (j)<=(i)+(m)->ku)
+
+/** Index of element (i, j), which must lie within the band, in the storage of a band matrix */
+#define BANDMATRIX_INDEX(m, i, j) ((m)->ku+(i)-(j)+(j)*BANDMATRIX_LD(m))
+
+/** Creates a band matrix */
+objectbandmatrix *object_newbandmatrix(unsigned int n, unsigned int kl, unsigned int ku, bool zero);
+
+/** Creates a band matrix from the band of a square matrix */
+objectbandmatrix *object_bandmatrixfrommatrix(objectmatrix *m, unsigned int kl, unsigned int ku);
+
+/** Creates a full matrix from a band matrix */
+objectmatrix *object_matrixfrombandmatrix(objectbandmatrix *b);
+
+/* -------------------------------------------------------
+ * BandMatrix class
+ * ------------------------------------------------------- */
+
+#define BANDMATRIX_CLASSNAME "BandMatrix"
+
+#define BANDMATRIX_TOMATRIX_METHOD "tomatrix"
+#define BANDMATRIX_BANDWIDTHS_METHOD "bandwidths"
+
+#define BANDMATRIX_CONSTRUCTOR            "BndMtrxCns"
+#define BANDMATRIX_CONSTRUCTOR_MSG        "BandMatrix() constructor should be called with a dimension or a square Matrix followed by the numbers of subdiagonals and superdiagonals, or with a BandMatrix."
+
+#define BANDMATRIX_ARITHARGS              "BndMtrxArgs"
+#define BANDMATRIX_ARITHARGS_MSG          "BandMatrix arithmetic methods expect a BandMatrix, Matrix or number as their argument."
+
+#define BANDMATRIX_OUTSIDEBAND            "BndMtrxBnd"
+#define BANDMATRIX_OUTSIDEBAND_MSG        "Cannot set a nonzero element outside the band of a BandMatrix."
+
+/* -------------------------------------------------------
+ * BandMatrix interface
+ * ------------------------------------------------------- */
+
+double bandmatrix_get(objectbandmatrix *a, unsigned int i, unsigned int j);
+objectmatrixerror bandmatrix_accumulate(objectbandmatrix *a, double lambda, objectbandmatrix *b);
+objectmatrixerror bandmatrix_scale(objectbandmatrix *a, double scale);
+objectmatrixerror bandmatrix_mul(objectbandmatrix *a, objectbandmatrix *b, objectbandmatrix *out);
+objectmatrixerror bandmatrix_mulmatrix(objectbandmatrix *a, objectmatrix *b, objectmatrix *out);
+objectmatrixerror bandmatrix_matrixmul(objectmatrix *a, objectbandmatrix *b, objectmatrix *out);
+objectmatrixerror bandmatrix_inner(objectbandmatrix *a, objectbandmatrix *b, double *out);
+objectmatrixerror bandmatrix_solve(objectbandmatrix *a, objectmatrix *b, objectmatrix *out);
+objectmatrixerror bandmatrix_transpose(objectbandmatrix *a, objectbandmatrix *out);
+double bandmatrix_sum(objectbandmatrix *a);
+double bandmatrix_norm(objectbandmatrix *a);
+double bandmatrix_trace(objectbandmatrix *a);
+
+void bandmatrix_initialize(void);
+
+#endif /* bandmatrix_h */
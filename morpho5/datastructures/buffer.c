@@ -0,0 +1,646 @@
+/** @file buffer.c
+ *  @author T J Atherton
+ *
+ *  @brief Veneer class over the objectbuffer type, a packed array of doubles or integers
+ */
+
+#include <string.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <math.h>
+#include "object.h"
+#include "buffer.h"
+#include "matrix.h"
+#include "morpho.h"
+#include "builtin.h"
+#include "veneer.h"
+#include "common.h"
+
+/* **********************************************************************
+ * Buffer objects
+ * ********************************************************************** */
+
+objecttype objectbuffertype;
+
+/** Size of a single element in a given format */
+static size_t buffer_elementsize(objectbufferformat format) {
+    return (format==BUFFER_FLOAT ? sizeof(double) : sizeof(int32_t));
+}
+
+/** Function object definitions */
+size_t objectbuffer_sizefn(object *obj) {
+    objectbuffer *b = (objectbuffer *) obj;
+    return sizeof(objectbuffer)+(MORPHO_ISNIL(b->store) ? b->capacity*buffer_elementsize(b->format) : 0);
+}
+
+void objectbuffer_printfn(object *obj) {
+    printf("<Buffer>");
+}
+
+void objectbuffer_markfn(object *obj, void *v) {
+    morpho_markvalue(v, ((objectbuffer *) obj)->store);
+}
+
+void objectbuffer_freefn(object *obj) {
+    objectbuffer *b = (objectbuffer *) obj;
+    if (MORPHO_ISNIL(b->store) && b->data) MORPHO_FREE(b->data);
+}
+
+objecttypedefn objectbufferdefn = {
+    .printfn=objectbuffer_printfn,
+    .markfn=objectbuffer_markfn,
+    .freefn=objectbuffer_freefn,
+    .sizefn=objectbuffer_sizefn
+};
+
+/** Creates a buffer object */
+objectbuffer *object_newbuffer(objectbufferformat format, unsigned int count, bool zero) {
+    objectbuffer *new = (objectbuffer *) object_new(sizeof(objectbuffer), OBJECT_BUFFER);
+
+    if (new) {
+        new->format=format;
+        new->count=count;
+        new->capacity=count;
+        new->store=MORPHO_NIL;
+        new->data=NULL;
+
+        if (count) {
+            new->data=MORPHO_MALLOC(count*buffer_elementsize(format));
+            if (!new->data) {
+                object_free((object *) new);
+                return NULL;
+            }
+            if (zero) memset(new->data, 0, count*buffer_elementsize(format));
+        }
+    }
+
+    return new;
+}
+
+/** Creates a float buffer that views the elements of a matrix */
+static objectbuffer *object_bufferfrommatrix(objectmatrix *m) {
+    objectbuffer *new = object_newbuffer(BUFFER_FLOAT, 0, false);
+
+    if (new) {
+        new->count=new->capacity=m->nrows*m->ncols;
+        new->store=MORPHO_OBJECT(m);
+        new->data=m->elements;
+    }
+
+    return new;
+}
+
+/** Creates a new buffer from an existing buffer, converting to a given format */
+objectbuffer *object_clonebuffer(objectbuffer *b, objectbufferformat format) {
+    objectbuffer *new = object_newbuffer(format, b->count, false);
+
+    if (new) {
+        if (format==b->format) {
+            memcpy(new->data, b->data, b->count*buffer_elementsize(format));
+        } else if (format==BUFFER_FLOAT) {
+            for (unsigned int i=0; i<b->count; i++) BUFFER_FLOATS(new)[i]=(double) BUFFER_INTS(b)[i];
+        } else {
+            for (unsigned int i=0; i<b->count; i++) BUFFER_INTS(new)[i]=(int32_t) BUFFER_FLOATS(b)[i];
+        }
+    }
+
+    return new;
+}
+
+/* **********************************************************************
+ * Buffer operations
+ * ********************************************************************* */
+
+/** Ensures a buffer owns storage for at least n elements, copying any viewed data */
+static bool buffer_reserve(objectbuffer *b, unsigned int n) {
+    size_t size = buffer_elementsize(b->format);
+
+    if (!MORPHO_ISNIL(b->store)) {
+        unsigned int capacity = (n>b->count ? n : b->count);
+        void *new = MORPHO_MALLOC(capacity*size);
+        if (!new) return false;
+        if (b->count) memcpy(new, b->data, b->count*size);
+        b->data=new;
+        b->capacity=capacity;
+        b->store=MORPHO_NIL;
+    } else if (n>b->capacity) {
+        unsigned int capacity = (b->capacity<8 ? 8 : b->capacity);
+        while (capacity<n) capacity*=2;
+        void *new = MORPHO_REALLOC(b->data, capacity*size);
+        if (!new) return false;
+        b->data=new;
+        b->capacity=capacity;
+    }
+
+    return true;
+}
+
+/** Checks whether a float can be held exactly by an integer buffer */
+static inline bool buffer_isint32(double x) {
+    return (x>=INT32_MIN && x<=INT32_MAX && x==trunc(x));
+}
+
+/** Checks whether every element of an array of floats can be held exactly by an integer buffer */
+static bool buffer_areint32(unsigned int n, double *x) {
+    for (unsigned int i=0; i<n; i++) if (!buffer_isint32(x[i])) return false;
+    return true;
+}
+
+/** Stores a value in a given element of a buffer; returns false if the value is not a number,
+    or, for an integer buffer, not a whole number in range, which would otherwise be silently truncated */
+static inline bool buffer_store(objectbuffer *b, unsigned int i, value val) {
+    if (b->format==BUFFER_FLOAT) return morpho_valuetofloat(val, BUFFER_FLOATS(b)+i);
+
+    if (MORPHO_ISINTEGER(val)) {
+        BUFFER_INTS(b)[i]=(int32_t) MORPHO_GETINTEGERVALUE(val);
+    } else if (MORPHO_ISFLOAT(val) && buffer_isint32(MORPHO_GETFLOATVALUE(val))) {
+        BUFFER_INTS(b)[i]=(int32_t) MORPHO_GETFLOATVALUE(val);
+    } else return false;
+    return true;
+}
+
+/** Boxes a given element of a buffer */
+static inline value buffer_load(objectbuffer *b, unsigned int i) {
+    if (b->format==BUFFER_FLOAT) return MORPHO_FLOAT(BUFFER_FLOATS(b)[i]);
+    return MORPHO_INTEGER(BUFFER_INTS(b)[i]);
+}
+
+/** Appends a value to a buffer */
+bool buffer_append(objectbuffer *b, value val) {
+    if (!MORPHO_ISNUMBER(val) || !buffer_reserve(b, b->count+1) ||
+        !buffer_store(b, b->count, val)) return false;
+    b->count++;
+    return true;
+}
+
+/** Converts an index, which may be negative to count from the end, into an offset */
+static inline bool buffer_index(objectbuffer *b, int i, unsigned int *out) {
+    if (i<0) i+=b->count;
+    if (i<0 || i>=(int) b->count) return false;
+    *out = (unsigned int) i;
+    return true;
+}
+
+/** Gets an element from a buffer */
+bool buffer_getelement(objectbuffer *b, int i, value *out) {
+    unsigned int k;
+    if (!buffer_index(b, i, &k)) return false;
+    *out = buffer_load(b, k);
+    return true;
+}
+
+/** Sets an element of a buffer */
+bool buffer_setelement(objectbuffer *b, int i, value val) {
+    unsigned int k;
+    if (!buffer_index(b, i, &k)) return false;
+    return buffer_store(b, k, val);
+}
+
+/** Sums the elements of a buffer, using several independent accumulators so the loop vectorizes */
+double buffer_sum(objectbuffer *b) {
+    unsigned int n=b->count, i=0;
+
+    if (b->format==BUFFER_FLOAT) {
+        double *x = BUFFER_FLOATS(b);
+        double s0=0.0, s1=0.0, s2=0.0, s3=0.0;
+        for (; i+4<=n; i+=4) { s0+=x[i]; s1+=x[i+1]; s2+=x[i+2]; s3+=x[i+3]; }
+        for (; i<n; i++) s0+=x[i];
+        return (s0+s1)+(s2+s3);
+    }
+
+    int32_t *x = BUFFER_INTS(b);
+    int64_t s=0;
+    for (; i<n; i++) s+=x[i];
+    return (double) s;
+}
+
+/** Computes the minimum (if max is false) or maximum of a nonempty buffer */
+static double buffer_extremum(objectbuffer *b, bool max) {
+    unsigned int n=b->count;
+
+    if (b->format==BUFFER_FLOAT) {
+        double *x = BUFFER_FLOATS(b), m=x[0];
+        if (max) { for (unsigned int i=1; i<n; i++) m = (x[i]>m ? x[i] : m); }
+        else { for (unsigned int i=1; i<n; i++) m = (x[i]<m ? x[i] : m); }
+        return m;
+    }
+
+    int32_t *x = BUFFER_INTS(b), m=x[0];
+    if (max) { for (unsigned int i=1; i<n; i++) m = (x[i]>m ? x[i] : m); }
+    else { for (unsigned int i=1; i<n; i++) m = (x[i]<m ? x[i] : m); }
+    return (double) m;
+}
+
+/** Computes the inner product of two buffers of equal length */
+double buffer_dot(objectbuffer *a, objectbuffer *b) {
+    unsigned int n=a->count;
+
+    if (a->format==BUFFER_FLOAT && b->format==BUFFER_FLOAT) {
+        return cblas_ddot(n, BUFFER_FLOATS(a), 1, BUFFER_FLOATS(b), 1);
+    } else if (a->format==BUFFER_INT && b->format==BUFFER_INT) {
+        int32_t *x = BUFFER_INTS(a), *y = BUFFER_INTS(b);
+        int64_t s=0;
+        for (unsigned int i=0; i<n; i++) s+=(int64_t) x[i]*y[i];
+        return (double) s;
+    }
+
+    objectbuffer *f = (a->format==BUFFER_FLOAT ? a : b), *k = (a->format==BUFFER_FLOAT ? b : a);
+    double *x = BUFFER_FLOATS(f), s=0.0;
+    int32_t *y = BUFFER_INTS(k);
+    for (unsigned int i=0; i<n; i++) s+=x[i]*y[i];
+    return s;
+}
+
+/** Sort functions for buffer_sort */
+static int buffer_sortfloat(const void *a, const void *b) {
+    double x=*(const double *) a, y=*(const double *) b;
+    return (x>y) - (x<y);
+}
+
+static int buffer_sortint(const void *a, const void *b) {
+    int32_t x=*(const int32_t *) a, y=*(const int32_t *) b;
+    return (x>y) - (x<y);
+}
+
+/** Sorts a buffer in place into ascending order */
+void buffer_sort(objectbuffer *b) {
+    qsort(b->data, b->count, buffer_elementsize(b->format), (b->format==BUFFER_FLOAT ? buffer_sortfloat : buffer_sortint));
+}
+
+/** Finds the number of elements of a sorted buffer that are less than x, i.e. the index at which x would be inserted */
+unsigned int buffer_searchsorted(objectbuffer *b, double x) {
+    unsigned int lo=0, hi=b->count;
+
+    while (lo<hi) {
+        unsigned int mid = lo + (hi-lo)/2;
+        double y = (b->format==BUFFER_FLOAT ? BUFFER_FLOATS(b)[mid] : (double) BUFFER_INTS(b)[mid]);
+        if (y<x) lo=mid+1; else hi=mid;
+    }
+
+    return lo;
+}
+
+/* **********************************************************************
+ * Buffer veneer class
+ * ********************************************************************* */
+
+/** Converts a sum or product of integers back to a value, promoting to float if it overflows */
+static value buffer_integerresult(double x) {
+    if (x>=INT32_MIN && x<=INT32_MAX) return MORPHO_INTEGER((int) x);
+    return MORPHO_FLOAT(x);
+}
+
+/** Appends a value to a buffer, telling the VM if its storage grows */
+static bool buffer_appendwithvm(vm *v, objectbuffer *b, value val) {
+    size_t size = objectbuffer_sizefn((object *) b);
+    bool success = buffer_append(b, val);
+    size_t newsize = objectbuffer_sizefn((object *) b);
+    if (newsize!=size) morpho_resizeobject(v, (object *) b, size, newsize);
+    return success;
+}
+
+/** Appends each item of an enumerable to a buffer */
+static bool buffer_enumerableinitializer(vm *v, indx i, value val, void *ref) {
+    if (!buffer_appendwithvm(v, (objectbuffer *) ref, val)) {
+        morpho_runtimeerror(v, BUFFER_NONNUM);
+        return false;
+    }
+    return true;
+}
+
+/** Creates a buffer of a given format from constructor arguments */
+static value buffer_construct(vm *v, objectbufferformat format, int nargs, value *args) {
+    value out=MORPHO_NIL;
+    value init = (nargs==1 ? MORPHO_GETARG(args, 0) : MORPHO_NIL);
+    objectbuffer *new=NULL;
+
+    if (nargs==0) {
+        new=object_newbuffer(format, 0, false);
+    } else if (nargs==1 && MORPHO_ISINTEGER(init) && MORPHO_GETINTEGERVALUE(init)>=0) {
+        new=object_newbuffer(format, MORPHO_GETINTEGERVALUE(init), true);
+    } else if (nargs==1 && MORPHO_ISMATRIX(init) && format==BUFFER_FLOAT) {
+        new=object_bufferfrommatrix(MORPHO_GETMATRIX(init)); /* No copy is made */
+    } else if (nargs==1 && MORPHO_ISMATRIX(init)) {
+        objectmatrix *m = MORPHO_GETMATRIX(init);
+        objectbuffer view = { .format=BUFFER_FLOAT, .count=m->nrows*m->ncols, .store=init, .data=m->elements };
+        if (!buffer_areint32(view.count, m->elements)) MORPHO_RAISE(v, BUFFER_NONNUM);
+        new=object_clonebuffer(&view, format);
+    } else if (nargs==1 && MORPHO_ISBUFFER(init)) {
+        objectbuffer *b = MORPHO_GETBUFFER(init);
+        if (format==BUFFER_INT && b->format==BUFFER_FLOAT && !buffer_areint32(b->count, BUFFER_FLOATS(b))) MORPHO_RAISE(v, BUFFER_NONNUM);
+        new=object_clonebuffer(b, format);
+    } else if (nargs==1 && MORPHO_ISLIST(init)) {
+        objectlist *lst = MORPHO_GETLIST(init);
+        new=object_newbuffer(format, lst->val.count, false);
+        if (new) for (unsigned int i=0; i<lst->val.count; i++) {
+            if (!buffer_store(new, i, lst->val.data[i])) {
+                object_free((object *) new);
+                MORPHO_RAISE(v, BUFFER_NONNUM);
+            }
+        }
+    } else if (nargs==1 && (MORPHO_ISRANGE(init) || MORPHO_ISARRAY(init))) {
+        new=object_newbuffer(format, 0, false);
+        if (new) {
+            out=MORPHO_OBJECT(new);
+            morpho_bindobjects(v, 1, &out);
+            builtin_enumerateloop(v, init, buffer_enumerableinitializer, new);
+            return out;
+        }
+    } else MORPHO_RAISE(v, BUFFER_CONSTRUCTOR);
+
+    if (new) {
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+
+    return out;
+}
+
+/** Constructs a buffer of doubles */
+value buffer_floatconstructor(vm *v, int nargs, value *args) {
+    return buffer_construct(v, BUFFER_FLOAT, nargs, args);
+}
+
+/** Constructs a buffer of integers */
+value buffer_intconstructor(vm *v, int nargs, value *args) {
+    return buffer_construct(v, BUFFER_INT, nargs, args);
+}
+
+/** Gets a buffer element */
+value Buffer_getindex(vm *v, int nargs, value *args) {
+    objectbuffer *slf = MORPHO_GETBUFFER(MORPHO_SELF(args));
+    value out=MORPHO_NIL;
+
+    if (nargs==1 && MORPHO_ISINTEGER(MORPHO_GETARG(args, 0))) {
+        if (!buffer_getelement(slf, MORPHO_GETINTEGERVALUE(MORPHO_GETARG(args, 0)), &out)) {
+            morpho_runtimeerror(v, VM_OUTOFBOUNDS);
+        }
+    } else morpho_runtimeerror(v, VM_NONNUMINDX);
+
+    return out;
+}
+
+/** Sets a buffer element */
+value Buffer_setindex(vm *v, int nargs, value *args) {
+    objectbuffer *slf = MORPHO_GETBUFFER(MORPHO_SELF(args));
+
+    if (nargs==2 && MORPHO_ISINTEGER(MORPHO_GETARG(args, 0))) {
+        unsigned int k;
+        if (!buffer_index(slf, MORPHO_GETINTEGERVALUE(MORPHO_GETARG(args, 0)), &k)) {
+            morpho_runtimeerror(v, VM_OUTOFBOUNDS);
+        } else if (!buffer_store(slf, k, MORPHO_GETARG(args, 1))) {
+            morpho_runtimeerror(v, BUFFER_NONNUM);
+        }
+    } else morpho_runtimeerror(v, SETINDEX_ARGS);
+
+    return MORPHO_NIL;
+}
+
+/** Appends numbers to a buffer */
+value Buffer_append(vm *v, int nargs, value *args) {
+    objectbuffer *slf = MORPHO_GETBUFFER(MORPHO_SELF(args));
+
+    for (unsigned int i=0; i<nargs; i++) {
+        if (!buffer_appendwithvm(v, slf, MORPHO_GETARG(args, i))) MORPHO_RAISE(v, BUFFER_NONNUM);
+    }
+
+    return MORPHO_SELF(args);
+}
+
+/** Prints a buffer */
+value Buffer_print(vm *v, int nargs, value *args) {
+    value self = MORPHO_SELF(args);
+    if (!MORPHO_ISBUFFER(self)) return Object_print(v, nargs, args);
+
+    objectbuffer *b=MORPHO_GETBUFFER(self);
+
+    printf("[ ");
+    for (unsigned int i=0; i<b->count; i++) {
+        morpho_printvalue(buffer_load(b, i));
+        if (i<b->count-1) printf(", ");
+    }
+    printf(" ]");
+
+    return MORPHO_NIL;
+}
+
+/** Number of elements */
+value Buffer_count(vm *v, int nargs, value *args) {
+    return MORPHO_INTEGER(MORPHO_GETBUFFER(MORPHO_SELF(args))->count);
+}
+
+/** Enumerate protocol */
+value Buffer_enumerate(vm *v, int nargs, value *args) {
+    objectbuffer *slf = MORPHO_GETBUFFER(MORPHO_SELF(args));
+    value out=MORPHO_NIL;
+
+    if (nargs==1 && MORPHO_ISINTEGER(MORPHO_GETARG(args, 0))) {
+        int i=MORPHO_GETINTEGERVALUE(MORPHO_GETARG(args, 0));
+
+        if (i<0) out=MORPHO_INTEGER(slf->count);
+        else if (i<slf->count) out=buffer_load(slf, i);
+        else morpho_runtimeerror(v, VM_OUTOFBOUNDS);
+    } else MORPHO_RAISE(v, ENUMERATE_ARGS);
+
+    return out;
+}
+
+/** Clones a buffer; the clone always owns its data */
+value Buffer_clone(vm *v, int nargs, value *args) {
+    objectbuffer *slf = MORPHO_GETBUFFER(MORPHO_SELF(args));
+    value out=MORPHO_NIL;
+    objectbuffer *new=object_clonebuffer(slf, slf->format);
+    if (new) {
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+    return out;
+}
+
+/** Sum of elements */
+value Buffer_sum(vm *v, int nargs, value *args) {
+    objectbuffer *slf = MORPHO_GETBUFFER(MORPHO_SELF(args));
+    double s = buffer_sum(slf);
+    return (slf->format==BUFFER_FLOAT ? MORPHO_FLOAT(s) : buffer_integerresult(s));
+}
+
+/** Minimum and maximum elements */
+static value buffer_extremumvalue(vm *v, value self, bool max) {
+    objectbuffer *slf = MORPHO_GETBUFFER(self);
+    if (!slf->count) MORPHO_RAISE(v, BUFFER_EMPTY);
+    double m = buffer_extremum(slf, max);
+    return (slf->format==BUFFER_FLOAT ? MORPHO_FLOAT(m) : MORPHO_INTEGER((int) m));
+}
+
+value Buffer_min(vm *v, int nargs, value *args) {
+    return buffer_extremumvalue(v, MORPHO_SELF(args), false);
+}
+
+value Buffer_max(vm *v, int nargs, value *args) {
+    return buffer_extremumvalue(v, MORPHO_SELF(args), true);
+}
+
+/** Inner product with another buffer */
+value Buffer_dot(vm *v, int nargs, value *args) {
+    objectbuffer *slf = MORPHO_GETBUFFER(MORPHO_SELF(args));
+
+    if (nargs==1 && MORPHO_ISBUFFER(MORPHO_GETARG(args, 0))) {
+        objectbuffer *b = MORPHO_GETBUFFER(MORPHO_GETARG(args, 0));
+        if (b->count!=slf->count) MORPHO_RAISE(v, BUFFER_INCOMPATIBLE);
+
+        double s = buffer_dot(slf, b);
+        if (slf->format==BUFFER_INT && b->format==BUFFER_INT) return buffer_integerresult(s);
+        return MORPHO_FLOAT(s);
+    } else MORPHO_RAISE(v, BUFFER_INVLDARGS);
+}
+
+/** Multiplies every element by a scalar in place */
+value Buffer_scale(vm *v, int nargs, value *args) {
+    objectbuffer *slf = MORPHO_GETBUFFER(MORPHO_SELF(args));
+    value a = (nargs==1 ? MORPHO_GETARG(args, 0) : MORPHO_NIL);
+    double lambda;
+
+    if (slf->format==BUFFER_FLOAT && morpho_valuetofloat(a, &lambda)) {
+        cblas_dscal(slf->count, lambda, BUFFER_FLOATS(slf), 1);
+    } else if (slf->format==BUFFER_INT && MORPHO_ISINTEGER(a)) {
+        int64_t k = MORPHO_GETINTEGERVALUE(a);
+        int32_t *x = BUFFER_INTS(slf);
+        for (unsigned int i=0; i<slf->count; i++) { // Check every product first so that the buffer is unchanged on overflow
+            int64_t y=k*x[i];
+            if (y<INT32_MIN || y>INT32_MAX) MORPHO_RAISE(v, BUFFER_OVERFLOW);
+        }
+        for (unsigned int i=0; i<slf->count; i++) x[i]=(int32_t) (k*x[i]);
+    } else MORPHO_RAISE(v, BUFFER_INVLDARGS);
+
+    return MORPHO_SELF(args);
+}
+
+/** Accumulates a multiple of another buffer, i.e. self = self + a*x, in place */
+value Buffer_axpy(vm *v, int nargs, value *args) {
+    objectbuffer *slf = MORPHO_GETBUFFER(MORPHO_SELF(args));
+
+    if (nargs!=2 || !MORPHO_ISNUMBER(MORPHO_GETARG(args, 0)) || !MORPHO_ISBUFFER(MORPHO_GETARG(args, 1))) MORPHO_RAISE(v, BUFFER_INVLDARGS);
+
+    value a = MORPHO_GETARG(args, 0);
+    objectbuffer *x = MORPHO_GETBUFFER(MORPHO_GETARG(args, 1));
+    if (x->count!=slf->count) MORPHO_RAISE(v, BUFFER_INCOMPATIBLE);
+
+    if (slf->format==BUFFER_FLOAT) {
+        double lambda;
+        if (!morpho_valuetofloat(a, &lambda)) MORPHO_RAISE(v, BUFFER_INVLDARGS);
+        if (x->format==BUFFER_FLOAT) {
+            cblas_daxpy(slf->count, lambda, BUFFER_FLOATS(x), 1, BUFFER_FLOATS(slf), 1);
+        } else {
+            double *y = BUFFER_FLOATS(slf);
+            int32_t *xx = BUFFER_INTS(x);
+            for (unsigned int i=0; i<slf->count; i++) y[i]+=lambda*xx[i];
+        }
+    } else if (x->format==BUFFER_INT && MORPHO_ISINTEGER(a)) {
+        int64_t lambda = MORPHO_GETINTEGERVALUE(a);
+        int32_t *y = BUFFER_INTS(slf), *xx = BUFFER_INTS(x);
+        for (unsigned int i=0; i<slf->count; i++) { // As for scale, check before changing any element
+            int64_t z=y[i]+lambda*xx[i];
+            if (z<INT32_MIN || z>INT32_MAX) MORPHO_RAISE(v, BUFFER_OVERFLOW);
+        }
+        for (unsigned int i=0; i<slf->count; i++) y[i]=(int32_t) (y[i]+lambda*xx[i]);
+    } else MORPHO_RAISE(v, BUFFER_INVLDARGS);
+
+    return MORPHO_SELF(args);
+}
+
+/** Sorts the buffer in place */
+value Buffer_sort(vm *v, int nargs, value *args) {
+    buffer_sort(MORPHO_GETBUFFER(MORPHO_SELF(args)));
+    return MORPHO_SELF(args);
+}
+
+/** Finds where a value would be inserted into a sorted buffer */
+value Buffer_searchsorted(vm *v, int nargs, value *args) {
+    double x;
+
+    if (nargs==1 && morpho_valuetofloat(MORPHO_GETARG(args, 0), &x)) {
+        return MORPHO_INTEGER(buffer_searchsorted(MORPHO_GETBUFFER(MORPHO_SELF(args)), x));
+    } else MORPHO_RAISE(v, BUFFER_INVLDARGS);
+}
+
+/** Converts a buffer to a List */
+value Buffer_tolist(vm *v, int nargs, value *args) {
+    objectbuffer *slf = MORPHO_GETBUFFER(MORPHO_SELF(args));
+    value out=MORPHO_NIL;
+    objectlist *new = object_newlist(0, NULL);
+
+    if (new && varray_valueresize(&new->val, slf->count)) {
+        for (unsigned int i=0; i<slf->count; i++) new->val.data[i]=buffer_load(slf, i);
+        new->val.count=slf->count;
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else {
+        if (new) object_free((object *) new);
+        morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+    }
+
+    return out;
+}
+
+/** Converts a buffer to a column Matrix; a buffer that views a whole Matrix returns it without copying */
+value Buffer_tomatrix(vm *v, int nargs, value *args) {
+    objectbuffer *slf = MORPHO_GETBUFFER(MORPHO_SELF(args));
+    value out=MORPHO_NIL;
+
+    if (MORPHO_ISMATRIX(slf->store)) return slf->store;
+
+    objectmatrix *new = object_newmatrix(slf->count, 1, false);
+    if (new) {
+        for (unsigned int i=0; i<slf->count; i++) {
+            new->elements[i] = (slf->format==BUFFER_FLOAT ? BUFFER_FLOATS(slf)[i] : (double) BUFFER_INTS(slf)[i]);
+        }
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+
+    return out;
+}
+
+MORPHO_BEGINCLASS(Buffer)
+MORPHO_METHOD(MORPHO_GETINDEX_METHOD, Buffer_getindex, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_SETINDEX_METHOD, Buffer_setindex, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_APPEND_METHOD, Buffer_append, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_PRINT_METHOD, Buffer_print, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_COUNT_METHOD, Buffer_count, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_ENUMERATE_METHOD, Buffer_enumerate, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_CLONE_METHOD, Buffer_clone, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_SUM_METHOD, Buffer_sum, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(BUFFER_MIN_METHOD, Buffer_min, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(BUFFER_MAX_METHOD, Buffer_max, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(BUFFER_DOT_METHOD, Buffer_dot, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(BUFFER_SCALE_METHOD, Buffer_scale, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(BUFFER_AXPY_METHOD, Buffer_axpy, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(BUFFER_SORT_METHOD, Buffer_sort, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(BUFFER_SEARCHSORTED_METHOD, Buffer_searchsorted, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(BUFFER_TOLIST_METHOD, Buffer_tolist, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(BUFFER_TOMATRIX_METHOD, Buffer_tomatrix, BUILTIN_FLAGSEMPTY)
+MORPHO_ENDCLASS
+
+/* **********************************************************************
+ * Initialization
+ * ********************************************************************* */
+
+void buffer_initialize(void) {
+    objectbuffertype=object_addtype(&objectbufferdefn);
+
+    builtin_addfunction(BUFFER_FLOATCONSTRUCTOR, buffer_floatconstructor, BUILTIN_FLAGSCONSTRUCTOR);
+    builtin_addfunction(BUFFER_INTCONSTRUCTOR, buffer_intconstructor, BUILTIN_FLAGSCONSTRUCTOR);
+
+    objectstring objname = MORPHO_STATICSTRING(OBJECT_CLASSNAME);
+    value objclass = builtin_findclass(MORPHO_OBJECT(&objname));
+
+    value bufferclass=builtin_addclass(BUFFER_CLASSNAME, MORPHO_GETCLASSDEFINITION(Buffer), objclass);
+    object_setveneerclass(OBJECT_BUFFER, bufferclass);
+
+    morpho_defineerror(BUFFER_CONSTRUCTOR, ERROR_HALT, BUFFER_CONSTRUCTOR_MSG);
+    morpho_defineerror(BUFFER_NONNUM, ERROR_HALT, BUFFER_NONNUM_MSG);
+    morpho_defineerror(BUFFER_INVLDARGS, ERROR_HALT, BUFFER_INVLDARGS_MSG);
+    morpho_defineerror(BUFFER_INCOMPATIBLE, ERROR_HALT, BUFFER_INCOMPATIBLE_MSG);
+    morpho_defineerror(BUFFER_OVERFLOW, ERROR_HALT, BUFFER_OVERFLOW_MSG);
+    morpho_defineerror(BUFFER_EMPTY, ERROR_HALT, BUFFER_EMPTY_MSG);
+}
@@ -0,0 +1,104 @@
+/** @file buffer.h
+ *  @author T J Atherton
+ *
+ *  @brief Veneer class over the objectbuffer type, a packed array of doubles or integers
+ */
+
+#ifndef buffer_h
+#define buffer_h
+
+#include <stdio.h>
+#include <stdint.h>
+#include "veneer.h"
+
+/* -------------------------------------------------------
+ * Buffer objects
+ * ------------------------------------------------------- */
+
+extern objecttype objectbuffertype;
+#define OBJECT_BUFFER objectbuffertype
+
+/** Element formats a buffer may hold */
+typedef enum { BUFFER_FLOAT, BUFFER_INT } objectbufferformat;
+
+/** Buffers hold numbers unboxed in contiguous storage, either double or int32_t.
+    A float buffer may view the elements of a Matrix rather than own its data; in that case
+    store refers to the Matrix, which is kept alive by the buffer, and any change to either is visible
+    in both. Operations that need to grow the buffer first copy the data so that the buffer owns it. */
+typedef struct {
+    object obj;
+    objectbufferformat format;
+    unsigned int count;
+    unsigned int capacity;
+    value store; /** Object whose storage is viewed, or nil if data is owned by the buffer */
+    void *data;
+} objectbuffer;
+
+/** Tests whether an object is a buffer */
+#define MORPHO_ISBUFFER(val) object_istype(val, OBJECT_BUFFER)
+
+/** Gets the object as a buffer */
+#define MORPHO_GETBUFFER(val)   ((objectbuffer *) MORPHO_GETOBJECT(val))
+
+/** Access the elements of a buffer in the appropriate format */
+#define BUFFER_FLOATS(b) ((double *) (b)->data)
+#define BUFFER_INTS(b) ((int32_t *) (b)->data)
+
+/** Creates a buffer object */
+objectbuffer *object_newbuffer(objectbufferformat format, unsigned int count, bool zero);
+
+/** Creates a new buffer from an existing buffer, converting to a given format */
+objectbuffer *object_clonebuffer(objectbuffer *b, objectbufferformat format);
+
+/* -------------------------------------------------------
+ * Buffer class
+ * ------------------------------------------------------- */
+
+#define BUFFER_CLASSNAME "Buffer"
+#define BUFFER_FLOATCONSTRUCTOR "FloatBuffer"
+#define BUFFER_INTCONSTRUCTOR "IntBuffer"
+
+#define BUFFER_MIN_METHOD "min"
+#define BUFFER_MAX_METHOD "max"
+#define BUFFER_DOT_METHOD "dot"
+#define BUFFER_SCALE_METHOD "scale"
+#define BUFFER_AXPY_METHOD "axpy"
+#define BUFFER_SORT_METHOD "sort"
+#define BUFFER_SEARCHSORTED_METHOD "searchsorted"
+#define BUFFER_TOLIST_METHOD "tolist"
+#define BUFFER_TOMATRIX_METHOD "tomatrix"
+
+#define BUFFER_CONSTRUCTOR                "BffrCns"
+#define BUFFER_CONSTRUCTOR_MSG            "Buffer constructors should be called with a length or a List, Range, Matrix or Buffer initializer."
+
+#define BUFFER_NONNUM                     "BffrNnNm"
+#define BUFFER_NONNUM_MSG                 "Buffers can only hold numbers, and integer buffers only whole numbers in the range of a 32 bit integer."
+
+#define BUFFER_INVLDARGS                  "BffrInvldArg"
+#define BUFFER_INVLDARGS_MSG              "Buffer method called with invalid arguments; integer buffers can only be combined with integers."
+
+#define BUFFER_INCOMPATIBLE               "BffrIncmptbl"
+#define BUFFER_INCOMPATIBLE_MSG           "Buffers have incompatible lengths."
+
+#define BUFFER_OVERFLOW                   "BffrOvrflw"
+#define BUFFER_OVERFLOW_MSG               "Result is too large for an integer buffer; use a FloatBuffer instead."
+
+#define BUFFER_EMPTY                      "BffrEmpty"
+#define BUFFER_EMPTY_MSG                  "Buffer is empty."
+
+/* -------------------------------------------------------
+ * Buffer interface
+ * ------------------------------------------------------- */
+
+bool buffer_append(objectbuffer *b, value val);
+bool buffer_getelement(objectbuffer *b, int i, value *out);
+bool buffer_setelement(objectbuffer *b, int i, value val);
+
+double buffer_sum(objectbuffer *b);
+double buffer_dot(objectbuffer *a, objectbuffer *b);
+void buffer_sort(objectbuffer *b);
+unsigned int buffer_searchsorted(objectbuffer *b, double x);
+
+void buffer_initialize(void);
+
+#endif /* buffer_h */
@@ -7,6 +7,7 @@
 #include <string.h>
 #include "object.h"
 #include "cmplx.h"
+#include "complexmatrix.h"
 #include "morpho.h"
 #include "builtin.h"
 #include "veneer.h"
@@ -483,6 +484,8 @@ value Complex_mul(vm *v, int nargs, value *args) {
                 complex_mul_real(a, val, new);
             }
         }
+    } else if (nargs==1 && MORPHO_ISCOMPLEXMATRIX(MORPHO_GETARG(args, 0))) {
+        // Returns nil to ensure it gets passed to mulr on ComplexMatrix
     } else morpho_runtimeerror(v, COMPLEX_ARITHARGS);
     
     if (!MORPHO_ISNIL(out)) morpho_bindobjects(v, 1, &out);
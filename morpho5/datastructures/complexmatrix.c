@@ -0,0 +1,797 @@
+/** @file complexmatrix.c
+ *  @author T J Atherton
+ *
+ *  @brief Veneer class over the objectcomplexmatrix type, a dense matrix of complex numbers
+ */
+
+#include <string.h>
+#include "object.h"
+#include "matrix.h"
+#include "complexmatrix.h"
+#include "sparse.h"
+#include "morpho.h"
+#include "builtin.h"
+#include "veneer.h"
+#include "common.h"
+
+/* **********************************************************************
+ * Complex matrix objects
+ * ********************************************************************** */
+
+objecttype objectcomplexmatrixtype;
+
+/** Function object definitions */
+size_t objectcomplexmatrix_sizefn(object *obj) {
+    return sizeof(objectcomplexmatrix)+sizeof(double complex) *
+            ((objectcomplexmatrix *) obj)->ncols *
+            ((objectcomplexmatrix *) obj)->nrows;
+}
+
+void objectcomplexmatrix_printfn(object *obj) {
+    printf("<ComplexMatrix>");
+}
+
+objecttypedefn objectcomplexmatrixdefn = {
+    .printfn=objectcomplexmatrix_printfn,
+    .markfn=NULL,
+    .freefn=NULL,
+    .sizefn=objectcomplexmatrix_sizefn
+};
+
+/** Creates a complex matrix */
+objectcomplexmatrix *object_newcomplexmatrix(unsigned int nrows, unsigned int ncols, bool zero) {
+    unsigned int nel = nrows*ncols;
+    objectcomplexmatrix *new = (objectcomplexmatrix *) object_new(sizeof(objectcomplexmatrix)+nel*sizeof(double complex), OBJECT_COMPLEXMATRIX);
+
+    if (new) {
+        new->ncols=ncols;
+        new->nrows=nrows;
+        new->elements=new->matrixdata;
+        if (zero) memset(new->elements, 0, sizeof(double complex)*nel);
+    }
+
+    return new;
+}
+
+/** Creates a complex matrix from a real matrix and, optionally, a matrix of imaginary parts of the same shape */
+objectcomplexmatrix *object_complexmatrixfrommatrix(objectmatrix *re, objectmatrix *im) {
+    if (im && (im->nrows!=re->nrows || im->ncols!=re->ncols)) return NULL;
+    objectcomplexmatrix *new = object_newcomplexmatrix(re->nrows, re->ncols, false);
+
+    if (new) {
+        unsigned int nel = re->nrows*re->ncols;
+        for (unsigned int i=0; i<nel; i++) new->elements[i]=re->elements[i] + (im ? im->elements[i] : 0.0)*I;
+    }
+
+    return new;
+}
+
+/** Creates a copy of a complex matrix */
+objectcomplexmatrix *object_clonecomplexmatrix(objectcomplexmatrix *m) {
+    objectcomplexmatrix *new = object_newcomplexmatrix(m->nrows, m->ncols, false);
+    if (new) cblas_zcopy(m->ncols*m->nrows, m->elements, 1, new->elements, 1);
+    return new;
+}
+
+/** Converts a number or a Complex to a double complex */
+static bool complexmatrix_valuetocomplex(value val, double complex *out) {
+    double x;
+    if (MORPHO_ISCOMPLEX(val)) {
+        *out=MORPHO_GETCOMPLEX(val)->Z;
+        return true;
+    } else if (morpho_valuetofloat(val, &x)) {
+        *out=x;
+        return true;
+    }
+    return false;
+}
+
+/** Gets a ComplexMatrix from a ComplexMatrix or Matrix value; a Matrix is converted to a new, unbound object that the caller must free
+ * @returns the complex matrix or NULL if the value is neither */
+static objectcomplexmatrix *complexmatrix_promote(value val, bool *temporary) {
+    *temporary=false;
+    if (MORPHO_ISCOMPLEXMATRIX(val)) return MORPHO_GETCOMPLEXMATRIX(val);
+    if (MORPHO_ISMATRIX(val)) {
+        *temporary=true;
+        return object_complexmatrixfrommatrix(MORPHO_GETMATRIX(val), NULL);
+    }
+    return NULL;
+}
+
+/** Frees a matrix created by complexmatrix_promote */
+static void complexmatrix_release(objectcomplexmatrix *m, bool temporary) {
+    if (temporary && m) object_free((object *) m);
+}
+
+/* **********************************************************************
+ * Complex matrix operations
+ * ********************************************************************* */
+
+/** Tests whether two matrices have the same shape */
+#define COMPLEXMATRIX_SAMESHAPE(a, b) ((a)->nrows==(b)->nrows && (a)->ncols==(b)->ncols)
+
+/** Adds two matrices, a + b -> out */
+objectmatrixerror complexmatrix_add(objectcomplexmatrix *a, objectcomplexmatrix *b, objectcomplexmatrix *out) {
+    double complex one = 1.0;
+    if (!COMPLEXMATRIX_SAMESHAPE(a, b) || !COMPLEXMATRIX_SAMESHAPE(a, out)) return MATRIX_INCMPTBLDIM;
+    if (a!=out) cblas_zcopy(a->ncols*a->nrows, a->elements, 1, out->elements, 1);
+    cblas_zaxpy(a->ncols*a->nrows, &one, b->elements, 1, out->elements, 1);
+    return MATRIX_OK;
+}
+
+/** Accumulates a multiple of another matrix in place, a + lambda*b -> a */
+objectmatrixerror complexmatrix_accumulate(objectcomplexmatrix *a, double complex lambda, objectcomplexmatrix *b) {
+    if (!COMPLEXMATRIX_SAMESHAPE(a, b)) return MATRIX_INCMPTBLDIM;
+    cblas_zaxpy(a->ncols*a->nrows, &lambda, b->elements, 1, a->elements, 1);
+    return MATRIX_OK;
+}
+
+/** Multiplies two matrices, a * b -> out */
+objectmatrixerror complexmatrix_mul(objectcomplexmatrix *a, objectcomplexmatrix *b, objectcomplexmatrix *out) {
+    double complex one = 1.0, zero = 0.0;
+    if (a->ncols!=b->nrows || out->nrows!=a->nrows || out->ncols!=b->ncols) return MATRIX_INCMPTBLDIM;
+    cblas_zgemm(CblasColMajor, CblasNoTrans, CblasNoTrans, a->nrows, b->ncols, a->ncols, &one, a->elements, a->nrows, b->elements, b->nrows, &zero, out->elements, out->nrows);
+    return MATRIX_OK;
+}
+
+/** Scales a matrix in place */
+objectmatrixerror complexmatrix_scale(objectcomplexmatrix *a, double complex scale) {
+    cblas_zscal(a->ncols*a->nrows, &scale, a->elements, 1);
+    return MATRIX_OK;
+}
+
+/** Frobenius inner product, sum of conj(a_ij)*b_ij, so that a.inner(a) is the square of the norm */
+objectmatrixerror complexmatrix_inner(objectcomplexmatrix *a, objectcomplexmatrix *b, double complex *out) {
+    if (!COMPLEXMATRIX_SAMESHAPE(a, b)) return MATRIX_INCMPTBLDIM;
+    cblas_zdotc_sub(a->ncols*a->nrows, a->elements, 1, b->elements, 1, out);
+    return MATRIX_OK;
+}
+
+/** Frobenius norm */
+double complexmatrix_norm(objectcomplexmatrix *a) {
+    return cblas_dznrm2(a->ncols*a->nrows, a->elements, 1);
+}
+
+/** Solves the system a.x = b */
+objectmatrixerror complexmatrix_solve(objectcomplexmatrix *a, objectcomplexmatrix *b, objectcomplexmatrix *out) {
+    int n=a->nrows, nrhs=b->ncols, info;
+    if (a->nrows!=a->ncols) return MATRIX_NSQ;
+    if (a->ncols!=b->nrows || !COMPLEXMATRIX_SAMESHAPE(b, out)) return MATRIX_INCMPTBLDIM;
+
+    double complex *lu=MORPHO_MALLOC(sizeof(double complex)*n*n);
+    int *pivot=MORPHO_MALLOC(sizeof(int)*n);
+    if (!lu || !pivot) {
+        if (lu) MORPHO_FREE(lu);
+        if (pivot) MORPHO_FREE(pivot);
+        return MATRIX_ALLOC;
+    }
+
+    cblas_zcopy(n*n, a->elements, 1, lu, 1);
+    if (b!=out) cblas_zcopy(b->ncols*b->nrows, b->elements, 1, out->elements, 1);
+#ifdef MORPHO_LINALG_USE_LAPACKE
+    info=LAPACKE_zgesv(LAPACK_COL_MAJOR, n, nrhs, lu, n, pivot, out->elements, n);
+#else
+    zgesv_(&n, &nrhs, (__CLPK_doublecomplex *) lu, &n, pivot, (__CLPK_doublecomplex *) out->elements, &n, &info);
+#endif
+
+    MORPHO_FREE(lu);
+    MORPHO_FREE(pivot);
+
+    return (info==0 ? MATRIX_OK : (info>0 ? MATRIX_SING : MATRIX_INVLD));
+}
+
+/** Inverts the matrix a */
+objectmatrixerror complexmatrix_inverse(objectcomplexmatrix *a, objectcomplexmatrix *out) {
+    int n=a->nrows, info;
+    if (a->nrows!=a->ncols) return MATRIX_NSQ;
+    if (!COMPLEXMATRIX_SAMESHAPE(a, out)) return MATRIX_INCMPTBLDIM;
+
+    int pivot[n];
+    cblas_zcopy(n*n, a->elements, 1, out->elements, 1);
+#ifdef MORPHO_LINALG_USE_LAPACKE
+    info=LAPACKE_zgetrf(LAPACK_COL_MAJOR, n, n, out->elements, n, pivot);
+#else
+    zgetrf_(&n, &n, (__CLPK_doublecomplex *) out->elements, &n, pivot, &info);
+#endif
+
+    if (info!=0) return (info>0 ? MATRIX_SING : MATRIX_INVLD);
+
+#ifdef MORPHO_LINALG_USE_LAPACKE
+    info=LAPACKE_zgetri(LAPACK_COL_MAJOR, n, out->elements, n, pivot);
+#else
+    int lwork=n*n; double complex work[n*n];
+    zgetri_(&n, (__CLPK_doublecomplex *) out->elements, &n, pivot, (__CLPK_doublecomplex *) work, &lwork, &info);
+#endif
+
+    return (info==0 ? MATRIX_OK : (info>0 ? MATRIX_SING : MATRIX_INVLD));
+}
+
+/** Finds the eigenvalues and, optionally, the eigenvectors of a matrix
+ * @param[in] a - the matrix
+ * @param[out] w - eigenvalues; you must provide an array with as many entries as rows of a
+ * @param[out] vec - (optional) matrix whose columns receive the eigenvectors */
+objectmatrixerror complexmatrix_eigensystem(objectcomplexmatrix *a, double complex *w, objectcomplexmatrix *vec) {
+    int info, n=a->nrows;
+    if (a->nrows!=a->ncols) return MATRIX_NSQ;
+    if (vec && !COMPLEXMATRIX_SAMESHAPE(a, vec)) return MATRIX_INCMPTBLDIM;
+
+    // Copy a to prevent destruction
+    double complex *acopy=MORPHO_MALLOC(n*n*sizeof(double complex));
+    if (!acopy) return MATRIX_ALLOC;
+    cblas_zcopy(n*n, a->elements, 1, acopy, 1);
+
+#ifdef MORPHO_LINALG_USE_LAPACKE
+    info=LAPACKE_zgeev(LAPACK_COL_MAJOR, 'N', (vec ? 'V' : 'N'), n, acopy, n, w, NULL, n, (vec ? vec->elements : NULL), n);
+#else
+    int lwork=4*n; double complex work[4*n]; double rwork[2*n];
+    zgeev_("N", (vec ? "V" : "N"), &n, (__CLPK_doublecomplex *) acopy, &n, (__CLPK_doublecomplex *) w, NULL, &n, (vec ? (__CLPK_doublecomplex *) vec->elements : NULL), &n, (__CLPK_doublecomplex *) work, &lwork, rwork, &info);
+#endif
+
+    MORPHO_FREE(acopy);
+
+    if (info!=0) return (info>0 ? MATRIX_FAILED : MATRIX_INVLD);
+
+    return MATRIX_OK;
+}
+
+/** Prints a complex matrix */
+static void complexmatrix_print(objectcomplexmatrix *m) {
+    for (int i=0; i<m->nrows; i++) { // Rows run from 0...m
+        printf("[ ");
+        for (int j=0; j<m->ncols; j++) { // Columns run from 0...k
+            objectcomplex c = MORPHO_STATICCOMPLEX(0, 0);
+            c.Z=m->elements[i+j*m->nrows];
+            complex_print(&c);
+            printf(" ");
+        }
+        printf("]%s", (i<m->nrows-1 ? "\n" : ""));
+    }
+}
+
+/* **********************************************************************
+ * ComplexMatrix class
+ * ********************************************************************* */
+
+/** Binds a newly created matrix, or raises an allocation error */
+static value complexmatrix_bind(vm *v, objectcomplexmatrix *new) {
+    value out=MORPHO_NIL;
+    if (new) {
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+    return out;
+}
+
+/** Creates a complex matrix from a List of rows, or a List of elements for a column vector */
+static objectcomplexmatrix *complexmatrix_fromlist(objectlist *list) {
+    unsigned int nrows=list->val.count, ncols=1;
+    if (nrows && MORPHO_ISLIST(list->val.data[0])) ncols=MORPHO_GETLIST(list->val.data[0])->val.count;
+
+    objectcomplexmatrix *new=object_newcomplexmatrix(nrows, ncols, true);
+    if (!new) return NULL;
+
+    for (unsigned int i=0; i<nrows; i++) {
+        value row=list->val.data[i];
+        bool success=true;
+
+        if (MORPHO_ISLIST(row)) {
+            objectlist *r = MORPHO_GETLIST(row);
+            success=(r->val.count==ncols);
+            for (unsigned int j=0; j<ncols && success; j++) success=complexmatrix_valuetocomplex(r->val.data[j], &new->elements[i+j*nrows]);
+        } else success=(ncols==1 && complexmatrix_valuetocomplex(row, &new->elements[i]));
+
+        if (!success) {
+            object_free((object *) new);
+            return NULL;
+        }
+    }
+
+    return new;
+}
+
+/** Constructs a ComplexMatrix */
+value complexmatrix_constructor(vm *v, int nargs, value *args) {
+    objectcomplexmatrix *new=NULL;
+
+    if (nargs==2 &&
+        MORPHO_ISINTEGER(MORPHO_GETARG(args, 0)) &&
+        MORPHO_ISINTEGER(MORPHO_GETARG(args, 1))) {
+        new=object_newcomplexmatrix(MORPHO_GETINTEGERVALUE(MORPHO_GETARG(args, 0)), MORPHO_GETINTEGERVALUE(MORPHO_GETARG(args, 1)), true);
+    } else if (nargs==1 && MORPHO_ISINTEGER(MORPHO_GETARG(args, 0))) {
+        new=object_newcomplexmatrix(MORPHO_GETINTEGERVALUE(MORPHO_GETARG(args, 0)), 1, true);
+    } else if (nargs==1 && MORPHO_ISLIST(MORPHO_GETARG(args, 0))) {
+        new=complexmatrix_fromlist(MORPHO_GETLIST(MORPHO_GETARG(args, 0)));
+        if (!new) MORPHO_RAISE(v, MATRIX_INVLDARRAYINIT);
+    } else if (nargs==1 && MORPHO_ISMATRIX(MORPHO_GETARG(args, 0))) {
+        new=object_complexmatrixfrommatrix(MORPHO_GETMATRIX(MORPHO_GETARG(args, 0)), NULL);
+    } else if (nargs==2 &&
+               MORPHO_ISMATRIX(MORPHO_GETARG(args, 0)) &&
+               MORPHO_ISMATRIX(MORPHO_GETARG(args, 1))) {
+        objectmatrix *re=MORPHO_GETMATRIX(MORPHO_GETARG(args, 0)), *im=MORPHO_GETMATRIX(MORPHO_GETARG(args, 1));
+        if (re->nrows!=im->nrows || re->ncols!=im->ncols) MORPHO_RAISE(v, MATRIX_INCOMPATIBLEMATRICES);
+        new=object_complexmatrixfrommatrix(re, im);
+    } else if (nargs==1 && MORPHO_ISCOMPLEXMATRIX(MORPHO_GETARG(args, 0))) {
+        new=object_clonecomplexmatrix(MORPHO_GETCOMPLEXMATRIX(MORPHO_GETARG(args, 0)));
+    } else MORPHO_RAISE(v, COMPLEXMATRIX_CONSTRUCTOR);
+
+    return complexmatrix_bind(v, new);
+}
+
+/** Gets the matrix element with given indices */
+value ComplexMatrix_getindex(vm *v, int nargs, value *args) {
+    objectcomplexmatrix *m=MORPHO_GETCOMPLEXMATRIX(MORPHO_SELF(args));
+    unsigned int indx[2]={0,0};
+    value out=MORPHO_NIL;
+
+    if (nargs>2) MORPHO_RAISE(v, MATRIX_INVLDNUMINDICES);
+    if (!array_valuelisttoindices(nargs, args+1, indx)) MORPHO_RAISE(v, MATRIX_INVLDINDICES);
+    if (indx[0]>=m->nrows || indx[1]>=m->ncols) MORPHO_RAISE(v, MATRIX_INDICESOUTSIDEBOUNDS);
+
+    double complex z=m->elements[indx[0]+indx[1]*m->nrows];
+    objectcomplex *new=object_newcomplex(creal(z), cimag(z));
+    if (new) {
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+
+    return out;
+}
+
+/** Sets the matrix element with given indices */
+value ComplexMatrix_setindex(vm *v, int nargs, value *args) {
+    objectcomplexmatrix *m=MORPHO_GETCOMPLEXMATRIX(MORPHO_SELF(args));
+    unsigned int indx[2]={0,0};
+    double complex z;
+
+    if (!array_valuelisttoindices(nargs-1, args+1, indx)) MORPHO_RAISE(v, MATRIX_INVLDINDICES);
+    if (indx[0]>=m->nrows || indx[1]>=m->ncols) MORPHO_RAISE(v, MATRIX_INDICESOUTSIDEBOUNDS);
+    if (!complexmatrix_valuetocomplex(args[nargs], &z)) MORPHO_RAISE(v, COMPLEXMATRIX_ARITHARGS);
+    m->elements[indx[0]+indx[1]*m->nrows]=z;
+
+    return MORPHO_NIL;
+}
+
+/** Prints a complex matrix */
+value ComplexMatrix_print(vm *v, int nargs, value *args) {
+    value self = MORPHO_SELF(args);
+    if (!MORPHO_ISCOMPLEXMATRIX(self)) return Object_print(v, nargs, args);
+
+    complexmatrix_print(MORPHO_GETCOMPLEXMATRIX(self));
+    return MORPHO_NIL;
+}
+
+/** Adds or subtracts a matrix or a scalar; sign is applied to the argument, and the result is negated if right is set */
+static value complexmatrix_addsub(vm *v, int nargs, value *args, double sign, bool right) {
+    objectcomplexmatrix *a=MORPHO_GETCOMPLEXMATRIX(MORPHO_SELF(args));
+    objectcomplexmatrix *new=NULL;
+    double complex z;
+    bool temp;
+
+    if (nargs!=1) MORPHO_RAISE(v, COMPLEXMATRIX_ARITHARGS);
+    value arg=MORPHO_GETARG(args, 0);
+    objectcomplexmatrix *b=complexmatrix_promote(arg, &temp);
+
+    if (b) {
+        bool compatible=COMPLEXMATRIX_SAMESHAPE(a, b);
+        if (compatible) {
+            new=object_clonecomplexmatrix(a);
+            if (new) complexmatrix_accumulate(new, sign, b);
+        }
+        complexmatrix_release(b, temp);
+        if (!compatible) MORPHO_RAISE(v, MATRIX_INCOMPATIBLEMATRICES);
+    } else if (complexmatrix_valuetocomplex(arg, &z)) {
+        new=object_clonecomplexmatrix(a);
+        if (new) for (unsigned int i=0; i<a->nrows*a->ncols; i++) new->elements[i]+=sign*z;
+    } else if (right && MORPHO_ISNIL(arg)) {
+        new=object_clonecomplexmatrix(a);
+    } else MORPHO_RAISE(v, COMPLEXMATRIX_ARITHARGS);
+
+    if (new && right) complexmatrix_scale(new, -1.0);
+    return complexmatrix_bind(v, new);
+}
+
+value ComplexMatrix_add(vm *v, int nargs, value *args) {
+    return complexmatrix_addsub(v, nargs, args, 1.0, false);
+}
+
+/** Right add, for which the result is the same as add; adding nil returns a copy so that matrices can be summed starting from nil */
+value ComplexMatrix_addr(vm *v, int nargs, value *args) {
+    if (nargs==1 && MORPHO_ISNIL(MORPHO_GETARG(args, 0))) return complexmatrix_bind(v, object_clonecomplexmatrix(MORPHO_GETCOMPLEXMATRIX(MORPHO_SELF(args))));
+    return complexmatrix_addsub(v, nargs, args, 1.0, false);
+}
+
+value ComplexMatrix_sub(vm *v, int nargs, value *args) {
+    return complexmatrix_addsub(v, nargs, args, -1.0, false);
+}
+
+value ComplexMatrix_subr(vm *v, int nargs, value *args) {
+    return complexmatrix_addsub(v, nargs, args, -1.0, true);
+}
+
+/** Multiplies by a matrix on the right, or by a scalar */
+value ComplexMatrix_mul(vm *v, int nargs, value *args) {
+    objectcomplexmatrix *a=MORPHO_GETCOMPLEXMATRIX(MORPHO_SELF(args));
+    objectcomplexmatrix *new=NULL;
+    double complex z;
+    bool temp;
+
+    if (nargs!=1) MORPHO_RAISE(v, COMPLEXMATRIX_ARITHARGS);
+    value arg=MORPHO_GETARG(args, 0);
+    objectcomplexmatrix *b=complexmatrix_promote(arg, &temp);
+
+    if (b) {
+        bool compatible=(a->ncols==b->nrows);
+        if (compatible) {
+            new=object_newcomplexmatrix(a->nrows, b->ncols, false);
+            if (new) complexmatrix_mul(a, b, new);
+        }
+        complexmatrix_release(b, temp);
+        if (!compatible) MORPHO_RAISE(v, MATRIX_INCOMPATIBLEMATRICES);
+    } else if (complexmatrix_valuetocomplex(arg, &z)) {
+        new=object_clonecomplexmatrix(a);
+        if (new) complexmatrix_scale(new, z);
+    } else if (MORPHO_ISSPARSE(arg)) {
+        return MORPHO_NIL; // Passed to mulr on Sparse
+    } else MORPHO_RAISE(v, COMPLEXMATRIX_ARITHARGS);
+
+    return complexmatrix_bind(v, new);
+}
+
+/** Called when multiplying on the right, i.e. arg*self, by a Matrix or a scalar */
+value ComplexMatrix_mulr(vm *v, int nargs, value *args) {
+    objectcomplexmatrix *b=MORPHO_GETCOMPLEXMATRIX(MORPHO_SELF(args));
+    objectcomplexmatrix *new=NULL;
+
+    if (nargs==1 && MORPHO_ISMATRIX(MORPHO_GETARG(args, 0))) {
+        bool temp;
+        objectcomplexmatrix *a=complexmatrix_promote(MORPHO_GETARG(args, 0), &temp);
+        if (!a) MORPHO_RAISE(v, ERROR_ALLOCATIONFAILED);
+        bool compatible=(a->ncols==b->nrows);
+        if (compatible) {
+            new=object_newcomplexmatrix(a->nrows, b->ncols, false);
+            if (new) complexmatrix_mul(a, b, new);
+        }
+        complexmatrix_release(a, temp);
+        if (!compatible) MORPHO_RAISE(v, MATRIX_INCOMPATIBLEMATRICES);
+        return complexmatrix_bind(v, new);
+    }
+
+    return ComplexMatrix_mul(v, nargs, args); // Scalars commute
+}
+
+/** Solves a.x = self, i.e. self/a, or divides by a scalar */
+value ComplexMatrix_div(vm *v, int nargs, value *args) {
+    objectcomplexmatrix *b=MORPHO_GETCOMPLEXMATRIX(MORPHO_SELF(args));
+    objectcomplexmatrix *new=NULL;
+    double complex z;
+    bool temp;
+
+    if (nargs!=1) MORPHO_RAISE(v, COMPLEXMATRIX_ARITHARGS);
+    value arg=MORPHO_GETARG(args, 0);
+    objectcomplexmatrix *a=complexmatrix_promote(arg, &temp);
+
+    if (a) {
+        objectmatrixerror err=MATRIX_ALLOC;
+        new=object_newcomplexmatrix(b->nrows, b->ncols, false);
+        if (new) err=complexmatrix_solve(a, b, new);
+        complexmatrix_release(a, temp);
+        if (err!=MATRIX_OK) {
+            if (new) object_free((object *) new);
+            matrix_raiseerror(v, err);
+            return MORPHO_NIL;
+        }
+    } else if (complexmatrix_valuetocomplex(arg, &z)) {
+        new=object_clonecomplexmatrix(b);
+        if (new) complexmatrix_scale(new, 1.0/z);
+    } else if (MORPHO_ISSPARSE(arg)) {
+        return MORPHO_NIL; // Passed to divr on Sparse
+    } else MORPHO_RAISE(v, COMPLEXMATRIX_ARITHARGS);
+
+    return complexmatrix_bind(v, new);
+}
+
+/** Solves self.x = arg, i.e. arg/self, where arg is a Matrix */
+value ComplexMatrix_divr(vm *v, int nargs, value *args) {
+    objectcomplexmatrix *a=MORPHO_GETCOMPLEXMATRIX(MORPHO_SELF(args));
+    bool temp;
+
+    if (nargs!=1 || !MORPHO_ISMATRIX(MORPHO_GETARG(args, 0))) MORPHO_RAISE(v, COMPLEXMATRIX_ARITHARGS);
+    objectcomplexmatrix *b=complexmatrix_promote(MORPHO_GETARG(args, 0), &temp);
+    if (!b) MORPHO_RAISE(v, ERROR_ALLOCATIONFAILED);
+
+    objectmatrixerror err=MATRIX_ALLOC;
+    objectcomplexmatrix *new=object_newcomplexmatrix(b->nrows, b->ncols, false);
+    if (new) err=complexmatrix_solve(a, b, new);
+    complexmatrix_release(b, temp);
+
+    if (err!=MATRIX_OK) {
+        if (new) object_free((object *) new);
+        matrix_raiseerror(v, err);
+        return MORPHO_NIL;
+    }
+    return complexmatrix_bind(v, new);
+}
+
+/** Accumulates a multiple of a matrix in place */
+value ComplexMatrix_acc(vm *v, int nargs, value *args) {
+    objectcomplexmatrix *a=MORPHO_GETCOMPLEXMATRIX(MORPHO_SELF(args));
+    double complex lambda;
+    bool temp;
+
+    if (nargs!=2 || !complexmatrix_valuetocomplex(MORPHO_GETARG(args, 0), &lambda)) MORPHO_RAISE(v, COMPLEXMATRIX_ARITHARGS);
+    objectcomplexmatrix *b=complexmatrix_promote(MORPHO_GETARG(args, 1), &temp);
+    if (!b) MORPHO_RAISE(v, COMPLEXMATRIX_ARITHARGS);
+
+    objectmatrixerror err=complexmatrix_accumulate(a, lambda, b);
+    complexmatrix_release(b, temp);
+
+    if (err!=MATRIX_OK) matrix_raiseerror(v, err);
+    return MORPHO_NIL;
+}
+
+/** Creates a bound Complex */
+static value complexmatrix_newcomplex(vm *v, double complex z) {
+    value out=MORPHO_NIL;
+    objectcomplex *new=object_newcomplex(creal(z), cimag(z));
+    if (new) {
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+    return out;
+}
+
+/** Frobenius inner product */
+value ComplexMatrix_inner(vm *v, int nargs, value *args) {
+    objectcomplexmatrix *a=MORPHO_GETCOMPLEXMATRIX(MORPHO_SELF(args));
+    double complex prod=0.0;
+    bool temp;
+
+    if (nargs!=1) MORPHO_RAISE(v, COMPLEXMATRIX_ARITHARGS);
+    objectcomplexmatrix *b=complexmatrix_promote(MORPHO_GETARG(args, 0), &temp);
+    if (!b) MORPHO_RAISE(v, COMPLEXMATRIX_ARITHARGS);
+
+    objectmatrixerror err=complexmatrix_inner(a, b, &prod);
+    complexmatrix_release(b, temp);
+
+    if (err!=MATRIX_OK) {
+        matrix_raiseerror(v, err);
+        return MORPHO_NIL;
+    }
+    return complexmatrix_newcomplex(v, prod);
+}
+
+/** Sum of the elements */
+value ComplexMatrix_sum(vm *v, int nargs, value *args) {
+    objectcomplexmatrix *a=MORPHO_GETCOMPLEXMATRIX(MORPHO_SELF(args));
+    double complex sum=0.0;
+    for (unsigned int i=0; i<a->nrows*a->ncols; i++) sum+=a->elements[i];
+    return complexmatrix_newcomplex(v, sum);
+}
+
+/** Trace */
+value ComplexMatrix_trace(vm *v, int nargs, value *args) {
+    objectcomplexmatrix *a=MORPHO_GETCOMPLEXMATRIX(MORPHO_SELF(args));
+    double complex sum=0.0;
+    if (a->nrows!=a->ncols) MORPHO_RAISE(v, MATRIX_NOTSQ);
+    for (unsigned int i=0; i<a->nrows; i++) sum+=a->elements[i*(a->nrows+1)];
+    return complexmatrix_newcomplex(v, sum);
+}
+
+/** Frobenius norm */
+value ComplexMatrix_norm(vm *v, int nargs, value *args) {
+    return MORPHO_FLOAT(complexmatrix_norm(MORPHO_GETCOMPLEXMATRIX(MORPHO_SELF(args))));
+}
+
+/** Transpose, optionally conjugating each element */
+static value complexmatrix_transpose(vm *v, value self, bool conjugate) {
+    objectcomplexmatrix *a=MORPHO_GETCOMPLEXMATRIX(self);
+    objectcomplexmatrix *new=object_newcomplexmatrix(a->ncols, a->nrows, false);
+
+    if (new) {
+        for (unsigned int j=0; j<a->ncols; j++) for (unsigned int i=0; i<a->nrows; i++) {
+            double complex z=a->elements[i+j*a->nrows];
+            new->elements[j+i*a->ncols]=(conjugate ? conj(z) : z);
+        }
+    }
+    return complexmatrix_bind(v, new);
+}
+
+value ComplexMatrix_transpose(vm *v, int nargs, value *args) {
+    return complexmatrix_transpose(v, MORPHO_SELF(args), false);
+}
+
+/** Complex conjugate of each element */
+value ComplexMatrix_conj(vm *v, int nargs, value *args) {
+    objectcomplexmatrix *new=object_clonecomplexmatrix(MORPHO_GETCOMPLEXMATRIX(MORPHO_SELF(args)));
+    if (new) for (unsigned int i=0; i<new->nrows*new->ncols; i++) new->elements[i]=conj(new->elements[i]);
+    return complexmatrix_bind(v, new);
+}
+
+/** Real or imaginary parts as a Matrix */
+static value complexmatrix_part(vm *v, value self, bool imag) {
+    objectcomplexmatrix *a=MORPHO_GETCOMPLEXMATRIX(self);
+    value out=MORPHO_NIL;
+    objectmatrix *new=object_newmatrix(a->nrows, a->ncols, false);
+
+    if (new) {
+        for (unsigned int i=0; i<a->nrows*a->ncols; i++) new->elements[i]=(imag ? cimag(a->elements[i]) : creal(a->elements[i]));
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+
+    return out;
+}
+
+value ComplexMatrix_real(vm *v, int nargs, value *args) {
+    return complexmatrix_part(v, MORPHO_SELF(args), false);
+}
+
+value ComplexMatrix_imag(vm *v, int nargs, value *args) {
+    return complexmatrix_part(v, MORPHO_SELF(args), true);
+}
+
+/** Inverse */
+value ComplexMatrix_inverse(vm *v, int nargs, value *args) {
+    objectcomplexmatrix *a=MORPHO_GETCOMPLEXMATRIX(MORPHO_SELF(args));
+    objectcomplexmatrix *new=object_newcomplexmatrix(a->nrows, a->ncols, false);
+    if (!new) MORPHO_RAISE(v, ERROR_ALLOCATIONFAILED);
+
+    objectmatrixerror err=complexmatrix_inverse(a, new);
+    if (err!=MATRIX_OK) {
+        object_free((object *) new);
+        matrix_raiseerror(v, err);
+        return MORPHO_NIL;
+    }
+    return complexmatrix_bind(v, new);
+}
+
+/** Finds the eigenvalues, returned as a List of Complex numbers, and optionally the eigenvectors */
+static value complexmatrix_eigen(vm *v, value self, bool vectors) {
+    objectcomplexmatrix *a=MORPHO_GETCOMPLEXMATRIX(self);
+    if (a->nrows!=a->ncols) MORPHO_RAISE(v, MATRIX_NOTSQ);
+    int n=a->nrows;
+
+    double complex *w=MORPHO_MALLOC(sizeof(double complex)*(n ? n : 1));
+    objectcomplexmatrix *vec=(vectors ? object_newcomplexmatrix(n, n, false) : NULL);
+    objectlist *vals=object_newlist(0, NULL);
+    objectlist *result=(vectors ? object_newlist(0, NULL) : NULL);
+    objectmatrixerror err=MATRIX_ALLOC;
+    value out=MORPHO_NIL;
+
+    if (w && vals && (!vectors || (vec && result))) err=complexmatrix_eigensystem(a, w, vec);
+
+    if (err==MATRIX_OK) {
+        for (int i=0; i<n && err==MATRIX_OK; i++) {
+            objectcomplex *c=object_newcomplex(creal(w[i]), cimag(w[i]));
+            if (c) list_append(vals, MORPHO_OBJECT(c));
+            else err=MATRIX_ALLOC;
+        }
+    }
+
+    if (err==MATRIX_OK) {
+        out=MORPHO_OBJECT(vals);
+        if (vectors) {
+            list_append(result, MORPHO_OBJECT(vals));
+            list_append(result, MORPHO_OBJECT(vec));
+            out=MORPHO_OBJECT(result);
+        }
+
+        // Bind the Complex eigenvalues together with the containers by temporarily appending these to vals
+        list_append(vals, MORPHO_OBJECT(vals));
+        if (vectors) {
+            list_append(vals, MORPHO_OBJECT(vec));
+            list_append(vals, MORPHO_OBJECT(result));
+        }
+        morpho_bindobjects(v, vals->val.count, vals->val.data);
+        vals->val.count=n;
+    } else {
+        if (vals) {
+            for (unsigned int i=0; i<vals->val.count; i++) morpho_freeobject(vals->val.data[i]);
+            object_free((object *) vals);
+        }
+        if (vec) object_free((object *) vec);
+        if (result) object_free((object *) result);
+        matrix_raiseerror(v, err);
+    }
+
+    if (w) MORPHO_FREE(w);
+    return out;
+}
+
+value ComplexMatrix_eigenvalues(vm *v, int nargs, value *args) {
+    return complexmatrix_eigen(v, MORPHO_SELF(args), false);
+}
+
+value ComplexMatrix_eigensystem(vm *v, int nargs, value *args) {
+    return complexmatrix_eigen(v, MORPHO_SELF(args), true);
+}
+
+/** Enumerate protocol */
+value ComplexMatrix_enumerate(vm *v, int nargs, value *args) {
+    objectcomplexmatrix *a=MORPHO_GETCOMPLEXMATRIX(MORPHO_SELF(args));
+    value out=MORPHO_NIL;
+
+    if (nargs==1 && MORPHO_ISINTEGER(MORPHO_GETARG(args, 0))) {
+        int i=MORPHO_GETINTEGERVALUE(MORPHO_GETARG(args, 0));
+
+        if (i<0) out=MORPHO_INTEGER(a->ncols*a->nrows);
+        else if (i<a->ncols*a->nrows) out=complexmatrix_newcomplex(v, a->elements[i]);
+    }
+
+    return out;
+}
+
+/** Number of matrix elements */
+value ComplexMatrix_count(vm *v, int nargs, value *args) {
+    objectcomplexmatrix *a=MORPHO_GETCOMPLEXMATRIX(MORPHO_SELF(args));
+    return MORPHO_INTEGER(a->ncols*a->nrows);
+}
+
+/** Matrix dimensions */
+value ComplexMatrix_dimensions(vm *v, int nargs, value *args) {
+    objectcomplexmatrix *a=MORPHO_GETCOMPLEXMATRIX(MORPHO_SELF(args));
+    value dim[2] = { MORPHO_INTEGER(a->nrows), MORPHO_INTEGER(a->ncols) };
+    value out=MORPHO_NIL;
+
+    objectlist *new=object_newlist(2, dim);
+    if (new) {
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+
+    return out;
+}
+
+/** Clones a complex matrix */
+value ComplexMatrix_clone(vm *v, int nargs, value *args) {
+    return complexmatrix_bind(v, object_clonecomplexmatrix(MORPHO_GETCOMPLEXMATRIX(MORPHO_SELF(args))));
+}
+
+MORPHO_BEGINCLASS(ComplexMatrix)
+MORPHO_METHOD(MORPHO_GETINDEX_METHOD, ComplexMatrix_getindex, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_SETINDEX_METHOD, ComplexMatrix_setindex, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_PRINT_METHOD, ComplexMatrix_print, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_ADD_METHOD, ComplexMatrix_add, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_ADDR_METHOD, ComplexMatrix_addr, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_SUB_METHOD, ComplexMatrix_sub, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_SUBR_METHOD, ComplexMatrix_subr, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_MUL_METHOD, ComplexMatrix_mul, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_MULR_METHOD, ComplexMatrix_mulr, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_DIV_METHOD, ComplexMatrix_div, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_DIVR_METHOD, ComplexMatrix_divr, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_ACC_METHOD, ComplexMatrix_acc, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MATRIX_INNER_METHOD, ComplexMatrix_inner, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_SUM_METHOD, ComplexMatrix_sum, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MATRIX_TRACE_METHOD, ComplexMatrix_trace, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MATRIX_NORM_METHOD, ComplexMatrix_norm, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MATRIX_TRANSPOSE_METHOD, ComplexMatrix_transpose, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(COMPLEXMATRIX_CONJ_METHOD, ComplexMatrix_conj, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(COMPLEXMATRIX_REAL_METHOD, ComplexMatrix_real, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(COMPLEXMATRIX_IMAG_METHOD, ComplexMatrix_imag, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MATRIX_INVERSE_METHOD, ComplexMatrix_inverse, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MATRIX_EIGENVALUES_METHOD, ComplexMatrix_eigenvalues, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MATRIX_EIGENSYSTEM_METHOD, ComplexMatrix_eigensystem, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_ENUMERATE_METHOD, ComplexMatrix_enumerate, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_COUNT_METHOD, ComplexMatrix_count, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MATRIX_DIMENSIONS_METHOD, ComplexMatrix_dimensions, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_CLONE_METHOD, ComplexMatrix_clone, BUILTIN_FLAGSEMPTY)
+MORPHO_ENDCLASS
+
+/* **********************************************************************
+ * Initialization
+ * ********************************************************************* */
+
+void complexmatrix_initialize(void) {
+    objectcomplexmatrixtype=object_addtype(&objectcomplexmatrixdefn);
+
+    builtin_addfunction(COMPLEXMATRIX_CLASSNAME, complexmatrix_constructor, BUILTIN_FLAGSCONSTRUCTOR);
+
+    objectstring objname = MORPHO_STATICSTRING(OBJECT_CLASSNAME);
+    value objclass = builtin_findclass(MORPHO_OBJECT(&objname));
+
+    value complexmatrixclass=builtin_addclass(COMPLEXMATRIX_CLASSNAME, MORPHO_GETCLASSDEFINITION(ComplexMatrix), objclass);
+    object_setveneerclass(OBJECT_COMPLEXMATRIX, complexmatrixclass);
+
+    morpho_defineerror(COMPLEXMATRIX_CONSTRUCTOR, ERROR_HALT, COMPLEXMATRIX_CONSTRUCTOR_MSG);
+    morpho_defineerror(COMPLEXMATRIX_ARITHARGS, ERROR_HALT, COMPLEXMATRIX_ARITHARGS_MSG);
+}
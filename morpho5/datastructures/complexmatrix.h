@@ -0,0 +1,80 @@
+/** @file complexmatrix.h
+ *  @author T J Atherton
+ *
+ *  @brief Veneer class over the objectcomplexmatrix type, a dense matrix of complex numbers
+ */
+
+#ifndef complexmatrix_h
+#define complexmatrix_h
+
+#include <stdio.h>
+#include "veneer.h"
+#include "matrix.h"
+#include "cmplx.h"
+
+/* -------------------------------------------------------
+ * Complex matrix objects
+ * ------------------------------------------------------- */
+
+extern objecttype objectcomplexmatrixtype;
+#define OBJECT_COMPLEXMATRIX objectcomplexmatrixtype
+
+/** Complex matrices store their elements in column-major order like objectmatrix; each element is a
+    C99 double complex, i.e. the real and imaginary parts are interleaved, which is the layout expected
+    by the z-prefixed BLAS and LAPACK routines. */
+typedef struct {
+    object obj;
+    unsigned int nrows;
+    unsigned int ncols;
+    double complex *elements;
+    double complex matrixdata[];
+} objectcomplexmatrix;
+
+/** Tests whether an object is a complex matrix */
+#define MORPHO_ISCOMPLEXMATRIX(val) object_istype(val, OBJECT_COMPLEXMATRIX)
+
+/** Gets the object as a complex matrix */
+#define MORPHO_GETCOMPLEXMATRIX(val)   ((objectcomplexmatrix *) MORPHO_GETOBJECT(val))
+
+/** Creates a complex matrix */
+objectcomplexmatrix *object_newcomplexmatrix(unsigned int nrows, unsigned int ncols, bool zero);
+
+/** Creates a complex matrix from a real matrix and, optionally, a matrix of imaginary parts */
+objectcomplexmatrix *object_complexmatrixfrommatrix(objectmatrix *re, objectmatrix *im);
+
+/** Creates a copy of a complex matrix */
+objectcomplexmatrix *object_clonecomplexmatrix(objectcomplexmatrix *m);
+
+/* -------------------------------------------------------
+ * ComplexMatrix class
+ * ------------------------------------------------------- */
+
+#define COMPLEXMATRIX_CLASSNAME "ComplexMatrix"
+
+#define COMPLEXMATRIX_CONJ_METHOD "conj"
+#define COMPLEXMATRIX_REAL_METHOD "real"
+#define COMPLEXMATRIX_IMAG_METHOD "imag"
+
+#define COMPLEXMATRIX_CONSTRUCTOR         "CmplxMtrxCns"
+#define COMPLEXMATRIX_CONSTRUCTOR_MSG     "ComplexMatrix() constructor should be called with dimensions, a list initializer, one or two matrices holding the real and imaginary parts, or a ComplexMatrix."
+
+#define COMPLEXMATRIX_ARITHARGS           "CmplxMtrxArgs"
+#define COMPLEXMATRIX_ARITHARGS_MSG       "ComplexMatrix arithmetic methods expect a ComplexMatrix, Matrix, Complex or number as their argument."
+
+/* -------------------------------------------------------
+ * ComplexMatrix interface
+ * ------------------------------------------------------- */
+
+objectmatrixerror complexmatrix_add(objectcomplexmatrix *a, objectcomplexmatrix *b, objectcomplexmatrix *out);
+objectmatrixerror complexmatrix_accumulate(objectcomplexmatrix *a, double complex lambda, objectcomplexmatrix *b);
+objectmatrixerror complexmatrix_mul(objectcomplexmatrix *a, objectcomplexmatrix *b, objectcomplexmatrix *out);
+objectmatrixerror complexmatrix_scale(objectcomplexmatrix *a, double complex scale);
+objectmatrixerror complexmatrix_inner(objectcomplexmatrix *a, objectcomplexmatrix *b, double complex *out);
+objectmatrixerror complexmatrix_solve(objectcomplexmatrix *a, objectcomplexmatrix *b, objectcomplexmatrix *out);
+objectmatrixerror complexmatrix_inverse(objectcomplexmatrix *a, objectcomplexmatrix *out);
+objectmatrixerror complexmatrix_eigensystem(objectcomplexmatrix *a, double complex *w, objectcomplexmatrix *vec);
+double complexmatrix_norm(objectcomplexmatrix *a);
+
+void complexmatrix_initialize(void);
+
+#endif /* complexmatrix_h */
@@ -6,6 +6,7 @@
 
 #include <stdio.h>
 #include <inttypes.h>
+#include <string.h>
 #include "dictionary.h"
 #include "common.h"
 #include "memory.h"
@@ -23,15 +24,9 @@
 /** An empty value */
 #define DICTIONARY_EMPTYVALUE MORPHO_NIL
 
-/** Value used to indicate a tombstone */
-#define DICTIONARY_TOMBSTONEVALUE MORPHO_TRUE
-
 /** Literal for an empty entry */
 #define DICTIONARY_EMPTYENTRY ((dictionaryentry) { DICTIONARY_EMPTYVALUE, DICTIONARY_EMPTYVALUE})
 
-/** Literal for a tombstone entry */
-#define DICTIONARY_TOMBSTONEENTRY ((dictionaryentry) { DICTIONARY_EMPTYVALUE, DICTIONARY_TOMBSTONEVALUE})
-
 /*
  * These macros can be changed to tune the algorithm
  */
@@ -62,7 +57,7 @@
 /** Integer modulo */
 //#define DICTIONARY_REDUCE(x, size) (x % size)
 /** Faster version for power of two sizes */
-#define DICTIONARY_REDUCE(x, size) (x & (size-1))
+#define DICTIONARY_REDUCE(x, size) ((x) & ((size)-1))
 
 /** Faster version for arbitrary sizes - https://lemire.me/blog/2016/06/27/a-fast-alternative-to-the-modulo-reduction/ */
 /*static inline uint32_t dictionary_reduce64(uint32_t x, uint32_t N) {
@@ -137,8 +132,13 @@ static hash dictionary_hash(value key, bool intern) {
         if (intern) {
             return MORPHO_GETOBJECTHASH(key);
         } else {
-            if (MORPHO_ISSTRING(key)) {
-                return dictionary_hashstring(MORPHO_GETCSTRING(key), MORPHO_GETSTRINGLENGTH(key));
+            if (MORPHO_ISSTRING(key)) { /* Strings are immutable, so cache their hash */
+                hash h = MORPHO_GETOBJECTHASH(key);
+                if (h==HASH_EMPTY) {
+                    h=dictionary_hashstring(MORPHO_GETCSTRING(key), MORPHO_GETSTRINGLENGTH(key));
+                    MORPHO_SETOBJECTHASH(key, h);
+                }
+                return h;
             } else if (MORPHO_ISDOKKEY(key)) {
                 return dictionary_hashdokkey(MORPHO_GETDOKKEY(key));
             } else {
@@ -149,19 +149,95 @@ static hash dictionary_hash(value key, bool intern) {
     return 0;
 }
 
+/*
+ * Control bytes
+ */
+
+/** Control byte for an empty slot; occupied slots hold DICTIONARY_H2 of their hash, which never has the top bit set */
+#define DICTIONARY_CTRLEMPTY 0x80
+
+/** Number of control bytes examined at once */
+#define DICTIONARY_GROUPWIDTH 16
+
+/** Seven bits of the hash stored in the control byte; the top bits are used because the bottom bits select the slot */
+#define DICTIONARY_H2(h) ((uint8_t) ((h) >> 25))
+
+/** Bitmask with one bit per slot in a group */
+typedef uint32_t dictionarymask;
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+
+/** Returns a mask of the slots in the group starting at ctrl whose control byte is b */
+static inline dictionarymask dictionary_groupmatch(uint8_t *ctrl, uint8_t b) {
+    __m128i group = _mm_loadu_si128((__m128i *) ctrl);
+    return (dictionarymask) _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char) b)));
+}
+
+/** Returns a mask of the empty slots in the group starting at ctrl */
+static inline dictionarymask dictionary_groupempty(uint8_t *ctrl) {
+    return (dictionarymask) _mm_movemask_epi8(_mm_loadu_si128((__m128i *) ctrl));
+}
+#else
+static inline dictionarymask dictionary_groupmatch(uint8_t *ctrl, uint8_t b) {
+    dictionarymask mask = 0;
+    for (int i=0; i<DICTIONARY_GROUPWIDTH; i++) if (ctrl[i]==b) mask |= (1u<<i);
+    return mask;
+}
+
+static inline dictionarymask dictionary_groupempty(uint8_t *ctrl) {
+    dictionarymask mask = 0;
+    for (int i=0; i<DICTIONARY_GROUPWIDTH; i++) if (ctrl[i] & DICTIONARY_CTRLEMPTY) mask |= (1u<<i);
+    return mask;
+}
+#endif
+
+/** Index of the lowest set bit in a nonzero mask */
+static inline unsigned int dictionary_lowestbit(dictionarymask mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned int) __builtin_ctz(mask);
+#else
+    unsigned int i=0;
+    while (!(mask & 1u)) { mask >>= 1; i++; }
+    return i;
+#endif
+}
+
+/** Sets a control byte, keeping the copy of the first group that follows the table in step */
+static inline void dictionary_setctrl(dictionary *dict, unsigned int i, uint8_t b) {
+    dict->ctrl[i] = b;
+    if (i<DICTIONARY_GROUPWIDTH) dict->ctrl[dict->capacity+i] = b;
+}
+
+/** Tests whether a stored key matches a key being looked up.
+ *  Integers and interned keys are equal only if they're identical, so only other keys need the full comparison. */
+static inline bool dictionary_keyequal(value a, value key, bool intern) {
+    if (MORPHO_ISSAME(a, key)) return true;
+    if (intern || MORPHO_ISINTEGER(key)) return false;
+    if (MORPHO_ISSTRING(a) && MORPHO_ISSTRING(key)) {
+        /* Distinct interned strings always differ; otherwise compare cached hashes before contents */
+        if (MORPHO_ISINTERNEDSTRING(a) && MORPHO_ISINTERNEDSTRING(key)) return false;
+        hash ha=MORPHO_GETOBJECTHASH(a), hb=MORPHO_GETOBJECTHASH(key);
+        if (ha!=HASH_EMPTY && hb!=HASH_EMPTY && ha!=hb) return false;
+    }
+    return MORPHO_ISEQUAL(a, key);
+}
+
 /** @brief Initializes a dictionary
  * @param dict the dictionary to initialize */
 void dictionary_init(dictionary *dict) {
     dict->capacity=0;
     dict->count=0;
     dict->contents=NULL;
+    dict->hashes=NULL;
+    dict->ctrl=NULL;
 }
 
 /** @brief Clears a dictionary structure, freeing attached memory
  *  @param dict the dictionary to clear
  *  @warning This doens't free keys or values in the dictionary. */
 void dictionary_clear(dictionary *dict) {
-    if (dict->contents) MORPHO_FREE(dict->contents);
+    if (dict->contents) MORPHO_FREE(dict->contents); /* Metadata shares this allocation */
     dictionary_init(dict);
 }
 
@@ -170,6 +246,7 @@ void dictionary_clear(dictionary *dict) {
  *  @warning This doens't free keys or values in the dictionary. */
 void dictionary_wipe(dictionary *dict) {
     for (unsigned int i=0; i<dict->capacity; i++) dict->contents[i].key=MORPHO_NIL;
+    if (dict->ctrl) memset(dict->ctrl, DICTIONARY_CTRLEMPTY, dict->capacity+DICTIONARY_GROUPWIDTH);
     dict->count=0;
 }
 
@@ -190,14 +267,33 @@ void dictionary_freecontents(dictionary *dict, bool freekeys, bool freevals) {
     }
 }
 
+/** @brief Finds the first empty slot on the probe sequence for a given hash
+ *  @details The table is never full, so this always succeeds. */
+static inline unsigned int dictionary_findempty(dictionary *dict, hash h) {
+    unsigned int indx = DICTIONARY_REDUCE(h, dict->capacity);
+    
+    for (;;) {
+        dictionarymask empty = dictionary_groupempty(dict->ctrl+indx);
+        if (empty) return DICTIONARY_REDUCE(indx + dictionary_lowestbit(empty), dict->capacity);
+        indx = DICTIONARY_REDUCE(indx + DICTIONARY_GROUPWIDTH, dict->capacity);
+    }
+}
+
+/** @brief Places a new entry into an empty slot */
+static inline void dictionary_place(dictionary *dict, unsigned int i, hash h, value key, value val) {
+    dict->contents[i].key=key;
+    dict->contents[i].val=val;
+    dict->hashes[i]=h;
+    dictionary_setctrl(dict, i, DICTIONARY_H2(h));
+}
+
 /** @brief Resizes a dictionary.
  *  @param dict the dictionary to resize
  *  @param size a new size for the dictionary
  *  @returns true on success
  */
 bool dictionary_resize(dictionary *dict, unsigned int size) {
-    dictionaryentry *new=NULL, *old = dict->contents;
-    unsigned int oldsize = dict->capacity;
+    dictionary old = *dict;
 #ifdef DICTIONARY_ENFORCEPOWEROFTWO
     unsigned int newsize = morpho_powerof2ceiling(size);
 #else
@@ -206,87 +302,75 @@ bool dictionary_resize(dictionary *dict, unsigned int size) {
     
     /* Don't resize below the minimum */
     if (dict->contents && newsize<DICTIONARY_DEFAULTSIZE) return false;
+    if (newsize<DICTIONARY_DEFAULTSIZE) newsize=DICTIONARY_DEFAULTSIZE;
     
-    new=MORPHO_MALLOC(newsize * sizeof(dictionaryentry));
-
-    /* Clear the newly allocated structure */
-    if (new) {
-        for (unsigned int i=0; i<newsize; i++) new[i] = DICTIONARY_EMPTYENTRY;
-    } else return false;
+    /* Entries, hashes and control bytes are held in a single allocation */
+    char *new=MORPHO_MALLOC(newsize * (sizeof(dictionaryentry) + sizeof(hash) + sizeof(uint8_t)) + DICTIONARY_GROUPWIDTH);
+    if (!new) return false;
     
     /* Update the dictionary */
     dict->capacity=newsize;
-    dict->contents=new;
-    dict->count=0; /* Restart from no entries */
+    dict->contents=(dictionaryentry *) new;
+    dict->hashes=(hash *) (new + newsize*sizeof(dictionaryentry));
+    dict->ctrl=(uint8_t *) (new + newsize*(sizeof(dictionaryentry) + sizeof(hash)));
+    dict->count=old.count;
+    
+    /* Clear the newly allocated structure */
+    for (unsigned int i=0; i<newsize; i++) dict->contents[i] = DICTIONARY_EMPTYENTRY;
+    memset(dict->ctrl, DICTIONARY_CTRLEMPTY, newsize+DICTIONARY_GROUPWIDTH);
     
-    if (old) {
-        /* Copy the contents over */
-        for (unsigned int i=0; i<oldsize; i++) {
-            dictionaryentry *e = &old[i];
-            
-            if (MORPHO_ISNIL(e->key)) continue;
-            
-            dictionary_insert(dict, e->key, e->val);
+    if (old.contents) {
+        /* Move the contents over, reusing the stored hashes; keys are already distinct */
+        for (unsigned int i=0; i<old.capacity; i++) {
+            if (old.ctrl[i] & DICTIONARY_CTRLEMPTY) continue;
+            hash h = old.hashes[i];
+            dictionary_place(dict, dictionary_findempty(dict, h), h, old.contents[i].key, old.contents[i].val);
         }
-        MORPHO_FREE(old); 
+        MORPHO_FREE(old.contents);
     }
     
-    return (bool) dict->contents;
+    return true;
 }
 
 /** @brief Searches for an entry in a dictionary
+ *  @details Slots are probed linearly, a group of control bytes at a time. Only slots whose control
+ *           byte matches the key's hash are compared and the search stops at the first empty slot.
  *  @param[in]  dict   the dictionary to search
  *  @param[in]  key    the key to search for
+ *  @param[in]  h      hash of the key
  *  @param[in]  intern whether to use a strict equality search for objects or a fast search
- *  @param[out] entry  the dictionary entry corresponding to the key or a blank entry.
+ *  @param[out] slot   the slot containing the key, or the empty slot where it should be inserted.
  *  @returns true if the entry was found, false otherwise */
-static bool dictionary_find(dictionary *dict, value key, bool intern, dictionaryentry **entry) {
+static bool dictionary_find(dictionary *dict, value key, hash h, bool intern, unsigned int *slot) {
     /* If there's nothing in the hashtable, return immediately */
     if (!dict->contents) return false;
     
-    /* Find the starting point by hashing the key */
-    unsigned int start_index = DICTIONARY_REDUCE(dictionary_hash(key, intern), dict->capacity);
-    unsigned int indx = start_index;
-    
-    /* Store a pointer to any tombstones we encounter along the way. */
-    dictionaryentry *tombstone = NULL;
-    dictionaryentry *e = NULL;
+    uint8_t h2 = DICTIONARY_H2(h);
+    unsigned int indx = DICTIONARY_REDUCE(h, dict->capacity);
     
-    /* Loop over entries */
-    do {
-        e = &dict->contents[indx];
-        if (intern) {
-            /* If intern is set, we use MORPHO_SAME (tests for equality depending on whether
-            objects are the same not just equivalent. */
-            if (MORPHO_ISSAME(e->key, key)) {
-                /* We found the key! */
-                *entry = e;
+    for (;;) {
+        dictionarymask match = dictionary_groupmatch(dict->ctrl+indx, h2);
+        dictionarymask empty = dictionary_groupempty(dict->ctrl+indx);
+        
+        /* Only slots before the first empty one belong to the probe sequence */
+        if (empty) match &= (empty & (~empty+1)) - 1;
+        
+        while (match) {
+            unsigned int i = DICTIONARY_REDUCE(indx + dictionary_lowestbit(match), dict->capacity);
+            if (dictionary_keyequal(dict->contents[i].key, key, intern)) {
+                *slot = i;
                 return true;
             }
-        } else if (MORPHO_ISEQUAL(e->key, key)) {
-            /* If intern is false, we can use the slower equivalence test */
-            /* We found the key! */
-            *entry = e;
-            return true;
+            match &= match-1;
         }
         
-        /* If the key for this entry is blank, it's empty or could be a tombstone */
-        if (MORPHO_ISNIL(e->key)) {
-            if (MORPHO_ISEQUAL(e->val, DICTIONARY_TOMBSTONEVALUE)) {
-                if (!tombstone) tombstone = e; /* We found a tombstone */
-            } else {
-                /* Otherwise, this is an empty slot. We can now break
-                the loop and eventually return this, or the tombstone */
-                break;
-            }
+        if (empty) {
+            *slot = DICTIONARY_REDUCE(indx + dictionary_lowestbit(empty), dict->capacity);
+            return false;
         }
         
-        indx = DICTIONARY_REDUCE((indx + 1), dict->capacity);
-    } while (indx!=start_index); /* Loop will always terminate if we do a full cycle of the entries */
-    // If we did not find an existing entry, return the blank, or
-    // preferably a tombstone
-    *entry = (tombstone ? tombstone : e);
-    return false;
+        indx = DICTIONARY_REDUCE(indx + DICTIONARY_GROUPWIDTH, dict->capacity);
+    }
 }
 
 /** @brief Internal function that inserts a value in a hashtable given a key
@@ -298,34 +382,27 @@ static bool dictionary_find(dictionary *dict, value key, bool intern, dictionary
  * @warning If an entry already exists, it is overwritten. Caller should check for existing keys
  *          if this is necessary. */
 static inline bool _dictionary_insert(dictionary *dict, value key, value val, bool intern) {
-    dictionaryentry *entry=NULL;
+    hash h = dictionary_hash(key, intern);
+    unsigned int slot;
+    
+    if (dictionary_find(dict, key, h, intern, &slot)) {
+        /* Entry already exists */
+        dict->contents[slot].val=val;
+        return true;
+    }
     
     if (!dict->contents) {
-        dictionary_resize(dict, DICTIONARY_DEFAULTSIZE);
+        if (!dictionary_resize(dict, DICTIONARY_DEFAULTSIZE)) return false;
+        slot = dictionary_findempty(dict, h);
     } else if (dict->count+1 > DICTIONARY_SIZEINCREASETHRESHOLD(dict->capacity)) {
         /* Trigger a resize */
-        dictionary_resize(dict, DICTIONARY_INCREASESIZE(dict->capacity));
+        if (!dictionary_resize(dict, DICTIONARY_INCREASESIZE(dict->capacity))) return false;
+        slot = dictionary_findempty(dict, h);
     }
     
-    if (dict->contents) {
-        if (dictionary_find(dict, key, intern, &entry)) {
-            /* Entry already exists */
-            entry->val=val;
-            return true;
-        } else {
-            /* Entry doesn't exist, */
-            if (entry) {
-                entry->key=key;
-                entry->val=val;
-                dict->count++;
-                return true;
-            } else {
-                UNREACHABLE("Dictionary failed to insert an entry");
-            }
-        }
-    }
-    
-    return false;
+    dictionary_place(dict, slot, h, key, val);
+    dict->count++;
+    return true;
 }
 
 /** @brief Inserts a value in a hashtable given a key
@@ -358,15 +435,16 @@ bool dictionary_insertintern(dictionary *dict, value key, value val) {
  *  @param[in]  key  a new key to intern
  *  @returns the internalized key, or MORPHO_NIL on failure. */
 value dictionary_intern(dictionary *dict, value key) {
-    dictionaryentry *entry=NULL;
+    hash h = dictionary_hash(key, false);
+    unsigned int slot;
     
     /* Is the key already in the dictionary? */
-    if (dictionary_find(dict, key, false, &entry)) {
-        return entry->key;
+    if (dictionary_find(dict, key, h, false, &slot)) {
+        return dict->contents[slot].key;
     } else {
         /* If not, insert it with a blank value */
         if (dictionary_insert(dict, key, MORPHO_NIL)) {
-            MORPHO_SETOBJECTHASH( key, dictionary_hash(key, false));
+            MORPHO_SETOBJECTHASH(key, h);
             return key;
         }
     }
@@ -383,10 +461,10 @@ value dictionary_intern(dictionary *dict, value key) {
  * @returns true if found, false otherwise
 */
 static inline bool _dictionary_get(dictionary *dict, value key, bool intern, value *val) {
-    dictionaryentry *entry=NULL;
+    unsigned int slot;
     
-    if (dictionary_find(dict, key, intern, &entry)) {
-        if (val) *val = entry->val;
+    if (dictionary_find(dict, key, dictionary_hash(key, intern), intern, &slot)) {
+        if (val) *val = dict->contents[slot].val;
         return true;
     }
     
@@ -414,16 +492,37 @@ bool dictionary_getintern(dictionary *dict, value key, value *val) {
     return _dictionary_get(dict, key, true, val);
 }
 
+/** @brief Empties a slot without leaving a tombstone
+ *  @details Later entries on the same probe run are shifted back into the hole whenever the
+ *           hole lies between their home slot and where they currently sit. */
+static void dictionary_erase(dictionary *dict, unsigned int hole) {
+    unsigned int mask = dict->capacity-1;
+    
+    for (unsigned int j=(hole+1) & mask; !(dict->ctrl[j] & DICTIONARY_CTRLEMPTY); j=(j+1) & mask) {
+        unsigned int home = DICTIONARY_REDUCE(dict->hashes[j], dict->capacity);
+        
+        if (((j-home) & mask) >= ((j-hole) & mask)) {
+            dict->contents[hole]=dict->contents[j];
+            dict->hashes[hole]=dict->hashes[j];
+            dictionary_setctrl(dict, hole, dict->ctrl[j]);
+            hole=j;
+        }
+    }
+    
+    dict->contents[hole] = DICTIONARY_EMPTYENTRY;
+    dictionary_setctrl(dict, hole, DICTIONARY_CTRLEMPTY);
+}
+
 /** @brief Removes a key from a dictionary given a key
  * @param[in]  dict the dictionary to initialize
  * @param[in]  key  key to remove
  * @returns true if the key was found, false otherwise
  */
 bool dictionary_remove(dictionary *dict, value key) {
-    dictionaryentry *entry=NULL;
+    unsigned int slot;
     
-    if (dictionary_find(dict, key, false, &entry)) {
-        *entry = DICTIONARY_TOMBSTONEENTRY;
+    if (dictionary_find(dict, key, dictionary_hash(key, false), false, &slot)) {
+        dictionary_erase(dict, slot);
         dict->count--;
         
         /* If we have lost our last entry, clear the dictionary */
@@ -440,6 +539,45 @@ bool dictionary_remove(dictionary *dict, value key) {
     return false;
 }
 
+/** @brief Resets a cursor so that the next search starts from the beginning of a dictionary */
+void dictionary_cursorinit(dictionarycursor *cursor) {
+    cursor->indx=-1;
+    cursor->slot=0;
+    cursor->count=0;
+    cursor->capacity=0;
+}
+
+/** @brief Finds the slot holding the n-th entry of a dictionary, counting in slot order
+ * @param[in]  dict   the dictionary
+ * @param[in]  n      index of the entry to find
+ * @param[in]  cursor optional cursor; if set by an earlier call for an entry before n, the search resumes from there
+ * @param[out] slot   slot holding the entry
+ * @returns true if found, false if the dictionary has n or fewer entries */
+bool dictionary_nthentry(dictionary *dict, unsigned int n, dictionarycursor *cursor, unsigned int *slot) {
+    unsigned int k=0, i=0;
+
+    if (cursor && cursor->indx>=0 && n>=(unsigned int) cursor->indx &&
+        cursor->count==dict->count && cursor->capacity==dict->capacity) {
+        k=cursor->indx; i=cursor->slot;
+    }
+
+    for (; i<dict->capacity; i++) {
+        if (!MORPHO_ISNIL(dict->contents[i].key)) {
+            if (k==n) {
+                if (cursor) {
+                    cursor->indx=n; cursor->slot=i;
+                    cursor->count=dict->count; cursor->capacity=dict->capacity;
+                }
+                *slot=i;
+                return true;
+            }
+            k++;
+        }
+    }
+
+    return false;
+}
+
 /** @brief Copies the entries of one dictionary to another */
 bool dictionary_copy(dictionary *src, dictionary *dest) {
     if (src->contents) {
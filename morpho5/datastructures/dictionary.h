@@ -18,14 +18,30 @@ typedef struct {
     value val;
 } dictionaryentry;
 
-/** @brief dictionary data structure that maps keys to values */
+/** @brief dictionary data structure that maps keys to values
+ *  @details Entries live in contents, which may be iterated over directly; empty slots have a nil key.
+ *           Probing is driven by a separate array of control bytes, one per slot, that hold either
+ *           DICTIONARY_CTRLEMPTY or seven bits of the key's hash, so that a whole group of slots can
+ *           be rejected without touching the entries themselves. */
 typedef struct {
     unsigned int capacity; /** capacity of the dictionary */
     unsigned int count; /** number of items in the dictionary */
     
     dictionaryentry *contents; /** contents of the dictionary */
+    hash *hashes; /** full hash of the key in each slot */
+    uint8_t *ctrl; /** control bytes for each slot, followed by a copy of the first group */
 } dictionary;
 
+/** @brief Records the position reached when stepping through the entries of a dictionary in slot order
+ *  @details Successive entries can then be found without rescanning from the start. A cursor is ignored if the
+ *           dictionary's count or capacity has changed since it was set. */
+typedef struct {
+    int indx; /** index of the entry last found, or -1 */
+    unsigned int slot; /** slot that held it */
+    unsigned int count; /** count of the dictionary when the cursor was set */
+    unsigned int capacity; /** capacity of the dictionary when the cursor was set */
+} dictionarycursor;
+
 void dictionary_init(dictionary *dict);
 void dictionary_clear(dictionary *dict);
 void dictionary_wipe(dictionary *dict);
@@ -38,6 +54,9 @@ bool dictionary_getintern(dictionary *dict, value key, value *val);
 bool dictionary_remove(dictionary *dict, value key);
 bool dictionary_copy(dictionary *src, dictionary *dest);
 
+void dictionary_cursorinit(dictionarycursor *cursor);
+bool dictionary_nthentry(dictionary *dict, unsigned int n, dictionarycursor *cursor, unsigned int *slot);
+
 bool dictionary_union(dictionary *a, dictionary *b, dictionary *out);
 bool dictionary_intersection(dictionary *a, dictionary *b, dictionary *out);
 bool dictionary_difference(dictionary *a, dictionary *b, dictionary *out);
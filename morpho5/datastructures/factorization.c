@@ -0,0 +1,575 @@
+/** @file factorization.c
+ *  @author T J Atherton
+ *
+ *  @brief Factorization objects that cache LU, Cholesky, QR and singular value decompositions of a matrix
+ */
+
+#include <string.h>
+#include <float.h>
+#include "object.h"
+#include "matrix.h"
+#include "factorization.h"
+#include "morpho.h"
+#include "builtin.h"
+#include "veneer.h"
+#include "common.h"
+
+/* **********************************************************************
+ * Factorization objects
+ * ********************************************************************** */
+
+objecttype objectfactorizationtype;
+
+/** Names of each kind of factorization */
+static char *factorization_names[] = { "LU", "Cholesky", "QR", "SVD" };
+
+/** Smaller dimension of the factorized matrix */
+#define FACTORIZATION_MINDIM(f) ((f)->nrows<(f)->ncols ? (f)->nrows : (f)->ncols)
+
+/** Size of the record kept for each pending rank-one update */
+#define FACTORIZATION_UPDATESIZE(f) (2*(f)->nrows+1)
+
+/** Function object definitions */
+size_t objectfactorization_sizefn(object *obj) {
+    objectfactorization *f = (objectfactorization *) obj;
+    size_t m=f->nrows, n=f->ncols, k=FACTORIZATION_MINDIM(f);
+    size_t size = sizeof(objectfactorization)+2*m*n*sizeof(double);
+
+    if (f->pivot) size+=n*sizeof(int);
+    if (f->tau) size+=k*sizeof(double);
+    if (f->vt) size+=k*n*sizeof(double);
+    if (f->updates) size+=FACTORIZATION_MAXUPDATES*FACTORIZATION_UPDATESIZE(f)*sizeof(double);
+
+    return size;
+}
+
+void objectfactorization_printfn(object *obj) {
+    printf("<Factorization: %s>", factorization_names[((objectfactorization *) obj)->kind]);
+}
+
+void objectfactorization_freefn(object *obj) {
+    objectfactorization *f = (objectfactorization *) obj;
+    if (f->a) MORPHO_FREE(f->a);
+    if (f->factors) MORPHO_FREE(f->factors);
+    if (f->pivot) MORPHO_FREE(f->pivot);
+    if (f->tau) MORPHO_FREE(f->tau);
+    if (f->vt) MORPHO_FREE(f->vt);
+    if (f->updates) MORPHO_FREE(f->updates);
+}
+
+objecttypedefn objectfactorizationdefn = {
+    .printfn=objectfactorization_printfn,
+    .markfn=NULL,
+    .freefn=objectfactorization_freefn,
+    .sizefn=objectfactorization_sizefn
+};
+
+/* **********************************************************************
+ * Factorization
+ * ********************************************************************* */
+
+/** Factorizes the matrix held in f->a, discarding any pending updates */
+static objectmatrixerror factorization_factorize(objectfactorization *f) {
+    int m=f->nrows, n=f->ncols, k=FACTORIZATION_MINDIM(f), info=0;
+    f->nupdates=0;
+
+    switch (f->kind) {
+        case FACTORIZATION_LU:
+            memcpy(f->factors, f->a, sizeof(double)*m*n);
+#ifdef MORPHO_LINALG_USE_LAPACKE
+            info=LAPACKE_dgetrf(LAPACK_COL_MAJOR, m, n, f->factors, m, f->pivot);
+#else
+            dgetrf_(&m, &n, f->factors, &m, f->pivot, &info);
+#endif
+            return (info==0 ? MATRIX_OK : (info>0 ? MATRIX_SING : MATRIX_INVLD));
+
+        case FACTORIZATION_CHOLESKY:
+            memcpy(f->factors, f->a, sizeof(double)*m*n);
+#ifdef MORPHO_LINALG_USE_LAPACKE
+            info=LAPACKE_dpotrf(LAPACK_COL_MAJOR, 'L', n, f->factors, n);
+#else
+            dpotrf_("L", &n, f->factors, &n, &info);
+#endif
+            return (info==0 ? MATRIX_OK : (info>0 ? MATRIX_FAILED : MATRIX_INVLD));
+
+        case FACTORIZATION_QR: {
+            memcpy(f->factors, f->a, sizeof(double)*m*n);
+#ifdef MORPHO_LINALG_USE_LAPACKE
+            info=LAPACKE_dgeqrf(LAPACK_COL_MAJOR, m, n, f->factors, m, f->tau);
+#else
+            int lwork=-1; double wsize;
+            dgeqrf_(&m, &n, f->factors, &m, f->tau, &wsize, &lwork, &info);
+            lwork=(int) wsize;
+            double *work=MORPHO_MALLOC(sizeof(double)*lwork);
+            if (!work) return MATRIX_ALLOC;
+            dgeqrf_(&m, &n, f->factors, &m, f->tau, work, &lwork, &info);
+            MORPHO_FREE(work);
+#endif
+            return (info==0 ? MATRIX_OK : MATRIX_INVLD);
+        }
+
+        case FACTORIZATION_SVD: {
+            // dgesvd destroys its input, so work on a copy
+            double *acopy=MORPHO_MALLOC(sizeof(double)*m*n);
+            if (!acopy) return MATRIX_ALLOC;
+            memcpy(acopy, f->a, sizeof(double)*m*n);
+#ifdef MORPHO_LINALG_USE_LAPACKE
+            double superb[k];
+            info=LAPACKE_dgesvd(LAPACK_COL_MAJOR, 'S', 'S', m, n, acopy, m, f->tau, f->factors, m, f->vt, k, superb);
+#else
+            int lwork=-1; double wsize;
+            dgesvd_("S", "S", &m, &n, acopy, &m, f->tau, f->factors, &m, f->vt, &k, &wsize, &lwork, &info);
+            lwork=(int) wsize;
+            double *work=MORPHO_MALLOC(sizeof(double)*lwork);
+            if (work) {
+                dgesvd_("S", "S", &m, &n, acopy, &m, f->tau, f->factors, &m, f->vt, &k, work, &lwork, &info);
+                MORPHO_FREE(work);
+            } else info=-1;
+#endif
+            MORPHO_FREE(acopy);
+            return (info==0 ? MATRIX_OK : (info>0 ? MATRIX_FAILED : MATRIX_INVLD));
+        }
+    }
+
+    return MATRIX_INVLD;
+}
+
+/** Creates a factorization of a matrix
+ * @param[in] m - the matrix to factorize; LU and Cholesky factorizations require m to be square, QR that it has no more columns than rows
+ * @param[in] kind - kind of factorization
+ * @param[out] err - set if the factorization fails
+ * @returns the factorization, or NULL on failure */
+objectfactorization *object_newfactorization(objectmatrix *m, factorizationkind kind, objectmatrixerror *err) {
+    objectfactorization *new = (objectfactorization *) object_new(sizeof(objectfactorization), OBJECT_FACTORIZATION);
+
+    if (!new) {
+        *err=MATRIX_ALLOC;
+        return NULL;
+    }
+
+    new->kind=kind;
+    new->nrows=m->nrows;
+    new->ncols=m->ncols;
+    new->pivot=NULL;
+    new->tau=NULL;
+    new->vt=NULL;
+    new->nupdates=0;
+    new->updates=NULL;
+
+    int nel=m->nrows*m->ncols, k=FACTORIZATION_MINDIM(new);
+    new->a=MORPHO_MALLOC(sizeof(double)*nel);
+    new->factors=MORPHO_MALLOC(sizeof(double)*(kind==FACTORIZATION_SVD ? m->nrows*k : nel));
+
+    bool success=(new->a && new->factors);
+    if (kind==FACTORIZATION_LU) success&=((new->pivot=MORPHO_MALLOC(sizeof(int)*m->ncols))!=NULL);
+    if (kind==FACTORIZATION_QR || kind==FACTORIZATION_SVD) success&=((new->tau=MORPHO_MALLOC(sizeof(double)*k))!=NULL);
+    if (kind==FACTORIZATION_SVD) success&=((new->vt=MORPHO_MALLOC(sizeof(double)*k*m->ncols))!=NULL);
+
+    *err=MATRIX_ALLOC;
+    if (success) {
+        memcpy(new->a, m->elements, sizeof(double)*nel);
+        *err=factorization_factorize(new);
+    }
+
+    if (*err!=MATRIX_OK) {
+        object_free((object *) new);
+        new=NULL;
+    }
+
+    return new;
+}
+
+/* **********************************************************************
+ * Solution
+ * ********************************************************************* */
+
+/** Solves A.x = b using the factorization alone, ignoring pending updates
+ * @param[in] f - the factorization
+ * @param[in] nrhs - number of right hand sides
+ * @param[in] b - nrows x nrhs right hand sides
+ * @param[out] x - ncols x nrhs solutions; must not alias b */
+static objectmatrixerror factorization_basesolve(objectfactorization *f, int nrhs, double *b, double *x) {
+    int m=f->nrows, n=f->ncols, k=FACTORIZATION_MINDIM(f), info=0;
+
+    switch (f->kind) {
+        case FACTORIZATION_LU:
+            memcpy(x, b, sizeof(double)*n*nrhs);
+#ifdef MORPHO_LINALG_USE_LAPACKE
+            info=LAPACKE_dgetrs(LAPACK_COL_MAJOR, 'N', n, nrhs, f->factors, n, f->pivot, x, n);
+#else
+            dgetrs_("N", &n, &nrhs, f->factors, &n, f->pivot, x, &n, &info);
+#endif
+            break;
+
+        case FACTORIZATION_CHOLESKY:
+            memcpy(x, b, sizeof(double)*n*nrhs);
+#ifdef MORPHO_LINALG_USE_LAPACKE
+            info=LAPACKE_dpotrs(LAPACK_COL_MAJOR, 'L', n, nrhs, f->factors, n, x, n);
+#else
+            dpotrs_("L", &n, &nrhs, f->factors, &n, x, &n, &info);
+#endif
+            break;
+
+        case FACTORIZATION_QR: {
+            // x minimizes |A.x - b|: form Q^T.b, then solve R.x = (Q^T.b) using its first n rows
+            for (int i=0; i<n; i++) if (f->factors[i*(m+1)]==0.0) return MATRIX_SING;
+
+            double *qtb=MORPHO_MALLOC(sizeof(double)*m*nrhs);
+            if (!qtb) return MATRIX_ALLOC;
+            memcpy(qtb, b, sizeof(double)*m*nrhs);
+#ifdef MORPHO_LINALG_USE_LAPACKE
+            info=LAPACKE_dormqr(LAPACK_COL_MAJOR, 'L', 'T', m, nrhs, n, f->factors, m, f->tau, qtb, m);
+#else
+            int lwork=-1; double wsize;
+            dormqr_("L", "T", &m, &nrhs, &n, f->factors, &m, f->tau, qtb, &m, &wsize, &lwork, &info);
+            lwork=(int) wsize;
+            double *work=MORPHO_MALLOC(sizeof(double)*lwork);
+            if (work) {
+                dormqr_("L", "T", &m, &nrhs, &n, f->factors, &m, f->tau, qtb, &m, work, &lwork, &info);
+                MORPHO_FREE(work);
+            } else info=-1;
+#endif
+            for (int j=0; j<nrhs; j++) memcpy(x+j*n, qtb+j*m, sizeof(double)*n);
+            MORPHO_FREE(qtb);
+
+            if (info==0) cblas_dtrsm(CblasColMajor, CblasLeft, CblasUpper, CblasNoTrans, CblasNonUnit, n, nrhs, 1.0, f->factors, m, x, n);
+        }
+            break;
+
+        case FACTORIZATION_SVD: {
+            // x = V.S^+.U^T.b, discarding singular values that are negligible relative to the largest
+            double *utb=MORPHO_MALLOC(sizeof(double)*k*nrhs);
+            if (!utb) return MATRIX_ALLOC;
+
+            cblas_dgemm(CblasColMajor, CblasTrans, CblasNoTrans, k, nrhs, m, 1.0, f->factors, m, b, m, 0.0, utb, k);
+
+            double tol = (m>n ? m : n)*DBL_EPSILON*(k>0 ? f->tau[0] : 0.0);
+            for (int i=0; i<k; i++) {
+                double scale = (f->tau[i]>tol ? 1.0/f->tau[i] : 0.0);
+                for (int j=0; j<nrhs; j++) utb[i+j*k]*=scale;
+            }
+
+            cblas_dgemm(CblasColMajor, CblasTrans, CblasNoTrans, n, nrhs, k, 1.0, f->vt, k, utb, k, 0.0, x, n);
+            MORPHO_FREE(utb);
+        }
+            break;
+    }
+
+    return (info==0 ? MATRIX_OK : (info>0 ? MATRIX_SING : MATRIX_INVLD));
+}
+
+/** Applies pending rank-one updates to solutions found by factorization_basesolve, using the Sherman-Morrison formula
+ *  (A + u v^T)^{-1}.b = A^{-1}.b - z (v.A^{-1}.b)/(1 + v.z) where z = A^{-1}.u */
+static void factorization_applyupdates(objectfactorization *f, int nrhs, double *x) {
+    int n=f->nrows;
+
+    for (int j=0; j<f->nupdates; j++) {
+        double *z = f->updates+j*FACTORIZATION_UPDATESIZE(f), *v = z+n, gamma = z[2*n];
+
+        for (int c=0; c<nrhs; c++) {
+            double *xc = x+c*n;
+            cblas_daxpy(n, -cblas_ddot(n, v, 1, xc, 1)/gamma, z, 1, xc, 1);
+        }
+    }
+}
+
+/** Solves A.x = b, in the least squares sense for QR and SVD factorizations
+ * @param[in] f - the factorization
+ * @param[in] b - right hand sides, one per column, with as many rows as A
+ * @param[out] x - solutions, with as many rows as A has columns and as many columns as b; must not alias b
+ * @returns MATRIX_OK on success */
+objectmatrixerror factorization_solve(objectfactorization *f, objectmatrix *b, objectmatrix *x) {
+    if (b->nrows!=f->nrows || x->nrows!=f->ncols || x->ncols!=b->ncols) return MATRIX_INCMPTBLDIM;
+
+    objectmatrixerror err=factorization_basesolve(f, b->ncols, b->elements, x->elements);
+    if (err==MATRIX_OK) factorization_applyupdates(f, b->ncols, x->elements);
+
+    return err;
+}
+
+/* **********************************************************************
+ * Updates
+ * ********************************************************************* */
+
+/** Updates a Cholesky factor L of A in place so that it becomes the factor of A + u u^T */
+static objectmatrixerror factorization_choleskyupdate(objectfactorization *f, double *u) {
+    int n=f->nrows;
+    double *L=f->factors, *w=MORPHO_MALLOC(sizeof(double)*n);
+    if (!w) return MATRIX_ALLOC;
+    memcpy(w, u, sizeof(double)*n);
+
+    for (int k=0; k<n; k++) {
+        double lkk=L[k+k*n], r=sqrt(lkk*lkk+w[k]*w[k]), c=r/lkk, s=w[k]/lkk;
+        L[k+k*n]=r;
+        for (int i=k+1; i<n; i++) {
+            L[i+k*n]=(L[i+k*n]+s*w[i])/c;
+            w[i]=c*w[i]-s*L[i+k*n];
+        }
+    }
+
+    MORPHO_FREE(w);
+    cblas_dger(CblasColMajor, n, n, 1.0, u, 1, u, 1, f->a, n);
+    return MATRIX_OK;
+}
+
+/** Factorizes A + u v^T afresh in scratch storage, replacing the matrix and its factors only if this succeeds
+ * @param[in] u - vector with as many elements as A has rows, or NULL to refactorize A itself
+ * @param[in] v - vector of the same size; ignored if u is NULL */
+static objectmatrixerror factorization_refactorize(objectfactorization *f, double *u, double *v) {
+    int n=f->nrows;
+    objectfactorization trial=*f;
+    trial.a=MORPHO_MALLOC(sizeof(double)*n*n);
+    trial.factors=MORPHO_MALLOC(sizeof(double)*n*n);
+    trial.pivot=(f->pivot ? MORPHO_MALLOC(sizeof(int)*n) : NULL);
+    trial.tau=(f->tau ? MORPHO_MALLOC(sizeof(double)*n) : NULL);
+    trial.vt=(f->vt ? MORPHO_MALLOC(sizeof(double)*n*n) : NULL);
+    trial.updates=NULL;
+
+    objectmatrixerror err=MATRIX_ALLOC;
+    if (trial.a && trial.factors && (trial.pivot || !f->pivot) &&
+        (trial.tau || !f->tau) && (trial.vt || !f->vt)) {
+        memcpy(trial.a, f->a, sizeof(double)*n*n);
+        if (u) cblas_dger(CblasColMajor, n, n, 1.0, u, 1, v, 1, trial.a, n);
+        err=factorization_factorize(&trial);
+    }
+
+    if (err==MATRIX_OK) { // Swap the new storage into f so that the old is freed below
+        double *a=f->a, *factors=f->factors, *tau=f->tau, *vt=f->vt;
+        int *pivot=f->pivot;
+        f->a=trial.a; f->factors=trial.factors; f->pivot=trial.pivot; f->tau=trial.tau; f->vt=trial.vt;
+        f->nupdates=0;
+        trial.a=a; trial.factors=factors; trial.pivot=pivot; trial.tau=tau; trial.vt=vt;
+    }
+
+    objectfactorization_freefn((object *) &trial);
+    return err;
+}
+
+/** Applies a rank-one update A -> A + u v^T to a factorization of a square matrix
+ * @param[in] f - the factorization
+ * @param[in] u - vector with as many elements as A has rows
+ * @param[in] v - vector of the same size, or NULL to use u; must be NULL for Cholesky factorizations
+ * @returns MATRIX_OK on success, or MATRIX_SING if the update would make A singular, in which case f is unchanged */
+objectmatrixerror factorization_update(objectfactorization *f, double *u, double *v) {
+    int n=f->nrows;
+    if (f->nrows!=f->ncols) return MATRIX_NSQ;
+
+    if (f->kind==FACTORIZATION_CHOLESKY) {
+        if (v && v!=u) return MATRIX_INVLD;
+        return factorization_choleskyupdate(f, u);
+    }
+    if (!v) v=u;
+
+    if (f->nupdates>=FACTORIZATION_MAXUPDATES) return factorization_refactorize(f, u, v);
+
+    if (!f->updates) {
+        f->updates=MORPHO_MALLOC(sizeof(double)*FACTORIZATION_MAXUPDATES*FACTORIZATION_UPDATESIZE(f));
+        if (!f->updates) return MATRIX_ALLOC;
+    }
+
+    double *z=f->updates+f->nupdates*FACTORIZATION_UPDATESIZE(f);
+    objectmatrixerror err=factorization_basesolve(f, 1, u, z);
+    if (err!=MATRIX_OK) return err;
+    factorization_applyupdates(f, 1, z);
+
+    double gamma=1.0+cblas_ddot(n, v, 1, z, 1);
+    if (gamma==0.0) return MATRIX_SING;
+
+    memcpy(z+n, v, sizeof(double)*n);
+    z[2*n]=gamma;
+    f->nupdates++;
+
+    cblas_dger(CblasColMajor, n, n, 1.0, u, 1, v, 1, f->a, n);
+    return MATRIX_OK;
+}
+
+/* **********************************************************************
+ * Factorization veneer class
+ * ********************************************************************* */
+
+/** Creates a factorization and raises an error if this fails */
+static value factorization_create(vm *v, objectmatrix *m, factorizationkind kind) {
+    value out=MORPHO_NIL;
+    objectmatrixerror err;
+    objectfactorization *new=object_newfactorization(m, kind, &err);
+
+    if (new) {
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else if (err==MATRIX_FAILED && kind==FACTORIZATION_CHOLESKY) {
+        morpho_runtimeerror(v, FACTORIZATION_NOTPD);
+    } else matrix_raiseerror(v, err);
+
+    return out;
+}
+
+/** LU factorization of a square matrix */
+value Matrix_lu(vm *v, int nargs, value *args) {
+    objectmatrix *a=MORPHO_GETMATRIX(MORPHO_SELF(args));
+    if (a->nrows!=a->ncols) MORPHO_RAISE(v, MATRIX_NOTSQ);
+    return factorization_create(v, a, FACTORIZATION_LU);
+}
+
+/** Cholesky factorization of a symmetric positive definite matrix */
+value Matrix_cholesky(vm *v, int nargs, value *args) {
+    objectmatrix *a=MORPHO_GETMATRIX(MORPHO_SELF(args));
+    if (a->nrows!=a->ncols) MORPHO_RAISE(v, MATRIX_NOTSQ);
+    return factorization_create(v, a, FACTORIZATION_CHOLESKY);
+}
+
+/** QR factorization of a matrix with at least as many rows as columns */
+value Matrix_qr(vm *v, int nargs, value *args) {
+    objectmatrix *a=MORPHO_GETMATRIX(MORPHO_SELF(args));
+    if (a->nrows<a->ncols) MORPHO_RAISE(v, FACTORIZATION_QRSHAPE);
+    return factorization_create(v, a, FACTORIZATION_QR);
+}
+
+/** Singular value decomposition of a matrix */
+value Matrix_svd(vm *v, int nargs, value *args) {
+    objectmatrix *a=MORPHO_GETMATRIX(MORPHO_SELF(args));
+    return factorization_create(v, a, FACTORIZATION_SVD);
+}
+
+/** Solves A.x = b for any number of right hand sides */
+value Factorization_solve(vm *v, int nargs, value *args) {
+    objectfactorization *f=MORPHO_GETFACTORIZATION(MORPHO_SELF(args));
+    value out=MORPHO_NIL;
+
+    if (nargs==1 && MORPHO_ISMATRIX(MORPHO_GETARG(args, 0)) &&
+        MORPHO_GETMATRIX(MORPHO_GETARG(args, 0))->nrows==f->nrows) {
+        objectmatrix *b=MORPHO_GETMATRIX(MORPHO_GETARG(args, 0));
+        objectmatrix *new=object_newmatrix(f->ncols, b->ncols, false);
+
+        if (new) {
+            objectmatrixerror err=factorization_solve(f, b, new);
+            if (err==MATRIX_OK) {
+                out=MORPHO_OBJECT(new);
+                morpho_bindobjects(v, 1, &out);
+            } else {
+                object_free((object *) new);
+                matrix_raiseerror(v, err);
+            }
+        } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+    } else morpho_runtimeerror(v, FACTORIZATION_SOLVEARGS);
+
+    return out;
+}
+
+/** Applies a rank-one update A -> A + u v^T, or A + u u^T if v is omitted */
+value Factorization_update(vm *v, int nargs, value *args) {
+    objectfactorization *f=MORPHO_GETFACTORIZATION(MORPHO_SELF(args));
+    objectmatrix *vec[2]={NULL, NULL};
+
+    if (nargs<1 || nargs>2 || f->nrows!=f->ncols ||
+        (nargs==2 && f->kind==FACTORIZATION_CHOLESKY)) MORPHO_RAISE(v, FACTORIZATION_UPDATEARGS);
+
+    for (int i=0; i<nargs; i++) {
+        value arg=MORPHO_GETARG(args, i);
+        if (!MORPHO_ISMATRIX(arg) || MORPHO_GETMATRIX(arg)->nrows*MORPHO_GETMATRIX(arg)->ncols!=f->nrows) MORPHO_RAISE(v, FACTORIZATION_UPDATEARGS);
+        vec[i]=MORPHO_GETMATRIX(arg);
+    }
+
+    size_t size=objectfactorization_sizefn((object *) f);
+    objectmatrixerror err=factorization_update(f, vec[0]->elements, (vec[1] ? vec[1]->elements : NULL));
+    morpho_resizeobject(v, (object *) f, size, objectfactorization_sizefn((object *) f));
+
+    if (err!=MATRIX_OK) matrix_raiseerror(v, err);
+
+    return MORPHO_NIL;
+}
+
+/** Determinant of the factorized matrix */
+value Factorization_det(vm *v, int nargs, value *args) {
+    objectfactorization *f=MORPHO_GETFACTORIZATION(MORPHO_SELF(args));
+    int n=f->nrows;
+    double det=1.0;
+
+    switch (f->kind) {
+        case FACTORIZATION_LU:
+            for (int i=0; i<n; i++) det*=(f->pivot[i]!=i+1 ? -f->factors[i*(n+1)] : f->factors[i*(n+1)]);
+            // By the matrix determinant lemma, each pending update multiplies the determinant by 1 + v.z
+            for (int j=0; j<f->nupdates; j++) det*=f->updates[j*FACTORIZATION_UPDATESIZE(f)+2*n];
+            break;
+        case FACTORIZATION_CHOLESKY:
+            for (int i=0; i<n; i++) det*=f->factors[i*(n+1)]*f->factors[i*(n+1)];
+            break;
+        default:
+            MORPHO_RAISEVARGS(v, FACTORIZATION_METHOD, FACTORIZATION_DET_METHOD, factorization_names[f->kind]);
+    }
+
+    return MORPHO_FLOAT(det);
+}
+
+/** Returns a copy of the factorized matrix, including any updates */
+value Factorization_matrix(vm *v, int nargs, value *args) {
+    objectfactorization *f=MORPHO_GETFACTORIZATION(MORPHO_SELF(args));
+    value out=MORPHO_NIL;
+
+    objectmatrix *new=object_matrixfromfloats(f->nrows, f->ncols, f->a);
+    if (new) {
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+
+    return out;
+}
+
+/** Singular values in descending order, as a column matrix */
+value Factorization_singularvalues(vm *v, int nargs, value *args) {
+    objectfactorization *f=MORPHO_GETFACTORIZATION(MORPHO_SELF(args));
+    value out=MORPHO_NIL;
+
+    if (f->kind!=FACTORIZATION_SVD) MORPHO_RAISEVARGS(v, FACTORIZATION_METHOD, FACTORIZATION_SINGULARVALUES_METHOD, factorization_names[f->kind]);
+    if (f->nupdates>0 && factorization_refactorize(f, NULL, NULL)!=MATRIX_OK) MORPHO_RAISE(v, MATRIX_OPFAILED);
+
+    objectmatrix *new=object_matrixfromfloats(FACTORIZATION_MINDIM(f), 1, f->tau);
+    if (new) {
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+
+    return out;
+}
+
+/** Numerical rank, the number of singular values that are not negligible relative to the largest */
+value Factorization_rank(vm *v, int nargs, value *args) {
+    objectfactorization *f=MORPHO_GETFACTORIZATION(MORPHO_SELF(args));
+    int k=FACTORIZATION_MINDIM(f), rank=0;
+
+    if (f->kind!=FACTORIZATION_SVD) MORPHO_RAISEVARGS(v, FACTORIZATION_METHOD, FACTORIZATION_RANK_METHOD, factorization_names[f->kind]);
+    if (f->nupdates>0 && factorization_refactorize(f, NULL, NULL)!=MATRIX_OK) MORPHO_RAISE(v, MATRIX_OPFAILED);
+
+    double tol = (f->nrows>f->ncols ? f->nrows : f->ncols)*DBL_EPSILON*(k>0 ? f->tau[0] : 0.0);
+    for (int i=0; i<k; i++) if (f->tau[i]>tol) rank++;
+
+    return MORPHO_INTEGER(rank);
+}
+
+MORPHO_BEGINCLASS(Factorization)
+MORPHO_METHOD(FACTORIZATION_SOLVE_METHOD, Factorization_solve, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(FACTORIZATION_UPDATE_METHOD, Factorization_update, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(FACTORIZATION_DET_METHOD, Factorization_det, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(FACTORIZATION_MATRIX_METHOD, Factorization_matrix, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(FACTORIZATION_SINGULARVALUES_METHOD, Factorization_singularvalues, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(FACTORIZATION_RANK_METHOD, Factorization_rank, BUILTIN_FLAGSEMPTY)
+MORPHO_ENDCLASS
+
+/* **********************************************************************
+ * Initialization
+ * ********************************************************************* */
+
+void factorization_initialize(void) {
+    objectfactorizationtype=object_addtype(&objectfactorizationdefn);
+
+    objectstring objname = MORPHO_STATICSTRING(OBJECT_CLASSNAME);
+    value objclass = builtin_findclass(MORPHO_OBJECT(&objname));
+
+    value factorizationclass=builtin_addclass(FACTORIZATION_CLASSNAME, MORPHO_GETCLASSDEFINITION(Factorization), objclass);
+    object_setveneerclass(OBJECT_FACTORIZATION, factorizationclass);
+
+    morpho_defineerror(FACTORIZATION_NOTPD, ERROR_HALT, FACTORIZATION_NOTPD_MSG);
+    morpho_defineerror(FACTORIZATION_QRSHAPE, ERROR_HALT, FACTORIZATION_QRSHAPE_MSG);
+    morpho_defineerror(FACTORIZATION_SOLVEARGS, ERROR_HALT, FACTORIZATION_SOLVEARGS_MSG);
+    morpho_defineerror(FACTORIZATION_UPDATEARGS, ERROR_HALT, FACTORIZATION_UPDATEARGS_MSG);
+    morpho_defineerror(FACTORIZATION_METHOD, ERROR_HALT, FACTORIZATION_METHOD_MSG);
+}
@@ -0,0 +1,100 @@
+/** @file factorization.h
+ *  @author T J Atherton
+ *
+ *  @brief Factorization objects that cache LU, Cholesky, QR and singular value decompositions of a matrix
+ */
+
+#ifndef factorization_h
+#define factorization_h
+
+#include <stdio.h>
+#include "veneer.h"
+#include "matrix.h"
+
+/* -------------------------------------------------------
+ * Factorization objects
+ * ------------------------------------------------------- */
+
+extern objecttype objectfactorizationtype;
+#define OBJECT_FACTORIZATION objectfactorizationtype
+
+typedef enum { FACTORIZATION_LU, FACTORIZATION_CHOLESKY, FACTORIZATION_QR, FACTORIZATION_SVD } factorizationkind;
+
+/** Number of rank-one updates that are folded into solves before the matrix is factorized afresh */
+#define FACTORIZATION_MAXUPDATES 16
+
+/** Factorizations hold a decomposition of a matrix so that it can be reused for any number of solves.
+    Rank-one updates A -> A + u v^T are applied to the Cholesky factor directly; other factorizations
+    keep the decomposition of the original matrix and apply the updates during each solve using the
+    Sherman-Morrison formula, refactorizing once FACTORIZATION_MAXUPDATES have accumulated. */
+typedef struct {
+    object obj;
+    factorizationkind kind;
+    int nrows;
+    int ncols;
+    double *a; /** The matrix, including any rank-one updates */
+    double *factors; /** LU: L and U; Cholesky: L; QR: R and the Householder reflectors; SVD: U */
+    int *pivot; /** LU: row interchanges */
+    double *tau; /** QR: scale factors of the reflectors; SVD: singular values */
+    double *vt; /** SVD: transpose of V */
+    int nupdates; /** Number of updates pending since the matrix was last factorized */
+    double *updates; /** For each pending update j, z_j = A_{j-1}^{-1} u_j, v_j and 1 + v_j.z_j */
+} objectfactorization;
+
+/** Tests whether an object is a factorization */
+#define MORPHO_ISFACTORIZATION(val) object_istype(val, OBJECT_FACTORIZATION)
+
+/** Gets the object as a factorization */
+#define MORPHO_GETFACTORIZATION(val)   ((objectfactorization *) MORPHO_GETOBJECT(val))
+
+/** Creates a factorization of a matrix */
+objectfactorization *object_newfactorization(objectmatrix *m, factorizationkind kind, objectmatrixerror *err);
+
+/* -------------------------------------------------------
+ * Factorization class
+ * ------------------------------------------------------- */
+
+#define FACTORIZATION_CLASSNAME "Factorization"
+
+#define FACTORIZATION_LU_METHOD "lu"
+#define FACTORIZATION_CHOLESKY_METHOD "cholesky"
+#define FACTORIZATION_QR_METHOD "qr"
+#define FACTORIZATION_SVD_METHOD "svd"
+
+#define FACTORIZATION_SOLVE_METHOD "solve"
+#define FACTORIZATION_UPDATE_METHOD "update"
+#define FACTORIZATION_DET_METHOD "det"
+#define FACTORIZATION_MATRIX_METHOD "matrix"
+#define FACTORIZATION_SINGULARVALUES_METHOD "singularvalues"
+#define FACTORIZATION_RANK_METHOD "rank"
+
+#define FACTORIZATION_NOTPD               "FctrNtPD"
+#define FACTORIZATION_NOTPD_MSG           "Matrix is not positive definite."
+
+#define FACTORIZATION_QRSHAPE             "FctrQRShp"
+#define FACTORIZATION_QRSHAPE_MSG         "QR factorization requires at least as many rows as columns."
+
+#define FACTORIZATION_SOLVEARGS           "FctrSlvArgs"
+#define FACTORIZATION_SOLVEARGS_MSG       "Method solve expects a matrix with as many rows as the factorized matrix."
+
+#define FACTORIZATION_UPDATEARGS          "FctrUpdtArgs"
+#define FACTORIZATION_UPDATEARGS_MSG      "Method update expects one or two vectors with as many elements as the rows of a square factorized matrix; Cholesky factorizations accept only one."
+
+#define FACTORIZATION_METHOD              "FctrMthd"
+#define FACTORIZATION_METHOD_MSG          "Method '%s' is not supported by %s factorizations."
+
+/* -------------------------------------------------------
+ * Factorization interface
+ * ------------------------------------------------------- */
+
+objectmatrixerror factorization_solve(objectfactorization *f, objectmatrix *b, objectmatrix *x);
+objectmatrixerror factorization_update(objectfactorization *f, double *u, double *v);
+
+value Matrix_lu(vm *v, int nargs, value *args);
+value Matrix_cholesky(vm *v, int nargs, value *args);
+value Matrix_qr(vm *v, int nargs, value *args);
+value Matrix_svd(vm *v, int nargs, value *args);
+
+void factorization_initialize(void);
+
+#endif /* factorization_h */
@@ -0,0 +1,167 @@
+/** @file iterator.c
+ *  @author T J Atherton
+ *
+ *  @brief Veneer class over the objectiterator type, which generates the elements of a sequence on demand
+ */
+
+#include <string.h>
+#include "object.h"
+#include "iterator.h"
+#include "morpho.h"
+#include "builtin.h"
+#include "veneer.h"
+#include "common.h"
+
+/* **********************************************************************
+ * Iterator objects
+ * ********************************************************************** */
+
+objecttype objectiteratortype;
+
+/** Function object definitions */
+size_t objectiterator_sizefn(object *obj) {
+    return sizeof(objectiterator)+((objectiterator *) obj)->nwork*sizeof(unsigned int);
+}
+
+void objectiterator_printfn(object *obj) {
+    printf("<Iterator>");
+}
+
+void objectiterator_markfn(object *obj, void *v) {
+    morpho_markvalue(v, ((objectiterator *) obj)->source);
+}
+
+void objectiterator_freefn(object *obj) {
+    objectiterator *it = (objectiterator *) obj;
+    if (it->work) MORPHO_FREE(it->work);
+}
+
+objecttypedefn objectiteratordefn = {
+    .printfn=objectiterator_printfn,
+    .markfn=objectiterator_markfn,
+    .freefn=objectiterator_freefn,
+    .sizefn=objectiterator_sizefn
+};
+
+/** Creates an iterator */
+objectiterator *object_newiterator(value source, unsigned int count, iteratorfn fn, unsigned int param, unsigned int nwork) {
+    objectiterator *new = (objectiterator *) object_new(sizeof(objectiterator), OBJECT_ITERATOR);
+
+    if (new) {
+        new->source=source;
+        new->count=count;
+        new->fn=fn;
+        new->indx=-1;
+        new->param=param;
+        dictionary_cursorinit(&new->cursor);
+        new->nwork=nwork;
+        new->work=NULL;
+
+        if (nwork) {
+            new->work=MORPHO_MALLOC(nwork*sizeof(unsigned int));
+            if (!new->work) {
+                object_free((object *) new);
+                return NULL;
+            }
+        }
+    }
+
+    return new;
+}
+
+/* **********************************************************************
+ * Iterator operations
+ * ********************************************************************* */
+
+/** Creates an iterator and binds it to the VM, raising an error on failure */
+value iterator_new(vm *v, value source, unsigned int count, iteratorfn fn, unsigned int param, unsigned int nwork) {
+    value out=MORPHO_NIL;
+    objectiterator *new=object_newiterator(source, count, fn, param, nwork);
+
+    if (new) {
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+
+    return out;
+}
+
+/** Generates the i'th element of an iterator */
+bool iterator_element(vm *v, objectiterator *it, unsigned int i, value *out) {
+    if (i>=it->count || !(it->fn) (v, it, i, out)) return false;
+    it->indx=i;
+    return true;
+}
+
+/* **********************************************************************
+ * Iterator veneer class
+ * ********************************************************************* */
+
+/** Enumerate protocol */
+value Iterator_enumerate(vm *v, int nargs, value *args) {
+    objectiterator *slf = MORPHO_GETITERATOR(MORPHO_SELF(args));
+    value out=MORPHO_NIL;
+
+    if (nargs==1 && MORPHO_ISINTEGER(MORPHO_GETARG(args, 0))) {
+        int i=MORPHO_GETINTEGERVALUE(MORPHO_GETARG(args, 0));
+
+        if (i<0) out=MORPHO_INTEGER(slf->count);
+        else if (i>=slf->count) morpho_runtimeerror(v, VM_OUTOFBOUNDS);
+        else iterator_element(v, slf, i, &out); // Leaves nil if the source no longer has the element
+    } else MORPHO_RAISE(v, ENUMERATE_ARGS);
+
+    return out;
+}
+
+/** Number of elements */
+value Iterator_count(vm *v, int nargs, value *args) {
+    return MORPHO_INTEGER(MORPHO_GETITERATOR(MORPHO_SELF(args))->count);
+}
+
+/** Generates every element and collects them in a List */
+value Iterator_tolist(vm *v, int nargs, value *args) {
+    objectiterator *slf = MORPHO_GETITERATOR(MORPHO_SELF(args));
+    objectlist *new = object_newlist(0, NULL);
+    value out=MORPHO_NIL;
+
+    if (!new || !list_resize(new, slf->count)) {
+        if (new) object_free((object *) new);
+        MORPHO_RAISE(v, ERROR_ALLOCATIONFAILED);
+    }
+
+    out=MORPHO_OBJECT(new);
+    morpho_bindobjects(v, 1, &out);
+    int handle=morpho_retainobjects(v, 1, &out); // Elements may be collected as they are generated otherwise
+
+    for (unsigned int i=0; i<slf->count; i++) {
+        value el;
+        if (!iterator_element(v, slf, i, &el)) break;
+        list_append(new, el);
+    }
+
+    morpho_releaseobjects(v, handle);
+
+    return out;
+}
+
+MORPHO_BEGINCLASS(Iterator)
+MORPHO_METHOD(MORPHO_ENUMERATE_METHOD, Iterator_enumerate, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_COUNT_METHOD, Iterator_count, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(ITERATOR_TOLIST_METHOD, Iterator_tolist, BUILTIN_FLAGSEMPTY)
+MORPHO_ENDCLASS
+
+/* **********************************************************************
+ * Initialization
+ * ********************************************************************* */
+
+void iterator_initialize(void) {
+    objectiteratortype=object_addtype(&objectiteratordefn);
+
+    objectstring objname = MORPHO_STATICSTRING(OBJECT_CLASSNAME);
+    value objclass = builtin_findclass(MORPHO_OBJECT(&objname));
+
+    value iteratorclass=builtin_addclass(ITERATOR_CLASSNAME, MORPHO_GETCLASSDEFINITION(Iterator), objclass);
+    object_setveneerclass(OBJECT_ITERATOR, iteratorclass);
+
+    morpho_defineerror(ITERATOR_TOOLONG, ERROR_HALT, ITERATOR_TOOLONG_MSG);
+}
@@ -0,0 +1,71 @@
+/** @file iterator.h
+ *  @author T J Atherton
+ *
+ *  @brief Veneer class over the objectiterator type, which generates the elements of a sequence on demand
+ */
+
+#ifndef iterator_h
+#define iterator_h
+
+#include <stdio.h>
+#include "veneer.h"
+
+/* -------------------------------------------------------
+ * Iterator objects
+ * ------------------------------------------------------- */
+
+extern objecttype objectiteratortype;
+#define OBJECT_ITERATOR objectiteratortype
+
+typedef struct sobjectiterator objectiterator;
+
+/** Generates the i'th element of an iterator, returning false if there is no such element. Elements are
+    usually requested in order, so implementations may keep a cursor in the iterator and resume from it
+    when i follows the element last produced, it->indx. */
+typedef bool (*iteratorfn) (vm *v, objectiterator *it, unsigned int i, value *out);
+
+/** Iterators stand in for a collection that would otherwise be built in full before being looped over.
+    They follow the enumerate protocol, so for..in loops visit them without further support, but each
+    element is produced only when it is requested. */
+struct sobjectiterator {
+    object obj;
+    value source; /** The object the elements are generated from, which is kept alive by the iterator */
+    unsigned int count; /** Number of elements */
+    iteratorfn fn; /** Generates an element */
+    int indx; /** Index of the element last produced, or -1 */
+    unsigned int param; /** Parameter for fn, e.g. a grade or tuple length */
+    dictionarycursor cursor; /** Cursor for iterators that step through a dictionary */
+    unsigned int nwork; /** Size of the workspace */
+    unsigned int *work; /** Workspace for fn, or NULL */
+};
+
+/** Tests whether an object is an iterator */
+#define MORPHO_ISITERATOR(val) object_istype(val, OBJECT_ITERATOR)
+
+/** Gets the object as an iterator */
+#define MORPHO_GETITERATOR(val)   ((objectiterator *) MORPHO_GETOBJECT(val))
+
+/** Creates an iterator */
+objectiterator *object_newiterator(value source, unsigned int count, iteratorfn fn, unsigned int param, unsigned int nwork);
+
+/* -------------------------------------------------------
+ * Iterator class
+ * ------------------------------------------------------- */
+
+#define ITERATOR_CLASSNAME "Iterator"
+
+#define ITERATOR_TOLIST_METHOD "tolist"
+
+#define ITERATOR_TOOLONG                  "IterTooLng"
+#define ITERATOR_TOOLONG_MSG              "Iterator would have too many elements."
+
+/* -------------------------------------------------------
+ * Iterator interface
+ * ------------------------------------------------------- */
+
+value iterator_new(vm *v, value source, unsigned int count, iteratorfn fn, unsigned int param, unsigned int nwork);
+bool iterator_element(vm *v, objectiterator *it, unsigned int i, value *out);
+
+void iterator_initialize(void);
+
+#endif /* iterator_h */
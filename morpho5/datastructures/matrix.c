@@ -5,9 +5,15 @@
  */
 
 #include <string.h>
+#include <float.h>
 #include "object.h"
 #include "matrix.h"
 #include "sparse.h"
+#include "factorization.h"
+#include "matrixf.h"
+#include "complexmatrix.h"
+#include "symmatrix.h"
+#include "bandmatrix.h"
 #include "morpho.h"
 #include "builtin.h"
 #include "veneer.h"
@@ -21,6 +27,7 @@ objecttype objectmatrixtype;
 
 /** Function object definitions */
 size_t objectmatrix_sizefn(object *obj) {
+    if (MATRIX_ISVIEW((objectmatrix *) obj)) return sizeof(objectmatrix);
     return sizeof(objectmatrix)+sizeof(double) *
             ((objectmatrix *) obj)->ncols *
             ((objectmatrix *) obj)->nrows;
@@ -30,9 +37,15 @@ void objectmatrix_printfn(object *obj) {
     printf("<Matrix>");
 }
 
+/** A view keeps the matrix that owns its elements alive */
+void objectmatrix_markfn(object *obj, void *v) {
+    objectmatrix *m = (objectmatrix *) obj;
+    if (m->parent) morpho_markobject(v, m->parent);
+}
+
 objecttypedefn objectmatrixdefn = {
     .printfn=objectmatrix_printfn,
-    .markfn=NULL,
+    .markfn=objectmatrix_markfn,
     .freefn=NULL,
     .sizefn=objectmatrix_sizefn
 };
@@ -46,6 +59,7 @@ objectmatrix *object_newmatrix(unsigned int nrows, unsigned int ncols, bool zero
         new->ncols=ncols;
         new->nrows=nrows;
         new->elements=new->matrixdata;
+        new->parent=NULL;
         if (zero) {
             memset(new->elements, 0, sizeof(double)*nel);
         }
@@ -236,6 +250,30 @@ objectmatrix *object_clonematrix(objectmatrix *in) {
     return new;
 }
 
+/** Creates a view onto a block of the elements of an existing matrix
+ * @param[in] parent - matrix to view
+ * @param[in] offset - offset of the first element of the view into the parent's elements
+ * @param[in] nrows - number of rows of the view
+ * @param[in] ncols - number of columns of the view
+ * @returns the view, or NULL if the block lies outside the parent or allocation failed
+ * @warning A view of a matrix not managed by the garbage collector, such as a mesh's vertex matrix,
+ *          is only valid while its owner survives */
+objectmatrix *object_newmatrixview(objectmatrix *parent, unsigned int offset, unsigned int nrows, unsigned int ncols) {
+    if (offset+nrows*ncols>parent->nrows*parent->ncols) return NULL;
+    
+    objectmatrix *new = (objectmatrix *) object_new(sizeof(objectmatrix), OBJECT_MATRIX);
+    
+    if (new) {
+        new->nrows=nrows;
+        new->ncols=ncols;
+        new->elements=parent->elements+offset;
+        // Views of views refer directly to the owner of the elements
+        new->parent=(parent->parent ? parent->parent : (object *) parent);
+    }
+    
+    return new;
+}
+
 /* **********************************************************************
  * Matrix operations
  * ********************************************************************* */
@@ -300,6 +338,314 @@ bool matrix_addtocolumn(objectmatrix *m, unsigned int col, double alpha, double
     return false;
 }
 
+/* **********************************************************************
+ * Tiny matrix kernels
+ * ********************************************************************* */
+
+/** Factorizes a tiny n x n column-major matrix in place as P.a = L.U, using partial pivoting exactly as LAPACK's dgetrf does
+ * @param[in] n - dimension, at most MATRIX_TINYDIM
+ * @param[in|out] lu - the matrix on entry; L (with unit diagonal, not stored) and U on exit
+ * @param[out] pivot - row interchanged with row i at step i
+ * @param[out] sign - (optional) sign of the permutation
+ * @returns false if the matrix is singular */
+static bool matrix_tinylu(int n, double *lu, int *pivot, double *sign) {
+    double s=1.0;
+    
+    for (int k=0; k<n; k++) {
+        int p=k;
+        for (int i=k+1; i<n; i++) if (fabs(lu[i+k*n])>fabs(lu[p+k*n])) p=i;
+        pivot[k]=p;
+        if (lu[p+k*n]==0.0) return false;
+        
+        if (p!=k) {
+            for (int j=0; j<n; j++) {
+                double t=lu[k+j*n]; lu[k+j*n]=lu[p+j*n]; lu[p+j*n]=t;
+            }
+            s=-s;
+        }
+        
+        for (int i=k+1; i<n; i++) {
+            double l=(lu[i+k*n]/=lu[k+k*n]);
+            for (int j=k+1; j<n; j++) lu[i+j*n]-=l*lu[k+j*n];
+        }
+    }
+    
+    if (sign) *sign=s;
+    return true;
+}
+
+/** Solves a.x = b in place given the factorization from matrix_tinylu
+ * @param[in] n - dimension
+ * @param[in] lu - factorized matrix
+ * @param[in] pivot - pivots
+ * @param[in] nrhs - number of right hand sides
+ * @param[in|out] b - n x nrhs column-major right hand sides on entry; the solutions on exit */
+static void matrix_tinylusolve(int n, double *lu, int *pivot, int nrhs, double *b) {
+    for (int c=0; c<nrhs; c++) {
+        double *x = b+c*n;
+        for (int k=0; k<n; k++) if (pivot[k]!=k) {
+            double t=x[k]; x[k]=x[pivot[k]]; x[pivot[k]]=t;
+        }
+        for (int i=1; i<n; i++) for (int j=0; j<i; j++) x[i]-=lu[i+j*n]*x[j];
+        for (int i=n-1; i>=0; i--) {
+            for (int j=i+1; j<n; j++) x[i]-=lu[i+j*n]*x[j];
+            x[i]/=lu[i+i*n];
+        }
+    }
+}
+
+/** Determinant of a tiny square matrix, closed form up to 3x3 */
+static double matrix_tinydet(int n, double *a) {
+    switch (n) {
+        case 1: return a[0];
+        case 2: return a[0]*a[3]-a[2]*a[1];
+        case 3: return a[0]*(a[4]*a[8]-a[7]*a[5])
+                      -a[3]*(a[1]*a[8]-a[7]*a[2])
+                      +a[6]*(a[1]*a[5]-a[4]*a[2]);
+        default: {
+            double lu[n*n], sign, det;
+            int pivot[n];
+            for (int i=0; i<n*n; i++) lu[i]=a[i];
+            if (!matrix_tinylu(n, lu, pivot, &sign)) return 0.0;
+            det=sign;
+            for (int i=0; i<n; i++) det*=lu[i*(n+1)];
+            return det;
+        }
+    }
+}
+
+/** Inverts a tiny square matrix a into out, which must not alias a; closed form up to 3x3 */
+static objectmatrixerror matrix_tinyinverse(int n, double *a, double *out) {
+    if (n<=3) {
+        double det=matrix_tinydet(n, a);
+        if (det==0.0) return MATRIX_SING;
+        double r=1.0/det;
+        
+        switch (n) {
+            case 1: out[0]=r; break;
+            case 2:
+                out[0]=a[3]*r; out[2]=-a[2]*r;
+                out[1]=-a[1]*r; out[3]=a[0]*r;
+                break;
+            case 3:
+                out[0]=(a[4]*a[8]-a[7]*a[5])*r;
+                out[3]=(a[6]*a[5]-a[3]*a[8])*r;
+                out[6]=(a[3]*a[7]-a[6]*a[4])*r;
+                out[1]=(a[7]*a[2]-a[1]*a[8])*r;
+                out[4]=(a[0]*a[8]-a[6]*a[2])*r;
+                out[7]=(a[6]*a[1]-a[0]*a[7])*r;
+                out[2]=(a[1]*a[5]-a[4]*a[2])*r;
+                out[5]=(a[3]*a[2]-a[0]*a[5])*r;
+                out[8]=(a[0]*a[4]-a[3]*a[1])*r;
+                break;
+        }
+    } else {
+        double lu[n*n];
+        int pivot[n];
+        for (int i=0; i<n*n; i++) lu[i]=a[i];
+        if (!matrix_tinylu(n, lu, pivot, NULL)) return MATRIX_SING;
+        for (int j=0; j<n; j++) for (int i=0; i<n; i++) out[i+j*n]=(i==j ? 1.0 : 0.0);
+        matrix_tinylusolve(n, lu, pivot, n, out);
+    }
+    return MATRIX_OK;
+}
+
+/* **********************************************************************
+ * Parallel kernels
+ * ********************************************************************* */
+
+/** Large matrices are divided into contiguous ranges of elements, or of columns, that are processed by the
+ *  workers of a dedicated threadpool. These kernels do not call BLAS, so that the results do not depend on
+ *  which implementation is linked; reductions are compensated so that dividing a sum between threads does not
+ *  lose accuracy. */
+static threadpool matrix_pool;
+static bool matrix_poolactive=false;
+
+/** Counts the tasks of one call to matrix_parallel that are still to complete, so that the caller waits only for
+ *  its own tasks rather than for everything queued on the shared pool */
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t done; /* Signalled when the last task completes */
+    int remaining;
+} matrix_batch;
+
+typedef struct {
+    unsigned int start, end; /* Range of elements or columns to process */
+    double alpha, lambda; /* Coefficients */
+    double *x, *y, *out; /* Operands of elementwise kernels and reductions */
+    objectmatrix *a, *b, *c; /* Operands of transposes and products */
+    double sum, comp; /* Partial result of a reduction and its compensation */
+    workfn fn; /* Kernel to run on the range */
+    matrix_batch *batch; /* Batch the task belongs to */
+    _MORPHO_PADDING;
+} matrix_task;
+
+/** Decides how many tasks n units of work should be divided into, given that each should do at least min units
+ * @returns the number of tasks, or 0 if the work should be done serially */
+static int matrix_ntasks(size_t n, size_t min) {
+    if (!matrix_poolactive || n<2*min) return 0;
+    size_t ntask=morpho_threadnumber();
+    if (ntask>n/min) ntask=n/min;
+    return (ntask>1 ? (int) ntask : 0);
+}
+
+/** Runs the kernel of a task and marks it complete in its batch */
+static bool matrix_runtask(void *arg) {
+    matrix_task *task = (matrix_task *) arg;
+    matrix_batch *batch = task->batch;
+    bool success=(task->fn) (arg);
+
+    pthread_mutex_lock(&batch->lock);
+    if (--batch->remaining==0) pthread_cond_signal(&batch->done);
+    pthread_mutex_unlock(&batch->lock);
+    return success;
+}
+
+/** Divides n units of work into ntask ranges whose boundaries are multiples of align, initializes each task from a
+ *  template and runs fn on them in the matrix threadpool, returning once all of these tasks are complete */
+static void matrix_parallel(int ntask, unsigned int n, unsigned int align, workfn fn, matrix_task *tmpl, matrix_task *tasks) {
+    matrix_batch batch = { .remaining = ntask };
+    pthread_mutex_init(&batch.lock, NULL);
+    pthread_cond_init(&batch.done, NULL);
+
+    for (int i=0; i<ntask; i++) {
+        tasks[i]=*tmpl;
+        tasks[i].start=(unsigned int) ((((size_t) n*i)/ntask)/align*align);
+        tasks[i].end=(i==ntask-1 ? n : (unsigned int) ((((size_t) n*(i+1))/ntask)/align*align));
+        tasks[i].fn=fn;
+        tasks[i].batch=&batch;
+        if (!threadpool_add_task(&matrix_pool, matrix_runtask, (void *) &tasks[i])) matrix_runtask(&tasks[i]);
+    }
+
+    pthread_mutex_lock(&batch.lock);
+    while (batch.remaining>0) pthread_cond_wait(&batch.done, &batch.lock);
+    pthread_mutex_unlock(&batch.lock);
+
+    pthread_mutex_destroy(&batch.lock);
+    pthread_cond_destroy(&batch.done);
+}
+
+/** Combines the compensated partial sums of a reduction in task order */
+static double matrix_parallelsum(int ntask, matrix_task *tasks) {
+    double sum=0.0, c=0.0, y, t;
+    for (int i=0; i<ntask; i++) {
+        y=tasks[i].sum-tasks[i].comp-c;
+        t=sum+y;
+        c=(t-sum)-y;
+        sum=t;
+    }
+    return sum;
+}
+
+/** Computes alpha*x + lambda*y -> out over a range of elements; y may be NULL */
+static bool matrix_axpbyworker(void *arg) {
+    matrix_task *task = (matrix_task *) arg;
+    double alpha=task->alpha, lambda=task->lambda, *x=task->x, *y=task->y, *out=task->out;
+    
+    if (y) {
+        for (unsigned int i=task->start; i<task->end; i++) out[i]=alpha*x[i]+lambda*y[i];
+    } else {
+        for (unsigned int i=task->start; i<task->end; i++) out[i]=alpha*x[i];
+    }
+    return true;
+}
+
+/** Computes alpha*x + lambda*y -> out for arrays of n elements, dividing the work between threads
+ * @returns true if the operation was performed, false if it is too small to parallelize */
+static bool matrix_parallelaxpby(unsigned int n, double alpha, double *x, double lambda, double *y, double *out) {
+    int ntask=matrix_ntasks(n, MATRIX_PARALLELSIZE/2);
+    if (!ntask) return false;
+    
+    matrix_task tmpl = { .alpha=alpha, .lambda=lambda, .x=x, .y=y, .out=out }, tasks[ntask];
+    matrix_parallel(ntask, n, MATRIX_BLOCKSIZE, matrix_axpbyworker, &tmpl, tasks);
+    return true;
+}
+
+/** Kahan summation of x, or of the elementwise product of x and y if y is provided, over a range of elements */
+static bool matrix_sumworker(void *arg) {
+    matrix_task *task = (matrix_task *) arg;
+    double *x=task->x, *y=task->y;
+    double sum=0.0, c=0.0, v, t;
+    
+    for (unsigned int i=task->start; i<task->end; i++) {
+        v=(y ? x[i]*y[i] : x[i])-c;
+        t=sum+v;
+        c=(t-sum)-v;
+        sum=t;
+    }
+    task->sum=sum;
+    task->comp=c;
+    return true;
+}
+
+/** Sums the elements of x, or the elementwise product of x and y if y is provided, dividing the work between threads
+ * @returns true if the sum was computed, false if it is too small to parallelize */
+static bool matrix_parallelreduce(unsigned int n, double *x, double *y, double *out) {
+    int ntask=matrix_ntasks(n, MATRIX_PARALLELSIZE/2);
+    if (!ntask) return false;
+    
+    matrix_task tmpl = { .x=x, .y=y }, tasks[ntask];
+    matrix_parallel(ntask, n, MATRIX_BLOCKSIZE, matrix_sumworker, &tmpl, tasks);
+    *out=matrix_parallelsum(ntask, tasks);
+    return true;
+}
+
+/** Transposes a range of columns of a into c, working on square blocks so that both are accessed in cache-sized pieces */
+static bool matrix_transposeworker(void *arg) {
+    matrix_task *task = (matrix_task *) arg;
+    unsigned int nrows=task->a->nrows, ncols=task->a->ncols;
+    double *a=task->a->elements, *c=task->c->elements;
+    
+    for (unsigned int jj=task->start; jj<task->end; jj+=MATRIX_BLOCKSIZE) {
+        unsigned int jmax=(jj+MATRIX_BLOCKSIZE<task->end ? jj+MATRIX_BLOCKSIZE : task->end);
+        for (unsigned int ii=0; ii<nrows; ii+=MATRIX_BLOCKSIZE) {
+            unsigned int imax=(ii+MATRIX_BLOCKSIZE<nrows ? ii+MATRIX_BLOCKSIZE : nrows);
+            for (unsigned int j=jj; j<jmax; j++) {
+                for (unsigned int i=ii; i<imax; i++) c[j+i*ncols]=a[i+j*nrows];
+            }
+        }
+    }
+    return true;
+}
+
+/** Computes a range of columns of the product c = a*b. The rows of a and the inner dimension are blocked so that
+ *  the block of a in use stays in cache while it is applied to every column in the range; the innermost loop is a
+ *  contiguous update of a column of c, which the compiler vectorizes. */
+static bool matrix_gemmworker(void *arg) {
+    matrix_task *task = (matrix_task *) arg;
+    unsigned int m=task->a->nrows, k=task->a->ncols;
+    double *a=task->a->elements, *b=task->b->elements, *c=task->c->elements;
+    const unsigned int iblock=4*MATRIX_BLOCKSIZE;
+    
+    for (unsigned int j=task->start; j<task->end; j++) memset(c+j*m, 0, sizeof(double)*m);
+    
+    for (unsigned int ii=0; ii<m; ii+=iblock) {
+        unsigned int imax=(ii+iblock<m ? ii+iblock : m);
+        for (unsigned int ll=0; ll<k; ll+=MATRIX_BLOCKSIZE) {
+            unsigned int lmax=(ll+MATRIX_BLOCKSIZE<k ? ll+MATRIX_BLOCKSIZE : k);
+            for (unsigned int j=task->start; j<task->end; j++) {
+                double *cj=c+j*m;
+                for (unsigned int l=ll; l<lmax; l++) {
+                    double blj=b[l+j*k], *al=a+l*m;
+                    for (unsigned int i=ii; i<imax; i++) cj[i]+=al[i]*blj;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/** Initializes the matrix threadpool if morpho has been asked to use worker threads */
+static void matrix_initializepool(void) {
+    matrix_poolactive=threadpool_init(&matrix_pool, morpho_threadnumber());
+}
+
+/** Shuts down the matrix threadpool */
+void matrix_finalize(void) {
+    if (matrix_poolactive) threadpool_clear(&matrix_pool);
+    matrix_poolactive=false;
+}
+
 /* **********************************************************************
  * Matrix arithmetic
  * ********************************************************************* */
@@ -307,7 +653,9 @@ bool matrix_addtocolumn(objectmatrix *m, unsigned int col, double alpha, double
 /** Copies one matrix to another */
 objectmatrixerror matrix_copy(objectmatrix *a, objectmatrix *out) {
     if (a->ncols==out->ncols && a->nrows==out->nrows) {
-        cblas_dcopy(a->ncols * a->nrows, a->elements, 1, out->elements, 1);
+        if (MATRIX_ISTINY(a)) {
+            for (unsigned int i=0; i<a->nrows*a->ncols; i++) out->elements[i]=a->elements[i];
+        } else cblas_dcopy(a->ncols * a->nrows, a->elements, 1, out->elements, 1);
         return MATRIX_OK;
     }
     return MATRIX_INCMPTBLDIM;
@@ -333,6 +681,11 @@ objectmatrixerror matrix_copyat(objectmatrix *a, objectmatrix *out, int row0, in
 objectmatrixerror matrix_add(objectmatrix *a, objectmatrix *b, objectmatrix *out) {
     if (a->ncols==b->ncols && a->ncols==out->ncols &&
         a->nrows==b->nrows && a->nrows==out->nrows) {
+        if (MATRIX_ISTINY(a)) {
+            for (unsigned int i=0; i<a->nrows*a->ncols; i++) out->elements[i]=a->elements[i]+b->elements[i];
+            return MATRIX_OK;
+        }
+        if (matrix_parallelaxpby(a->ncols * a->nrows, 1.0, a->elements, 1.0, b->elements, out->elements)) return MATRIX_OK;
         if (a!=out) cblas_dcopy(a->ncols * a->nrows, a->elements, 1, out->elements, 1);
         cblas_daxpy(a->ncols * a->nrows, 1.0, b->elements, 1, out->elements, 1);
         return MATRIX_OK;
@@ -355,16 +708,69 @@ objectmatrixerror matrix_addscalar(objectmatrix *a, double lambda, double beta,
 /** Performs a + lambda*b -> a. */
 objectmatrixerror matrix_accumulate(objectmatrix *a, double lambda, objectmatrix *b) {
     if (a->ncols==b->ncols && a->nrows==b->nrows ) {
-        cblas_daxpy(a->ncols * a->nrows, lambda, b->elements, 1, a->elements, 1);
+        if (MATRIX_ISTINY(a)) {
+            for (unsigned int i=0; i<a->nrows*a->ncols; i++) a->elements[i]+=lambda*b->elements[i];
+        } else if (!matrix_parallelaxpby(a->ncols * a->nrows, 1.0, a->elements, lambda, b->elements, a->elements)) cblas_daxpy(a->ncols * a->nrows, lambda, b->elements, 1, a->elements, 1);
         return MATRIX_OK;
     }
     return MATRIX_INCMPTBLDIM;
 }
 
+/** Performs alpha*a + sum_k lambda[k]*b[k] -> a in a single pass over memory, so that a linear
+ *  combination of several matrices needs neither temporaries nor repeated traversals
+ * @param[in|out] a - matrix to update; any of the b[k] may be a itself
+ * @param[in] alpha - scale applied to a
+ * @param[in] n - number of terms
+ * @param[in] lambda - coefficient of each term
+ * @param[in] b - matrices of the same shape as a
+ * @returns MATRIX_OK or MATRIX_INCMPTBLDIM if the shapes differ */
+objectmatrixerror matrix_combine(objectmatrix *a, double alpha, unsigned int n, double *lambda, objectmatrix **b) {
+    for (unsigned int k=0; k<n; k++) if (a->ncols!=b[k]->ncols || a->nrows!=b[k]->nrows) return MATRIX_INCMPTBLDIM;
+    
+    unsigned int nel=a->nrows*a->ncols;
+    double *x=a->elements;
+    
+    /* The common cases are unrolled so the compiler can vectorize each as a simple loop */
+    switch (n) {
+        case 0:
+            for (unsigned int i=0; i<nel; i++) x[i]*=alpha;
+            break;
+        case 1: {
+            double l0=lambda[0], *y0=b[0]->elements;
+            for (unsigned int i=0; i<nel; i++) x[i]=alpha*x[i]+l0*y0[i];
+        }
+            break;
+        case 2: {
+            double l0=lambda[0], l1=lambda[1], *y0=b[0]->elements, *y1=b[1]->elements;
+            for (unsigned int i=0; i<nel; i++) x[i]=alpha*x[i]+l0*y0[i]+l1*y1[i];
+        }
+            break;
+        case 3: {
+            double l0=lambda[0], l1=lambda[1], l2=lambda[2];
+            double *y0=b[0]->elements, *y1=b[1]->elements, *y2=b[2]->elements;
+            for (unsigned int i=0; i<nel; i++) x[i]=alpha*x[i]+l0*y0[i]+l1*y1[i]+l2*y2[i];
+        }
+            break;
+        default:
+            for (unsigned int i=0; i<nel; i++) {
+                double sum=alpha*x[i];
+                for (unsigned int k=0; k<n; k++) sum+=lambda[k]*b[k]->elements[i];
+                x[i]=sum;
+            }
+    }
+    
+    return MATRIX_OK;
+}
+
 /** Performs a - b -> out */
 objectmatrixerror matrix_sub(objectmatrix *a, objectmatrix *b, objectmatrix *out) {
     if (a->ncols==b->ncols && a->ncols==out->ncols &&
         a->nrows==b->nrows && a->nrows==out->nrows) {
+        if (MATRIX_ISTINY(a)) {
+            for (unsigned int i=0; i<a->nrows*a->ncols; i++) out->elements[i]=a->elements[i]-b->elements[i];
+            return MATRIX_OK;
+        }
+        if (matrix_parallelaxpby(a->ncols * a->nrows, 1.0, a->elements, -1.0, b->elements, out->elements)) return MATRIX_OK;
         if (a!=out) cblas_dcopy(a->ncols * a->nrows, a->elements, 1, out->elements, 1);
         cblas_daxpy(a->ncols * a->nrows, -1.0, b->elements, 1, out->elements, 1);
         return MATRIX_OK;
@@ -375,6 +781,25 @@ objectmatrixerror matrix_sub(objectmatrix *a, objectmatrix *b, objectmatrix *out
 /** Performs a * b -> out */
 objectmatrixerror matrix_mul(objectmatrix *a, objectmatrix *b, objectmatrix *out) {
     if (a->ncols==b->nrows && a->nrows==out->nrows && b->ncols==out->ncols) {
+        if (a->nrows<=MATRIX_TINYDIM && a->ncols<=MATRIX_TINYDIM && b->ncols<=MATRIX_TINYDIM &&
+            out!=a && out!=b) {
+            for (unsigned int j=0; j<b->ncols; j++) {
+                for (unsigned int i=0; i<a->nrows; i++) {
+                    double sum=0.0;
+                    for (unsigned int k=0; k<a->ncols; k++) sum+=a->elements[i+k*a->nrows]*b->elements[k+j*b->nrows];
+                    out->elements[i+j*out->nrows]=sum;
+                }
+            }
+            return MATRIX_OK;
+        }
+        
+        int ntask=(out!=a && out!=b ? matrix_ntasks((size_t) a->nrows*a->ncols*b->ncols, MATRIX_PARALLELFLOPS/2) : 0);
+        if (ntask>(int) b->ncols) ntask=b->ncols;
+        if (ntask>1) {
+            matrix_task tmpl = { .a=a, .b=b, .c=out }, tasks[ntask];
+            matrix_parallel(ntask, b->ncols, 1, matrix_gemmworker, &tmpl, tasks);
+            return MATRIX_OK;
+        }
         cblas_dgemm(CblasColMajor, CblasNoTrans, CblasNoTrans, a->nrows, b->ncols, a->ncols, 1.0, a->elements, a->nrows, b->elements, b->nrows, 0.0, out->elements, out->nrows);
         return MATRIX_OK;
     }
@@ -384,6 +809,13 @@ objectmatrixerror matrix_mul(objectmatrix *a, objectmatrix *b, objectmatrix *out
 /** Finds the Frobenius inner product of two matrices  */
 objectmatrixerror matrix_inner(objectmatrix *a, objectmatrix *b, double *out) {
     if (a->ncols==b->ncols && a->nrows==b->nrows) {
+        if (MATRIX_ISTINY(a)) {
+            double sum=0.0;
+            for (unsigned int i=0; i<a->nrows*a->ncols; i++) sum+=a->elements[i]*b->elements[i];
+            *out=sum;
+            return MATRIX_OK;
+        }
+        if (matrix_parallelreduce(a->ncols*a->nrows, a->elements, b->elements, out)) return MATRIX_OK;
         *out=cblas_ddot(a->ncols*a->nrows, a->elements, 1, b->elements, 1);
         return MATRIX_OK;
     }
@@ -420,6 +852,15 @@ objectmatrixerror matrix_divs(objectmatrix *a, objectmatrix *b, objectmatrix *ou
         int pivot[a->nrows];
         double lu[a->nrows*a->ncols];
         
+        if (a->nrows==a->ncols && a->nrows<=MATRIX_TINYDIM) {
+            int n=a->nrows;
+            for (int i=0; i<n*n; i++) lu[i]=a->elements[i];
+            if (b!=out) for (unsigned int i=0; i<b->nrows*b->ncols; i++) out->elements[i]=b->elements[i];
+            if (!matrix_tinylu(n, lu, pivot, NULL)) return MATRIX_SING;
+            matrix_tinylusolve(n, lu, pivot, b->ncols, out->elements);
+            return MATRIX_OK;
+        }
+        
         return matrix_div(a, b, out, lu, pivot);
     }
     return MATRIX_INCMPTBLDIM;
@@ -450,6 +891,8 @@ objectmatrixerror matrix_inverse(objectmatrix *a, objectmatrix *out) {
     int nrows=a->nrows, ncols=a->ncols, info;
     if (!(a->ncols==out->nrows && a->ncols == out->nrows)) return MATRIX_INCMPTBLDIM;
     
+    if (nrows==ncols && nrows<=MATRIX_TINYDIM && a!=out) return matrix_tinyinverse(nrows, a->elements, out->elements);
+    
     int pivot[nrows];
     
     cblas_dcopy(a->ncols * a->nrows, a->elements, 1, out->elements, 1);
@@ -507,6 +950,8 @@ double matrix_sum(objectmatrix *a) {
     unsigned int nel=a->ncols*a->nrows;
     double sum=0.0, c=0.0, y,t;
     
+    if (matrix_parallelreduce(nel, a->elements, NULL, &sum)) return sum;
+    
     for (unsigned int i=0; i<nel; i++) {
         y=a->elements[i]-c;
         t=sum+y;
@@ -520,6 +965,17 @@ double matrix_sum(objectmatrix *a) {
 
 /** Computes the Frobenius norm of a matrix */
 double matrix_norm(objectmatrix *a) {
+    if (MATRIX_ISTINY(a)) {
+        double sum=0.0;
+        for (unsigned int i=0; i<a->nrows*a->ncols; i++) sum+=a->elements[i]*a->elements[i];
+        return sqrt(sum);
+    }
+    
+    /* The parallel sum of squares is unscaled, so fall back to BLAS if it overflows or underflows */
+    double ssq;
+    if (matrix_parallelreduce(a->ncols*a->nrows, a->elements, a->elements, &ssq) &&
+        isfinite(ssq) && ssq>DBL_MIN/DBL_EPSILON) return sqrt(ssq);
+    
     double nrm2=cblas_dnrm2(a->ncols*a->nrows, a->elements, 1);
     return nrm2;
 }
@@ -568,10 +1024,15 @@ double matrix_Linfnorm(objectmatrix *a) {
 objectmatrixerror matrix_transpose(objectmatrix *a, objectmatrix *out) {
     if (!(a->ncols==out->nrows && a->nrows == out->ncols)) return MATRIX_INCMPTBLDIM;
 
-    /* Copy elements a column at a time */
-    for (unsigned int i=0; i<a->ncols; i++) {
-        cblas_dcopy(a->nrows, a->elements+(i*a->nrows), 1, out->elements+i, a->ncols);
-    }
+    matrix_task tmpl = { .start=0, .end=a->ncols, .a=a, .c=out };
+    int ntask=matrix_ntasks((size_t) a->nrows*a->ncols, MATRIX_PARALLELSIZE/2);
+    if (ntask>(int) (a->ncols/MATRIX_BLOCKSIZE)) ntask=a->ncols/MATRIX_BLOCKSIZE;
+    
+    if (ntask>1) {
+        matrix_task tasks[ntask];
+        matrix_parallel(ntask, a->ncols, MATRIX_BLOCKSIZE, matrix_transposeworker, &tmpl, tasks);
+    } else matrix_transposeworker(&tmpl);
+    
     return MATRIX_OK;
 }
 
@@ -586,8 +1047,324 @@ objectmatrixerror matrix_trace(objectmatrix *a, double *out) {
 
 /** Scale a matrix */
 objectmatrixerror matrix_scale(objectmatrix *a, double scale) {
-    cblas_dscal(a->ncols*a->nrows, scale, a->elements, 1);
+    if (MATRIX_ISTINY(a)) {
+        for (unsigned int i=0; i<a->nrows*a->ncols; i++) a->elements[i]*=scale;
+    } else if (!matrix_parallelaxpby(a->ncols*a->nrows, scale, a->elements, 0.0, NULL, a->elements)) cblas_dscal(a->ncols*a->nrows, scale, a->elements, 1);
+    
+    return MATRIX_OK;
+}
+
+/** Calculate the determinant of a matrix */
+objectmatrixerror matrix_det(objectmatrix *a, double *out) {
+    int n=a->nrows, info;
+    if (a->nrows!=a->ncols) return MATRIX_NSQ;
+    
+    if (n<=MATRIX_TINYDIM) {
+        *out=matrix_tinydet(n, a->elements);
+        return MATRIX_OK;
+    }
+    
+    int *pivot=MORPHO_MALLOC(sizeof(int)*n);
+    double *lu=MORPHO_MALLOC(sizeof(double)*n*n);
+    objectmatrixerror ret=MATRIX_ALLOC;
+    
+    if (pivot && lu) {
+        cblas_dcopy(n*n, a->elements, 1, lu, 1);
+#ifdef MORPHO_LINALG_USE_LAPACKE
+        info=LAPACKE_dgetrf(LAPACK_COL_MAJOR, n, n, lu, n, pivot);
+#else
+        dgetrf_(&n, &n, lu, &n, pivot, &info);
+#endif
+        if (info>=0) { // A zero pivot (info>0) simply means the determinant vanishes
+            double det=1.0;
+            for (int i=0; i<n; i++) det*=(pivot[i]!=i+1 ? -lu[i*(n+1)] : lu[i*(n+1)]);
+            *out=det;
+            ret=MATRIX_OK;
+        } else ret=MATRIX_INVLD;
+    }
+    
+    if (pivot) MORPHO_FREE(pivot);
+    if (lu) MORPHO_FREE(lu);
+    
+    return ret;
+}
+
+/** Calculate the cross product of two vectors with three elements; out must not alias a or b */
+objectmatrixerror matrix_cross(objectmatrix *a, objectmatrix *b, objectmatrix *out) {
+    if (a->nrows*a->ncols!=3 || b->nrows*b->ncols!=3 || out->nrows*out->ncols!=3) return MATRIX_INCMPTBLDIM;
+    double *x=a->elements, *y=b->elements;
     
+    out->elements[0]=x[1]*y[2]-x[2]*y[1];
+    out->elements[1]=x[2]*y[0]-x[0]*y[2];
+    out->elements[2]=x[0]*y[1]-x[1]*y[0];
+    
+    return MATRIX_OK;
+}
+
+/* **********************************************************************
+ * Batched kernels
+ * ********************************************************************* */
+
+/** Address of element (i,j) of matrix k in a batch */
+#define MATRIX_BATCHEL(b, k, i, j) ((b)->data+(ptrdiff_t) (k)*(b)->sbatch+(ptrdiff_t) (i)*(b)->srow+(ptrdiff_t) (j)*(b)->scol)
+
+/** Copies matrix k of a batch into a column-major array */
+static void matrix_batchload(matrixbatch *b, unsigned int k, double *dest) {
+    for (unsigned int j=0; j<b->ncols; j++) for (unsigned int i=0; i<b->nrows; i++) dest[i+j*b->nrows]=*MATRIX_BATCHEL(b, k, i, j);
+}
+
+/** Copies a column-major array into matrix k of a batch */
+static void matrix_batchstore(matrixbatch *b, unsigned int k, double *src) {
+    for (unsigned int j=0; j<b->ncols; j++) for (unsigned int i=0; i<b->nrows; i++) *MATRIX_BATCHEL(b, k, i, j)=src[i+j*b->nrows];
+}
+
+/** Multiplies each pair of matrices in two batches, a[k]*b[k] -> out[k]; out must not overlap a or b */
+objectmatrixerror matrix_batchmul(unsigned int n, matrixbatch *a, matrixbatch *b, matrixbatch *out) {
+    if (a->ncols!=b->nrows || out->nrows!=a->nrows || out->ncols!=b->ncols) return MATRIX_INCMPTBLDIM;
+
+    /* The batch index runs innermost so that each step is a simple loop across the batch */
+    for (unsigned int i=0; i<a->nrows; i++) {
+        for (unsigned int j=0; j<b->ncols; j++) {
+            double *o=MATRIX_BATCHEL(out, 0, i, j);
+            ptrdiff_t so=out->sbatch, sa=a->sbatch, sb=b->sbatch;
+
+            for (unsigned int k=0; k<n; k++) o[k*so]=0.0;
+            for (unsigned int l=0; l<a->ncols; l++) {
+                double *x=MATRIX_BATCHEL(a, 0, i, l), *y=MATRIX_BATCHEL(b, 0, l, j);
+                for (unsigned int k=0; k<n; k++) o[k*so]+=x[k*sa]*y[k*sb];
+            }
+        }
+    }
+
+    return MATRIX_OK;
+}
+
+/** Finds the determinant of each matrix in a batch of square matrices
+ * @param[in] n - number of matrices
+ * @param[in] a - the batch
+ * @param[out] out - determinants, stored at stride sout */
+objectmatrixerror matrix_batchdet(unsigned int n, matrixbatch *a, double *out, ptrdiff_t sout) {
+    if (a->nrows!=a->ncols) return MATRIX_NSQ;
+    ptrdiff_t s=a->sbatch;
+
+    switch (a->nrows) {
+        case 1: {
+            double *a00=MATRIX_BATCHEL(a, 0, 0, 0);
+            for (unsigned int k=0; k<n; k++) out[k*sout]=a00[k*s];
+        }
+            break;
+        case 2: {
+            double *a00=MATRIX_BATCHEL(a, 0, 0, 0), *a01=MATRIX_BATCHEL(a, 0, 0, 1),
+                   *a10=MATRIX_BATCHEL(a, 0, 1, 0), *a11=MATRIX_BATCHEL(a, 0, 1, 1);
+            for (unsigned int k=0; k<n; k++) out[k*sout]=a00[k*s]*a11[k*s]-a01[k*s]*a10[k*s];
+        }
+            break;
+        case 3: {
+            double *p[3][3];
+            for (int i=0; i<3; i++) for (int j=0; j<3; j++) p[i][j]=MATRIX_BATCHEL(a, 0, i, j);
+            for (unsigned int k=0; k<n; k++) {
+                out[k*sout]=p[0][0][k*s]*(p[1][1][k*s]*p[2][2][k*s]-p[1][2][k*s]*p[2][1][k*s])
+                           -p[0][1][k*s]*(p[1][0][k*s]*p[2][2][k*s]-p[1][2][k*s]*p[2][0][k*s])
+                           +p[0][2][k*s]*(p[1][0][k*s]*p[2][1][k*s]-p[1][1][k*s]*p[2][0][k*s]);
+            }
+        }
+            break;
+        default: {
+            int d=a->nrows;
+            double *el=MORPHO_MALLOC(sizeof(double)*d*d);
+            if (!el) return MATRIX_ALLOC;
+            objectmatrix m = MORPHO_STATICMATRIX(el, d, d);
+            objectmatrixerror err=MATRIX_OK;
+
+            for (unsigned int k=0; k<n && err==MATRIX_OK; k++) {
+                matrix_batchload(a, k, el);
+                err=matrix_det(&m, out+k*sout);
+            }
+
+            MORPHO_FREE(el);
+            return err;
+        }
+    }
+
+    return MATRIX_OK;
+}
+
+/** Inverts each matrix in a batch of square matrices
+ * @returns MATRIX_SING if any matrix is singular, in which case its inverse is filled with NaN; the other inverses are still found */
+objectmatrixerror matrix_batchinverse(unsigned int n, matrixbatch *a, matrixbatch *out) {
+    if (a->nrows!=a->ncols) return MATRIX_NSQ;
+    if (out->nrows!=a->nrows || out->ncols!=a->ncols) return MATRIX_INCMPTBLDIM;
+    bool singular=false;
+    ptrdiff_t s=a->sbatch, so=out->sbatch;
+
+    switch (a->nrows) {
+        case 2: {
+            double *a00=MATRIX_BATCHEL(a, 0, 0, 0), *a01=MATRIX_BATCHEL(a, 0, 0, 1),
+                   *a10=MATRIX_BATCHEL(a, 0, 1, 0), *a11=MATRIX_BATCHEL(a, 0, 1, 1);
+            double *o00=MATRIX_BATCHEL(out, 0, 0, 0), *o01=MATRIX_BATCHEL(out, 0, 0, 1),
+                   *o10=MATRIX_BATCHEL(out, 0, 1, 0), *o11=MATRIX_BATCHEL(out, 0, 1, 1);
+            for (unsigned int k=0; k<n; k++) {
+                double x00=a00[k*s], x01=a01[k*s], x10=a10[k*s], x11=a11[k*s];
+                double det=x00*x11-x01*x10;
+                singular|=(det==0.0);
+                double r=(det==0.0 ? NAN : 1.0/det);
+                o00[k*so]=x11*r; o01[k*so]=-x01*r;
+                o10[k*so]=-x10*r; o11[k*so]=x00*r;
+            }
+        }
+            break;
+        case 3: {
+            double *p[3][3], *q[3][3];
+            for (int i=0; i<3; i++) for (int j=0; j<3; j++) {
+                p[i][j]=MATRIX_BATCHEL(a, 0, i, j);
+                q[i][j]=MATRIX_BATCHEL(out, 0, i, j);
+            }
+            for (unsigned int k=0; k<n; k++) {
+                double x[3][3];
+                for (int i=0; i<3; i++) for (int j=0; j<3; j++) x[i][j]=p[i][j][k*s];
+
+                double c00=x[1][1]*x[2][2]-x[1][2]*x[2][1],
+                       c01=x[1][2]*x[2][0]-x[1][0]*x[2][2],
+                       c02=x[1][0]*x[2][1]-x[1][1]*x[2][0];
+                double det=x[0][0]*c00+x[0][1]*c01+x[0][2]*c02;
+                singular|=(det==0.0);
+                double r=(det==0.0 ? NAN : 1.0/det);
+
+                q[0][0][k*so]=c00*r;
+                q[1][0][k*so]=c01*r;
+                q[2][0][k*so]=c02*r;
+                q[0][1][k*so]=(x[0][2]*x[2][1]-x[0][1]*x[2][2])*r;
+                q[1][1][k*so]=(x[0][0]*x[2][2]-x[0][2]*x[2][0])*r;
+                q[2][1][k*so]=(x[0][1]*x[2][0]-x[0][0]*x[2][1])*r;
+                q[0][2][k*so]=(x[0][1]*x[1][2]-x[0][2]*x[1][1])*r;
+                q[1][2][k*so]=(x[0][2]*x[1][0]-x[0][0]*x[1][2])*r;
+                q[2][2][k*so]=(x[0][0]*x[1][1]-x[0][1]*x[1][0])*r;
+            }
+        }
+            break;
+        default: {
+            int d=a->nrows;
+            double *el=MORPHO_MALLOC(sizeof(double)*2*d*d);
+            if (!el) return MATRIX_ALLOC;
+            objectmatrix m = MORPHO_STATICMATRIX(el, d, d), inv = MORPHO_STATICMATRIX(el+d*d, d, d);
+
+            for (unsigned int k=0; k<n; k++) {
+                matrix_batchload(a, k, el);
+                objectmatrixerror err=matrix_inverse(&m, &inv);
+                if (err==MATRIX_SING) {
+                    singular=true;
+                    for (int i=0; i<d*d; i++) inv.elements[i]=NAN;
+                } else if (err!=MATRIX_OK) {
+                    MORPHO_FREE(el);
+                    return err;
+                }
+                matrix_batchstore(out, k, inv.elements);
+            }
+
+            MORPHO_FREE(el);
+        }
+    }
+
+    return (singular ? MATRIX_SING : MATRIX_OK);
+}
+
+/** Diagonalizes a symmetric d x d column-major matrix a in place by cyclic Jacobi rotations, accumulating the rotations in v */
+static void matrix_jacobi(int d, double *a, double *v) {
+    for (int i=0; i<d; i++) for (int j=0; j<d; j++) v[i+j*d]=(i==j ? 1.0 : 0.0);
+
+    for (int sweep=0; sweep<50; sweep++) {
+        double off=0.0, diag=0.0;
+        for (int q=0; q<d; q++) {
+            diag+=a[q+q*d]*a[q+q*d];
+            for (int p=0; p<q; p++) off+=a[p+q*d]*a[p+q*d];
+        }
+        if (off<=DBL_EPSILON*DBL_EPSILON*diag || off==0.0) break;
+
+        for (int q=1; q<d; q++) for (int p=0; p<q; p++) {
+            double apq=a[p+q*d];
+            if (apq==0.0) continue;
+
+            double theta=(a[q+q*d]-a[p+p*d])/(2.0*apq);
+            double t=(theta>=0 ? 1.0 : -1.0)/(fabs(theta)+sqrt(theta*theta+1.0));
+            double c=1.0/sqrt(t*t+1.0), s=t*c;
+
+            for (int k=0; k<d; k++) { // Columns p and q
+                double akp=a[k+p*d], akq=a[k+q*d];
+                a[k+p*d]=c*akp-s*akq;
+                a[k+q*d]=s*akp+c*akq;
+            }
+            for (int k=0; k<d; k++) { // Rows p and q
+                double apk=a[p+k*d], aqk=a[q+k*d];
+                a[p+k*d]=c*apk-s*aqk;
+                a[q+k*d]=s*apk+c*aqk;
+            }
+            for (int k=0; k<d; k++) {
+                double vkp=v[k+p*d], vkq=v[k+q*d];
+                v[k+p*d]=c*vkp-s*vkq;
+                v[k+q*d]=s*vkp+c*vkq;
+            }
+            a[p+q*d]=a[q+p*d]=0.0;
+        }
+    }
+}
+
+/** Finds the eigenvalues, and optionally the eigenvectors, of each matrix in a batch of symmetric matrices
+ * @param[in] n - number of matrices
+ * @param[in] a - batch of symmetric d x d matrices; only the lower triangle is read for 2x2 matrices
+ * @param[out] evals - batch of d x 1 matrices that receive the eigenvalues in ascending order
+ * @param[out] evecs - (optional) batch of d x d matrices that receive the corresponding normalized eigenvectors as columns */
+objectmatrixerror matrix_batcheigensym(unsigned int n, matrixbatch *a, matrixbatch *evals, matrixbatch *evecs) {
+    int d=a->nrows;
+    if (a->nrows!=a->ncols) return MATRIX_NSQ;
+    if (evals->nrows*evals->ncols!=d || (evecs && (evecs->nrows!=d || evecs->ncols!=d))) return MATRIX_INCMPTBLDIM;
+    ptrdiff_t s=a->sbatch, se=evals->sbatch;
+
+    if (d==2) {
+        /* Closed form: the eigenvectors are a rotation by half the angle whose tangent is 2b/(a-c) */
+        double *a00=MATRIX_BATCHEL(a, 0, 0, 0), *a10=MATRIX_BATCHEL(a, 0, 1, 0), *a11=MATRIX_BATCHEL(a, 0, 1, 1);
+        double *e0=evals->data, *e1=evals->data+(evals->nrows>1 ? evals->srow : evals->scol);
+        for (unsigned int k=0; k<n; k++) {
+            double x=a00[k*s], b=a10[k*s], c=a11[k*s];
+            double mean=0.5*(x+c), r=sqrt(0.25*(x-c)*(x-c)+b*b);
+            e0[k*se]=mean-r;
+            e1[k*se]=mean+r;
+        }
+        if (evecs) {
+            double *v00=MATRIX_BATCHEL(evecs, 0, 0, 0), *v01=MATRIX_BATCHEL(evecs, 0, 0, 1),
+                   *v10=MATRIX_BATCHEL(evecs, 0, 1, 0), *v11=MATRIX_BATCHEL(evecs, 0, 1, 1);
+            ptrdiff_t sv=evecs->sbatch;
+            for (unsigned int k=0; k<n; k++) {
+                double theta=0.5*atan2(2.0*a10[k*s], a00[k*s]-a11[k*s]), ct=cos(theta), st=sin(theta);
+                v00[k*sv]=-st; v01[k*sv]=ct;
+                v10[k*sv]=ct; v11[k*sv]=st;
+            }
+        }
+        return MATRIX_OK;
+    }
+
+    double *el=MORPHO_MALLOC(sizeof(double)*(2*d*d+d));
+    if (!el) return MATRIX_ALLOC;
+    double *v=el+d*d, *w=v+d*d;
+    int order[d];
+
+    for (unsigned int k=0; k<n; k++) {
+        matrix_batchload(a, k, el);
+        matrix_jacobi(d, el, v);
+
+        // Sort the eigenvalues into ascending order
+        for (int i=0; i<d; i++) order[i]=i;
+        for (int i=1; i<d; i++) for (int j=i; j>0 && el[order[j]*(d+1)]<el[order[j-1]*(d+1)]; j--) {
+            int t=order[j]; order[j]=order[j-1]; order[j-1]=t;
+        }
+
+        for (int i=0; i<d; i++) w[i]=el[order[i]*(d+1)];
+        for (int i=0; i<d; i++) *(evals->data+k*se+i*(evals->nrows>1 ? evals->srow : evals->scol))=w[i];
+        if (evecs) {
+            for (int j=0; j<d; j++) for (int i=0; i<d; i++) *MATRIX_BATCHEL(evecs, k, i, j)=v[i+order[j]*d];
+        }
+    }
+
+    MORPHO_FREE(el);
     return MATRIX_OK;
 }
 
@@ -713,6 +1490,18 @@ value matrix_constructor(vm *v, int nargs, value *args) {
                MORPHO_ISSPARSE(MORPHO_GETARG(args, 0))) {
         objectsparseerror err=sparse_tomatrix(MORPHO_GETSPARSE(MORPHO_GETARG(args, 0)), &new);
         if (err!=SPARSE_OK) morpho_runtimeerror(v, MATRIX_INVLDARRAYINIT);
+    } else if (nargs==1 &&
+               MORPHO_ISMATRIXF(MORPHO_GETARG(args, 0))) {
+        new=object_matrixfrommatrixf(MORPHO_GETMATRIXF(MORPHO_GETARG(args, 0)));
+        if (!new) morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+    } else if (nargs==1 &&
+               MORPHO_ISSYMMATRIX(MORPHO_GETARG(args, 0))) {
+        new=object_matrixfromsymmatrix(MORPHO_GETSYMMATRIX(MORPHO_GETARG(args, 0)));
+        if (!new) morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+    } else if (nargs==1 &&
+               MORPHO_ISBANDMATRIX(MORPHO_GETARG(args, 0))) {
+        new=object_matrixfrombandmatrix(MORPHO_GETBANDMATRIX(MORPHO_GETARG(args, 0)));
+        if (!new) morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
     } else morpho_runtimeerror(v, MATRIX_CONSTRUCTOR);
     
     if (new) {
@@ -844,6 +1633,37 @@ value Matrix_getcolumn(vm *v, int nargs, value *args) {
     return out;
 }
 
+/** Creates a view onto a column or a range of consecutive columns */
+value Matrix_view(vm *v, int nargs, value *args) {
+    objectmatrix *m=MORPHO_GETMATRIX(MORPHO_SELF(args));
+    value out=MORPHO_NIL;
+    int col0=0, ncols=0;
+    
+    if (nargs==1 && MORPHO_ISINTEGER(MORPHO_GETARG(args, 0))) {
+        col0=MORPHO_GETINTEGERVALUE(MORPHO_GETARG(args, 0));
+        ncols=1;
+    } else if (nargs==1 && MORPHO_ISRANGE(MORPHO_GETARG(args, 0))) {
+        objectrange *rng = MORPHO_GETRANGE(MORPHO_GETARG(args, 0));
+        ncols=range_count(rng);
+        if (ncols>0) {
+            value first=range_iterate(rng, 0), last=range_iterate(rng, ncols-1);
+            if (!MORPHO_ISINTEGER(first) || !MORPHO_ISINTEGER(last) ||
+                MORPHO_GETINTEGERVALUE(last)-MORPHO_GETINTEGERVALUE(first)!=ncols-1) MORPHO_RAISE(v, MATRIX_VIEWARGS);
+            col0=MORPHO_GETINTEGERVALUE(first);
+        }
+    } else MORPHO_RAISE(v, MATRIX_VIEWARGS);
+    
+    if (col0<0 || ncols<=0 || col0+ncols>m->ncols) MORPHO_RAISE(v, MATRIX_INDICESOUTSIDEBOUNDS);
+    
+    objectmatrix *new=object_newmatrixview(m, col0*m->nrows, m->nrows, ncols);
+    if (new) {
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+    
+    return out;
+}
+
 /** Prints a matrix */
 value Matrix_print(vm *v, int nargs, value *args) {
     value self = MORPHO_SELF(args);
@@ -893,6 +1713,11 @@ value Matrix_add(vm *v, int nargs, value *args) {
                 matrix_addscalar(a, 1.0, val, new);
             }
         }
+    } else if (nargs==1 && MORPHO_ISCOMPLEXMATRIX(MORPHO_GETARG(args, 0))) {
+        // Returns nil to ensure it gets passed to the right hand method on ComplexMatrix
+    } else if (nargs==1 && (MORPHO_ISSYMMATRIX(MORPHO_GETARG(args, 0)) ||
+                            MORPHO_ISBANDMATRIX(MORPHO_GETARG(args, 0)))) {
+        // Returns nil to ensure it gets passed to the right hand method on SymmetricMatrix or BandMatrix
     } else morpho_runtimeerror(v, MATRIX_ARITHARGS);
     
     if (!MORPHO_ISNIL(out)) morpho_bindobjects(v, 1, &out);
@@ -949,6 +1774,11 @@ value Matrix_sub(vm *v, int nargs, value *args) {
                 matrix_addscalar(a, 1.0, -val, new);
             }
         }
+    } else if (nargs==1 && MORPHO_ISCOMPLEXMATRIX(MORPHO_GETARG(args, 0))) {
+        // Returns nil to ensure it gets passed to the right hand method on ComplexMatrix
+    } else if (nargs==1 && (MORPHO_ISSYMMATRIX(MORPHO_GETARG(args, 0)) ||
+                            MORPHO_ISBANDMATRIX(MORPHO_GETARG(args, 0)))) {
+        // Returns nil to ensure it gets passed to the right hand method on SymmetricMatrix or BandMatrix
     } else morpho_runtimeerror(v, MATRIX_ARITHARGS);
     
     if (!MORPHO_ISNIL(out)) morpho_bindobjects(v, 1, &out);
@@ -1023,6 +1853,11 @@ value Matrix_mul(vm *v, int nargs, value *args) {
         }
     } else if (nargs==1 && MORPHO_ISSPARSE(MORPHO_GETARG(args, 0))) {
         // Returns nil to ensure it gets passed to mulr on Sparse
+    } else if (nargs==1 && MORPHO_ISCOMPLEXMATRIX(MORPHO_GETARG(args, 0))) {
+        // Returns nil to ensure it gets passed to mulr on ComplexMatrix
+    } else if (nargs==1 && (MORPHO_ISSYMMATRIX(MORPHO_GETARG(args, 0)) ||
+                            MORPHO_ISBANDMATRIX(MORPHO_GETARG(args, 0)))) {
+        // Returns nil to ensure it gets passed to mulr on SymmetricMatrix or BandMatrix
     } else morpho_runtimeerror(v, MATRIX_ARITHARGS);
     
     return out;
@@ -1078,6 +1913,11 @@ value Matrix_div(vm *v, int nargs, value *args) {
         /* Division by a sparse matrix: redirect to the divr selector of Sparse. */
         value vargs[2]={args[1],args[0]};
         return Sparse_divr(v, nargs, vargs);
+    } else if (nargs==1 && MORPHO_ISCOMPLEXMATRIX(MORPHO_GETARG(args, 0))) {
+        // Returns nil to ensure it gets passed to divr on ComplexMatrix
+    } else if (nargs==1 && (MORPHO_ISSYMMATRIX(MORPHO_GETARG(args, 0)) ||
+                            MORPHO_ISBANDMATRIX(MORPHO_GETARG(args, 0)))) {
+        // Returns nil to ensure it gets passed to divr on SymmetricMatrix or BandMatrix
     } else if (nargs==1 && MORPHO_ISNUMBER(MORPHO_GETARG(args, 0))) {
         /* Division by a scalar */
         double scale=1.0;
@@ -1111,11 +1951,45 @@ value Matrix_acc(vm *v, int nargs, value *args) {
             morpho_valuetofloat(MORPHO_GETARG(args, 0), &lambda);
             matrix_accumulate(a, lambda, b);
         } else morpho_runtimeerror(v, MATRIX_INCOMPATIBLEMATRICES);
+    } else if (nargs>2 && nargs%2==0) {
+        /* Several terms are accumulated in one pass */
+        double lambda[nargs/2];
+        objectmatrix *b[nargs/2];
+        
+        for (int k=0; k<nargs/2; k++) {
+            if (!morpho_valuetofloat(MORPHO_GETARG(args, 2*k), &lambda[k]) ||
+                !MORPHO_ISMATRIX(MORPHO_GETARG(args, 2*k+1))) MORPHO_RAISE(v, MATRIX_ARITHARGS);
+            b[k]=MORPHO_GETMATRIX(MORPHO_GETARG(args, 2*k+1));
+        }
+        
+        if (matrix_combine(a, 1.0, nargs/2, lambda, b)!=MATRIX_OK) morpho_runtimeerror(v, MATRIX_INCOMPATIBLEMATRICES);
     } else morpho_runtimeerror(v, MATRIX_ARITHARGS);
     
     return MORPHO_NIL;
 }
 
+/** Replaces a matrix in place by a linear combination of itself and other matrices */
+value Matrix_combine(vm *v, int nargs, value *args) {
+    objectmatrix *a=MORPHO_GETMATRIX(MORPHO_SELF(args));
+    double alpha;
+    
+    if (nargs<1 || nargs%2==0 || !morpho_valuetofloat(MORPHO_GETARG(args, 0), &alpha)) MORPHO_RAISE(v, MATRIX_COMBINEARGS);
+    
+    int n=(nargs-1)/2;
+    double lambda[n+1];
+    objectmatrix *b[n+1];
+    
+    for (int k=0; k<n; k++) {
+        if (!morpho_valuetofloat(MORPHO_GETARG(args, 2*k+1), &lambda[k]) ||
+            !MORPHO_ISMATRIX(MORPHO_GETARG(args, 2*k+2))) MORPHO_RAISE(v, MATRIX_COMBINEARGS);
+        b[k]=MORPHO_GETMATRIX(MORPHO_GETARG(args, 2*k+2));
+    }
+    
+    if (matrix_combine(a, alpha, n, lambda, b)!=MATRIX_OK) MORPHO_RAISE(v, MATRIX_INCOMPATIBLEMATRICES);
+    
+    return MORPHO_NIL;
+}
+
 /** Frobenius inner product */
 value Matrix_inner(vm *v, int nargs, value *args) {
     objectmatrix *a=MORPHO_GETMATRIX(MORPHO_SELF(args));
@@ -1231,6 +2105,40 @@ value Matrix_inverse(vm *v, int nargs, value *args) {
     return out;
 }
 
+/** Determinant of a matrix */
+value Matrix_det(vm *v, int nargs, value *args) {
+    objectmatrix *a=MORPHO_GETMATRIX(MORPHO_SELF(args));
+    value out=MORPHO_NIL;
+    double det;
+    
+    objectmatrixerror err=matrix_det(a, &det);
+    if (err==MATRIX_OK) out=MORPHO_FLOAT(det);
+    else matrix_raiseerror(v, err);
+    
+    return out;
+}
+
+/** Cross product of two vectors with three elements */
+value Matrix_cross(vm *v, int nargs, value *args) {
+    objectmatrix *a=MORPHO_GETMATRIX(MORPHO_SELF(args));
+    value out=MORPHO_NIL;
+    
+    if (nargs==1 && MORPHO_ISMATRIX(MORPHO_GETARG(args, 0))) {
+        objectmatrix *b=MORPHO_GETMATRIX(MORPHO_GETARG(args, 0));
+        
+        if (a->nrows*a->ncols==3 && b->nrows*b->ncols==3) {
+            objectmatrix *new = object_newmatrix(a->nrows, a->ncols, false);
+            if (new) {
+                matrix_cross(a, b, new);
+                out=MORPHO_OBJECT(new);
+                morpho_bindobjects(v, 1, &out);
+            } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+        } else morpho_runtimeerror(v, MATRIX_CROSSARGS);
+    } else morpho_runtimeerror(v, MATRIX_CROSSARGS);
+    
+    return out;
+}
+
 /** Transpose of a matrix */
 value Matrix_transpose(vm *v, int nargs, value *args) {
     objectmatrix *a=MORPHO_GETMATRIX(MORPHO_SELF(args));
@@ -1335,10 +2243,33 @@ value Matrix_clone(vm *v, int nargs, value *args) {
     return out;
 }
 
+/** Higher order functions over the columns of a matrix */
+value Matrix_map(vm *v, int nargs, value *args) {
+    return veneer_map(v, MORPHO_SELF(args), nargs, args);
+}
+
+value Matrix_filter(vm *v, int nargs, value *args) {
+    return veneer_filter(v, MORPHO_SELF(args), nargs, args);
+}
+
+value Matrix_reduce(vm *v, int nargs, value *args) {
+    return veneer_reduce(v, MORPHO_SELF(args), nargs, args);
+}
+
+value Matrix_parallelmap(vm *v, int nargs, value *args) {
+    return veneer_parallelmap(v, MORPHO_SELF(args), nargs, args);
+}
+
 MORPHO_BEGINCLASS(Matrix)
 MORPHO_METHOD(MORPHO_GETINDEX_METHOD, Matrix_getindex, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(MORPHO_SETINDEX_METHOD, Matrix_setindex, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(MATRIX_GETCOLUMN_METHOD, Matrix_getcolumn, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MATRIX_VIEW_METHOD, Matrix_view, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MATRIX_COMBINE_METHOD, Matrix_combine, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(FACTORIZATION_LU_METHOD, Matrix_lu, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(FACTORIZATION_CHOLESKY_METHOD, Matrix_cholesky, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(FACTORIZATION_QR_METHOD, Matrix_qr, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(FACTORIZATION_SVD_METHOD, Matrix_svd, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(MATRIX_SETCOLUMN_METHOD, Matrix_setcolumn, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(MORPHO_PRINT_METHOD, Matrix_print, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(MORPHO_ASSIGN_METHOD, Matrix_assign, BUILTIN_FLAGSEMPTY),
@@ -1359,10 +2290,16 @@ MORPHO_METHOD(MATRIX_RESHAPE_METHOD, Matrix_reshape, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(MATRIX_EIGENVALUES_METHOD, Matrix_eigenvalues, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(MATRIX_EIGENSYSTEM_METHOD, Matrix_eigensystem, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(MATRIX_TRACE_METHOD, Matrix_trace, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MATRIX_DET_METHOD, Matrix_det, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MATRIX_CROSS_METHOD, Matrix_cross, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(MORPHO_ENUMERATE_METHOD, Matrix_enumerate, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(MORPHO_COUNT_METHOD, Matrix_count, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(MATRIX_DIMENSIONS_METHOD, Matrix_dimensions, BUILTIN_FLAGSEMPTY),
-MORPHO_METHOD(MORPHO_CLONE_METHOD, Matrix_clone, BUILTIN_FLAGSEMPTY)
+MORPHO_METHOD(MORPHO_CLONE_METHOD, Matrix_clone, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(COLLECTION_MAP_METHOD, Matrix_map, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(COLLECTION_FILTER_METHOD, Matrix_filter, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(COLLECTION_REDUCE_METHOD, Matrix_reduce, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(COLLECTION_PARALLELMAP_METHOD, Matrix_parallelmap, BUILTIN_FLAGSEMPTY)
 MORPHO_ENDCLASS
 
 /* **********************************************************************
@@ -1372,7 +2309,7 @@ MORPHO_ENDCLASS
 void matrix_initialize(void) {
     objectmatrixtype=object_addtype(&objectmatrixdefn);
     
-    builtin_addfunction(MATRIX_CLASSNAME, matrix_constructor, BUILTIN_FLAGSEMPTY);
+    builtin_addfunction(MATRIX_CLASSNAME, matrix_constructor, BUILTIN_FLAGSCONSTRUCTOR);
     
     objectstring objname = MORPHO_STATICSTRING(OBJECT_CLASSNAME);
     value objclass = builtin_findclass(MORPHO_OBJECT(&objname));
@@ -1393,4 +2330,9 @@ void matrix_initialize(void) {
     morpho_defineerror(MATRIX_OPFAILED, ERROR_HALT, MATRIX_OPFAILED_MSG);
     morpho_defineerror(MATRIX_SETCOLARGS, ERROR_HALT, MATRIX_SETCOLARGS_MSG);
     morpho_defineerror(MATRIX_NORMARGS, ERROR_HALT, MATRIX_NORMARGS_MSG);
+    morpho_defineerror(MATRIX_COMBINEARGS, ERROR_HALT, MATRIX_COMBINEARGS_MSG);
+    morpho_defineerror(MATRIX_VIEWARGS, ERROR_HALT, MATRIX_VIEWARGS_MSG);
+    morpho_defineerror(MATRIX_CROSSARGS, ERROR_HALT, MATRIX_CROSSARGS_MSG);
+    
+    matrix_initializepool();
 }
@@ -38,13 +38,17 @@ extern objecttype objectmatrixtype;
     Elements are stored in column-major format, i.e.
         [ 1 2 ]
         [ 3 4 ]
-    is stored ( 1, 3, 2, 4 ) in memory. This is for compatibility with standard linear algebra packages */
+    is stored ( 1, 3, 2, 4 ) in memory. This is for compatibility with standard linear algebra packages.
+    A view is a matrix whose elements lie within the storage of a parent matrix; because storage is
+    column-major, a block of consecutive columns is itself contiguous, so views are handled by every
+    routine that processes ordinary matrices and writes through a view update the parent. */
 
 typedef struct {
     object obj;
     unsigned int nrows;
     unsigned int ncols;
     double *elements;
+    object *parent; /** For a view, the matrix that owns the elements; NULL otherwise */
     double matrixdata[];
 } objectmatrix;
 
@@ -57,12 +61,21 @@ typedef struct {
 /** Creates a matrix object */
 objectmatrix *object_newmatrix(unsigned int nrows, unsigned int ncols, bool zero);
 
+/** Creates a new matrix from a list of doubles in column-major order */
+objectmatrix *object_matrixfromfloats(unsigned int nrows, unsigned int ncols, double *list);
+
 /** Creates a new matrix from an array */
 objectmatrix *object_matrixfromarray(objectarray *array);
 
 /** Creates a new matrix from an existing matrix */
 objectmatrix *object_clonematrix(objectmatrix *array);
 
+/** Creates a view onto a block of the elements of an existing matrix */
+objectmatrix *object_newmatrixview(objectmatrix *parent, unsigned int offset, unsigned int nrows, unsigned int ncols);
+
+/** Tests whether a matrix is a view */
+#define MATRIX_ISVIEW(m) ((m)->parent!=NULL)
+
 /** @brief Use to create static matrices on the C stack
     @details Intended for small matrices; Caller needs to supply a double array of size nr*nc. */
 #define MORPHO_STATICMATRIX(darray, nr, nc)      { .obj.type=OBJECT_MATRIX, .obj.status=OBJECT_ISUNMANAGED, .obj.next=NULL, .elements=darray, .nrows=nr, .ncols=nc }
@@ -70,6 +83,26 @@ objectmatrix *object_clonematrix(objectmatrix *array);
 /** Macro to decide if a matrix is 'small' or 'large' and hence static or dynamic allocation should be used. */
 #define MATRIX_ISSMALL(m) (m->nrows*m->ncols<MORPHO_MAXIMUMSTACKALLOC)
 
+/** Matrices with no more elements than this, which covers vectors of up to 16 components and square matrices up to 4x4,
+    are processed with inline loops and closed-form expressions; at these sizes the overhead of a call into BLAS or LAPACK exceeds the arithmetic. */
+#define MATRIX_TINYSIZE 16
+
+/** Macro to decide if a matrix is 'tiny' and hence should bypass BLAS and LAPACK */
+#define MATRIX_ISTINY(m) ((m)->nrows*(m)->ncols<=MATRIX_TINYSIZE)
+
+/** Largest dimension of a square matrix handled without LAPACK */
+#define MATRIX_TINYDIM 4
+
+/** Elementwise operations, reductions and transposes of matrices with at least this many elements are divided between
+    the worker threads of the matrix threadpool when morpho is run with more than one worker thread */
+#define MATRIX_PARALLELSIZE 65536
+
+/** Matrix products are divided between worker threads when they require at least this many multiply-adds */
+#define MATRIX_PARALLELFLOPS 2097152
+
+/** Edge length of the blocks processed by the parallel kernels, chosen so that a block of each operand fits in cache */
+#define MATRIX_BLOCKSIZE 64
+
 /* -------------------------------------------------------
  * Matrix class
  * ------------------------------------------------------- */
@@ -81,12 +114,15 @@ objectmatrix *object_clonematrix(objectmatrix *array);
 #define MATRIX_TRACE_METHOD "trace"
 #define MATRIX_INNER_METHOD "inner"
 #define MATRIX_DET_METHOD "det"
+#define MATRIX_CROSS_METHOD "cross"
 #define MATRIX_EIGENVALUES_METHOD "eigenvalues"
 #define MATRIX_EIGENSYSTEM_METHOD "eigensystem"
 #define MATRIX_NORM_METHOD "norm"
 #define MATRIX_GETCOLUMN_METHOD "column"
 #define MATRIX_SETCOLUMN_METHOD "setcolumn"
 #define MATRIX_RESHAPE_METHOD "reshape"
+#define MATRIX_VIEW_METHOD "view"
+#define MATRIX_COMBINE_METHOD "combine"
 #define MATRIX_EIGENVALUES_METHOD "eigenvalues"
 #define MATRIX_EIGENSYSTEM_METHOD "eigensystem"
 
@@ -131,6 +167,34 @@ objectmatrix *object_clonematrix(objectmatrix *array);
 #define MATRIX_NORMARGS                   "MtrxNrmArgs"
 #define MATRIX_NORMARGS_MSG               "Method norm expects an (optional) numerical argument."
 
+#define MATRIX_VIEWARGS                   "MtrxVwArgs"
+#define MATRIX_VIEWARGS_MSG               "Method view expects a column index or a range of consecutive column indices."
+
+#define MATRIX_COMBINEARGS                "MtrxCmbnArgs"
+#define MATRIX_COMBINEARGS_MSG            "Method expects a number, followed by pairs of a number and a matrix of the same shape."
+
+#define MATRIX_CROSSARGS                  "MtrxCrssArgs"
+#define MATRIX_CROSSARGS_MSG              "Method cross expects a matrix argument; both vectors must have three elements."
+
+/* -------------------------------------------------------
+ * Batches of small matrices
+ * ------------------------------------------------------- */
+
+/** A batch of matrices of the same shape, whose elements are addressed through strides (counted in elements)
+    between successive matrices, rows and columns. When the batch stride is 1, i.e. corresponding elements
+    of successive matrices are adjacent, the batched kernels vectorize across the batch. */
+typedef struct {
+    double *data; /** First element of the first matrix */
+    unsigned int nrows;
+    unsigned int ncols;
+    ptrdiff_t sbatch; /** Stride between matrices */
+    ptrdiff_t srow; /** Stride between rows */
+    ptrdiff_t scol; /** Stride between columns */
+} matrixbatch;
+
+/** Describes a batch of column-major matrices packed one after another, as produced by copying the elements of successive Matrix objects */
+#define MATRIX_PACKEDBATCH(d, nr, nc) { .data=d, .nrows=nr, .ncols=nc, .sbatch=(nr)*(nc), .srow=1, .scol=nr }
+
 /* -------------------------------------------------------
  * Matrix errors
  * ------------------------------------------------------- */
@@ -158,6 +222,7 @@ objectmatrixerror matrix_copy(objectmatrix *a, objectmatrix *out);
 objectmatrixerror matrix_copyat(objectmatrix *a, objectmatrix *out, int row0, int col0);
 objectmatrixerror matrix_add(objectmatrix *a, objectmatrix *b, objectmatrix *out);
 objectmatrixerror matrix_accumulate(objectmatrix *a, double lambda, objectmatrix *b);
+objectmatrixerror matrix_combine(objectmatrix *a, double alpha, unsigned int n, double *lambda, objectmatrix **b);
 objectmatrixerror matrix_sub(objectmatrix *a, objectmatrix *b, objectmatrix *out);
 objectmatrixerror matrix_mul(objectmatrix *a, objectmatrix *b, objectmatrix *out);
 objectmatrixerror matrix_inner(objectmatrix *a, objectmatrix *b, double *out);
@@ -168,12 +233,21 @@ objectmatrixerror matrix_transpose(objectmatrix *a, objectmatrix *out);
 objectmatrixerror matrix_trace(objectmatrix *a, double *out);
 objectmatrixerror matrix_scale(objectmatrix *a, double scale);
 objectmatrixerror matrix_identity(objectmatrix *a);
+objectmatrixerror matrix_det(objectmatrix *a, double *out);
+objectmatrixerror matrix_cross(objectmatrix *a, objectmatrix *b, objectmatrix *out);
 double matrix_sum(objectmatrix *a);
-//objectmatrixerror matrix_det(objectmatrix *a, double *out);
+double matrix_norm(objectmatrix *a);
 //objectmatrixerror matrix_eigensystem(objectmatrix *a, double *val, objectmatrix *vec);
 
+objectmatrixerror matrix_batchmul(unsigned int n, matrixbatch *a, matrixbatch *b, matrixbatch *out);
+objectmatrixerror matrix_batchdet(unsigned int n, matrixbatch *a, double *out, ptrdiff_t sout);
+objectmatrixerror matrix_batchinverse(unsigned int n, matrixbatch *a, matrixbatch *out);
+objectmatrixerror matrix_batcheigensym(unsigned int n, matrixbatch *a, matrixbatch *evals, matrixbatch *evecs);
+
 void matrix_print(objectmatrix *m);
+void matrix_raiseerror(vm *v, objectmatrixerror err);
 
 void matrix_initialize(void);
+void matrix_finalize(void);
 
 #endif /* matrix_h */
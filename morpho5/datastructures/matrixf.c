@@ -0,0 +1,481 @@
+/** @file matrixf.c
+ *  @author T J Atherton
+ *
+ *  @brief Veneer class over the objectmatrixf type, a matrix that stores its elements in single precision
+ */
+
+#include <string.h>
+#include "object.h"
+#include "matrix.h"
+#include "matrixf.h"
+#include "morpho.h"
+#include "builtin.h"
+#include "veneer.h"
+#include "common.h"
+
+/* **********************************************************************
+ * Single precision matrix objects
+ * ********************************************************************** */
+
+objecttype objectmatrixftype;
+
+/** Function object definitions */
+size_t objectmatrixf_sizefn(object *obj) {
+    return sizeof(objectmatrixf)+sizeof(float) *
+            ((objectmatrixf *) obj)->ncols *
+            ((objectmatrixf *) obj)->nrows;
+}
+
+void objectmatrixf_printfn(object *obj) {
+    printf("<Float32Matrix>");
+}
+
+objecttypedefn objectmatrixfdefn = {
+    .printfn=objectmatrixf_printfn,
+    .markfn=NULL,
+    .freefn=NULL,
+    .sizefn=objectmatrixf_sizefn
+};
+
+/** Creates a single precision matrix */
+objectmatrixf *object_newmatrixf(unsigned int nrows, unsigned int ncols, bool zero) {
+    unsigned int nel = nrows*ncols;
+    objectmatrixf *new = (objectmatrixf *) object_new(sizeof(objectmatrixf)+nel*sizeof(float), OBJECT_MATRIXF);
+
+    if (new) {
+        new->ncols=ncols;
+        new->nrows=nrows;
+        new->elements=new->matrixdata;
+        if (zero) memset(new->elements, 0, sizeof(float)*nel);
+    }
+
+    return new;
+}
+
+/** Creates a single precision copy of a matrix, rounding each element */
+objectmatrixf *object_matrixffrommatrix(objectmatrix *m) {
+    objectmatrixf *new = object_newmatrixf(m->nrows, m->ncols, false);
+
+    if (new) {
+        unsigned int nel = m->nrows*m->ncols;
+        for (unsigned int i=0; i<nel; i++) new->elements[i]=(float) m->elements[i];
+    }
+
+    return new;
+}
+
+/** Creates a double precision copy of a single precision matrix */
+objectmatrix *object_matrixfrommatrixf(objectmatrixf *m) {
+    objectmatrix *new = object_newmatrix(m->nrows, m->ncols, false);
+
+    if (new) {
+        unsigned int nel = m->nrows*m->ncols;
+        for (unsigned int i=0; i<nel; i++) new->elements[i]=(double) m->elements[i];
+    }
+
+    return new;
+}
+
+/** Creates a copy of a single precision matrix */
+static objectmatrixf *object_clonematrixf(objectmatrixf *m) {
+    objectmatrixf *new = object_newmatrixf(m->nrows, m->ncols, false);
+    if (new) cblas_scopy(m->ncols*m->nrows, m->elements, 1, new->elements, 1);
+    return new;
+}
+
+/* **********************************************************************
+ * Single precision matrix operations
+ * ********************************************************************* */
+
+/** Tests whether two matrices have the same shape */
+#define MATRIXF_SAMESHAPE(a, b) ((a)->nrows==(b)->nrows && (a)->ncols==(b)->ncols)
+
+/** Adds two matrices, a + b -> out */
+objectmatrixerror matrixf_add(objectmatrixf *a, objectmatrixf *b, objectmatrixf *out) {
+    if (!MATRIXF_SAMESHAPE(a, b) || !MATRIXF_SAMESHAPE(a, out)) return MATRIX_INCMPTBLDIM;
+    if (a!=out) cblas_scopy(a->ncols*a->nrows, a->elements, 1, out->elements, 1);
+    cblas_saxpy(a->ncols*a->nrows, 1.0f, b->elements, 1, out->elements, 1);
+    return MATRIX_OK;
+}
+
+/** Subtracts two matrices, a - b -> out */
+objectmatrixerror matrixf_sub(objectmatrixf *a, objectmatrixf *b, objectmatrixf *out) {
+    if (!MATRIXF_SAMESHAPE(a, b) || !MATRIXF_SAMESHAPE(a, out)) return MATRIX_INCMPTBLDIM;
+    if (a!=out) cblas_scopy(a->ncols*a->nrows, a->elements, 1, out->elements, 1);
+    cblas_saxpy(a->ncols*a->nrows, -1.0f, b->elements, 1, out->elements, 1);
+    return MATRIX_OK;
+}
+
+/** Accumulates a multiple of another matrix in place, a + lambda*b -> a */
+objectmatrixerror matrixf_accumulate(objectmatrixf *a, double lambda, objectmatrixf *b) {
+    if (!MATRIXF_SAMESHAPE(a, b)) return MATRIX_INCMPTBLDIM;
+    cblas_saxpy(a->ncols*a->nrows, (float) lambda, b->elements, 1, a->elements, 1);
+    return MATRIX_OK;
+}
+
+/** Accumulates a multiple of a double precision matrix in place; each term is formed in double precision and rounded once */
+objectmatrixerror matrixf_accumulatematrix(objectmatrixf *a, double lambda, objectmatrix *b) {
+    if (!MATRIXF_SAMESHAPE(a, b)) return MATRIX_INCMPTBLDIM;
+    unsigned int nel = a->nrows*a->ncols;
+    for (unsigned int i=0; i<nel; i++) a->elements[i]=(float) (a->elements[i]+lambda*b->elements[i]);
+    return MATRIX_OK;
+}
+
+/** Multiplies two matrices, a * b -> out */
+objectmatrixerror matrixf_mul(objectmatrixf *a, objectmatrixf *b, objectmatrixf *out) {
+    if (a->ncols!=b->nrows || out->nrows!=a->nrows || out->ncols!=b->ncols) return MATRIX_INCMPTBLDIM;
+    cblas_sgemm(CblasColMajor, CblasNoTrans, CblasNoTrans, a->nrows, b->ncols, a->ncols, 1.0f, a->elements, a->nrows, b->elements, b->nrows, 0.0f, out->elements, out->nrows);
+    return MATRIX_OK;
+}
+
+/** Scales a matrix in place */
+objectmatrixerror matrixf_scale(objectmatrixf *a, double scale) {
+    cblas_sscal(a->ncols*a->nrows, (float) scale, a->elements, 1);
+    return MATRIX_OK;
+}
+
+/** Frobenius inner product, accumulated in double precision */
+objectmatrixerror matrixf_inner(objectmatrixf *a, objectmatrixf *b, double *out) {
+    if (!MATRIXF_SAMESHAPE(a, b)) return MATRIX_INCMPTBLDIM;
+    *out=cblas_dsdot(a->ncols*a->nrows, a->elements, 1, b->elements, 1);
+    return MATRIX_OK;
+}
+
+/** Frobenius inner product with a double precision matrix */
+objectmatrixerror matrixf_innermatrix(objectmatrixf *a, objectmatrix *b, double *out) {
+    if (!MATRIXF_SAMESHAPE(a, b)) return MATRIX_INCMPTBLDIM;
+    unsigned int nel = a->nrows*a->ncols;
+    double sum=0.0;
+    for (unsigned int i=0; i<nel; i++) sum+=a->elements[i]*b->elements[i];
+    *out=sum;
+    return MATRIX_OK;
+}
+
+/** Sums the elements in double precision, using Kahan summation as matrix_sum does */
+double matrixf_sum(objectmatrixf *a) {
+    unsigned int nel = a->nrows*a->ncols;
+    double sum=0.0, c=0.0, y, t;
+
+    for (unsigned int i=0; i<nel; i++) {
+        y=a->elements[i]-c;
+        t=sum+y;
+        c=(t-sum)-y;
+        sum=t;
+    }
+    return sum;
+}
+
+/** Frobenius norm, accumulated in double precision */
+double matrixf_norm(objectmatrixf *a) {
+    return sqrt(cblas_dsdot(a->ncols*a->nrows, a->elements, 1, a->elements, 1));
+}
+
+/** Prints a single precision matrix */
+static void matrixf_print(objectmatrixf *m) {
+    for (int i=0; i<m->nrows; i++) { // Rows run from 0...m
+        printf("[ ");
+        for (int j=0; j<m->ncols; j++) { // Columns run from 0...k
+            double v=m->elements[i+j*m->nrows];
+            printf("%g ", (fabs(v)<MORPHO_EPS ? 0 : v));
+        }
+        printf("]%s", (i<m->nrows-1 ? "\n" : ""));
+    }
+}
+
+/* **********************************************************************
+ * Float32Matrix class
+ * ********************************************************************* */
+
+/** Constructs a Float32Matrix */
+value matrixf_constructor(vm *v, int nargs, value *args) {
+    objectmatrixf *new=NULL;
+    value out=MORPHO_NIL;
+
+    if (nargs==2 &&
+        MORPHO_ISINTEGER(MORPHO_GETARG(args, 0)) &&
+        MORPHO_ISINTEGER(MORPHO_GETARG(args, 1))) {
+        new=object_newmatrixf(MORPHO_GETINTEGERVALUE(MORPHO_GETARG(args, 0)), MORPHO_GETINTEGERVALUE(MORPHO_GETARG(args, 1)), true);
+    } else if (nargs==1 && MORPHO_ISINTEGER(MORPHO_GETARG(args, 0))) {
+        new=object_newmatrixf(MORPHO_GETINTEGERVALUE(MORPHO_GETARG(args, 0)), 1, true);
+    } else if (nargs==1 && MORPHO_ISMATRIX(MORPHO_GETARG(args, 0))) {
+        new=object_matrixffrommatrix(MORPHO_GETMATRIX(MORPHO_GETARG(args, 0)));
+    } else if (nargs==1 && MORPHO_ISMATRIXF(MORPHO_GETARG(args, 0))) {
+        new=object_clonematrixf(MORPHO_GETMATRIXF(MORPHO_GETARG(args, 0)));
+    } else MORPHO_RAISE(v, MATRIXF_CONSTRUCTOR);
+
+    if (new) {
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+
+    return out;
+}
+
+/** Binds a newly created matrix, or raises an allocation error */
+static value matrixf_bind(vm *v, objectmatrixf *new) {
+    value out=MORPHO_NIL;
+    if (new) {
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+    return out;
+}
+
+/** Gets the matrix element with given indices */
+value Float32Matrix_getindex(vm *v, int nargs, value *args) {
+    objectmatrixf *m=MORPHO_GETMATRIXF(MORPHO_SELF(args));
+    unsigned int indx[2]={0,0};
+
+    if (nargs>2) MORPHO_RAISE(v, MATRIX_INVLDNUMINDICES);
+    if (!array_valuelisttoindices(nargs, args+1, indx)) MORPHO_RAISE(v, MATRIX_INVLDINDICES);
+    if (indx[0]>=m->nrows || indx[1]>=m->ncols) MORPHO_RAISE(v, MATRIX_INDICESOUTSIDEBOUNDS);
+
+    return MORPHO_FLOAT((double) m->elements[indx[0]+indx[1]*m->nrows]);
+}
+
+/** Sets the matrix element with given indices */
+value Float32Matrix_setindex(vm *v, int nargs, value *args) {
+    objectmatrixf *m=MORPHO_GETMATRIXF(MORPHO_SELF(args));
+    unsigned int indx[2]={0,0};
+    double val=0.0;
+
+    if (!array_valuelisttoindices(nargs-1, args+1, indx)) MORPHO_RAISE(v, MATRIX_INVLDINDICES);
+    if (indx[0]>=m->nrows || indx[1]>=m->ncols) MORPHO_RAISE(v, MATRIX_INDICESOUTSIDEBOUNDS);
+    morpho_valuetofloat(args[nargs], &val);
+    m->elements[indx[0]+indx[1]*m->nrows]=(float) val;
+
+    return MORPHO_NIL;
+}
+
+/** Prints a single precision matrix */
+value Float32Matrix_print(vm *v, int nargs, value *args) {
+    value self = MORPHO_SELF(args);
+    if (!MORPHO_ISMATRIXF(self)) return Object_print(v, nargs, args);
+
+    matrixf_print(MORPHO_GETMATRIXF(self));
+    return MORPHO_NIL;
+}
+
+/** Adds a Float32Matrix or a number */
+value Float32Matrix_add(vm *v, int nargs, value *args) {
+    objectmatrixf *a=MORPHO_GETMATRIXF(MORPHO_SELF(args));
+    double val;
+
+    if (nargs==1 && MORPHO_ISMATRIXF(MORPHO_GETARG(args, 0))) {
+        objectmatrixf *b=MORPHO_GETMATRIXF(MORPHO_GETARG(args, 0));
+        if (!MATRIXF_SAMESHAPE(a, b)) MORPHO_RAISE(v, MATRIX_INCOMPATIBLEMATRICES);
+        objectmatrixf *new=object_newmatrixf(a->nrows, a->ncols, false);
+        if (new) matrixf_add(a, b, new);
+        return matrixf_bind(v, new);
+    } else if (nargs==1 && morpho_valuetofloat(MORPHO_GETARG(args, 0), &val)) {
+        objectmatrixf *new=object_clonematrixf(a);
+        if (new) for (unsigned int i=0; i<a->nrows*a->ncols; i++) new->elements[i]+=(float) val;
+        return matrixf_bind(v, new);
+    } else MORPHO_RAISE(v, MATRIXF_ARITHARGS);
+
+    return MORPHO_NIL;
+}
+
+/** Right add; adding nil returns a copy so that matrices can be summed starting from nil */
+value Float32Matrix_addr(vm *v, int nargs, value *args) {
+    if (nargs==1 && MORPHO_ISNIL(MORPHO_GETARG(args, 0))) return matrixf_bind(v, object_clonematrixf(MORPHO_GETMATRIXF(MORPHO_SELF(args))));
+    return Float32Matrix_add(v, nargs, args);
+}
+
+/** Subtracts a Float32Matrix or a number */
+value Float32Matrix_sub(vm *v, int nargs, value *args) {
+    objectmatrixf *a=MORPHO_GETMATRIXF(MORPHO_SELF(args));
+    double val;
+
+    if (nargs==1 && MORPHO_ISMATRIXF(MORPHO_GETARG(args, 0))) {
+        objectmatrixf *b=MORPHO_GETMATRIXF(MORPHO_GETARG(args, 0));
+        if (!MATRIXF_SAMESHAPE(a, b)) MORPHO_RAISE(v, MATRIX_INCOMPATIBLEMATRICES);
+        objectmatrixf *new=object_newmatrixf(a->nrows, a->ncols, false);
+        if (new) matrixf_sub(a, b, new);
+        return matrixf_bind(v, new);
+    } else if (nargs==1 && morpho_valuetofloat(MORPHO_GETARG(args, 0), &val)) {
+        objectmatrixf *new=object_clonematrixf(a);
+        if (new) for (unsigned int i=0; i<a->nrows*a->ncols; i++) new->elements[i]-=(float) val;
+        return matrixf_bind(v, new);
+    } else MORPHO_RAISE(v, MATRIXF_ARITHARGS);
+
+    return MORPHO_NIL;
+}
+
+/** Multiplies by a Float32Matrix or a number */
+value Float32Matrix_mul(vm *v, int nargs, value *args) {
+    objectmatrixf *a=MORPHO_GETMATRIXF(MORPHO_SELF(args));
+    double scale;
+
+    if (nargs==1 && MORPHO_ISMATRIXF(MORPHO_GETARG(args, 0))) {
+        objectmatrixf *b=MORPHO_GETMATRIXF(MORPHO_GETARG(args, 0));
+        if (a->ncols!=b->nrows) MORPHO_RAISE(v, MATRIX_INCOMPATIBLEMATRICES);
+        objectmatrixf *new=object_newmatrixf(a->nrows, b->ncols, false);
+        if (new) matrixf_mul(a, b, new);
+        return matrixf_bind(v, new);
+    } else if (nargs==1 && morpho_valuetofloat(MORPHO_GETARG(args, 0), &scale)) {
+        objectmatrixf *new=object_clonematrixf(a);
+        if (new) matrixf_scale(new, scale);
+        return matrixf_bind(v, new);
+    } else MORPHO_RAISE(v, MATRIXF_ARITHARGS);
+
+    return MORPHO_NIL;
+}
+
+/** Called when multiplying on the right by a number */
+value Float32Matrix_mulr(vm *v, int nargs, value *args) {
+    if (nargs==1 && MORPHO_ISNUMBER(MORPHO_GETARG(args, 0))) return Float32Matrix_mul(v, nargs, args);
+    MORPHO_RAISE(v, MATRIXF_ARITHARGS);
+}
+
+/** Divides by a number */
+value Float32Matrix_div(vm *v, int nargs, value *args) {
+    double scale;
+
+    if (nargs==1 && morpho_valuetofloat(MORPHO_GETARG(args, 0), &scale)) {
+        objectmatrixf *new=object_clonematrixf(MORPHO_GETMATRIXF(MORPHO_SELF(args)));
+        if (new) matrixf_scale(new, 1.0/scale);
+        return matrixf_bind(v, new);
+    } else MORPHO_RAISE(v, MATRIXF_ARITHARGS);
+
+    return MORPHO_NIL;
+}
+
+/** Accumulates a multiple of a Float32Matrix or a Matrix in place */
+value Float32Matrix_acc(vm *v, int nargs, value *args) {
+    objectmatrixf *a=MORPHO_GETMATRIXF(MORPHO_SELF(args));
+    objectmatrixerror err=MATRIX_OK;
+    double lambda;
+
+    if (nargs!=2 || !morpho_valuetofloat(MORPHO_GETARG(args, 0), &lambda)) MORPHO_RAISE(v, MATRIXF_ARITHARGS);
+    value b=MORPHO_GETARG(args, 1);
+
+    if (MORPHO_ISMATRIXF(b)) err=matrixf_accumulate(a, lambda, MORPHO_GETMATRIXF(b));
+    else if (MORPHO_ISMATRIX(b)) err=matrixf_accumulatematrix(a, lambda, MORPHO_GETMATRIX(b));
+    else MORPHO_RAISE(v, MATRIXF_ARITHARGS);
+
+    if (err!=MATRIX_OK) matrix_raiseerror(v, err);
+    return MORPHO_NIL;
+}
+
+/** Frobenius inner product with a Float32Matrix or a Matrix */
+value Float32Matrix_inner(vm *v, int nargs, value *args) {
+    objectmatrixf *a=MORPHO_GETMATRIXF(MORPHO_SELF(args));
+    objectmatrixerror err=MATRIX_OK;
+    double prod=0.0;
+
+    if (nargs!=1) MORPHO_RAISE(v, MATRIXF_ARITHARGS);
+    value b=MORPHO_GETARG(args, 0);
+
+    if (MORPHO_ISMATRIXF(b)) err=matrixf_inner(a, MORPHO_GETMATRIXF(b), &prod);
+    else if (MORPHO_ISMATRIX(b)) err=matrixf_innermatrix(a, MORPHO_GETMATRIX(b), &prod);
+    else MORPHO_RAISE(v, MATRIXF_ARITHARGS);
+
+    if (err!=MATRIX_OK) {
+        matrix_raiseerror(v, err);
+        return MORPHO_NIL;
+    }
+    return MORPHO_FLOAT(prod);
+}
+
+/** Sum of the elements */
+value Float32Matrix_sum(vm *v, int nargs, value *args) {
+    return MORPHO_FLOAT(matrixf_sum(MORPHO_GETMATRIXF(MORPHO_SELF(args))));
+}
+
+/** Frobenius norm */
+value Float32Matrix_norm(vm *v, int nargs, value *args) {
+    return MORPHO_FLOAT(matrixf_norm(MORPHO_GETMATRIXF(MORPHO_SELF(args))));
+}
+
+/** Converts to a double precision Matrix */
+value Float32Matrix_tomatrix(vm *v, int nargs, value *args) {
+    value out=MORPHO_NIL;
+    objectmatrix *new=object_matrixfrommatrixf(MORPHO_GETMATRIXF(MORPHO_SELF(args)));
+    if (new) {
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+    return out;
+}
+
+/** Enumerate protocol */
+value Float32Matrix_enumerate(vm *v, int nargs, value *args) {
+    objectmatrixf *a=MORPHO_GETMATRIXF(MORPHO_SELF(args));
+    value out=MORPHO_NIL;
+
+    if (nargs==1 && MORPHO_ISINTEGER(MORPHO_GETARG(args, 0))) {
+        int i=MORPHO_GETINTEGERVALUE(MORPHO_GETARG(args, 0));
+
+        if (i<0) out=MORPHO_INTEGER(a->ncols*a->nrows);
+        else if (i<a->ncols*a->nrows) out=MORPHO_FLOAT((double) a->elements[i]);
+    }
+
+    return out;
+}
+
+/** Number of matrix elements */
+value Float32Matrix_count(vm *v, int nargs, value *args) {
+    objectmatrixf *a=MORPHO_GETMATRIXF(MORPHO_SELF(args));
+    return MORPHO_INTEGER(a->ncols*a->nrows);
+}
+
+/** Matrix dimensions */
+value Float32Matrix_dimensions(vm *v, int nargs, value *args) {
+    objectmatrixf *a=MORPHO_GETMATRIXF(MORPHO_SELF(args));
+    value dim[2] = { MORPHO_INTEGER(a->nrows), MORPHO_INTEGER(a->ncols) };
+    value out=MORPHO_NIL;
+
+    objectlist *new=object_newlist(2, dim);
+    if (new) {
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+
+    return out;
+}
+
+/** Clones a single precision matrix */
+value Float32Matrix_clone(vm *v, int nargs, value *args) {
+    return matrixf_bind(v, object_clonematrixf(MORPHO_GETMATRIXF(MORPHO_SELF(args))));
+}
+
+MORPHO_BEGINCLASS(Float32Matrix)
+MORPHO_METHOD(MORPHO_GETINDEX_METHOD, Float32Matrix_getindex, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_SETINDEX_METHOD, Float32Matrix_setindex, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_PRINT_METHOD, Float32Matrix_print, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_ADD_METHOD, Float32Matrix_add, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_ADDR_METHOD, Float32Matrix_addr, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_SUB_METHOD, Float32Matrix_sub, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_MUL_METHOD, Float32Matrix_mul, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_MULR_METHOD, Float32Matrix_mulr, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_DIV_METHOD, Float32Matrix_div, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_ACC_METHOD, Float32Matrix_acc, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MATRIX_INNER_METHOD, Float32Matrix_inner, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_SUM_METHOD, Float32Matrix_sum, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MATRIX_NORM_METHOD, Float32Matrix_norm, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MATRIXF_TOMATRIX_METHOD, Float32Matrix_tomatrix, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_ENUMERATE_METHOD, Float32Matrix_enumerate, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_COUNT_METHOD, Float32Matrix_count, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MATRIX_DIMENSIONS_METHOD, Float32Matrix_dimensions, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_CLONE_METHOD, Float32Matrix_clone, BUILTIN_FLAGSEMPTY)
+MORPHO_ENDCLASS
+
+/* **********************************************************************
+ * Initialization
+ * ********************************************************************* */
+
+void matrixf_initialize(void) {
+    objectmatrixftype=object_addtype(&objectmatrixfdefn);
+
+    builtin_addfunction(MATRIXF_CLASSNAME, matrixf_constructor, BUILTIN_FLAGSCONSTRUCTOR);
+
+    objectstring objname = MORPHO_STATICSTRING(OBJECT_CLASSNAME);
+    value objclass = builtin_findclass(MORPHO_OBJECT(&objname));
+
+    value matrixfclass=builtin_addclass(MATRIXF_CLASSNAME, MORPHO_GETCLASSDEFINITION(Float32Matrix), objclass);
+    object_setveneerclass(OBJECT_MATRIXF, matrixfclass);
+
+    morpho_defineerror(MATRIXF_CONSTRUCTOR, ERROR_HALT, MATRIXF_CONSTRUCTOR_MSG);
+    morpho_defineerror(MATRIXF_ARITHARGS, ERROR_HALT, MATRIXF_ARITHARGS_MSG);
+}
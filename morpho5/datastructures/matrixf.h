@@ -0,0 +1,79 @@
+/** @file matrixf.h
+ *  @author T J Atherton
+ *
+ *  @brief Veneer class over the objectmatrixf type, a matrix that stores its elements in single precision
+ */
+
+#ifndef matrixf_h
+#define matrixf_h
+
+#include <stdio.h>
+#include "veneer.h"
+#include "matrix.h"
+
+/* -------------------------------------------------------
+ * Single precision matrix objects
+ * ------------------------------------------------------- */
+
+extern objecttype objectmatrixftype;
+#define OBJECT_MATRIXF objectmatrixftype
+
+/** Single precision matrices store their elements as 32 bit floats in the same column-major layout as
+    objectmatrix, halving memory use and memory traffic. Elementwise operations and products are performed
+    in single precision by the corresponding BLAS routines, but reductions (sums, inner products and norms)
+    accumulate in double precision and return doubles, so that they do not lose accuracy on large matrices. */
+typedef struct {
+    object obj;
+    unsigned int nrows;
+    unsigned int ncols;
+    float *elements;
+    float matrixdata[];
+} objectmatrixf;
+
+/** Tests whether an object is a single precision matrix */
+#define MORPHO_ISMATRIXF(val) object_istype(val, OBJECT_MATRIXF)
+
+/** Gets the object as a single precision matrix */
+#define MORPHO_GETMATRIXF(val)   ((objectmatrixf *) MORPHO_GETOBJECT(val))
+
+/** Creates a single precision matrix */
+objectmatrixf *object_newmatrixf(unsigned int nrows, unsigned int ncols, bool zero);
+
+/** Creates a single precision copy of a matrix, rounding each element */
+objectmatrixf *object_matrixffrommatrix(objectmatrix *m);
+
+/** Creates a double precision copy of a single precision matrix */
+objectmatrix *object_matrixfrommatrixf(objectmatrixf *m);
+
+/* -------------------------------------------------------
+ * Float32Matrix class
+ * ------------------------------------------------------- */
+
+#define MATRIXF_CLASSNAME "Float32Matrix"
+
+#define MATRIXF_TOMATRIX_METHOD "tomatrix"
+
+#define MATRIXF_CONSTRUCTOR               "MtrxFCns"
+#define MATRIXF_CONSTRUCTOR_MSG           "Float32Matrix() constructor should be called either with dimensions or a Matrix or Float32Matrix to convert."
+
+#define MATRIXF_ARITHARGS                 "MtrxFArgs"
+#define MATRIXF_ARITHARGS_MSG             "Float32Matrix arithmetic methods expect a Float32Matrix or number as their argument; acc and inner also accept a Matrix."
+
+/* -------------------------------------------------------
+ * Float32Matrix interface
+ * ------------------------------------------------------- */
+
+objectmatrixerror matrixf_add(objectmatrixf *a, objectmatrixf *b, objectmatrixf *out);
+objectmatrixerror matrixf_sub(objectmatrixf *a, objectmatrixf *b, objectmatrixf *out);
+objectmatrixerror matrixf_accumulate(objectmatrixf *a, double lambda, objectmatrixf *b);
+objectmatrixerror matrixf_accumulatematrix(objectmatrixf *a, double lambda, objectmatrix *b);
+objectmatrixerror matrixf_mul(objectmatrixf *a, objectmatrixf *b, objectmatrixf *out);
+objectmatrixerror matrixf_scale(objectmatrixf *a, double scale);
+objectmatrixerror matrixf_inner(objectmatrixf *a, objectmatrixf *b, double *out);
+objectmatrixerror matrixf_innermatrix(objectmatrixf *a, objectmatrix *b, double *out);
+double matrixf_sum(objectmatrixf *a);
+double matrixf_norm(objectmatrixf *a);
+
+void matrixf_initialize(void);
+
+#endif /* matrixf_h */
@@ -0,0 +1,1015 @@
+/** @file ndarray.c
+ *  @author T J Atherton
+ *
+ *  @brief Veneer class over the objectndarray type, a strided multidimensional array of doubles
+ */
+
+#include <string.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <limits.h>
+#include "object.h"
+#include "ndarray.h"
+#include "matrix.h"
+#include "morpho.h"
+#include "builtin.h"
+#include "veneer.h"
+#include "common.h"
+
+/* **********************************************************************
+ * NDArray objects
+ * ********************************************************************** */
+
+objecttype objectndarraytype;
+
+/** Function object definitions */
+size_t objectndarray_sizefn(object *obj) {
+    objectndarray *a = (objectndarray *) obj;
+    return sizeof(objectndarray)+(MORPHO_ISNIL(a->store) ? a->count*sizeof(double) : 0);
+}
+
+void objectndarray_printfn(object *obj) {
+    printf("<NDArray>");
+}
+
+void objectndarray_markfn(object *obj, void *v) {
+    morpho_markvalue(v, ((objectndarray *) obj)->store);
+}
+
+void objectndarray_freefn(object *obj) {
+    objectndarray *a = (objectndarray *) obj;
+    if (MORPHO_ISNIL(a->store) && a->data) MORPHO_FREE(a->data);
+}
+
+objecttypedefn objectndarraydefn = {
+    .printfn=objectndarray_printfn,
+    .markfn=objectndarray_markfn,
+    .freefn=objectndarray_freefn,
+    .sizefn=objectndarray_sizefn
+};
+
+/** Number of elements in an array of a given shape */
+static unsigned int ndarray_countelements(unsigned int ndim, unsigned int *shape) {
+    unsigned int n=1;
+    for (unsigned int i=0; i<ndim; i++) n*=shape[i];
+    return n;
+}
+
+/** Checks that an array of a given shape can be allocated and addressed: the strides are ints, so the product
+    of the dimensions, ignoring any that are zero, must fit in one, and the storage in a size_t. Each multiplication is
+    checked before it is made so that the product can't wrap around. */
+static bool ndarray_isaddressable(unsigned int ndim, unsigned int *shape) {
+    size_t max = (SIZE_MAX/sizeof(double) < INT_MAX ? SIZE_MAX/sizeof(double) : INT_MAX), n=1;
+    for (unsigned int i=0; i<ndim; i++) {
+        if (!shape[i]) continue;
+        if (shape[i]>max/n) return false;
+        n*=shape[i];
+    }
+    return true;
+}
+
+/** Sets strides so that elements are stored contiguously in row-major order */
+static void ndarray_setcontiguousstrides(unsigned int ndim, unsigned int *shape, int *stride) {
+    int s=1;
+    for (int i=(int) ndim-1; i>=0; i--) {
+        stride[i]=s;
+        s*=shape[i];
+    }
+}
+
+/** Creates a contiguous ndarray with a given shape
+ * @returns the new array, or NULL if it is too large or can't be allocated */
+objectndarray *object_newndarray(unsigned int ndim, unsigned int *shape, bool zero) {
+    if (!ndarray_isaddressable(ndim, shape)) return NULL;
+
+    objectndarray *new = (objectndarray *) object_new(sizeof(objectndarray), OBJECT_NDARRAY);
+
+    if (new) {
+        new->ndim=ndim;
+        for (unsigned int i=0; i<ndim; i++) new->shape[i]=shape[i];
+        ndarray_setcontiguousstrides(ndim, new->shape, new->stride);
+        new->count=ndarray_countelements(ndim, shape);
+        new->store=MORPHO_NIL;
+        new->data=NULL;
+
+        if (new->count) {
+            new->data=MORPHO_MALLOC(new->count*sizeof(double));
+            if (!new->data) {
+                object_free((object *) new);
+                return NULL;
+            }
+            if (zero) memset(new->data, 0, new->count*sizeof(double));
+        }
+    }
+
+    return new;
+}
+
+/** Finds the object that owns an array's storage */
+static value ndarray_owner(objectndarray *a) {
+    return (MORPHO_ISNIL(a->store) ? MORPHO_OBJECT(a) : a->store);
+}
+
+/** Creates a view with the same shape, strides and storage as a given array; the caller may then adjust these */
+static objectndarray *object_ndarrayview(objectndarray *a) {
+    objectndarray *new = (objectndarray *) object_new(sizeof(objectndarray), OBJECT_NDARRAY);
+
+    if (new) {
+        new->ndim=a->ndim;
+        new->count=a->count;
+        memcpy(new->shape, a->shape, sizeof(a->shape));
+        memcpy(new->stride, a->stride, sizeof(a->stride));
+        new->store=ndarray_owner(a);
+        new->data=a->data;
+    }
+
+    return new;
+}
+
+/** Creates an ndarray that views the elements of a matrix; matrices are stored in column-major order */
+static objectndarray *object_ndarrayfrommatrix(objectmatrix *m) {
+    objectndarray *new = (objectndarray *) object_new(sizeof(objectndarray), OBJECT_NDARRAY);
+
+    if (new) {
+        new->ndim=2;
+        new->shape[0]=m->nrows;
+        new->shape[1]=m->ncols;
+        new->stride[0]=1;
+        new->stride[1]=m->nrows;
+        new->count=m->nrows*m->ncols;
+        new->store=MORPHO_OBJECT(m);
+        new->data=m->elements;
+    }
+
+    return new;
+}
+
+/* **********************************************************************
+ * Elementwise kernels
+ * ********************************************************************* */
+
+typedef enum { NDARRAY_COPY, NDARRAY_ADD, NDARRAY_SUB, NDARRAY_MUL, NDARRAY_DIV } ndarrayop;
+
+#define NDARRAY_KERNEL(OUT, A, B) \
+    switch (op) { \
+        case NDARRAY_COPY: for (ptrdiff_t i=0; i<n; i++) OUT=A; break; \
+        case NDARRAY_ADD: for (ptrdiff_t i=0; i<n; i++) OUT=A+B; break; \
+        case NDARRAY_SUB: for (ptrdiff_t i=0; i<n; i++) OUT=A-B; break; \
+        case NDARRAY_MUL: for (ptrdiff_t i=0; i<n; i++) OUT=A*B; break; \
+        case NDARRAY_DIV: for (ptrdiff_t i=0; i<n; i++) OUT=A/B; break; \
+    }
+
+/** Applies an operation along a single row of n elements. Rows whose operands have unit stride, or are
+    broadcast with zero stride, are handled by separate loops so that the compiler can vectorize them. */
+static void ndarray_kernel(ndarrayop op, ptrdiff_t n, double *restrict out, ptrdiff_t so, const double *restrict a, ptrdiff_t sa, const double *restrict b, ptrdiff_t sb) {
+    if (so==1 && sa==1 && sb==1) {
+        NDARRAY_KERNEL(out[i], a[i], b[i])
+    } else if (so==1 && sa==1 && sb==0) {
+        double y=*b;
+        NDARRAY_KERNEL(out[i], a[i], y)
+    } else if (so==1 && sa==0 && sb==1) {
+        double x=*a;
+        NDARRAY_KERNEL(out[i], x, b[i])
+    } else {
+        NDARRAY_KERNEL(out[i*so], a[i*sa], b[i*sb])
+    }
+}
+
+/** Tests whether strides describe contiguous storage of a given shape, or a single broadcast element */
+static bool ndarray_iscontiguousorzero(unsigned int ndim, unsigned int *shape, int *stride) {
+    int s=1, zero=0;
+    for (int i=(int) ndim-1; i>=0; i--) {
+        if (stride[i]==0) zero++;
+        else if (shape[i]!=1 && stride[i]!=s) return false;
+        s*=shape[i];
+    }
+    return (zero==0 || zero==ndim);
+}
+
+/** Applies an elementwise operation over a given shape, out = a op b. Each operand is addressed through
+    its own strides, which are zero along broadcast axes. */
+static void ndarray_apply(ndarrayop op, unsigned int ndim, unsigned int *shape, double *out, int *so, const double *a, int *sa, const double *b, int *sb) {
+    unsigned int count=ndarray_countelements(ndim, shape);
+    if (!count) return;
+
+    /* If every operand is contiguous, treat the arrays as a single row */
+    if (ndarray_iscontiguousorzero(ndim, shape, so) &&
+        ndarray_iscontiguousorzero(ndim, shape, sa) &&
+        ndarray_iscontiguousorzero(ndim, shape, sb)) {
+        ndarray_kernel(op, count, out, 1, a, (sa[ndim-1] ? 1 : 0), b, (sb[ndim-1] ? 1 : 0));
+        return;
+    }
+
+    unsigned int last=ndim-1, nrows=count/shape[last], indx[NDARRAY_MAXDIM];
+    ptrdiff_t oo=0, ao=0, bo=0;
+    for (unsigned int i=0; i<ndim; i++) indx[i]=0;
+
+    for (unsigned int r=0; r<nrows; r++) {
+        ndarray_kernel(op, shape[last], out+oo, so[last], a+ao, sa[last], b+bo, sb[last]);
+
+        for (int d=(int) last-1; d>=0; d--) { // Advance the index over the outer axes
+            oo+=so[d]; ao+=sa[d]; bo+=sb[d];
+            if (++indx[d]<shape[d]) break;
+            oo-=(ptrdiff_t) so[d]*shape[d];
+            ao-=(ptrdiff_t) sa[d]*shape[d];
+            bo-=(ptrdiff_t) sb[d]*shape[d];
+            indx[d]=0;
+        }
+    }
+}
+
+/** Creates a contiguous copy of an ndarray */
+objectndarray *object_clonendarray(objectndarray *a) {
+    objectndarray *new = object_newndarray(a->ndim, a->shape, false);
+
+    if (new) ndarray_apply(NDARRAY_COPY, a->ndim, a->shape, new->data, new->stride, a->data, a->stride, a->data, a->stride);
+
+    return new;
+}
+
+/* **********************************************************************
+ * NDArray operations
+ * ********************************************************************* */
+
+/** Tests whether an array's elements are stored contiguously in row-major order */
+bool ndarray_iscontiguous(objectndarray *a) {
+    int s=1;
+    for (int i=(int) a->ndim-1; i>=0; i--) {
+        if (a->shape[i]!=1 && a->stride[i]!=s) return false;
+        s*=a->shape[i];
+    }
+    return true;
+}
+
+/** Finds the offset of an element from its indices */
+static bool ndarray_offset(objectndarray *a, unsigned int ndim, int *indx, ptrdiff_t *out) {
+    ptrdiff_t k=0;
+    if (ndim!=a->ndim) return false;
+    for (unsigned int i=0; i<ndim; i++) {
+        if (indx[i]<0 || indx[i]>=a->shape[i]) return false;
+        k+=(ptrdiff_t) indx[i]*a->stride[i];
+    }
+    *out=k;
+    return true;
+}
+
+/** Gets an ndarray element */
+bool ndarray_getelement(objectndarray *a, unsigned int ndim, int *indx, double *out) {
+    ptrdiff_t k;
+    if (!ndarray_offset(a, ndim, indx, &k)) return false;
+    *out=a->data[k];
+    return true;
+}
+
+/** Sets an ndarray element */
+bool ndarray_setelement(objectndarray *a, unsigned int ndim, int *indx, double in) {
+    ptrdiff_t k;
+    if (!ndarray_offset(a, ndim, indx, &k)) return false;
+    a->data[k]=in;
+    return true;
+}
+
+/** Resolves a list of indices into a view of an array. Integers select a single position along an axis,
+    which is dropped from the view, while ranges select evenly spaced positions; axes beyond the indices
+    supplied are kept whole. If every axis is given an integer, the view has no dimensions and refers to a single element. */
+static objectarrayerror ndarray_slice(objectndarray *a, unsigned int nindx, value *indx, objectndarray *out) {
+    double *data=a->data;
+    unsigned int ndim=0;
+
+    if (nindx>a->ndim) return ARRAY_WRONGDIM;
+
+    for (unsigned int i=0; i<a->ndim; i++) {
+        int k;
+
+        if (i>=nindx) {
+            out->shape[ndim]=a->shape[i];
+            out->stride[ndim]=a->stride[i];
+            ndim++;
+        } else if (morpho_valuetoint(indx[i], &k)) {
+            if (k<0 || k>=a->shape[i]) return ARRAY_OUTOFBOUNDS;
+            data+=(ptrdiff_t) k*a->stride[i];
+        } else if (MORPHO_ISRANGE(indx[i])) {
+            objectrange *r = MORPHO_GETRANGE(indx[i]);
+            int n=range_count(r), start=0, step=1;
+
+            if (n>0) {
+                if (!morpho_valuetoint(range_iterate(r, 0), &start)) return ARRAY_NONINTINDX;
+                if (n>1) {
+                    int next;
+                    if (!morpho_valuetoint(range_iterate(r, 1), &next)) return ARRAY_NONINTINDX;
+                    step=next-start;
+                }
+                int end=start+(n-1)*step;
+                if (start<0 || start>=a->shape[i] || end<0 || end>=a->shape[i]) return ARRAY_OUTOFBOUNDS;
+                data+=(ptrdiff_t) start*a->stride[i];
+            }
+
+            out->shape[ndim]=n;
+            out->stride[ndim]=a->stride[i]*step;
+            ndim++;
+        } else return ARRAY_NONINTINDX;
+    }
+
+    out->ndim=ndim;
+    out->count=ndarray_countelements(ndim, out->shape);
+    out->store=ndarray_owner(a);
+    out->data=data;
+
+    return ARRAY_OK;
+}
+
+/** Computes the shape that two arrays broadcast to, and the strides with which each is addressed in it.
+    Shapes are aligned at their last axis; an axis of length one, or one that is missing, is repeated. */
+static bool ndarray_broadcast(objectndarray *a, objectndarray *b, unsigned int *ndim, unsigned int *shape, int *sa, int *sb) {
+    unsigned int n = (a->ndim>b->ndim ? a->ndim : b->ndim);
+
+    for (unsigned int i=0; i<n; i++) {
+        int ia=(int) i-(int) (n-a->ndim), ib=(int) i-(int) (n-b->ndim);
+        unsigned int da=(ia>=0 ? a->shape[ia] : 1), db=(ib>=0 ? b->shape[ib] : 1);
+
+        if (da!=db && da!=1 && db!=1) return false;
+        shape[i]=(da==1 ? db : da);
+        sa[i]=(da==1 ? 0 : a->stride[ia]);
+        sb[i]=(db==1 ? 0 : b->stride[ib]);
+    }
+
+    *ndim=n;
+    return true;
+}
+
+/** Copies the elements of src into dest, broadcasting src to the shape of dest */
+static bool ndarray_assign(objectndarray *dest, objectndarray *src) {
+    unsigned int ndim, shape[NDARRAY_MAXDIM];
+    int sd[NDARRAY_MAXDIM], ss[NDARRAY_MAXDIM];
+
+    if (src->ndim>dest->ndim ||
+        !ndarray_broadcast(dest, src, &ndim, shape, sd, ss)) return false;
+    for (unsigned int i=0; i<ndim; i++) if (shape[i]!=dest->shape[i]) return false;
+
+    /* Copy through a temporary if the source and destination share storage */
+    objectndarray *tmp=NULL;
+    if (MORPHO_ISSAME(ndarray_owner(dest), ndarray_owner(src))) {
+        tmp=object_clonendarray(src);
+        if (!tmp) return false;
+        src=tmp;
+        ndarray_broadcast(dest, src, &ndim, shape, sd, ss);
+    }
+
+    ndarray_apply(NDARRAY_COPY, ndim, shape, dest->data, dest->stride, src->data, ss, src->data, ss);
+
+    if (tmp) object_free((object *) tmp);
+    return true;
+}
+
+/** Sets every element of an array to a given value */
+static void ndarray_fill(objectndarray *a, double x) {
+    int zero[NDARRAY_MAXDIM] = { 0 };
+    ndarray_apply(NDARRAY_COPY, a->ndim, a->shape, a->data, a->stride, &x, zero, &x, zero);
+}
+
+/** Finds the element at a given position in row-major order */
+static double ndarray_elementinorder(objectndarray *a, unsigned int i) {
+    ptrdiff_t k=0;
+    for (int d=(int) a->ndim-1; d>=0; d--) {
+        k+=(ptrdiff_t) (i % a->shape[d])*a->stride[d];
+        i/=a->shape[d];
+    }
+    return a->data[k];
+}
+
+/** Print an array recursively */
+static void ndarray_printrecurse(vm *v, objectndarray *a, double *data, unsigned int dim, varray_char *out) {
+    varray_charadd(out, "[ ", 2);
+    for (unsigned int i=0; i<a->shape[dim]; i++) {
+        double *el=data+(ptrdiff_t) i*a->stride[dim];
+        if (dim==a->ndim-1) morpho_printtobuffer(v, MORPHO_FLOAT(*el), out);
+        else ndarray_printrecurse(v, a, el, dim+1, out);
+
+        if (i<a->shape[dim]-1) varray_charadd(out, ", ", 2);
+    }
+    varray_charadd(out, " ]", 2);
+}
+
+/** Sum, minimum or maximum of the elements */
+typedef enum { NDARRAY_SUM, NDARRAY_MIN, NDARRAY_MAX } ndarrayreduction;
+
+static double ndarray_reduce(objectndarray *a, ndarrayreduction op) {
+    objectndarray *tmp=NULL;
+    if (!ndarray_iscontiguous(a)) tmp=a=object_clonendarray(a);
+    if (!a) return 0.0;
+
+    double *x=a->data, r=(op==NDARRAY_SUM ? 0.0 : x[0]);
+    unsigned int n=a->count;
+
+    switch (op) {
+        case NDARRAY_SUM: {
+            double c=0.0; // Kahan summation, as for matrices
+            for (unsigned int i=0; i<n; i++) {
+                double y=x[i]-c, t=r+y;
+                c=(t-r)-y;
+                r=t;
+            }
+        }
+            break;
+        case NDARRAY_MIN: for (unsigned int i=1; i<n; i++) if (x[i]<r) r=x[i];
+            break;
+        case NDARRAY_MAX: for (unsigned int i=1; i<n; i++) if (x[i]>r) r=x[i];
+            break;
+    }
+
+    if (tmp) object_free((object *) tmp);
+    return r;
+}
+
+/* **********************************************************************
+ * NDArray veneer class
+ * ********************************************************************* */
+
+/** Recursively finds the shape of a nested list */
+static bool ndarray_listshape(objectlist *list, unsigned int *ndim, unsigned int *shape) {
+    if (*ndim>=NDARRAY_MAXDIM) return false;
+    shape[(*ndim)++]=list->val.count;
+    if (list->val.count && MORPHO_ISLIST(list->val.data[0])) return ndarray_listshape(MORPHO_GETLIST(list->val.data[0]), ndim, shape);
+    return true;
+}
+
+/** Recursively copies a nested list into an array, checking that the list is rectangular */
+static bool ndarray_copyfromlist(objectlist *list, objectndarray *a, unsigned int dim, double **out) {
+    if (list->val.count!=a->shape[dim]) return false;
+
+    for (unsigned int i=0; i<list->val.count; i++) {
+        value el=list->val.data[i];
+        if (dim<a->ndim-1) {
+            if (!MORPHO_ISLIST(el) || !ndarray_copyfromlist(MORPHO_GETLIST(el), a, dim+1, out)) return false;
+        } else if (!morpho_valuetofloat(el, *out)) return false;
+        else (*out)++;
+    }
+
+    return true;
+}
+
+/** Copies an Array of numbers into a new ndarray */
+static objectndarray *ndarray_fromarray(objectarray *in) {
+    unsigned int ndim=in->ndim, shape[NDARRAY_MAXDIM];
+    if (ndim>NDARRAY_MAXDIM) return NULL;
+    for (unsigned int i=0; i<ndim; i++) shape[i]=MORPHO_GETINTEGERVALUE(in->dimensions[i]);
+
+    objectndarray *new = object_newndarray(ndim, shape, false);
+    if (!new) return NULL;
+
+    unsigned int indx[NDARRAY_MAXDIM];
+    for (unsigned int k=0; k<new->count; k++) {
+        unsigned int r=k;
+        for (int d=(int) ndim-1; d>=0; d--) {
+            indx[d]=r % shape[d];
+            r/=shape[d];
+        }
+
+        value val;
+        if (array_getelement(in, ndim, indx, &val)!=ARRAY_OK ||
+            !morpho_valuetofloat(val, new->data+k)) {
+            object_free((object *) new);
+            return NULL;
+        }
+    }
+
+    return new;
+}
+
+/** Constructs an ndarray */
+value ndarray_constructor(vm *v, int nargs, value *args) {
+    value out=MORPHO_NIL;
+    objectndarray *new=NULL;
+    value init=(nargs==1 ? MORPHO_GETARG(args, 0) : MORPHO_NIL);
+
+    if (nargs>NDARRAY_MAXDIM) MORPHO_RAISE(v, NDARRAY_MAXDIMS);
+
+    if (MORPHO_ISLIST(init)) {
+        unsigned int ndim=0, shape[NDARRAY_MAXDIM];
+        if (!ndarray_listshape(MORPHO_GETLIST(init), &ndim, shape)) MORPHO_RAISE(v, NDARRAY_MAXDIMS);
+
+        new=object_newndarray(ndim, shape, false);
+        double *el=(new ? new->data : NULL);
+        if (new && !ndarray_copyfromlist(MORPHO_GETLIST(init), new, 0, &el)) {
+            object_free((object *) new);
+            MORPHO_RAISE(v, NDARRAY_CONSTRUCTOR);
+        }
+    } else if (MORPHO_ISARRAY(init)) {
+        new=ndarray_fromarray(MORPHO_GETARRAY(init));
+        if (!new) MORPHO_RAISE(v, NDARRAY_NONNUM);
+    } else if (MORPHO_ISMATRIX(init)) {
+        new=object_ndarrayfrommatrix(MORPHO_GETMATRIX(init));
+    } else if (MORPHO_ISNDARRAY(init)) {
+        new=object_clonendarray(MORPHO_GETNDARRAY(init));
+    } else if (nargs>0) {
+        unsigned int shape[NDARRAY_MAXDIM];
+        for (unsigned int i=0; i<nargs; i++) {
+            value dim=MORPHO_GETARG(args, i);
+            if (!MORPHO_ISINTEGER(dim) || MORPHO_GETINTEGERVALUE(dim)<0) MORPHO_RAISE(v, NDARRAY_CONSTRUCTOR);
+            shape[i]=MORPHO_GETINTEGERVALUE(dim);
+        }
+        new=object_newndarray(nargs, shape, true);
+    } else MORPHO_RAISE(v, NDARRAY_CONSTRUCTOR);
+
+    if (new) {
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+
+    return out;
+}
+
+/** Gets an element, or a view of a slice of the array */
+value NDArray_getindex(vm *v, int nargs, value *args) {
+    objectndarray *slf = MORPHO_GETNDARRAY(MORPHO_SELF(args));
+    objectndarray view;
+    value out=MORPHO_NIL;
+
+    objectarrayerror err=ndarray_slice(slf, nargs, &MORPHO_GETARG(args, 0), &view);
+    if (err!=ARRAY_OK) MORPHO_RAISE(v, array_error(err));
+
+    if (view.ndim==0) return MORPHO_FLOAT(*view.data);
+
+    objectndarray *new=object_ndarrayview(slf);
+    if (new) {
+        new->ndim=view.ndim;
+        new->count=view.count;
+        memcpy(new->shape, view.shape, sizeof(view.shape));
+        memcpy(new->stride, view.stride, sizeof(view.stride));
+        new->data=view.data;
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+
+    return out;
+}
+
+/** Sets an element, or assigns a number or an array to a slice */
+value NDArray_setindex(vm *v, int nargs, value *args) {
+    objectndarray *slf = MORPHO_GETNDARRAY(MORPHO_SELF(args));
+    objectndarray view;
+    double x;
+
+    if (nargs<2) MORPHO_RAISE(v, SETINDEX_ARGS);
+    value in=MORPHO_GETARG(args, nargs-1);
+
+    objectarrayerror err=ndarray_slice(slf, nargs-1, &MORPHO_GETARG(args, 0), &view);
+    if (err!=ARRAY_OK) MORPHO_RAISE(v, array_error(err));
+
+    if (morpho_valuetofloat(in, &x)) {
+        if (view.ndim==0) *view.data=x;
+        else ndarray_fill(&view, x);
+    } else if (MORPHO_ISNDARRAY(in) && view.ndim>0) {
+        if (!ndarray_assign(&view, MORPHO_GETNDARRAY(in))) morpho_runtimeerror(v, NDARRAY_INCOMPATIBLE);
+    } else morpho_runtimeerror(v, NDARRAY_NONNUM);
+
+    return MORPHO_NIL;
+}
+
+/** Prints an ndarray */
+value NDArray_print(vm *v, int nargs, value *args) {
+    value self = MORPHO_SELF(args);
+    if (!MORPHO_ISNDARRAY(self)) return Object_print(v, nargs, args);
+
+    objectndarray *a=MORPHO_GETNDARRAY(self);
+    varray_char out;
+    varray_charinit(&out);
+
+    ndarray_printrecurse(v, a, a->data, 0, &out);
+    printf("%.*s", out.count, out.data);
+
+    varray_charclear(&out);
+    return MORPHO_NIL;
+}
+
+/** Number of elements */
+value NDArray_count(vm *v, int nargs, value *args) {
+    return MORPHO_INTEGER(MORPHO_GETNDARRAY(MORPHO_SELF(args))->count);
+}
+
+/** Dimensions of the array as a List */
+value NDArray_dimensions(vm *v, int nargs, value *args) {
+    objectndarray *slf = MORPHO_GETNDARRAY(MORPHO_SELF(args));
+    value dim[NDARRAY_MAXDIM], out=MORPHO_NIL;
+
+    for (unsigned int i=0; i<slf->ndim; i++) dim[i]=MORPHO_INTEGER(slf->shape[i]);
+
+    objectlist *new=object_newlist(slf->ndim, dim);
+    if (new) {
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+
+    return out;
+}
+
+/** Enumerate protocol; elements are visited in row-major order */
+value NDArray_enumerate(vm *v, int nargs, value *args) {
+    objectndarray *slf = MORPHO_GETNDARRAY(MORPHO_SELF(args));
+    value out=MORPHO_NIL;
+
+    if (nargs==1 && MORPHO_ISINTEGER(MORPHO_GETARG(args, 0))) {
+        int i=MORPHO_GETINTEGERVALUE(MORPHO_GETARG(args, 0));
+
+        if (i<0) out=MORPHO_INTEGER(slf->count);
+        else if (i<slf->count) out=MORPHO_FLOAT(ndarray_elementinorder(slf, i));
+        else morpho_runtimeerror(v, VM_OUTOFBOUNDS);
+    } else MORPHO_RAISE(v, ENUMERATE_ARGS);
+
+    return out;
+}
+
+/** Clones an ndarray; the clone is contiguous and owns its data */
+value NDArray_clone(vm *v, int nargs, value *args) {
+    objectndarray *slf = MORPHO_GETNDARRAY(MORPHO_SELF(args));
+    value out=MORPHO_NIL;
+    objectndarray *new=object_clonendarray(slf);
+    if (new) {
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+    return out;
+}
+
+/** Sets every element to a given value */
+value NDArray_fill(vm *v, int nargs, value *args) {
+    double x;
+
+    if (nargs==1 && morpho_valuetofloat(MORPHO_GETARG(args, 0), &x)) {
+        ndarray_fill(MORPHO_GETNDARRAY(MORPHO_SELF(args)), x);
+    } else MORPHO_RAISE(v, NDARRAY_NONNUM);
+
+    return MORPHO_SELF(args);
+}
+
+/** Sum, minimum and maximum of the elements */
+value NDArray_sum(vm *v, int nargs, value *args) {
+    return MORPHO_FLOAT(ndarray_reduce(MORPHO_GETNDARRAY(MORPHO_SELF(args)), NDARRAY_SUM));
+}
+
+static value ndarray_extremumvalue(vm *v, value self, ndarrayreduction op) {
+    objectndarray *slf = MORPHO_GETNDARRAY(self);
+    if (!slf->count) MORPHO_RAISE(v, NDARRAY_EMPTY);
+    return MORPHO_FLOAT(ndarray_reduce(slf, op));
+}
+
+value NDArray_min(vm *v, int nargs, value *args) {
+    return ndarray_extremumvalue(v, MORPHO_SELF(args), NDARRAY_MIN);
+}
+
+value NDArray_max(vm *v, int nargs, value *args) {
+    return ndarray_extremumvalue(v, MORPHO_SELF(args), NDARRAY_MAX);
+}
+
+/** Returns a view with the axes permuted; by default the order of the axes is reversed */
+value NDArray_transpose(vm *v, int nargs, value *args) {
+    objectndarray *slf = MORPHO_GETNDARRAY(MORPHO_SELF(args));
+    unsigned int perm[NDARRAY_MAXDIM];
+    bool used[NDARRAY_MAXDIM] = { false };
+    value out=MORPHO_NIL;
+
+    if (nargs==0) {
+        for (unsigned int i=0; i<slf->ndim; i++) perm[i]=slf->ndim-1-i;
+    } else if (nargs==slf->ndim) {
+        for (unsigned int i=0; i<nargs; i++) {
+            value p=MORPHO_GETARG(args, i);
+            if (!MORPHO_ISINTEGER(p)) MORPHO_RAISE(v, NDARRAY_TRANSPOSE);
+            int k=MORPHO_GETINTEGERVALUE(p);
+            if (k<0 || k>=slf->ndim || used[k]) MORPHO_RAISE(v, NDARRAY_TRANSPOSE);
+            perm[i]=k;
+            used[k]=true;
+        }
+    } else MORPHO_RAISE(v, NDARRAY_TRANSPOSE);
+
+    objectndarray *new=object_ndarrayview(slf);
+    if (new) {
+        for (unsigned int i=0; i<slf->ndim; i++) {
+            new->shape[i]=slf->shape[perm[i]];
+            new->stride[i]=slf->stride[perm[i]];
+        }
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+
+    return out;
+}
+
+/** Returns an array with the same elements in row-major order but a different shape. Contiguous arrays
+    are reshaped without copying; otherwise the elements are copied. */
+value NDArray_reshape(vm *v, int nargs, value *args) {
+    objectndarray *slf = MORPHO_GETNDARRAY(MORPHO_SELF(args));
+    unsigned int shape[NDARRAY_MAXDIM];
+    value out=MORPHO_NIL;
+
+    if (nargs<1 || nargs>NDARRAY_MAXDIM) MORPHO_RAISE(v, NDARRAY_RESHAPE);
+    for (unsigned int i=0; i<nargs; i++) {
+        value dim=MORPHO_GETARG(args, i);
+        if (!MORPHO_ISINTEGER(dim) || MORPHO_GETINTEGERVALUE(dim)<0) MORPHO_RAISE(v, NDARRAY_RESHAPE);
+        shape[i]=MORPHO_GETINTEGERVALUE(dim);
+    }
+    if (!ndarray_isaddressable(nargs, shape) || ndarray_countelements(nargs, shape)!=slf->count) MORPHO_RAISE(v, NDARRAY_RESHAPE);
+
+    objectndarray *new=(ndarray_iscontiguous(slf) ? object_ndarrayview(slf) : object_clonendarray(slf));
+    if (new) {
+        new->ndim=nargs;
+        for (unsigned int i=0; i<nargs; i++) new->shape[i]=shape[i];
+        ndarray_setcontiguousstrides(nargs, new->shape, new->stride);
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+
+    return out;
+}
+
+/** Copies a one or two dimensional array into a Matrix */
+value NDArray_tomatrix(vm *v, int nargs, value *args) {
+    objectndarray *slf = MORPHO_GETNDARRAY(MORPHO_SELF(args));
+    value out=MORPHO_NIL;
+
+    if (slf->ndim>2) MORPHO_RAISE(v, NDARRAY_NOTMATRIX);
+
+    unsigned int nrows=slf->shape[0], ncols=(slf->ndim==2 ? slf->shape[1] : 1);
+    objectmatrix *new=object_newmatrix(nrows, ncols, false);
+    if (new) {
+        int stride[2] = { 1, nrows };
+        ndarray_apply(NDARRAY_COPY, slf->ndim, slf->shape, new->elements, stride, slf->data, slf->stride, slf->data, slf->stride);
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+
+    return out;
+}
+
+/** Describes a three dimensional array of shape [N, rows, cols] as a batch of N matrices */
+static bool ndarray_tobatch(objectndarray *a, matrixbatch *b) {
+    if (a->ndim!=3) return false;
+    b->data=a->data;
+    b->nrows=a->shape[1];
+    b->ncols=a->shape[2];
+    b->sbatch=a->stride[0];
+    b->srow=a->stride[1];
+    b->scol=a->stride[2];
+    return true;
+}
+
+/** Creates a contiguous array of shape [N, rows, cols] together with a batch that describes it */
+static objectndarray *ndarray_newbatch(unsigned int n, unsigned int nrows, unsigned int ncols, matrixbatch *b) {
+    unsigned int shape[3] = { n, nrows, ncols };
+    objectndarray *new=object_newndarray(3, shape, false);
+    if (new) ndarray_tobatch(new, b);
+    return new;
+}
+
+/** Checks that an array holds a batch of square matrices */
+static bool ndarray_issquarebatch(objectndarray *a, matrixbatch *b) {
+    return (ndarray_tobatch(a, b) && b->nrows==b->ncols);
+}
+
+/** Multiplies corresponding matrices in two batches */
+value NDArray_matmul(vm *v, int nargs, value *args) {
+    objectndarray *slf = MORPHO_GETNDARRAY(MORPHO_SELF(args));
+    matrixbatch a, b, c;
+    value out=MORPHO_NIL;
+
+    if (nargs!=1 || !MORPHO_ISNDARRAY(MORPHO_GETARG(args, 0))) MORPHO_RAISE(v, NDARRAY_BATCHMUL);
+    objectndarray *arg = MORPHO_GETNDARRAY(MORPHO_GETARG(args, 0));
+    if (!ndarray_tobatch(slf, &a) || !ndarray_tobatch(arg, &b) ||
+        slf->shape[0]!=arg->shape[0] || a.ncols!=b.nrows) MORPHO_RAISE(v, NDARRAY_BATCHMUL);
+
+    objectndarray *new=ndarray_newbatch(slf->shape[0], a.nrows, b.ncols, &c);
+    if (new) {
+        matrix_batchmul(slf->shape[0], &a, &b, &c);
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+
+    return out;
+}
+
+/** Inverts each matrix in a batch */
+value NDArray_inverse(vm *v, int nargs, value *args) {
+    objectndarray *slf = MORPHO_GETNDARRAY(MORPHO_SELF(args));
+    matrixbatch a, b;
+    value out=MORPHO_NIL;
+
+    if (!ndarray_issquarebatch(slf, &a)) MORPHO_RAISE(v, NDARRAY_BATCH);
+
+    objectndarray *new=ndarray_newbatch(slf->shape[0], a.nrows, a.ncols, &b);
+    if (new) {
+        objectmatrixerror err=matrix_batchinverse(slf->shape[0], &a, &b);
+        if (err!=MATRIX_OK) {
+            object_free((object *) new);
+            matrix_raiseerror(v, err);
+            return MORPHO_NIL;
+        }
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+
+    return out;
+}
+
+/** Finds the determinant of each matrix in a batch */
+value NDArray_det(vm *v, int nargs, value *args) {
+    objectndarray *slf = MORPHO_GETNDARRAY(MORPHO_SELF(args));
+    matrixbatch a;
+    value out=MORPHO_NIL;
+
+    if (!ndarray_issquarebatch(slf, &a)) MORPHO_RAISE(v, NDARRAY_BATCH);
+
+    objectndarray *new=object_newndarray(1, slf->shape, false);
+    if (new) {
+        objectmatrixerror err=matrix_batchdet(slf->shape[0], &a, new->data, 1);
+        if (err!=MATRIX_OK) {
+            object_free((object *) new);
+            matrix_raiseerror(v, err);
+            return MORPHO_NIL;
+        }
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+
+    return out;
+}
+
+/** Finds the eigenvalues, and optionally the eigenvectors, of each matrix in a batch of symmetric matrices */
+static value ndarray_eigensym(vm *v, value self, bool vectors) {
+    objectndarray *slf = MORPHO_GETNDARRAY(self);
+    unsigned int n=(slf->ndim ? slf->shape[0] : 0);
+    matrixbatch a, evals, evecs;
+    value out=MORPHO_NIL;
+
+    if (!ndarray_issquarebatch(slf, &a)) MORPHO_RAISE(v, NDARRAY_BATCH);
+
+    unsigned int shape[2] = { n, a.nrows };
+    objectndarray *vals=object_newndarray(2, shape, false);
+    objectndarray *vecs=(vectors ? ndarray_newbatch(n, a.nrows, a.ncols, &evecs) : NULL);
+    objectlist *list=(vectors ? object_newlist(0, NULL) : NULL);
+
+    if (!vals || (vectors && (!vecs || !list))) {
+        if (vals) object_free((object *) vals);
+        if (vecs) object_free((object *) vecs);
+        if (list) object_free((object *) list);
+        morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+        return MORPHO_NIL;
+    }
+
+    evals.data=vals->data; // Eigenvalues of each matrix form a column vector
+    evals.nrows=a.nrows;
+    evals.ncols=1;
+    evals.sbatch=vals->stride[0];
+    evals.srow=vals->stride[1];
+    evals.scol=0;
+
+    matrix_batcheigensym(n, &a, &evals, (vectors ? &evecs : NULL));
+
+    if (vectors) {
+        value objs[3] = { MORPHO_OBJECT(vals), MORPHO_OBJECT(vecs), MORPHO_OBJECT(list) };
+        list_append(list, objs[0]);
+        list_append(list, objs[1]);
+        morpho_bindobjects(v, 3, objs);
+        out=objs[2];
+    } else {
+        out=MORPHO_OBJECT(vals);
+        morpho_bindobjects(v, 1, &out);
+    }
+
+    return out;
+}
+
+value NDArray_eigenvalues(vm *v, int nargs, value *args) {
+    return ndarray_eigensym(v, MORPHO_SELF(args), false);
+}
+
+value NDArray_eigensystem(vm *v, int nargs, value *args) {
+    return ndarray_eigensym(v, MORPHO_SELF(args), true);
+}
+
+/** Elementwise arithmetic with a number or with an array that broadcasts against this one.
+    If right is set, the operands are exchanged so that the argument is on the left. */
+static value ndarray_arithmetic(vm *v, ndarrayop op, bool right, int nargs, value *args) {
+    objectndarray *a = MORPHO_GETNDARRAY(MORPHO_SELF(args));
+    unsigned int ndim, shape[NDARRAY_MAXDIM];
+    int sa[NDARRAY_MAXDIM], sb[NDARRAY_MAXDIM];
+    double *b, scalar;
+    value out=MORPHO_NIL;
+
+    if (nargs!=1) MORPHO_RAISE(v, NDARRAY_ARITHARGS);
+    value arg=MORPHO_GETARG(args, 0);
+
+    if (MORPHO_ISNDARRAY(arg)) {
+        if (!ndarray_broadcast(a, MORPHO_GETNDARRAY(arg), &ndim, shape, sa, sb)) MORPHO_RAISE(v, NDARRAY_INCOMPATIBLE);
+        b=MORPHO_GETNDARRAY(arg)->data;
+    } else if (morpho_valuetofloat(arg, &scalar)) {
+        ndim=a->ndim;
+        for (unsigned int i=0; i<ndim; i++) {
+            shape[i]=a->shape[i];
+            sa[i]=a->stride[i];
+            sb[i]=0;
+        }
+        b=&scalar;
+    } else MORPHO_RAISE(v, NDARRAY_ARITHARGS);
+
+    objectndarray *new=object_newndarray(ndim, shape, false);
+    if (new) {
+        if (right) ndarray_apply(op, ndim, shape, new->data, new->stride, b, sb, a->data, sa);
+        else ndarray_apply(op, ndim, shape, new->data, new->stride, a->data, sa, b, sb);
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+
+    return out;
+}
+
+value NDArray_add(vm *v, int nargs, value *args) {
+    return ndarray_arithmetic(v, NDARRAY_ADD, false, nargs, args);
+}
+
+/** Right add; adding nil returns a copy so that arrays can be summed starting from nil */
+value NDArray_addr(vm *v, int nargs, value *args) {
+    if (nargs==1 && MORPHO_ISNIL(MORPHO_GETARG(args, 0))) return NDArray_clone(v, 0, args);
+    return ndarray_arithmetic(v, NDARRAY_ADD, true, nargs, args);
+}
+
+value NDArray_sub(vm *v, int nargs, value *args) {
+    return ndarray_arithmetic(v, NDARRAY_SUB, false, nargs, args);
+}
+
+value NDArray_subr(vm *v, int nargs, value *args) {
+    return ndarray_arithmetic(v, NDARRAY_SUB, true, nargs, args);
+}
+
+value NDArray_mul(vm *v, int nargs, value *args) {
+    return ndarray_arithmetic(v, NDARRAY_MUL, false, nargs, args);
+}
+
+value NDArray_mulr(vm *v, int nargs, value *args) {
+    return ndarray_arithmetic(v, NDARRAY_MUL, true, nargs, args);
+}
+
+value NDArray_div(vm *v, int nargs, value *args) {
+    return ndarray_arithmetic(v, NDARRAY_DIV, false, nargs, args);
+}
+
+value NDArray_divr(vm *v, int nargs, value *args) {
+    return ndarray_arithmetic(v, NDARRAY_DIV, true, nargs, args);
+}
+
+MORPHO_BEGINCLASS(NDArray)
+MORPHO_METHOD(MORPHO_GETINDEX_METHOD, NDArray_getindex, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_SETINDEX_METHOD, NDArray_setindex, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_PRINT_METHOD, NDArray_print, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_COUNT_METHOD, NDArray_count, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(ARRAY_DIMENSIONS_METHOD, NDArray_dimensions, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_ENUMERATE_METHOD, NDArray_enumerate, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_CLONE_METHOD, NDArray_clone, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(NDARRAY_FILL_METHOD, NDArray_fill, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_SUM_METHOD, NDArray_sum, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(NDARRAY_MIN_METHOD, NDArray_min, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(NDARRAY_MAX_METHOD, NDArray_max, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(NDARRAY_TRANSPOSE_METHOD, NDArray_transpose, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(NDARRAY_RESHAPE_METHOD, NDArray_reshape, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(NDARRAY_TOMATRIX_METHOD, NDArray_tomatrix, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(NDARRAY_MATMUL_METHOD, NDArray_matmul, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MATRIX_INVERSE_METHOD, NDArray_inverse, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MATRIX_DET_METHOD, NDArray_det, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MATRIX_EIGENVALUES_METHOD, NDArray_eigenvalues, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MATRIX_EIGENSYSTEM_METHOD, NDArray_eigensystem, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_ADD_METHOD, NDArray_add, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_ADDR_METHOD, NDArray_addr, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_SUB_METHOD, NDArray_sub, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_SUBR_METHOD, NDArray_subr, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_MUL_METHOD, NDArray_mul, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_MULR_METHOD, NDArray_mulr, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_DIV_METHOD, NDArray_div, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_DIVR_METHOD, NDArray_divr, BUILTIN_FLAGSEMPTY)
+MORPHO_ENDCLASS
+
+/* **********************************************************************
+ * Initialization
+ * ********************************************************************* */
+
+void ndarray_initialize(void) {
+    objectndarraytype=object_addtype(&objectndarraydefn);
+
+    builtin_addfunction(NDARRAY_CLASSNAME, ndarray_constructor, BUILTIN_FLAGSCONSTRUCTOR);
+
+    objectstring objname = MORPHO_STATICSTRING(OBJECT_CLASSNAME);
+    value objclass = builtin_findclass(MORPHO_OBJECT(&objname));
+
+    value ndarrayclass=builtin_addclass(NDARRAY_CLASSNAME, MORPHO_GETCLASSDEFINITION(NDArray), objclass);
+    object_setveneerclass(OBJECT_NDARRAY, ndarrayclass);
+
+    morpho_defineerror(NDARRAY_CONSTRUCTOR, ERROR_HALT, NDARRAY_CONSTRUCTOR_MSG);
+    morpho_defineerror(NDARRAY_NONNUM, ERROR_HALT, NDARRAY_NONNUM_MSG);
+    morpho_defineerror(NDARRAY_MAXDIMS, ERROR_HALT, NDARRAY_MAXDIMS_MSG);
+    morpho_defineerror(NDARRAY_INCOMPATIBLE, ERROR_HALT, NDARRAY_INCOMPATIBLE_MSG);
+    morpho_defineerror(NDARRAY_ARITHARGS, ERROR_HALT, NDARRAY_ARITHARGS_MSG);
+    morpho_defineerror(NDARRAY_RESHAPE, ERROR_HALT, NDARRAY_RESHAPE_MSG);
+    morpho_defineerror(NDARRAY_TRANSPOSE, ERROR_HALT, NDARRAY_TRANSPOSE_MSG);
+    morpho_defineerror(NDARRAY_NOTMATRIX, ERROR_HALT, NDARRAY_NOTMATRIX_MSG);
+    morpho_defineerror(NDARRAY_EMPTY, ERROR_HALT, NDARRAY_EMPTY_MSG);
+    morpho_defineerror(NDARRAY_BATCH, ERROR_HALT, NDARRAY_BATCH_MSG);
+    morpho_defineerror(NDARRAY_BATCHMUL, ERROR_HALT, NDARRAY_BATCHMUL_MSG);
+}
@@ -0,0 +1,106 @@
+/** @file ndarray.h
+ *  @author T J Atherton
+ *
+ *  @brief Veneer class over the objectndarray type, a strided multidimensional array of doubles
+ */
+
+#ifndef ndarray_h
+#define ndarray_h
+
+#include <stdio.h>
+#include "veneer.h"
+
+/* -------------------------------------------------------
+ * NDArray objects
+ * ------------------------------------------------------- */
+
+extern objecttype objectndarraytype;
+#define OBJECT_NDARRAY objectndarraytype
+
+/** Maximum number of dimensions */
+#define NDARRAY_MAXDIM 8
+
+/** NDArrays hold numbers unboxed in contiguous storage, addressed through a shape and per-axis strides
+    (counted in elements), so that slices and transpositions can refer to the storage of another array
+    rather than copy it. In that case store refers to the object that owns the storage, which is kept alive by
+    the view, and data points to the view's first element; changes to either are visible in both. */
+typedef struct {
+    object obj;
+    unsigned int ndim;
+    unsigned int count;
+    unsigned int shape[NDARRAY_MAXDIM];
+    int stride[NDARRAY_MAXDIM];
+    value store; /** Object whose storage is viewed, or nil if data is owned by the array */
+    double *data;
+} objectndarray;
+
+/** Tests whether an object is an ndarray */
+#define MORPHO_ISNDARRAY(val) object_istype(val, OBJECT_NDARRAY)
+
+/** Gets the object as an ndarray */
+#define MORPHO_GETNDARRAY(val)   ((objectndarray *) MORPHO_GETOBJECT(val))
+
+/** Creates a contiguous ndarray with a given shape */
+objectndarray *object_newndarray(unsigned int ndim, unsigned int *shape, bool zero);
+
+/** Creates a contiguous copy of an ndarray */
+objectndarray *object_clonendarray(objectndarray *a);
+
+/* -------------------------------------------------------
+ * NDArray class
+ * ------------------------------------------------------- */
+
+#define NDARRAY_CLASSNAME "NDArray"
+
+#define NDARRAY_TRANSPOSE_METHOD "transpose"
+#define NDARRAY_RESHAPE_METHOD "reshape"
+#define NDARRAY_FILL_METHOD "fill"
+#define NDARRAY_MIN_METHOD "min"
+#define NDARRAY_MAX_METHOD "max"
+#define NDARRAY_TOMATRIX_METHOD "tomatrix"
+#define NDARRAY_MATMUL_METHOD "matmul"
+
+#define NDARRAY_CONSTRUCTOR               "NDArrCns"
+#define NDARRAY_CONSTRUCTOR_MSG           "NDArray should be called with integer dimensions or a List, Array, Matrix or NDArray initializer."
+
+#define NDARRAY_NONNUM                    "NDArrNnNm"
+#define NDARRAY_NONNUM_MSG                "NDArrays can only hold numbers."
+
+#define NDARRAY_MAXDIMS                   "NDArrMxDm"
+#define NDARRAY_MAXDIMS_MSG               "NDArrays may have at most 8 dimensions."
+
+#define NDARRAY_INCOMPATIBLE              "NDArrIncmptbl"
+#define NDARRAY_INCOMPATIBLE_MSG          "NDArray shapes cannot be broadcast together."
+
+#define NDARRAY_ARITHARGS                 "NDArrArith"
+#define NDARRAY_ARITHARGS_MSG             "NDArray arithmetic methods expect an NDArray or a number as the argument."
+
+#define NDARRAY_RESHAPE                   "NDArrRshp"
+#define NDARRAY_RESHAPE_MSG               "Reshape requires integer dimensions whose product is the number of elements."
+
+#define NDARRAY_TRANSPOSE                 "NDArrTrnsps"
+#define NDARRAY_TRANSPOSE_MSG             "Transpose requires a permutation of the array's axes."
+
+#define NDARRAY_NOTMATRIX                 "NDArrNtMtrx"
+#define NDARRAY_NOTMATRIX_MSG             "Only one or two dimensional NDArrays can be converted to a Matrix."
+
+#define NDARRAY_EMPTY                     "NDArrEmpty"
+#define NDARRAY_EMPTY_MSG                 "NDArray is empty."
+
+#define NDARRAY_BATCH                     "NDArrBtch"
+#define NDARRAY_BATCH_MSG                 "Method expects a three dimensional NDArray holding a batch of square matrices."
+
+#define NDARRAY_BATCHMUL                  "NDArrBtchMl"
+#define NDARRAY_BATCHMUL_MSG              "Method matmul expects an NDArray holding a batch of the same number of matrices with compatible dimensions."
+
+/* -------------------------------------------------------
+ * NDArray interface
+ * ------------------------------------------------------- */
+
+bool ndarray_iscontiguous(objectndarray *a);
+bool ndarray_getelement(objectndarray *a, unsigned int ndim, int *indx, double *out);
+bool ndarray_setelement(objectndarray *a, unsigned int ndim, int *indx, double in);
+
+void ndarray_initialize(void);
+
+#endif /* ndarray_h */
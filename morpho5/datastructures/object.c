@@ -573,6 +573,7 @@ value object_stringfromcstring(const char *in, size_t length) {
 
     if (new) {
         new->string=new->stringdata;
+        new->interned=false;
         new->string[length] = '\0'; /* Zero terminate the string to be compatible with C */
         memcpy(new->string, in, length);
         new->length=strlen(new->string);
@@ -613,6 +614,7 @@ value object_concatenatestring(value a, value b) {
 
     if (new) {
         new->string=new->stringdata;
+        new->interned=false;
         new->length=length;
         /* Copy across old strings */
         if (astring) memcpy(new->string, astring->string, astring->length);
@@ -657,7 +659,10 @@ objecttypedefn objectdictionarydefn = {
 objectdictionary *object_newdictionary(void) {
     objectdictionary *new = (objectdictionary *) object_new(sizeof(objectdictionary), OBJECT_DICTIONARY);
 
-    if (new) dictionary_init(&new->dict);
+    if (new) {
+        dictionary_init(&new->dict);
+        dictionary_cursorinit(&new->cursor);
+    }
 
     return new;
 }
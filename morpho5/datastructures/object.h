@@ -81,6 +81,13 @@ typedef void (*objectfreefn) (object *obj);
 /** Returns the size of an object and allocated data */
 typedef size_t (*objectsizefn) (object *obj);
 
+/** Optionally looks up a property of an object, returning false if it has no property with that key */
+typedef bool (*objectgetpropertyfn) (object *obj, value key, value *out);
+
+/** Optionally sets a property of an object, returning NULL on success or the id of an error to raise;
+    the error message is supplied with the property name */
+typedef char * (*objectsetpropertyfn) (object *obj, value key, value val);
+
 /** Define a custom object type */
 typedef struct {
     object *veneer; // Veneer class
@@ -88,6 +95,8 @@ typedef struct {
     objectmarkfn markfn;
     objectsizefn sizefn;
     objectprintfn printfn;
+    objectgetpropertyfn getpropertyfn; // Optional; properties are looked up before veneer methods
+    objectsetpropertyfn setpropertyfn; // Optional; without it objects have no settable properties
 } objecttypedefn;
 
 DECLARE_VARRAY(objecttypedefn, objecttypedefn)
@@ -300,6 +309,7 @@ extern objecttype objectstringtype;
 typedef struct {
     object obj;
     size_t length;
+    bool interned; /** Set while the string is held in the table of interned strings of the VM it is bound to */
     char *string;
     char stringdata[];
 } objectstring;
@@ -307,6 +317,7 @@ typedef struct {
 #define MORPHO_GETSTRING(val)             ((objectstring *) MORPHO_GETOBJECT(val))
 #define MORPHO_GETCSTRING(val)            (((objectstring *) MORPHO_GETOBJECT(val))->string)
 #define MORPHO_GETSTRINGLENGTH(val)       (((objectstring *) MORPHO_GETOBJECT(val))->length)
+#define MORPHO_ISINTERNEDSTRING(val)      (((objectstring *) MORPHO_GETOBJECT(val))->interned)
 
 /** Tests whether an object is a string */
 #define MORPHO_ISSTRING(val) object_istype(val, OBJECT_STRING)
@@ -336,6 +347,7 @@ extern objecttype objectdictionarytype;
 typedef struct {
     object obj;
     dictionary dict;
+    dictionarycursor cursor; /** Position reached by enumerate */
 } objectdictionary;
 
 /** Tests whether an object is a dictionary */
@@ -0,0 +1,270 @@
+/** @file priorityqueue.c
+ *  @author T J Atherton
+ *
+ *  @brief Veneer class over the objectpriorityqueue type, a binary heap of values ordered by numerical priority
+ */
+
+#include <string.h>
+#include <math.h>
+#include "object.h"
+#include "priorityqueue.h"
+#include "morpho.h"
+#include "builtin.h"
+#include "veneer.h"
+#include "common.h"
+
+/* **********************************************************************
+ * PriorityQueue objects
+ * ********************************************************************** */
+
+objecttype objectpriorityqueuetype;
+
+/** Function object definitions */
+size_t objectpriorityqueue_sizefn(object *obj) {
+    return sizeof(objectpriorityqueue)+((objectpriorityqueue *) obj)->capacity*sizeof(priorityqueueentry);
+}
+
+void objectpriorityqueue_printfn(object *obj) {
+    printf("<PriorityQueue>");
+}
+
+void objectpriorityqueue_markfn(object *obj, void *v) {
+    objectpriorityqueue *q = (objectpriorityqueue *) obj;
+    for (unsigned int i=0; i<q->count; i++) morpho_markvalue(v, q->entries[i].val);
+}
+
+void objectpriorityqueue_freefn(object *obj) {
+    objectpriorityqueue *q = (objectpriorityqueue *) obj;
+    if (q->entries) MORPHO_FREE(q->entries);
+}
+
+objecttypedefn objectpriorityqueuedefn = {
+    .printfn=objectpriorityqueue_printfn,
+    .markfn=objectpriorityqueue_markfn,
+    .freefn=objectpriorityqueue_freefn,
+    .sizefn=objectpriorityqueue_sizefn
+};
+
+/** Creates an empty priorityqueue */
+objectpriorityqueue *object_newpriorityqueue(void) {
+    objectpriorityqueue *new = (objectpriorityqueue *) object_new(sizeof(objectpriorityqueue), OBJECT_PRIORITYQUEUE);
+
+    if (new) {
+        new->count=0;
+        new->capacity=0;
+        new->norder=0;
+        new->entries=NULL;
+    }
+
+    return new;
+}
+
+/* **********************************************************************
+ * PriorityQueue operations
+ * ********************************************************************* */
+
+/** Tests whether entry a should leave the queue before entry b */
+static inline bool priorityqueue_precedes(priorityqueueentry *a, priorityqueueentry *b) {
+    return (a->priority<b->priority || (a->priority==b->priority && a->order<b->order));
+}
+
+/** Moves the entry at i up the heap until its parent precedes it */
+static void priorityqueue_siftup(objectpriorityqueue *q, unsigned int i) {
+    priorityqueueentry e = q->entries[i];
+
+    while (i>0) {
+        unsigned int parent = (i-1)/2;
+        if (!priorityqueue_precedes(&e, &q->entries[parent])) break;
+        q->entries[i]=q->entries[parent];
+        i=parent;
+    }
+
+    q->entries[i]=e;
+}
+
+/** Moves the entry at i down the heap until it precedes its children */
+static void priorityqueue_siftdown(objectpriorityqueue *q, unsigned int i) {
+    priorityqueueentry e = q->entries[i];
+
+    for (;;) {
+        unsigned int child = 2*i+1;
+        if (child>=q->count) break;
+        if (child+1<q->count && priorityqueue_precedes(&q->entries[child+1], &q->entries[child])) child++;
+        if (!priorityqueue_precedes(&q->entries[child], &e)) break;
+        q->entries[i]=q->entries[child];
+        i=child;
+    }
+
+    q->entries[i]=e;
+}
+
+/** Adds a value to the queue with a given priority */
+bool priorityqueue_push(objectpriorityqueue *q, value val, double priority) {
+    if (q->count>=q->capacity) {
+        unsigned int capacity = (q->capacity ? 2*q->capacity : 8);
+        priorityqueueentry *new = MORPHO_REALLOC(q->entries, capacity*sizeof(priorityqueueentry));
+        if (!new) return false;
+        q->entries=new;
+        q->capacity=capacity;
+    }
+
+    q->entries[q->count].priority=priority;
+    q->entries[q->count].order=q->norder++;
+    q->entries[q->count].val=val;
+    q->count++;
+    priorityqueue_siftup(q, q->count-1);
+
+    return true;
+}
+
+/** Removes the value of lowest priority from the queue; either of val and priority may be NULL */
+bool priorityqueue_pop(objectpriorityqueue *q, value *val, double *priority) {
+    if (q->count==0) return false;
+
+    if (val) *val=q->entries[0].val;
+    if (priority) *priority=q->entries[0].priority;
+
+    q->count--;
+    if (q->count>0) {
+        q->entries[0]=q->entries[q->count];
+        priorityqueue_siftdown(q, 0);
+    }
+
+    return true;
+}
+
+/* **********************************************************************
+ * PriorityQueue veneer class
+ * ********************************************************************* */
+
+/** Constructs an empty PriorityQueue */
+value priorityqueue_constructor(vm *v, int nargs, value *args) {
+    value out=MORPHO_NIL;
+    objectpriorityqueue *new=object_newpriorityqueue();
+
+    if (new) {
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+
+    return out;
+}
+
+/** Pushes a value with a given priority */
+value PriorityQueue_push(vm *v, int nargs, value *args) {
+    objectpriorityqueue *slf = MORPHO_GETPRIORITYQUEUE(MORPHO_SELF(args));
+    double priority;
+
+    // A nan priority compares false with every other and would break the heap order
+    if (nargs!=2 || !morpho_valuetofloat(MORPHO_GETARG(args, 1), &priority) || !isfinite(priority)) MORPHO_RAISE(v, PRIORITYQUEUE_PUSHARGS);
+
+    unsigned int capacity = slf->capacity;
+    if (!priorityqueue_push(slf, MORPHO_GETARG(args, 0), priority)) MORPHO_RAISE(v, ERROR_ALLOCATIONFAILED);
+    if (slf->capacity!=capacity) morpho_resizeobject(v, (object *) slf, sizeof(objectpriorityqueue)+capacity*sizeof(priorityqueueentry), sizeof(objectpriorityqueue)+slf->capacity*sizeof(priorityqueueentry));
+
+    return MORPHO_NIL;
+}
+
+/** Removes and returns the value of lowest priority */
+value PriorityQueue_pop(vm *v, int nargs, value *args) {
+    value out=MORPHO_NIL;
+    if (!priorityqueue_pop(MORPHO_GETPRIORITYQUEUE(MORPHO_SELF(args)), &out, NULL)) MORPHO_RAISE(v, PRIORITYQUEUE_EMPTY);
+    return out;
+}
+
+/** Returns the value of lowest priority without removing it */
+value PriorityQueue_peek(vm *v, int nargs, value *args) {
+    objectpriorityqueue *slf = MORPHO_GETPRIORITYQUEUE(MORPHO_SELF(args));
+    if (slf->count==0) MORPHO_RAISE(v, PRIORITYQUEUE_EMPTY);
+    return slf->entries[0].val;
+}
+
+/** Returns the lowest priority in the queue */
+value PriorityQueue_priority(vm *v, int nargs, value *args) {
+    objectpriorityqueue *slf = MORPHO_GETPRIORITYQUEUE(MORPHO_SELF(args));
+    if (slf->count==0) MORPHO_RAISE(v, PRIORITYQUEUE_EMPTY);
+    return MORPHO_FLOAT(slf->entries[0].priority);
+}
+
+/** Number of entries */
+value PriorityQueue_count(vm *v, int nargs, value *args) {
+    return MORPHO_INTEGER(MORPHO_GETPRIORITYQUEUE(MORPHO_SELF(args))->count);
+}
+
+/** Removes every entry */
+value PriorityQueue_clear(vm *v, int nargs, value *args) {
+    MORPHO_GETPRIORITYQUEUE(MORPHO_SELF(args))->count=0;
+    return MORPHO_NIL;
+}
+
+/** Enumerate protocol; entries are visited in the order they are stored, not in order of priority */
+value PriorityQueue_enumerate(vm *v, int nargs, value *args) {
+    objectpriorityqueue *slf = MORPHO_GETPRIORITYQUEUE(MORPHO_SELF(args));
+    value out=MORPHO_NIL;
+
+    if (nargs==1 && MORPHO_ISINTEGER(MORPHO_GETARG(args, 0))) {
+        int i=MORPHO_GETINTEGERVALUE(MORPHO_GETARG(args, 0));
+
+        if (i<0) out=MORPHO_INTEGER(slf->count);
+        else if (i<slf->count) out=slf->entries[i].val;
+        else morpho_runtimeerror(v, VM_OUTOFBOUNDS);
+    } else MORPHO_RAISE(v, ENUMERATE_ARGS);
+
+    return out;
+}
+
+/** Clones a PriorityQueue */
+value PriorityQueue_clone(vm *v, int nargs, value *args) {
+    objectpriorityqueue *slf = MORPHO_GETPRIORITYQUEUE(MORPHO_SELF(args));
+    objectpriorityqueue *new = object_newpriorityqueue();
+    value out=MORPHO_NIL;
+
+    if (new && slf->count) {
+        new->entries=MORPHO_MALLOC(slf->count*sizeof(priorityqueueentry));
+        if (new->entries) {
+            memcpy(new->entries, slf->entries, slf->count*sizeof(priorityqueueentry));
+            new->count=new->capacity=slf->count;
+            new->norder=slf->norder;
+        } else {
+            object_free((object *) new);
+            new=NULL;
+        }
+    }
+
+    if (new) {
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+
+    return out;
+}
+
+MORPHO_BEGINCLASS(PriorityQueue)
+MORPHO_METHOD(PRIORITYQUEUE_PUSH_METHOD, PriorityQueue_push, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(PRIORITYQUEUE_POP_METHOD, PriorityQueue_pop, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(PRIORITYQUEUE_PEEK_METHOD, PriorityQueue_peek, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(PRIORITYQUEUE_PRIORITY_METHOD, PriorityQueue_priority, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(PRIORITYQUEUE_CLEAR_METHOD, PriorityQueue_clear, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_COUNT_METHOD, PriorityQueue_count, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_ENUMERATE_METHOD, PriorityQueue_enumerate, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_CLONE_METHOD, PriorityQueue_clone, BUILTIN_FLAGSEMPTY)
+MORPHO_ENDCLASS
+
+/* **********************************************************************
+ * Initialization
+ * ********************************************************************* */
+
+void priorityqueue_initialize(void) {
+    objectpriorityqueuetype=object_addtype(&objectpriorityqueuedefn);
+
+    builtin_addfunction(PRIORITYQUEUE_CLASSNAME, priorityqueue_constructor, BUILTIN_FLAGSCONSTRUCTOR);
+
+    objectstring objname = MORPHO_STATICSTRING(OBJECT_CLASSNAME);
+    value objclass = builtin_findclass(MORPHO_OBJECT(&objname));
+
+    value priorityqueueclass=builtin_addclass(PRIORITYQUEUE_CLASSNAME, MORPHO_GETCLASSDEFINITION(PriorityQueue), objclass);
+    object_setveneerclass(OBJECT_PRIORITYQUEUE, priorityqueueclass);
+
+    morpho_defineerror(PRIORITYQUEUE_PUSHARGS, ERROR_HALT, PRIORITYQUEUE_PUSHARGS_MSG);
+    morpho_defineerror(PRIORITYQUEUE_EMPTY, ERROR_HALT, PRIORITYQUEUE_EMPTY_MSG);
+}
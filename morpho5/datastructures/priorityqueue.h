@@ -0,0 +1,74 @@
+/** @file priorityqueue.h
+ *  @author T J Atherton
+ *
+ *  @brief Veneer class over the objectpriorityqueue type, a binary heap of values ordered by numerical priority
+ */
+
+#ifndef priorityqueue_h
+#define priorityqueue_h
+
+#include <stdio.h>
+#include "veneer.h"
+
+/* -------------------------------------------------------
+ * PriorityQueue objects
+ * ------------------------------------------------------- */
+
+extern objecttype objectpriorityqueuetype;
+#define OBJECT_PRIORITYQUEUE objectpriorityqueuetype
+
+/** Each entry of a priority queue; order records when the entry was pushed, so that entries of equal
+    priority leave the queue in the order they arrived */
+typedef struct {
+    double priority;
+    unsigned long order;
+    value val;
+} priorityqueueentry;
+
+/** Priority queues keep their entries in a binary heap, so that the entry of lowest priority is always
+    at the root and pushing or popping an entry takes O(log n) steps. */
+typedef struct {
+    object obj;
+    unsigned int count;
+    unsigned int capacity;
+    unsigned long norder; /** Number of entries pushed so far */
+    priorityqueueentry *entries;
+} objectpriorityqueue;
+
+/** Tests whether an object is a priorityqueue */
+#define MORPHO_ISPRIORITYQUEUE(val) object_istype(val, OBJECT_PRIORITYQUEUE)
+
+/** Gets the object as a priorityqueue */
+#define MORPHO_GETPRIORITYQUEUE(val)   ((objectpriorityqueue *) MORPHO_GETOBJECT(val))
+
+/** Creates an empty priorityqueue */
+objectpriorityqueue *object_newpriorityqueue(void);
+
+/* -------------------------------------------------------
+ * PriorityQueue class
+ * ------------------------------------------------------- */
+
+#define PRIORITYQUEUE_CLASSNAME "PriorityQueue"
+
+#define PRIORITYQUEUE_PUSH_METHOD "push"
+#define PRIORITYQUEUE_POP_METHOD "pop"
+#define PRIORITYQUEUE_PEEK_METHOD "peek"
+#define PRIORITYQUEUE_PRIORITY_METHOD "priority"
+#define PRIORITYQUEUE_CLEAR_METHOD "clear"
+
+#define PRIORITYQUEUE_PUSHARGS            "PQPshArgs"
+#define PRIORITYQUEUE_PUSHARGS_MSG        "Push expects a value and a finite numerical priority."
+
+#define PRIORITYQUEUE_EMPTY               "PQEmpty"
+#define PRIORITYQUEUE_EMPTY_MSG           "PriorityQueue is empty."
+
+/* -------------------------------------------------------
+ * PriorityQueue interface
+ * ------------------------------------------------------- */
+
+bool priorityqueue_push(objectpriorityqueue *q, value val, double priority);
+bool priorityqueue_pop(objectpriorityqueue *q, value *val, double *priority);
+
+void priorityqueue_initialize(void);
+
+#endif /* priorityqueue_h */
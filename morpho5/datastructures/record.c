@@ -0,0 +1,529 @@
+/** @file record.c
+ *  @author T J Atherton
+ *
+ *  @brief Veneer classes over the objectrecordarray type, which stores records with a fixed set of fields column by column
+ */
+
+#include <string.h>
+#include "object.h"
+#include "record.h"
+#include "matrix.h"
+#include "morpho.h"
+#include "builtin.h"
+#include "veneer.h"
+#include "common.h"
+
+/* **********************************************************************
+ * RecordArray objects
+ * ********************************************************************** */
+
+objecttype objectrecordarraytype;
+
+/** Function object definitions */
+size_t objectrecordarray_sizefn(object *obj) {
+    objectrecordarray *a = (objectrecordarray *) obj;
+    unsigned int nfields = a->nnum+a->nobj;
+    return sizeof(objectrecordarray)+nfields*(sizeof(value)+sizeof(void *))+
+           a->capacity*(a->nnum*sizeof(double)+a->nobj*sizeof(value));
+}
+
+void objectrecordarray_printfn(object *obj) {
+    printf("<RecordArray>");
+}
+
+void objectrecordarray_markfn(object *obj, void *v) {
+    objectrecordarray *a = (objectrecordarray *) obj;
+    for (unsigned int k=0; k<a->nnum+a->nobj; k++) morpho_markvalue(v, a->names[k]);
+    for (unsigned int k=0; k<a->nobj; k++) {
+        for (unsigned int i=0; i<a->count; i++) morpho_markvalue(v, a->vals[k][i]);
+    }
+}
+
+void objectrecordarray_freefn(object *obj) {
+    objectrecordarray *a = (objectrecordarray *) obj;
+    for (unsigned int k=0; k<a->nnum; k++) if (a->num[k]) MORPHO_FREE(a->num[k]);
+    for (unsigned int k=0; k<a->nobj; k++) if (a->vals[k]) MORPHO_FREE(a->vals[k]);
+    if (a->num) MORPHO_FREE(a->num);
+    if (a->vals) MORPHO_FREE(a->vals);
+    if (a->names) MORPHO_FREE(a->names);
+    dictionary_clear(&a->fields);
+}
+
+objecttypedefn objectrecordarraydefn = {
+    .printfn=objectrecordarray_printfn,
+    .markfn=objectrecordarray_markfn,
+    .freefn=objectrecordarray_freefn,
+    .sizefn=objectrecordarray_sizefn
+};
+
+/** Creates an empty recordarray. The names of the nnum numeric fields should be followed by those of the nobj object fields. */
+objectrecordarray *object_newrecordarray(unsigned int nnum, unsigned int nobj, value *names) {
+    objectrecordarray *new = (objectrecordarray *) object_new(sizeof(objectrecordarray), OBJECT_RECORDARRAY);
+
+    if (new) {
+        new->nnum=0;
+        new->nobj=0;
+        new->count=0;
+        new->capacity=0;
+        dictionary_init(&new->fields);
+        new->names=MORPHO_MALLOC((nnum+nobj)*sizeof(value));
+        new->num=(nnum ? MORPHO_MALLOC(nnum*sizeof(double *)) : NULL);
+        new->vals=(nobj ? MORPHO_MALLOC(nobj*sizeof(value *)) : NULL);
+
+        if (!new->names || (nnum && !new->num) || (nobj && !new->vals)) {
+            object_free((object *) new);
+            return NULL;
+        }
+
+        new->nnum=nnum;
+        new->nobj=nobj;
+        for (unsigned int k=0; k<nnum; k++) new->num[k]=NULL;
+        for (unsigned int k=0; k<nobj; k++) new->vals[k]=NULL;
+
+        for (unsigned int k=0; k<nnum+nobj; k++) {
+            new->names[k]=names[k];
+            if (!dictionary_insert(&new->fields, names[k], MORPHO_INTEGER(k))) {
+                object_free((object *) new);
+                return NULL;
+            }
+        }
+    }
+
+    return new;
+}
+
+/** Creates a copy of a recordarray */
+objectrecordarray *object_clonerecordarray(objectrecordarray *a) {
+    objectrecordarray *new = object_newrecordarray(a->nnum, a->nobj, a->names);
+
+    if (new) {
+        for (unsigned int i=0; i<a->count; i++) {
+            if (!recordarray_append(new)) {
+                object_free((object *) new);
+                return NULL;
+            }
+        }
+
+        for (unsigned int k=0; k<a->nnum; k++) memcpy(new->num[k], a->num[k], a->count*sizeof(double));
+        for (unsigned int k=0; k<a->nobj; k++) memcpy(new->vals[k], a->vals[k], a->count*sizeof(value));
+    }
+
+    return new;
+}
+
+/* **********************************************************************
+ * Record objects
+ * ********************************************************************** */
+
+objecttype objectrecordtype;
+
+/** Function object definitions */
+size_t objectrecord_sizefn(object *obj) {
+    return sizeof(objectrecord);
+}
+
+void objectrecord_printfn(object *obj) {
+    printf("<Record>");
+}
+
+void objectrecord_markfn(object *obj, void *v) {
+    morpho_markvalue(v, ((objectrecord *) obj)->array);
+}
+
+/** Fields of a record are read as properties */
+bool objectrecord_getpropertyfn(object *obj, value key, value *out) {
+    objectrecord *r = (objectrecord *) obj;
+    objectrecordarray *a = MORPHO_GETRECORDARRAY(r->array);
+    unsigned int col;
+
+    return (recordarray_column(a, key, &col) &&
+            recordarray_get(a, r->indx, col, out));
+}
+
+/** Fields of a record are set as properties */
+char *objectrecord_setpropertyfn(object *obj, value key, value val) {
+    objectrecord *r = (objectrecord *) obj;
+    objectrecordarray *a = MORPHO_GETRECORDARRAY(r->array);
+    unsigned int col;
+
+    if (!recordarray_column(a, key, &col)) return RECORDARRAY_FIELD;
+    if (!recordarray_set(a, r->indx, col, val)) return RECORDARRAY_NONNUM;
+
+    return NULL;
+}
+
+objecttypedefn objectrecorddefn = {
+    .printfn=objectrecord_printfn,
+    .markfn=objectrecord_markfn,
+    .freefn=NULL,
+    .sizefn=objectrecord_sizefn,
+    .getpropertyfn=objectrecord_getpropertyfn,
+    .setpropertyfn=objectrecord_setpropertyfn
+};
+
+/** Creates a record referring to a given element of a recordarray */
+objectrecord *object_newrecord(value array, unsigned int indx) {
+    objectrecord *new = (objectrecord *) object_new(sizeof(objectrecord), OBJECT_RECORD);
+
+    if (new) {
+        new->array=array;
+        new->indx=indx;
+    }
+
+    return new;
+}
+
+/* **********************************************************************
+ * RecordArray operations
+ * ********************************************************************* */
+
+/** Finds the column that holds a named field */
+bool recordarray_column(objectrecordarray *a, value name, unsigned int *col) {
+    value c;
+    if (!MORPHO_ISSTRING(name) || !dictionary_get(&a->fields, name, &c)) return false;
+    *col = (unsigned int) MORPHO_GETINTEGERVALUE(c);
+    return true;
+}
+
+/** Gets the value of field col of record i */
+bool recordarray_get(objectrecordarray *a, unsigned int i, unsigned int col, value *out) {
+    if (i>=a->count) return false;
+    if (col<a->nnum) *out = MORPHO_FLOAT(a->num[col][i]);
+    else *out = a->vals[col-a->nnum][i];
+    return true;
+}
+
+/** Sets the value of field col of record i; numeric fields only accept numbers */
+bool recordarray_set(objectrecordarray *a, unsigned int i, unsigned int col, value val) {
+    if (i>=a->count) return false;
+    if (col<a->nnum) {
+        double x;
+        if (!morpho_valuetofloat(val, &x)) return false;
+        a->num[col][i]=x;
+    } else a->vals[col-a->nnum][i]=val;
+    return true;
+}
+
+/** Adds a record whose numeric fields are zero and object fields nil, growing the columns as needed */
+bool recordarray_append(objectrecordarray *a) {
+    if (a->count>=a->capacity) {
+        unsigned int capacity = (a->capacity ? 2*a->capacity : 8);
+
+        for (unsigned int k=0; k<a->nnum; k++) {
+            double *new = MORPHO_REALLOC(a->num[k], capacity*sizeof(double));
+            if (!new) return false;
+            a->num[k]=new;
+        }
+
+        for (unsigned int k=0; k<a->nobj; k++) {
+            value *new = MORPHO_REALLOC(a->vals[k], capacity*sizeof(value));
+            if (!new) return false;
+            a->vals[k]=new;
+        }
+
+        a->capacity=capacity;
+    }
+
+    for (unsigned int k=0; k<a->nnum; k++) a->num[k][a->count]=0.0;
+    for (unsigned int k=0; k<a->nobj; k++) a->vals[k][a->count]=MORPHO_NIL;
+    a->count++;
+
+    return true;
+}
+
+/** Creates a record for element i and binds it to the VM */
+static value recordarray_record(vm *v, value array, unsigned int i) {
+    value out=MORPHO_NIL;
+    objectrecord *new=object_newrecord(array, i);
+
+    if (new) {
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+
+    return out;
+}
+
+/** Gets the names of the fields from a List, checking they are distinct strings */
+static bool recordarray_names(value list, dictionary *seen, varray_value *names) {
+    if (!MORPHO_ISLIST(list)) return false;
+    objectlist *l = MORPHO_GETLIST(list);
+
+    for (unsigned int i=0; i<l->val.count; i++) {
+        value name=l->val.data[i];
+        if (!MORPHO_ISSTRING(name) ||
+            dictionary_get(seen, name, NULL) ||
+            !dictionary_insert(seen, name, MORPHO_NIL)) return false;
+        varray_valuewrite(names, name);
+    }
+
+    return true;
+}
+
+/* **********************************************************************
+ * RecordArray veneer class
+ * ********************************************************************* */
+
+static value recordarray_objectsoption;
+
+/** Constructs a RecordArray from a List of numeric field names, with object fields given by an optional argument */
+value recordarray_constructor(vm *v, int nargs, value *args) {
+    value out=MORPHO_NIL;
+    value objects=MORPHO_NIL;
+    int nfixed;
+
+    builtin_options(v, nargs, args, &nfixed, 1, recordarray_objectsoption, &objects);
+
+    dictionary seen;
+    dictionary_init(&seen);
+    varray_value names;
+    varray_valueinit(&names);
+
+    bool success=(nfixed==1 && recordarray_names(MORPHO_GETARG(args, 0), &seen, &names));
+    unsigned int nnum=names.count;
+    if (success && !MORPHO_ISNIL(objects)) success=recordarray_names(objects, &seen, &names);
+    if (names.count==0) success=false;
+
+    if (success) {
+        objectrecordarray *new=object_newrecordarray(nnum, names.count-nnum, names.data);
+
+        if (new) {
+            out=MORPHO_OBJECT(new);
+            morpho_bindobjects(v, 1, &out);
+        } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+    } else morpho_runtimeerror(v, RECORDARRAY_CONSTRUCTOR);
+
+    dictionary_clear(&seen);
+    varray_valueclear(&names);
+
+    return out;
+}
+
+/** Finds a record from an index, raising an error if it doesn't exist */
+static bool recordarray_index(vm *v, objectrecordarray *a, value indx, unsigned int *i) {
+    if (!MORPHO_ISINTEGER(indx)) {
+        morpho_runtimeerror(v, RECORDARRAY_INDEX);
+        return false;
+    }
+
+    int k=MORPHO_GETINTEGERVALUE(indx);
+    if (k<0) k+=a->count;
+    if (k<0 || k>=a->count) {
+        morpho_runtimeerror(v, VM_OUTOFBOUNDS);
+        return false;
+    }
+
+    *i=(unsigned int) k;
+    return true;
+}
+
+/** Finds a field from its name, raising an error if it doesn't exist */
+static bool recordarray_field(vm *v, objectrecordarray *a, value name, unsigned int *col) {
+    if (!MORPHO_ISSTRING(name)) {
+        morpho_runtimeerror(v, RECORDARRAY_INDEX);
+        return false;
+    }
+
+    if (!recordarray_column(a, name, col)) {
+        morpho_runtimeerror(v, RECORDARRAY_FIELD, MORPHO_GETCSTRING(name));
+        return false;
+    }
+
+    return true;
+}
+
+/** Gets a record, or a single field of a record */
+value RecordArray_getindex(vm *v, int nargs, value *args) {
+    objectrecordarray *slf = MORPHO_GETRECORDARRAY(MORPHO_SELF(args));
+    value out=MORPHO_NIL;
+    unsigned int i, col;
+
+    if (nargs==1) {
+        if (recordarray_index(v, slf, MORPHO_GETARG(args, 0), &i)) out=recordarray_record(v, MORPHO_SELF(args), i);
+    } else if (nargs==2) {
+        if (recordarray_index(v, slf, MORPHO_GETARG(args, 0), &i) &&
+            recordarray_field(v, slf, MORPHO_GETARG(args, 1), &col)) recordarray_get(slf, i, col, &out);
+    } else morpho_runtimeerror(v, RECORDARRAY_INDEX);
+
+    return out;
+}
+
+/** Sets a single field of a record */
+value RecordArray_setindex(vm *v, int nargs, value *args) {
+    objectrecordarray *slf = MORPHO_GETRECORDARRAY(MORPHO_SELF(args));
+    unsigned int i, col;
+
+    if (nargs==3) {
+        if (recordarray_index(v, slf, MORPHO_GETARG(args, 0), &i) &&
+            recordarray_field(v, slf, MORPHO_GETARG(args, 1), &col) &&
+            !recordarray_set(slf, i, col, MORPHO_GETARG(args, 2))) {
+            morpho_runtimeerror(v, RECORDARRAY_NONNUM, MORPHO_GETCSTRING(MORPHO_GETARG(args, 1)));
+        }
+    } else morpho_runtimeerror(v, RECORDARRAY_INDEX);
+
+    return MORPHO_NIL;
+}
+
+/** Appends a record, given values for its fields in the order they were declared; omitted fields are zero or nil */
+value RecordArray_append(vm *v, int nargs, value *args) {
+    objectrecordarray *slf = MORPHO_GETRECORDARRAY(MORPHO_SELF(args));
+
+    if (nargs>slf->nnum+slf->nobj) MORPHO_RAISE(v, RECORDARRAY_APPEND);
+
+    size_t size = objectrecordarray_sizefn((object *) slf);
+    bool success = recordarray_append(slf);
+    size_t newsize = objectrecordarray_sizefn((object *) slf);
+    if (newsize!=size) morpho_resizeobject(v, (object *) slf, size, newsize);
+    if (!success) MORPHO_RAISE(v, ERROR_ALLOCATIONFAILED);
+
+    unsigned int i=slf->count-1;
+    for (unsigned int k=0; k<nargs; k++) {
+        if (!recordarray_set(slf, i, k, MORPHO_GETARG(args, k))) {
+            slf->count--;
+            morpho_runtimeerror(v, RECORDARRAY_NONNUM, MORPHO_GETCSTRING(slf->names[k]));
+            return MORPHO_NIL;
+        }
+    }
+
+    return MORPHO_INTEGER(i);
+}
+
+/** Number of records */
+value RecordArray_count(vm *v, int nargs, value *args) {
+    return MORPHO_INTEGER(MORPHO_GETRECORDARRAY(MORPHO_SELF(args))->count);
+}
+
+/** Enumerate protocol */
+value RecordArray_enumerate(vm *v, int nargs, value *args) {
+    objectrecordarray *slf = MORPHO_GETRECORDARRAY(MORPHO_SELF(args));
+    value out=MORPHO_NIL;
+
+    if (nargs==1 && MORPHO_ISINTEGER(MORPHO_GETARG(args, 0))) {
+        int i=MORPHO_GETINTEGERVALUE(MORPHO_GETARG(args, 0));
+
+        if (i<0) out=MORPHO_INTEGER(slf->count);
+        else if (i<slf->count) out=recordarray_record(v, MORPHO_SELF(args), i);
+        else morpho_runtimeerror(v, VM_OUTOFBOUNDS);
+    } else MORPHO_RAISE(v, ENUMERATE_ARGS);
+
+    return out;
+}
+
+/** Returns a List of the field names */
+value RecordArray_fields(vm *v, int nargs, value *args) {
+    objectrecordarray *slf = MORPHO_GETRECORDARRAY(MORPHO_SELF(args));
+    objectlist *new = object_newlist(slf->nnum+slf->nobj, slf->names);
+    value out=MORPHO_NIL;
+
+    if (new) {
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+
+    return out;
+}
+
+/** Copies a field of every record: a numeric field into a column Matrix, an object field into a List */
+value RecordArray_column(vm *v, int nargs, value *args) {
+    objectrecordarray *slf = MORPHO_GETRECORDARRAY(MORPHO_SELF(args));
+    value out=MORPHO_NIL;
+    unsigned int col;
+
+    if (nargs!=1) MORPHO_RAISE(v, RECORDARRAY_INDEX);
+    if (!recordarray_field(v, slf, MORPHO_GETARG(args, 0), &col)) return MORPHO_NIL;
+
+    object *new=NULL;
+    if (col<slf->nnum) {
+        objectmatrix *m = object_newmatrix(slf->count, 1, false);
+        if (m) memcpy(m->elements, slf->num[col], slf->count*sizeof(double));
+        new=(object *) m;
+    } else {
+        new=(object *) object_newlist(slf->count, slf->vals[col-slf->nnum]);
+    }
+
+    if (new) {
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+
+    return out;
+}
+
+/** Clones a RecordArray */
+value RecordArray_clone(vm *v, int nargs, value *args) {
+    objectrecordarray *new = object_clonerecordarray(MORPHO_GETRECORDARRAY(MORPHO_SELF(args)));
+    value out=MORPHO_NIL;
+
+    if (new) {
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+
+    return out;
+}
+
+MORPHO_BEGINCLASS(RecordArray)
+MORPHO_METHOD(MORPHO_GETINDEX_METHOD, RecordArray_getindex, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_SETINDEX_METHOD, RecordArray_setindex, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(RECORDARRAY_APPEND_METHOD, RecordArray_append, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_COUNT_METHOD, RecordArray_count, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_ENUMERATE_METHOD, RecordArray_enumerate, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(RECORDARRAY_FIELDS_METHOD, RecordArray_fields, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(RECORDARRAY_COLUMN_METHOD, RecordArray_column, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_CLONE_METHOD, RecordArray_clone, BUILTIN_FLAGSEMPTY)
+MORPHO_ENDCLASS
+
+/* **********************************************************************
+ * Record veneer class
+ * ********************************************************************* */
+
+/** Prints the fields of a record */
+value Record_print(vm *v, int nargs, value *args) {
+    objectrecord *slf = MORPHO_GETRECORD(MORPHO_SELF(args));
+    objectrecordarray *a = MORPHO_GETRECORDARRAY(slf->array);
+
+    printf("{ ");
+    for (unsigned int k=0; k<a->nnum+a->nobj; k++) {
+        value val=MORPHO_NIL;
+        recordarray_get(a, slf->indx, k, &val);
+        if (k>0) printf(" , ");
+        morpho_printvalue(a->names[k]);
+        printf(" : ");
+        morpho_printvalue(val);
+    }
+    printf(" }");
+
+    return MORPHO_NIL;
+}
+
+MORPHO_BEGINCLASS(Record)
+MORPHO_METHOD(MORPHO_PRINT_METHOD, Record_print, BUILTIN_FLAGSEMPTY)
+MORPHO_ENDCLASS
+
+/* **********************************************************************
+ * Initialization
+ * ********************************************************************* */
+
+void record_initialize(void) {
+    objectrecordarraytype=object_addtype(&objectrecordarraydefn);
+    objectrecordtype=object_addtype(&objectrecorddefn);
+
+    builtin_addfunction(RECORDARRAY_CLASSNAME, recordarray_constructor, BUILTIN_FLAGSCONSTRUCTOR);
+
+    objectstring objname = MORPHO_STATICSTRING(OBJECT_CLASSNAME);
+    value objclass = builtin_findclass(MORPHO_OBJECT(&objname));
+
+    value recordarrayclass=builtin_addclass(RECORDARRAY_CLASSNAME, MORPHO_GETCLASSDEFINITION(RecordArray), objclass);
+    object_setveneerclass(OBJECT_RECORDARRAY, recordarrayclass);
+
+    value recordclass=builtin_addclass(RECORD_CLASSNAME, MORPHO_GETCLASSDEFINITION(Record), objclass);
+    object_setveneerclass(OBJECT_RECORD, recordclass);
+
+    recordarray_objectsoption=builtin_internsymbolascstring(RECORDARRAY_OBJECTSOPTION);
+
+    morpho_defineerror(RECORDARRAY_CONSTRUCTOR, ERROR_HALT, RECORDARRAY_CONSTRUCTOR_MSG);
+    morpho_defineerror(RECORDARRAY_NONNUM, ERROR_HALT, RECORDARRAY_NONNUM_MSG);
+    morpho_defineerror(RECORDARRAY_INDEX, ERROR_HALT, RECORDARRAY_INDEX_MSG);
+    morpho_defineerror(RECORDARRAY_APPEND, ERROR_HALT, RECORDARRAY_APPEND_MSG);
+    morpho_defineerror(RECORDARRAY_FIELD, ERROR_HALT, RECORDARRAY_FIELD_MSG);
+}
@@ -0,0 +1,104 @@
+/** @file record.h
+ *  @author T J Atherton
+ *
+ *  @brief Veneer classes over the objectrecordarray type, which stores records with a fixed set of fields column by column
+ */
+
+#ifndef record_h
+#define record_h
+
+#include <stdio.h>
+#include "veneer.h"
+
+/* -------------------------------------------------------
+ * RecordArray objects
+ * ------------------------------------------------------- */
+
+extern objecttype objectrecordarraytype;
+#define OBJECT_RECORDARRAY objectrecordarraytype
+
+/** RecordArrays hold many records that share the same fields. Rather than give each record a dictionary of
+    its own, as an instance has, every field is stored as a column: numeric fields as unboxed doubles and
+    object fields as values. Columns are numbered with the numeric fields first, and a field's column is
+    found from its name through the fields dictionary. */
+typedef struct {
+    object obj;
+    unsigned int nnum; /** Number of numeric fields */
+    unsigned int nobj; /** Number of object fields */
+    value *names; /** Name of each field, in column order */
+    dictionary fields; /** Maps each name to its column */
+    unsigned int count; /** Number of records */
+    unsigned int capacity; /** Number of records the columns have space for */
+    double **num; /** Numeric columns */
+    value **vals; /** Object columns */
+} objectrecordarray;
+
+/** Tests whether an object is a recordarray */
+#define MORPHO_ISRECORDARRAY(val) object_istype(val, OBJECT_RECORDARRAY)
+
+/** Gets the object as a recordarray */
+#define MORPHO_GETRECORDARRAY(val)   ((objectrecordarray *) MORPHO_GETOBJECT(val))
+
+/** Creates an empty recordarray */
+objectrecordarray *object_newrecordarray(unsigned int nnum, unsigned int nobj, value *names);
+
+/* -------------------------------------------------------
+ * Record objects
+ * ------------------------------------------------------- */
+
+extern objecttype objectrecordtype;
+#define OBJECT_RECORD objectrecordtype
+
+/** A Record refers to one record in a RecordArray, and its fields are accessed as properties */
+typedef struct {
+    object obj;
+    value array; /** The RecordArray, which is kept alive by the record */
+    unsigned int indx; /** Index of the record */
+} objectrecord;
+
+/** Tests whether an object is a record */
+#define MORPHO_ISRECORD(val) object_istype(val, OBJECT_RECORD)
+
+/** Gets the object as a record */
+#define MORPHO_GETRECORD(val)   ((objectrecord *) MORPHO_GETOBJECT(val))
+
+/* -------------------------------------------------------
+ * RecordArray class
+ * ------------------------------------------------------- */
+
+#define RECORDARRAY_CLASSNAME "RecordArray"
+#define RECORD_CLASSNAME "Record"
+
+#define RECORDARRAY_OBJECTSOPTION "objects"
+
+#define RECORDARRAY_APPEND_METHOD "append"
+#define RECORDARRAY_FIELDS_METHOD "fields"
+#define RECORDARRAY_COLUMN_METHOD "column"
+
+#define RECORDARRAY_CONSTRUCTOR           "RcrdCns"
+#define RECORDARRAY_CONSTRUCTOR_MSG       "RecordArray expects a List of distinct field names, and optionally a List of object field names as the objects argument."
+
+#define RECORDARRAY_NONNUM                "RcrdNnNm"
+#define RECORDARRAY_NONNUM_MSG            "Field '%s' can only hold numbers."
+
+#define RECORDARRAY_INDEX                 "RcrdIndx"
+#define RECORDARRAY_INDEX_MSG             "RecordArrays are indexed by an integer, optionally followed by a field name."
+
+#define RECORDARRAY_APPEND                "RcrdAppnd"
+#define RECORDARRAY_APPEND_MSG            "Append expects at most one value for each field, in the order the fields were declared."
+
+#define RECORDARRAY_FIELD                 "RcrdFld"
+#define RECORDARRAY_FIELD_MSG             "RecordArray has no field '%s'."
+
+/* -------------------------------------------------------
+ * RecordArray interface
+ * ------------------------------------------------------- */
+
+bool recordarray_column(objectrecordarray *a, value name, unsigned int *col);
+bool recordarray_get(objectrecordarray *a, unsigned int i, unsigned int col, value *out);
+bool recordarray_set(objectrecordarray *a, unsigned int i, unsigned int col, value val);
+bool recordarray_append(objectrecordarray *a);
+
+void record_initialize(void);
+
+#endif /* record_h */
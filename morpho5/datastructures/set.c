@@ -0,0 +1,313 @@
+/** @file set.c
+ *  @author T J Atherton
+ *
+ *  @brief Veneer class over the objectset type, a hashed collection of distinct values
+ */
+
+#include "object.h"
+#include "set.h"
+#include "morpho.h"
+#include "builtin.h"
+#include "veneer.h"
+#include "common.h"
+
+/* **********************************************************************
+ * Set objects
+ * ********************************************************************** */
+
+objecttype objectsettype;
+
+/** Function object definitions */
+size_t objectset_sizefn(object *obj) {
+    return sizeof(objectset)+(((objectset *) obj)->dict.capacity)*sizeof(dictionaryentry);
+}
+
+void objectset_printfn(object *obj) {
+    printf("<Set>");
+}
+
+void objectset_markfn(object *obj, void *v) {
+    morpho_markdictionary(v, &((objectset *) obj)->dict);
+}
+
+void objectset_freefn(object *obj) {
+    dictionary_clear(&((objectset *) obj)->dict);
+}
+
+objecttypedefn objectsetdefn = {
+    .printfn=objectset_printfn,
+    .markfn=objectset_markfn,
+    .freefn=objectset_freefn,
+    .sizefn=objectset_sizefn
+};
+
+/** Creates an empty set */
+objectset *object_newset(void) {
+    objectset *new = (objectset *) object_new(sizeof(objectset), OBJECT_SET);
+
+    if (new) {
+        dictionary_init(&new->dict);
+        dictionary_cursorinit(&new->cursor);
+    }
+
+    return new;
+}
+
+/* **********************************************************************
+ * Set operations
+ * ********************************************************************* */
+
+/** Adds a value to a set; nil cannot be a member */
+bool set_insert(objectset *set, value val) {
+    if (MORPHO_ISNIL(val)) return false;
+    dictionary_cursorinit(&set->cursor);
+    return dictionary_insert(&set->dict, val, MORPHO_NIL);
+}
+
+/** Tests whether a value is a member of a set */
+bool set_ismember(objectset *set, value val) {
+    value out;
+    return (!MORPHO_ISNIL(val) && dictionary_get(&set->dict, val, &out));
+}
+
+/** Removes a value from a set */
+bool set_remove(objectset *set, value val) {
+    dictionary_cursorinit(&set->cursor);
+    return (!MORPHO_ISNIL(val) && dictionary_remove(&set->dict, val));
+}
+
+/** Returns the n'th member of a set in slot order. Successive calls with n, n+1, ... resume from
+    the slot found by the previous call rather than counting from the start. */
+static value set_iterate(objectset *set, unsigned int n) {
+    unsigned int slot;
+    if (dictionary_nthentry(&set->dict, n, &set->cursor, &slot)) return set->dict.contents[slot].key;
+    return MORPHO_NIL;
+}
+
+/* **********************************************************************
+ * Set veneer class
+ * ********************************************************************* */
+
+/** Inserts a value into a set, informing the VM if the set's storage grew */
+static bool set_insertwithvm(vm *v, objectset *set, value val) {
+    if (MORPHO_ISNIL(val)) {
+        morpho_runtimeerror(v, SET_NILMEMBER);
+        return false;
+    }
+
+    unsigned int capacity = set->dict.capacity;
+    bool success=set_insert(set, morpho_internstring(v, val));
+
+    if (set->dict.capacity!=capacity) morpho_resizeobject(v, (object *) set, capacity*sizeof(dictionaryentry)+sizeof(objectset), set->dict.capacity*sizeof(dictionaryentry)+sizeof(objectset));
+    if (!success) morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+
+    return success;
+}
+
+/** Adds each element of an enumerable object to a set */
+static bool set_enumerableinitializer(vm *v, indx i, value val, void *ref) {
+    return set_insertwithvm(v, (objectset *) ref, val);
+}
+
+/** Constructs a set from its members, or from the elements of a single List, Range or Set */
+value set_constructor(vm *v, int nargs, value *args) {
+    value out=MORPHO_NIL;
+    objectset *new=object_newset();
+    if (!new) {
+        morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+        return MORPHO_NIL;
+    }
+
+    out=MORPHO_OBJECT(new);
+    morpho_bindobjects(v, 1, &out);
+
+    value init = (nargs==1 ? MORPHO_GETARG(args, 0) : MORPHO_NIL);
+    if (MORPHO_ISSET(init)) {
+        if (!dictionary_copy(&MORPHO_GETSET(init)->dict, &new->dict)) morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+    } else if (MORPHO_ISLIST(init) || MORPHO_ISRANGE(init)) {
+        builtin_enumerateloop(v, init, set_enumerableinitializer, new);
+    } else {
+        for (int i=0; i<nargs; i++) {
+            if (!set_insertwithvm(v, new, MORPHO_GETARG(args, i))) break;
+        }
+    }
+
+    return out;
+}
+
+/** Inserts one or more values into a set */
+value Set_insert(vm *v, int nargs, value *args) {
+    objectset *slf = MORPHO_GETSET(MORPHO_SELF(args));
+
+    for (int i=0; i<nargs; i++) {
+        if (!set_insertwithvm(v, slf, MORPHO_GETARG(args, i))) break;
+    }
+
+    return MORPHO_NIL;
+}
+
+/** Removes a value from a set */
+value Set_remove(vm *v, int nargs, value *args) {
+    objectset *slf = MORPHO_GETSET(MORPHO_SELF(args));
+
+    if (nargs==1) set_remove(slf, MORPHO_GETARG(args, 0));
+
+    return MORPHO_NIL;
+}
+
+/** Tests whether a value is a member of a set */
+value Set_contains(vm *v, int nargs, value *args) {
+    objectset *slf = MORPHO_GETSET(MORPHO_SELF(args));
+
+    if (nargs==1) return MORPHO_BOOL(set_ismember(slf, MORPHO_GETARG(args, 0)));
+
+    return MORPHO_FALSE;
+}
+
+/** Removes all members of a set */
+value Set_clear(vm *v, int nargs, value *args) {
+    objectset *slf = MORPHO_GETSET(MORPHO_SELF(args));
+
+    dictionary_clear(&slf->dict);
+    dictionary_cursorinit(&slf->cursor);
+
+    return MORPHO_NIL;
+}
+
+/** Prints a set */
+value Set_print(vm *v, int nargs, value *args) {
+    value self = MORPHO_SELF(args);
+    if (!MORPHO_ISSET(self)) return Object_print(v, nargs, args);
+
+    objectset *slf = MORPHO_GETSET(self);
+
+    printf("Set(");
+    unsigned int k=0;
+    for (unsigned int i=0; i<slf->dict.capacity; i++) {
+        if (!MORPHO_ISNIL(slf->dict.contents[i].key)) {
+            printf(k>0 ? ", " : " ");
+            morpho_printvalue(slf->dict.contents[i].key);
+            k++;
+        }
+    }
+    printf(" )");
+
+    return MORPHO_NIL;
+}
+
+/** Counts the members of a set */
+value Set_count(vm *v, int nargs, value *args) {
+    objectset *slf = MORPHO_GETSET(MORPHO_SELF(args));
+
+    return MORPHO_INTEGER(slf->dict.count);
+}
+
+/** Enumerate protocol */
+value Set_enumerate(vm *v, int nargs, value *args) {
+    objectset *slf = MORPHO_GETSET(MORPHO_SELF(args));
+    value out=MORPHO_NIL;
+
+    if (nargs==1 && MORPHO_ISINTEGER(MORPHO_GETARG(args, 0))) {
+        int n=MORPHO_GETINTEGERVALUE(MORPHO_GETARG(args, 0));
+
+        if (n<0) out=MORPHO_INTEGER(slf->dict.count);
+        else if (n<slf->dict.count) out=set_iterate(slf, n);
+        else morpho_runtimeerror(v, VM_OUTOFBOUNDS);
+    } else MORPHO_RAISE(v, ENUMERATE_ARGS);
+
+    return out;
+}
+
+/** Clones a set */
+value Set_clone(vm *v, int nargs, value *args) {
+    objectset *slf = MORPHO_GETSET(MORPHO_SELF(args));
+    objectset *new = object_newset();
+    value out=MORPHO_NIL;
+
+    if (new && dictionary_copy(&slf->dict, &new->dict)) {
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else {
+        if (new) object_free((object *) new);
+        morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+    }
+
+    return out;
+}
+
+/** Returns the members of a set as a List */
+value Set_tolist(vm *v, int nargs, value *args) {
+    objectset *slf = MORPHO_GETSET(MORPHO_SELF(args));
+    objectlist *list = object_newlist(slf->dict.count, NULL);
+    value out=MORPHO_NIL;
+
+    if (list) {
+        for (unsigned int i=0; i<slf->dict.capacity; i++) {
+            if (!MORPHO_ISNIL(slf->dict.contents[i].key)) list_append(list, slf->dict.contents[i].key);
+        }
+        out=MORPHO_OBJECT(list);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+
+    return out;
+}
+
+#define SET_SETOP(op) \
+value Set_##op(vm *v, int nargs, value *args) { \
+    objectset *slf = MORPHO_GETSET(MORPHO_SELF(args)); \
+    value out=MORPHO_NIL; \
+    \
+    if (nargs==1 && MORPHO_ISSET(MORPHO_GETARG(args, 0))) { \
+        objectset *new = object_newset(); \
+        \
+        if (new) { \
+            objectset *b = MORPHO_GETSET(MORPHO_GETARG(args, 0)); \
+            dictionary_##op(&slf->dict, &b->dict, &new->dict); \
+            out=MORPHO_OBJECT(new); \
+            morpho_bindobjects(v, 1, &out); \
+        } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED); \
+    } else morpho_runtimeerror(v, SET_ARGS); \
+    \
+    return out; \
+}
+
+SET_SETOP(union)
+SET_SETOP(intersection)
+SET_SETOP(difference)
+
+MORPHO_BEGINCLASS(Set)
+MORPHO_METHOD(SET_INSERT_METHOD, Set_insert, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(SET_REMOVE_METHOD, Set_remove, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(SET_CLEAR_METHOD, Set_clear, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_CONTAINS_METHOD, Set_contains, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(SET_ISMEMBER_METHOD, Set_contains, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_PRINT_METHOD, Set_print, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_COUNT_METHOD, Set_count, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_ENUMERATE_METHOD, Set_enumerate, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_CLONE_METHOD, Set_clone, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(SET_TOLIST_METHOD, Set_tolist, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_UNION_METHOD, Set_union, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_INTERSECTION_METHOD, Set_intersection, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_DIFFERENCE_METHOD, Set_difference, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_ADD_METHOD, Set_union, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_SUB_METHOD, Set_difference, BUILTIN_FLAGSEMPTY)
+MORPHO_ENDCLASS
+
+/* **********************************************************************
+ * Initialization
+ * ********************************************************************* */
+
+void set_initialize(void) {
+    objectsettype=object_addtype(&objectsetdefn);
+
+    builtin_addfunction(SET_CLASSNAME, set_constructor, BUILTIN_FLAGSCONSTRUCTOR);
+
+    objectstring objname = MORPHO_STATICSTRING(OBJECT_CLASSNAME);
+    value objclass = builtin_findclass(MORPHO_OBJECT(&objname));
+
+    value setclass=builtin_addclass(SET_CLASSNAME, MORPHO_GETCLASSDEFINITION(Set), objclass);
+    object_setveneerclass(OBJECT_SET, setclass);
+
+    morpho_defineerror(SET_NILMEMBER, ERROR_HALT, SET_NILMEMBER_MSG);
+    morpho_defineerror(SET_ARGS, ERROR_HALT, SET_ARGS_MSG);
+}
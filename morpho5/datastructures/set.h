@@ -0,0 +1,67 @@
+/** @file set.h
+ *  @author T J Atherton
+ *
+ *  @brief Veneer class over the objectset type, a hashed collection of distinct values
+ */
+
+#ifndef set_h
+#define set_h
+
+#include <stdio.h>
+#include "veneer.h"
+#include "dictionary.h"
+
+/* -------------------------------------------------------
+ * Set objects
+ * ------------------------------------------------------- */
+
+extern objecttype objectsettype;
+#define OBJECT_SET objectsettype
+
+/** Sets store their members as the keys of a dictionary, so membership is tested by hashing
+    rather than by scanning. The cursor caches the position reached by enumerate, so that
+    a loop over a set visits each slot once; it is reset whenever the set is modified. */
+typedef struct {
+    object obj;
+    dictionary dict;
+    dictionarycursor cursor;
+} objectset;
+
+/** Tests whether an object is a set */
+#define MORPHO_ISSET(val) object_istype(val, OBJECT_SET)
+
+/** Gets the object as a set */
+#define MORPHO_GETSET(val)   ((objectset *) MORPHO_GETOBJECT(val))
+
+/** Creates an empty set */
+objectset *object_newset(void);
+
+/* -------------------------------------------------------
+ * Set class
+ * ------------------------------------------------------- */
+
+#define SET_CLASSNAME "Set"
+
+#define SET_INSERT_METHOD "insert"
+#define SET_REMOVE_METHOD "remove"
+#define SET_CLEAR_METHOD "clear"
+#define SET_ISMEMBER_METHOD "ismember"
+#define SET_TOLIST_METHOD "tolist"
+
+#define SET_NILMEMBER                     "SetNil"
+#define SET_NILMEMBER_MSG                 "Sets cannot contain nil."
+
+#define SET_ARGS                          "SetArgs"
+#define SET_ARGS_MSG                      "Set methods (union, intersection, difference) expect a Set as the argument."
+
+/* -------------------------------------------------------
+ * Set interface
+ * ------------------------------------------------------- */
+
+bool set_insert(objectset *set, value val);
+bool set_ismember(objectset *set, value val);
+bool set_remove(objectset *set, value val);
+
+void set_initialize(void);
+
+#endif /* set_h */
@@ -0,0 +1,770 @@
+/** @file sorted.c
+ *  @author T J Atherton
+ *
+ *  @brief Veneer classes over the objectsorted type, which keeps values in order in a skip list
+ */
+
+#include <string.h>
+#include <math.h>
+#include "object.h"
+#include "sorted.h"
+#include "set.h"
+#include "morpho.h"
+#include "builtin.h"
+#include "veneer.h"
+#include "common.h"
+
+/* **********************************************************************
+ * Skip lists
+ * ********************************************************************** */
+
+/** Orders values of different kinds: nil, then booleans, numbers, strings, lists and other objects */
+static int skiplist_rank(value a) {
+    if (MORPHO_ISNIL(a)) return 0;
+    if (MORPHO_ISBOOL(a)) return 1;
+    if (MORPHO_ISNUMBER(a)) return 2;
+    if (MORPHO_ISSTRING(a)) return 3;
+    if (MORPHO_ISLIST(a)) return 4;
+    return 5;
+}
+
+/** Compares two values, returning a negative number if a precedes b, a positive number if b precedes a
+    and zero if they are the same. Unlike morpho_comparevalue this is a total order: numbers compare by
+    value whether integer or float, with nan after every other number, strings and lists lexicographically, and other objects by identity.
+    List keys are copied on insertion by sorted_freezekey, so recursion into them is bounded. */
+int skiplist_compare(value a, value b) {
+    int ra=skiplist_rank(a), rb=skiplist_rank(b);
+    if (ra!=rb) return ra-rb;
+
+    switch (ra) {
+        case 0: return 0;
+        case 1: return (int) MORPHO_GETBOOLVALUE(a) - (int) MORPHO_GETBOOLVALUE(b);
+        case 2: {
+            if (MORPHO_ISINTEGER(a) && MORPHO_ISINTEGER(b)) {
+                int x=MORPHO_GETINTEGERVALUE(a), y=MORPHO_GETINTEGERVALUE(b);
+                return (x>y)-(x<y);
+            }
+            double x=0.0, y=0.0;
+            if (!morpho_valuetofloat(a, &x) || !morpho_valuetofloat(b, &y)) return 0;
+            bool xnan=isnan(x), ynan=isnan(y);
+            if (xnan || ynan) return (int) xnan - (int) ynan; // nan follows every other number
+            return (x>y)-(x<y);
+        }
+        case 3: {
+            objectstring *x=MORPHO_GETSTRING(a), *y=MORPHO_GETSTRING(b);
+            size_t len=(x->length<y->length ? x->length : y->length);
+            int c=memcmp(x->string, y->string, len);
+            if (c) return c;
+            return (x->length>y->length)-(x->length<y->length);
+        }
+        case 4: {
+            objectlist *x=MORPHO_GETLIST(a), *y=MORPHO_GETLIST(b);
+            unsigned int len=(x->val.count<y->val.count ? x->val.count : y->val.count);
+            for (unsigned int i=0; i<len; i++) {
+                int c=skiplist_compare(x->val.data[i], y->val.data[i]);
+                if (c) return c;
+            }
+            return (x->val.count>y->val.count)-(x->val.count<y->val.count);
+        }
+        default: {
+            object *x=MORPHO_GETOBJECT(a), *y=MORPHO_GETOBJECT(b);
+            if (x->type!=y->type) return (x->type>y->type)-(x->type<y->type);
+            return (x>y)-(x<y);
+        }
+    }
+}
+
+/** Creates a node with a given number of levels */
+static skiplistnode *skiplist_newnode(value key, value val, unsigned int nlevels) {
+    skiplistnode *new = MORPHO_MALLOC(sizeof(skiplistnode)+nlevels*sizeof(skiplistnode *));
+
+    if (new) {
+        new->key=key;
+        new->val=val;
+        new->nlevels=nlevels;
+        for (unsigned int l=0; l<nlevels; l++) new->next[l]=NULL;
+    }
+
+    return new;
+}
+
+/** Picks the number of levels for a new node, promoting one node in four to each level above the first */
+static unsigned int skiplist_randomlevel(skiplist *list) {
+    uint32_t x=list->seed;
+    x^=x<<13; x^=x>>17; x^=x<<5; // xorshift32
+    list->seed=x;
+
+    unsigned int nlevels=1;
+    while (nlevels<SKIPLIST_MAXLEVEL && (x & 3)==0) {
+        nlevels++;
+        x>>=2;
+    }
+
+    return nlevels;
+}
+
+/** Finds the first node whose key is not less than key, recording in update the last node before it on each level */
+static skiplistnode *skiplist_search(skiplist *list, value key, skiplistnode **update) {
+    skiplistnode *x=list->head;
+
+    for (int l=list->nlevels-1; l>=0; l--) {
+        while (x->next[l] && skiplist_compare(x->next[l]->key, key)<0) x=x->next[l];
+        if (update) update[l]=x;
+    }
+
+    return x->next[0];
+}
+
+/** Initializes an empty skip list */
+bool skiplist_init(skiplist *list) {
+    list->count=0;
+    list->nlevels=1;
+    list->seed=0x9e3779b9;
+    list->cursor=NULL;
+    list->cursorindx=0;
+    list->head=skiplist_newnode(MORPHO_NIL, MORPHO_NIL, SKIPLIST_MAXLEVEL);
+    return (list->head!=NULL);
+}
+
+/** Removes every entry from a skip list, leaving it ready for use */
+void skiplist_wipe(skiplist *list) {
+    if (!list->head) return;
+
+    skiplistnode *x=list->head->next[0];
+    while (x) {
+        skiplistnode *next=x->next[0];
+        MORPHO_FREE(x);
+        x=next;
+    }
+
+    for (unsigned int l=0; l<SKIPLIST_MAXLEVEL; l++) list->head->next[l]=NULL;
+    list->count=0;
+    list->nlevels=1;
+    list->cursor=NULL;
+}
+
+/** Clears a skip list, freeing attached memory
+ *  @warning This doesn't free keys or values in the list. */
+void skiplist_clear(skiplist *list) {
+    skiplist_wipe(list);
+    if (list->head) MORPHO_FREE(list->head);
+    list->head=NULL;
+}
+
+/** Inserts an entry, replacing the value of an existing entry with the same key */
+bool skiplist_insert(skiplist *list, value key, value val) {
+    skiplistnode *update[SKIPLIST_MAXLEVEL];
+    skiplistnode *x=skiplist_search(list, key, update);
+
+    if (x && skiplist_compare(x->key, key)==0) {
+        x->val=val;
+        return true;
+    }
+
+    unsigned int nlevels=skiplist_randomlevel(list);
+    skiplistnode *new=skiplist_newnode(key, val, nlevels);
+    if (!new) return false;
+
+    if (nlevels>list->nlevels) {
+        for (unsigned int l=list->nlevels; l<nlevels; l++) update[l]=list->head;
+        list->nlevels=nlevels;
+    }
+
+    for (unsigned int l=0; l<nlevels; l++) {
+        new->next[l]=update[l]->next[l];
+        update[l]->next[l]=new;
+    }
+
+    list->count++;
+    list->cursor=NULL;
+
+    return true;
+}
+
+/** Looks up the value stored with a key; val may be NULL */
+bool skiplist_get(skiplist *list, value key, value *val) {
+    skiplistnode *x=skiplist_search(list, key, NULL);
+
+    if (x && skiplist_compare(x->key, key)==0) {
+        if (val) *val=x->val;
+        return true;
+    }
+
+    return false;
+}
+
+/** Removes the entry with a given key */
+bool skiplist_remove(skiplist *list, value key) {
+    skiplistnode *update[SKIPLIST_MAXLEVEL];
+    skiplistnode *x=skiplist_search(list, key, update);
+
+    if (!x || skiplist_compare(x->key, key)!=0) return false;
+
+    for (unsigned int l=0; l<x->nlevels; l++) update[l]->next[l]=x->next[l];
+    MORPHO_FREE(x);
+
+    while (list->nlevels>1 && !list->head->next[list->nlevels-1]) list->nlevels--;
+    list->count--;
+    list->cursor=NULL;
+
+    return true;
+}
+
+/** Returns the node with the smallest key, or NULL if the list is empty */
+skiplistnode *skiplist_first(skiplist *list) {
+    return list->head->next[0];
+}
+
+/** Returns the node with the largest key, or NULL if the list is empty */
+skiplistnode *skiplist_last(skiplist *list) {
+    skiplistnode *x=list->head;
+    for (int l=list->nlevels-1; l>=0; l--) {
+        while (x->next[l]) x=x->next[l];
+    }
+    return (x==list->head ? NULL : x);
+}
+
+/** Returns the node with the smallest key not less than key, or NULL if there is none */
+skiplistnode *skiplist_ceiling(skiplist *list, value key) {
+    return skiplist_search(list, key, NULL);
+}
+
+/** Returns the node with the largest key not greater than key, or NULL if there is none */
+skiplistnode *skiplist_floor(skiplist *list, value key) {
+    skiplistnode *x=list->head;
+    for (int l=list->nlevels-1; l>=0; l--) {
+        while (x->next[l] && skiplist_compare(x->next[l]->key, key)<=0) x=x->next[l];
+    }
+    return (x==list->head ? NULL : x);
+}
+
+/** Returns the n'th node in order of key. Successive calls with n, n+1, ... resume from the node found
+    by the previous call rather than counting from the start. */
+skiplistnode *skiplist_nth(skiplist *list, unsigned int n) {
+    if (n>=list->count) return NULL;
+
+    skiplistnode *x=list->head->next[0];
+    unsigned int i=0;
+    if (list->cursor && list->cursorindx<=n) {
+        x=list->cursor;
+        i=list->cursorindx;
+    }
+
+    for (; i<n; i++) x=x->next[0];
+
+    list->cursor=x;
+    list->cursorindx=n;
+
+    return x;
+}
+
+/** Copies the entries of one skip list into another, which must be empty */
+bool skiplist_copy(skiplist *src, skiplist *dest) {
+    skiplistnode *tail[SKIPLIST_MAXLEVEL]; // Last node on each level
+    for (unsigned int l=0; l<SKIPLIST_MAXLEVEL; l++) tail[l]=dest->head;
+
+    for (skiplistnode *x=src->head->next[0]; x; x=x->next[0]) {
+        unsigned int nlevels=skiplist_randomlevel(dest);
+        skiplistnode *new=skiplist_newnode(x->key, x->val, nlevels);
+        if (!new) return false;
+
+        if (nlevels>dest->nlevels) dest->nlevels=nlevels;
+        for (unsigned int l=0; l<nlevels; l++) {
+            tail[l]->next[l]=new;
+            tail[l]=new;
+        }
+        dest->count++;
+    }
+
+    dest->cursor=NULL;
+    return true;
+}
+
+/* **********************************************************************
+ * Sorted objects
+ * ********************************************************************** */
+
+objecttype objectsortedsettype;
+objecttype objectsorteddictionarytype;
+
+/** Estimated memory used by a sorted collection; nodes have 4/3 levels on average */
+static size_t sorted_size(objectsorted *s) {
+    return sizeof(objectsorted)+sizeof(skiplistnode)+SKIPLIST_MAXLEVEL*sizeof(skiplistnode *)+
+           s->list.count*(sizeof(skiplistnode)+2*sizeof(skiplistnode *));
+}
+
+/** Function object definitions */
+size_t objectsorted_sizefn(object *obj) {
+    return sorted_size((objectsorted *) obj);
+}
+
+void objectsortedset_printfn(object *obj) {
+    printf("<SortedSet>");
+}
+
+void objectsorteddictionary_printfn(object *obj) {
+    printf("<SortedDictionary>");
+}
+
+void objectsorted_markfn(object *obj, void *v) {
+    objectsorted *s = (objectsorted *) obj;
+    for (skiplistnode *x=s->list.head->next[0]; x; x=x->next[0]) {
+        morpho_markvalue(v, x->key);
+        morpho_markvalue(v, x->val);
+    }
+}
+
+void objectsorted_freefn(object *obj) {
+    skiplist_clear(&((objectsorted *) obj)->list);
+}
+
+objecttypedefn objectsortedsetdefn = {
+    .printfn=objectsortedset_printfn,
+    .markfn=objectsorted_markfn,
+    .freefn=objectsorted_freefn,
+    .sizefn=objectsorted_sizefn
+};
+
+objecttypedefn objectsorteddictionarydefn = {
+    .printfn=objectsorteddictionary_printfn,
+    .markfn=objectsorted_markfn,
+    .freefn=objectsorted_freefn,
+    .sizefn=objectsorted_sizefn
+};
+
+/** Creates an empty sortedset or sorteddictionary */
+objectsorted *object_newsorted(objecttype type) {
+    objectsorted *new = (objectsorted *) object_new(sizeof(objectsorted), type);
+
+    if (new && !skiplist_init(&new->list)) {
+        object_free((object *) new);
+        new=NULL;
+    }
+
+    return new;
+}
+
+/* **********************************************************************
+ * Sorted operations
+ * ********************************************************************* */
+
+/** Lists nested at least this deep can't be used as keys; this also rejects Lists that contain themselves */
+#define SORTED_MAXLISTDEPTH 64
+
+/** Copies a List key and the Lists within it, recording the copies in new
+ * @returns NULL on success, or the id of the error that prevented the copy */
+static errorid sorted_copylistkey(value key, int depth, varray_value *new, value *out) {
+    *out=key;
+    if (!MORPHO_ISLIST(key)) return NULL;
+    if (depth>=SORTED_MAXLISTDEPTH) return SORTED_LISTKEY;
+
+    objectlist *list=MORPHO_GETLIST(key);
+    objectlist *copy=object_newlist(list->val.count, list->val.data);
+    if (!copy) return ERROR_ALLOCATIONFAILED;
+    varray_valuewrite(new, MORPHO_OBJECT(copy));
+    if (copy->val.count!=list->val.count) return ERROR_ALLOCATIONFAILED;
+
+    for (unsigned int i=0; i<copy->val.count; i++) {
+        errorid err=sorted_copylistkey(copy->val.data[i], depth+1, new, copy->val.data+i);
+        if (err) return err;
+    }
+
+    *out=MORPHO_OBJECT(copy);
+    return NULL;
+}
+
+/** Freezes a List key by copying it, so that changing the original later can't disorder the skip list */
+static bool sorted_freezekey(vm *v, value key, value *out) {
+    varray_value new;
+    varray_valueinit(&new);
+
+    errorid err=sorted_copylistkey(key, 0, &new, out);
+    if (err) {
+        for (unsigned int i=0; i<new.count; i++) object_free(MORPHO_GETOBJECT(new.data[i]));
+        morpho_runtimeerror(v, err, SORTED_MAXLISTDEPTH); // Only the message of SORTED_LISTKEY uses the depth
+    } else morpho_bindobjects(v, new.count, new.data);
+
+    varray_valueclear(&new);
+    return !err;
+}
+
+/** Inserts an entry, informing the VM of the memory used */
+static bool sorted_insertwithvm(vm *v, objectsorted *s, value key, value val) {
+    if (MORPHO_ISNIL(key)) {
+        morpho_runtimeerror(v, SORTED_NILKEY);
+        return false;
+    }
+    if (MORPHO_ISLIST(key) && !sorted_freezekey(v, key, &key)) return false;
+
+    size_t size=sorted_size(s);
+    bool success=skiplist_insert(&s->list, key, val);
+    morpho_resizeobject(v, (object *) s, size, sorted_size(s));
+    if (!success) morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+
+    return success;
+}
+
+/** Removes an entry, informing the VM of the memory used */
+static bool sorted_removewithvm(vm *v, objectsorted *s, value key) {
+    size_t size=sorted_size(s);
+    bool success=skiplist_remove(&s->list, key);
+    morpho_resizeobject(v, (object *) s, size, sorted_size(s));
+    return success;
+}
+
+/** Creates a sorted collection of the same type with the same entries */
+static value sorted_clone(vm *v, objectsorted *s) {
+    objectsorted *new = object_newsorted(s->obj.type);
+    value out=MORPHO_NIL;
+
+    if (new && skiplist_copy(&s->list, &new->list)) {
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else {
+        if (new) object_free((object *) new);
+        morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+    }
+
+    return out;
+}
+
+/** Creates a List from the keys, or values, of the nodes from start up to but not including the first whose key is not less than end */
+static value sorted_tolist(vm *v, skiplistnode *start, value *end, bool values) {
+    objectlist *new = object_newlist(0, NULL);
+    value out=MORPHO_NIL;
+
+    if (new) {
+        for (skiplistnode *x=start; x; x=x->next[0]) {
+            if (end && skiplist_compare(x->key, *end)>=0) break;
+            list_append(new, (values ? x->val : x->key));
+        }
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+
+    return out;
+}
+
+/** Adds each element of an enumerable object to a sorted collection */
+static bool sorted_enumerableinitializer(vm *v, indx i, value val, void *ref) {
+    return sorted_insertwithvm(v, (objectsorted *) ref, val, MORPHO_NIL);
+}
+
+/* **********************************************************************
+ * Methods common to SortedSet and SortedDictionary
+ * ********************************************************************* */
+
+/** Removes a key */
+value Sorted_remove(vm *v, int nargs, value *args) {
+    objectsorted *slf = MORPHO_GETSORTED(MORPHO_SELF(args));
+
+    if (nargs==1) sorted_removewithvm(v, slf, MORPHO_GETARG(args, 0));
+    else morpho_runtimeerror(v, SORTED_ARGS);
+
+    return MORPHO_NIL;
+}
+
+/** Removes every key */
+value Sorted_clear(vm *v, int nargs, value *args) {
+    objectsorted *slf = MORPHO_GETSORTED(MORPHO_SELF(args));
+    size_t size=sorted_size(slf);
+
+    skiplist_wipe(&slf->list);
+    morpho_resizeobject(v, (object *) slf, size, sorted_size(slf));
+
+    return MORPHO_NIL;
+}
+
+/** Tests whether a key is present */
+value Sorted_contains(vm *v, int nargs, value *args) {
+    objectsorted *slf = MORPHO_GETSORTED(MORPHO_SELF(args));
+
+    if (nargs==1) return MORPHO_BOOL(skiplist_get(&slf->list, MORPHO_GETARG(args, 0), NULL));
+    MORPHO_RAISE(v, SORTED_ARGS);
+
+    return MORPHO_FALSE;
+}
+
+/** Counts the keys */
+value Sorted_count(vm *v, int nargs, value *args) {
+    return MORPHO_INTEGER(MORPHO_GETSORTED(MORPHO_SELF(args))->list.count);
+}
+
+/** Enumerate protocol; keys are visited in ascending order */
+value Sorted_enumerate(vm *v, int nargs, value *args) {
+    objectsorted *slf = MORPHO_GETSORTED(MORPHO_SELF(args));
+    value out=MORPHO_NIL;
+
+    if (nargs==1 && MORPHO_ISINTEGER(MORPHO_GETARG(args, 0))) {
+        int n=MORPHO_GETINTEGERVALUE(MORPHO_GETARG(args, 0));
+
+        if (n<0) out=MORPHO_INTEGER(slf->list.count);
+        else if (n<slf->list.count) out=skiplist_nth(&slf->list, n)->key;
+        else morpho_runtimeerror(v, VM_OUTOFBOUNDS);
+    } else MORPHO_RAISE(v, ENUMERATE_ARGS);
+
+    return out;
+}
+
+/** Clones a sorted collection */
+value Sorted_clone(vm *v, int nargs, value *args) {
+    return sorted_clone(v, MORPHO_GETSORTED(MORPHO_SELF(args)));
+}
+
+/** Returns the keys in ascending order as a List */
+value Sorted_tolist(vm *v, int nargs, value *args) {
+    return sorted_tolist(v, skiplist_first(&MORPHO_GETSORTED(MORPHO_SELF(args))->list), NULL, false);
+}
+
+/** Returns the smallest key */
+value Sorted_first(vm *v, int nargs, value *args) {
+    skiplistnode *x=skiplist_first(&MORPHO_GETSORTED(MORPHO_SELF(args))->list);
+    if (!x) MORPHO_RAISE(v, SORTED_EMPTY);
+    return x->key;
+}
+
+/** Returns the largest key */
+value Sorted_last(vm *v, int nargs, value *args) {
+    skiplistnode *x=skiplist_last(&MORPHO_GETSORTED(MORPHO_SELF(args))->list);
+    if (!x) MORPHO_RAISE(v, SORTED_EMPTY);
+    return x->key;
+}
+
+/** Removes and returns the smallest key */
+value Sorted_popfirst(vm *v, int nargs, value *args) {
+    objectsorted *slf = MORPHO_GETSORTED(MORPHO_SELF(args));
+    skiplistnode *x=skiplist_first(&slf->list);
+    if (!x) MORPHO_RAISE(v, SORTED_EMPTY);
+
+    value key=x->key;
+    sorted_removewithvm(v, slf, key);
+
+    return key;
+}
+
+/** Removes and returns the largest key */
+value Sorted_poplast(vm *v, int nargs, value *args) {
+    objectsorted *slf = MORPHO_GETSORTED(MORPHO_SELF(args));
+    skiplistnode *x=skiplist_last(&slf->list);
+    if (!x) MORPHO_RAISE(v, SORTED_EMPTY);
+
+    value key=x->key;
+    sorted_removewithvm(v, slf, key);
+
+    return key;
+}
+
+/** Returns the smallest key not less than the argument, or nil */
+value Sorted_ceiling(vm *v, int nargs, value *args) {
+    if (nargs!=1) MORPHO_RAISE(v, SORTED_ARGS);
+    skiplistnode *x=skiplist_ceiling(&MORPHO_GETSORTED(MORPHO_SELF(args))->list, MORPHO_GETARG(args, 0));
+    return (x ? x->key : MORPHO_NIL);
+}
+
+/** Returns the largest key not greater than the argument, or nil */
+value Sorted_floor(vm *v, int nargs, value *args) {
+    if (nargs!=1) MORPHO_RAISE(v, SORTED_ARGS);
+    skiplistnode *x=skiplist_floor(&MORPHO_GETSORTED(MORPHO_SELF(args))->list, MORPHO_GETARG(args, 0));
+    return (x ? x->key : MORPHO_NIL);
+}
+
+/** Returns a List of the keys from a lower bound, included, up to an upper bound, excluded */
+value Sorted_between(vm *v, int nargs, value *args) {
+    if (nargs!=2) MORPHO_RAISE(v, SORTED_BETWEENARGS);
+    skiplistnode *x=skiplist_ceiling(&MORPHO_GETSORTED(MORPHO_SELF(args))->list, MORPHO_GETARG(args, 0));
+    return sorted_tolist(v, x, &MORPHO_GETARG(args, 1), false);
+}
+
+/* **********************************************************************
+ * SortedSet veneer class
+ * ********************************************************************* */
+
+/** Constructs a SortedSet from its members, or from the elements of a single List, Range, Set or SortedSet */
+value sortedset_constructor(vm *v, int nargs, value *args) {
+    value init = (nargs==1 ? MORPHO_GETARG(args, 0) : MORPHO_NIL);
+    if (MORPHO_ISSORTEDSET(init)) return sorted_clone(v, MORPHO_GETSORTED(init));
+
+    objectsorted *new=object_newsorted(OBJECT_SORTEDSET);
+    if (!new) MORPHO_RAISE(v, ERROR_ALLOCATIONFAILED);
+
+    value out=MORPHO_OBJECT(new);
+    morpho_bindobjects(v, 1, &out);
+
+    if (MORPHO_ISLIST(init) || MORPHO_ISRANGE(init) || MORPHO_ISSET(init)) {
+        builtin_enumerateloop(v, init, sorted_enumerableinitializer, new);
+    } else {
+        for (int i=0; i<nargs; i++) {
+            if (!sorted_insertwithvm(v, new, MORPHO_GETARG(args, i), MORPHO_NIL)) break;
+        }
+    }
+
+    return out;
+}
+
+/** Inserts one or more values into a sortedset */
+value SortedSet_insert(vm *v, int nargs, value *args) {
+    objectsorted *slf = MORPHO_GETSORTED(MORPHO_SELF(args));
+
+    for (int i=0; i<nargs; i++) {
+        if (!sorted_insertwithvm(v, slf, MORPHO_GETARG(args, i), MORPHO_NIL)) break;
+    }
+
+    return MORPHO_NIL;
+}
+
+/** Prints a sortedset */
+value SortedSet_print(vm *v, int nargs, value *args) {
+    value self = MORPHO_SELF(args);
+    if (!MORPHO_ISSORTEDSET(self)) return Object_print(v, nargs, args);
+
+    objectsorted *slf = MORPHO_GETSORTED(self);
+
+    printf("SortedSet(");
+    for (skiplistnode *x=skiplist_first(&slf->list); x; x=x->next[0]) {
+        printf(x==skiplist_first(&slf->list) ? " " : ", ");
+        morpho_printvalue(x->key);
+    }
+    printf(" )");
+
+    return MORPHO_NIL;
+}
+
+MORPHO_BEGINCLASS(SortedSet)
+MORPHO_METHOD(SORTED_INSERT_METHOD, SortedSet_insert, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(SORTED_REMOVE_METHOD, Sorted_remove, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(SORTED_CLEAR_METHOD, Sorted_clear, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_CONTAINS_METHOD, Sorted_contains, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(SORTED_ISMEMBER_METHOD, Sorted_contains, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_PRINT_METHOD, SortedSet_print, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_COUNT_METHOD, Sorted_count, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_ENUMERATE_METHOD, Sorted_enumerate, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_CLONE_METHOD, Sorted_clone, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(SORTED_TOLIST_METHOD, Sorted_tolist, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(SORTED_FIRST_METHOD, Sorted_first, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(SORTED_LAST_METHOD, Sorted_last, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(SORTED_POPFIRST_METHOD, Sorted_popfirst, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(SORTED_POPLAST_METHOD, Sorted_poplast, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(SORTED_CEILING_METHOD, Sorted_ceiling, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(SORTED_FLOOR_METHOD, Sorted_floor, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(SORTED_BETWEEN_METHOD, Sorted_between, BUILTIN_FLAGSEMPTY)
+MORPHO_ENDCLASS
+
+/* **********************************************************************
+ * SortedDictionary veneer class
+ * ********************************************************************* */
+
+/** Constructs an empty SortedDictionary, or one with the entries of a Dictionary or SortedDictionary */
+value sorteddictionary_constructor(vm *v, int nargs, value *args) {
+    value init = (nargs==1 ? MORPHO_GETARG(args, 0) : MORPHO_NIL);
+    if (MORPHO_ISSORTEDDICTIONARY(init)) return sorted_clone(v, MORPHO_GETSORTED(init));
+
+    objectsorted *new=object_newsorted(OBJECT_SORTEDDICTIONARY);
+    if (!new) MORPHO_RAISE(v, ERROR_ALLOCATIONFAILED);
+
+    value out=MORPHO_OBJECT(new);
+    morpho_bindobjects(v, 1, &out);
+
+    if (MORPHO_ISDICTIONARY(init)) {
+        dictionary *dict=&MORPHO_GETDICTIONARY(init)->dict;
+        for (unsigned int i=0; i<dict->capacity; i++) {
+            if (MORPHO_ISNIL(dict->contents[i].key)) continue;
+            if (!sorted_insertwithvm(v, new, dict->contents[i].key, dict->contents[i].val)) break;
+        }
+    }
+
+    return out;
+}
+
+/** Gets the value stored with a key */
+value SortedDictionary_getindex(vm *v, int nargs, value *args) {
+    objectsorted *slf = MORPHO_GETSORTED(MORPHO_SELF(args));
+    value out=MORPHO_NIL;
+
+    if (nargs==1) {
+        if (!skiplist_get(&slf->list, MORPHO_GETARG(args, 0), &out)) morpho_runtimeerror(v, DICT_DCTKYNTFND);
+    } else morpho_runtimeerror(v, SORTED_ARGS);
+
+    return out;
+}
+
+/** Stores a value with a key */
+value SortedDictionary_setindex(vm *v, int nargs, value *args) {
+    objectsorted *slf = MORPHO_GETSORTED(MORPHO_SELF(args));
+
+    if (nargs==2) sorted_insertwithvm(v, slf, MORPHO_GETARG(args, 0), MORPHO_GETARG(args, 1));
+    else morpho_runtimeerror(v, SETINDEX_ARGS);
+
+    return MORPHO_NIL;
+}
+
+/** Returns the values in ascending order of key as a List */
+value SortedDictionary_values(vm *v, int nargs, value *args) {
+    return sorted_tolist(v, skiplist_first(&MORPHO_GETSORTED(MORPHO_SELF(args))->list), NULL, true);
+}
+
+/** Prints a sorteddictionary */
+value SortedDictionary_print(vm *v, int nargs, value *args) {
+    value self = MORPHO_SELF(args);
+    if (!MORPHO_ISSORTEDDICTIONARY(self)) return Object_print(v, nargs, args);
+
+    objectsorted *slf = MORPHO_GETSORTED(self);
+
+    printf("{ ");
+    for (skiplistnode *x=skiplist_first(&slf->list); x; x=x->next[0]) {
+        if (x!=skiplist_first(&slf->list)) printf(" , ");
+        morpho_printvalue(x->key);
+        printf(" : ");
+        morpho_printvalue(x->val);
+    }
+    printf(" }");
+
+    return MORPHO_NIL;
+}
+
+MORPHO_BEGINCLASS(SortedDictionary)
+MORPHO_METHOD(MORPHO_GETINDEX_METHOD, SortedDictionary_getindex, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_SETINDEX_METHOD, SortedDictionary_setindex, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(SORTED_REMOVE_METHOD, Sorted_remove, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(SORTED_CLEAR_METHOD, Sorted_clear, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_CONTAINS_METHOD, Sorted_contains, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_PRINT_METHOD, SortedDictionary_print, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_COUNT_METHOD, Sorted_count, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_ENUMERATE_METHOD, Sorted_enumerate, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_CLONE_METHOD, Sorted_clone, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(SORTED_KEYS_METHOD, Sorted_tolist, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(SORTED_VALUES_METHOD, SortedDictionary_values, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(SORTED_FIRST_METHOD, Sorted_first, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(SORTED_LAST_METHOD, Sorted_last, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(SORTED_POPFIRST_METHOD, Sorted_popfirst, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(SORTED_POPLAST_METHOD, Sorted_poplast, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(SORTED_CEILING_METHOD, Sorted_ceiling, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(SORTED_FLOOR_METHOD, Sorted_floor, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(SORTED_BETWEEN_METHOD, Sorted_between, BUILTIN_FLAGSEMPTY)
+MORPHO_ENDCLASS
+
+/* **********************************************************************
+ * Initialization
+ * ********************************************************************* */
+
+void sorted_initialize(void) {
+    objectsortedsettype=object_addtype(&objectsortedsetdefn);
+    objectsorteddictionarytype=object_addtype(&objectsorteddictionarydefn);
+
+    builtin_addfunction(SORTEDSET_CLASSNAME, sortedset_constructor, BUILTIN_FLAGSCONSTRUCTOR);
+    builtin_addfunction(SORTEDDICTIONARY_CLASSNAME, sorteddictionary_constructor, BUILTIN_FLAGSCONSTRUCTOR);
+
+    objectstring objname = MORPHO_STATICSTRING(OBJECT_CLASSNAME);
+    value objclass = builtin_findclass(MORPHO_OBJECT(&objname));
+
+    value sortedsetclass=builtin_addclass(SORTEDSET_CLASSNAME, MORPHO_GETCLASSDEFINITION(SortedSet), objclass);
+    object_setveneerclass(OBJECT_SORTEDSET, sortedsetclass);
+
+    value sorteddictionaryclass=builtin_addclass(SORTEDDICTIONARY_CLASSNAME, MORPHO_GETCLASSDEFINITION(SortedDictionary), objclass);
+    object_setveneerclass(OBJECT_SORTEDDICTIONARY, sorteddictionaryclass);
+
+    morpho_defineerror(SORTED_NILKEY, ERROR_HALT, SORTED_NILKEY_MSG);
+    morpho_defineerror(SORTED_LISTKEY, ERROR_HALT, SORTED_LISTKEY_MSG);
+    morpho_defineerror(SORTED_EMPTY, ERROR_HALT, SORTED_EMPTY_MSG);
+    morpho_defineerror(SORTED_ARGS, ERROR_HALT, SORTED_ARGS_MSG);
+    morpho_defineerror(SORTED_BETWEENARGS, ERROR_HALT, SORTED_BETWEENARGS_MSG);
+}
@@ -0,0 +1,130 @@
+/** @file sorted.h
+ *  @author T J Atherton
+ *
+ *  @brief Veneer classes over the objectsorted type, which keeps values in order in a skip list
+ */
+
+#ifndef sorted_h
+#define sorted_h
+
+#include <stdio.h>
+#include <stdint.h>
+#include "veneer.h"
+
+/* -------------------------------------------------------
+ * Skip lists
+ * ------------------------------------------------------- */
+
+/** Maximum number of levels in a skip list; with one node in four promoted to each level above the
+    first, this comfortably exceeds log_4 of the number of entries that fit in memory */
+#define SKIPLIST_MAXLEVEL 16
+
+/** Each node of a skip list holds an entry and links to the next node on each of its levels */
+typedef struct sskiplistnode {
+    value key;
+    value val;
+    unsigned int nlevels;
+    struct sskiplistnode *next[];
+} skiplistnode;
+
+/** Skip lists keep their entries in ascending order of key on the first level, and link progressively
+    sparser subsets of them on the levels above, so that an entry is found, inserted or removed in
+    O(log n) expected steps. The cursor caches the node reached when stepping through the entries by
+    position; it is reset whenever an entry is inserted or removed. */
+typedef struct {
+    unsigned int count; /** Number of entries */
+    unsigned int nlevels; /** Number of levels in use */
+    uint32_t seed; /** State of the generator that picks the level of new nodes */
+    skiplistnode *head; /** Sentinel node that links to the first node on every level */
+    skiplistnode *cursor; /** Node last found by position, or NULL */
+    unsigned int cursorindx; /** Position of that node */
+} skiplist;
+
+int skiplist_compare(value a, value b);
+
+bool skiplist_init(skiplist *list);
+void skiplist_clear(skiplist *list);
+void skiplist_wipe(skiplist *list);
+bool skiplist_insert(skiplist *list, value key, value val);
+bool skiplist_get(skiplist *list, value key, value *val);
+bool skiplist_remove(skiplist *list, value key);
+skiplistnode *skiplist_first(skiplist *list);
+skiplistnode *skiplist_last(skiplist *list);
+skiplistnode *skiplist_ceiling(skiplist *list, value key);
+skiplistnode *skiplist_floor(skiplist *list, value key);
+skiplistnode *skiplist_nth(skiplist *list, unsigned int n);
+bool skiplist_copy(skiplist *src, skiplist *dest);
+
+/* -------------------------------------------------------
+ * Sorted objects
+ * ------------------------------------------------------- */
+
+extern objecttype objectsortedsettype;
+#define OBJECT_SORTEDSET objectsortedsettype
+
+extern objecttype objectsorteddictionarytype;
+#define OBJECT_SORTEDDICTIONARY objectsorteddictionarytype
+
+/** SortedSets and SortedDictionaries both keep their entries in a skip list; the members of a
+    SortedSet are the keys, with nil values. */
+typedef struct {
+    object obj;
+    skiplist list;
+} objectsorted;
+
+/** Tests whether an object is a sortedset */
+#define MORPHO_ISSORTEDSET(val) object_istype(val, OBJECT_SORTEDSET)
+
+/** Tests whether an object is a sorteddictionary */
+#define MORPHO_ISSORTEDDICTIONARY(val) object_istype(val, OBJECT_SORTEDDICTIONARY)
+
+/** Gets the object as a sorted collection */
+#define MORPHO_GETSORTED(val)   ((objectsorted *) MORPHO_GETOBJECT(val))
+
+/** Creates an empty sortedset or sorteddictionary */
+objectsorted *object_newsorted(objecttype type);
+
+/* -------------------------------------------------------
+ * SortedSet and SortedDictionary classes
+ * ------------------------------------------------------- */
+
+#define SORTEDSET_CLASSNAME "SortedSet"
+#define SORTEDDICTIONARY_CLASSNAME "SortedDictionary"
+
+#define SORTED_INSERT_METHOD "insert"
+#define SORTED_REMOVE_METHOD "remove"
+#define SORTED_CLEAR_METHOD "clear"
+#define SORTED_ISMEMBER_METHOD "ismember"
+#define SORTED_TOLIST_METHOD "tolist"
+#define SORTED_KEYS_METHOD "keys"
+#define SORTED_VALUES_METHOD "values"
+#define SORTED_FIRST_METHOD "first"
+#define SORTED_LAST_METHOD "last"
+#define SORTED_POPFIRST_METHOD "popfirst"
+#define SORTED_POPLAST_METHOD "poplast"
+#define SORTED_CEILING_METHOD "ceiling"
+#define SORTED_FLOOR_METHOD "floor"
+#define SORTED_BETWEEN_METHOD "between"
+
+#define SORTED_NILKEY                     "SrtdNil"
+#define SORTED_NILKEY_MSG                 "Sorted collections cannot contain nil."
+
+#define SORTED_LISTKEY                    "SrtdLstKey"
+#define SORTED_LISTKEY_MSG                "Lists used as keys of sorted collections must be nested fewer than %i deep and cannot contain themselves."
+
+#define SORTED_EMPTY                      "SrtdEmpty"
+#define SORTED_EMPTY_MSG                  "Sorted collection is empty."
+
+#define SORTED_ARGS                       "SrtdArgs"
+#define SORTED_ARGS_MSG                   "Method expects a single key."
+
+#define SORTED_BETWEENARGS                "SrtdBtwnArgs"
+#define SORTED_BETWEENARGS_MSG            "Between expects two keys, the lower bound included and the upper bound excluded."
+
+/* -------------------------------------------------------
+ * Sorted interface
+ * ------------------------------------------------------- */
+
+void sorted_initialize(void);
+
+#endif /* sorted_h */
@@ -1141,6 +1141,80 @@ objectsparseerror sparse_div(objectsparse *a, objectmatrix *b, objectmatrix *out
     return SPARSE_FAILED;
 }
 
+/** Multiply a sparse matrix a by a complex dense matrix b: out -> out + a*b
+ * @param[in] a - sparse matrix
+ * @param[in] b - complex matrix
+ * @param[out] out - out + a*b. */
+objectsparseerror sparse_mulsxz(objectsparse *a, objectcomplexmatrix *b, objectcomplexmatrix *out) {
+    if (!(sparse_checkformat(a, SPARSE_CCS, true, true))) return SPARSE_CONVFAILED;
+    if (a->ccs.ncols!=b->nrows || out->nrows!=a->ccs.nrows || out->ncols!=b->ncols) return SPARSE_INCMPTBLDIM;
+
+    for (int col=0; col<a->ccs.ncols; col++) {
+        int nentries, *entries;
+        double *svalues;
+        sparseccs_getrowindiceswithvalues(&a->ccs, col, &nentries, &entries, &svalues);
+
+        for (unsigned int k=0; k<b->ncols; k++) {
+            double complex bk=b->elements[col+k*b->nrows];
+            for (int i=0; i<nentries; i++) out->elements[entries[i]+k*out->nrows]+=svalues[i]*bk;
+        }
+    }
+    return SPARSE_OK;
+}
+
+/** Multiply a complex dense matrix a by a sparse matrix b: out -> out + a*b
+ * @param[in] a - complex matrix
+ * @param[in] b - sparse matrix
+ * @param[out] out - out + a*b. */
+objectsparseerror sparse_mulzxs(objectcomplexmatrix *a, objectsparse *b, objectcomplexmatrix *out) {
+    if (!(sparse_checkformat(b, SPARSE_CCS, true, true))) return SPARSE_CONVFAILED;
+    if (a->ncols!=b->ccs.nrows || out->nrows!=a->nrows || out->ncols!=b->ccs.ncols) return SPARSE_INCMPTBLDIM;
+
+    for (int col=0; col<b->ccs.ncols; col++) {
+        int nentries, *entries;
+        double *svalues;
+        sparseccs_getrowindiceswithvalues(&b->ccs, col, &nentries, &entries, &svalues);
+
+        for (int i=0; i<nentries; i++) {
+            for (unsigned int row=0; row<a->nrows; row++) out->elements[row+col*out->nrows]+=a->elements[row+entries[i]*a->nrows]*svalues[i];
+        }
+    }
+    return SPARSE_OK;
+}
+
+/** Solves a linear system with a sparse matrix a and complex right hand side b. As a is real, the real and
+ *  imaginary parts of each column of b are solved for separately.
+ * @param[in] a - sparse matrix
+ * @param[in] b - complex matrix
+ * @param[out] out - the solution. */
+objectsparseerror sparse_divz(objectsparse *a, objectcomplexmatrix *b, objectcomplexmatrix *out) {
+    if (!(sparse_checkformat(a, SPARSE_CCS, true, true))) return SPARSE_CONVFAILED;
+    if (a->ccs.ncols!=b->nrows || b->nrows!=out->nrows || b->ncols!=out->ncols) return SPARSE_INCMPTBLDIM;
+
+#ifdef MORPHO_LINALG_USE_CSPARSE
+    cs A;
+    sparse_ccstocsparse(&a->ccs, &A);
+    int n=b->nrows, ret=true;
+    double *x=MORPHO_MALLOC(sizeof(double)*n);
+    if (!x) return SPARSE_FAILED;
+
+    for (unsigned int k=0; k<b->ncols && ret; k++) {
+        double complex *bk=b->elements+k*n, *ok=out->elements+k*n;
+        for (int part=0; part<2 && ret; part++) {
+            for (int i=0; i<n; i++) x[i]=(part ? cimag(bk[i]) : creal(bk[i]));
+            ret=(a->ccs.ncols==a->ccs.nrows ? cs_lusol(0, &A, x, MORPHO_EPS) : cs_qrsol(0, &A, x));
+            if (part) for (int i=0; i<n; i++) ok[i]+=x[i]*I;
+            else for (int i=0; i<n; i++) ok[i]=x[i];
+        }
+    }
+
+    MORPHO_FREE(x);
+    if (ret) return SPARSE_OK;
+#endif
+
+    return SPARSE_FAILED;
+}
+
 /** Transpose a sparse matrix
  * @param[in] a - sparse matrix
  * @param[out] out - transpose(A). */
@@ -1378,6 +1452,17 @@ value Sparse_mul(vm *v, int nargs, value *args) {
             if (out) {
                 err=sparse_mulsxd(a, b, out);
             } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+        } else if (MORPHO_ISCOMPLEXMATRIX(MORPHO_GETARG(args, 0))) {
+            objectcomplexmatrix *b=MORPHO_GETCOMPLEXMATRIX(MORPHO_GETARG(args, 0));
+            int nrows;
+            sparse_getdimensions(a, &nrows, NULL);
+
+            objectcomplexmatrix *out=object_newcomplexmatrix(nrows, b->ncols, true);
+            new = (objectsparse *) out; // Munge type to ensure binding/deallocation
+
+            if (out) {
+                err=sparse_mulsxz(a, b, out);
+            } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
         } else if (MORPHO_ISNUMBER(MORPHO_GETARG(args, 0))) {
             double scale;
             if (!morpho_valuetofloat(MORPHO_GETARG(args, 0), &scale)) return MORPHO_NIL;
@@ -1426,6 +1511,23 @@ value Sparse_mulr(vm *v, int nargs, value *args) {
                     if (new) object_free((object *) new);
                 }
             } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+        } else if (MORPHO_ISCOMPLEXMATRIX(MORPHO_GETARG(args, 0))) {
+            objectcomplexmatrix *a=MORPHO_GETCOMPLEXMATRIX(MORPHO_GETARG(args, 0));
+            int ncols;
+            sparse_getdimensions(b, NULL, &ncols);
+
+            objectcomplexmatrix *new=object_newcomplexmatrix(a->nrows, ncols, true);
+
+            if (new) {
+                err=sparse_mulzxs(a, b, new);
+                if (err==SPARSE_OK) {
+                    out=MORPHO_OBJECT(new);
+                    morpho_bindobjects(v, 1, &out);
+                } else {
+                    sparse_raiseerror(v, err);
+                    object_free((object *) new);
+                }
+            } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
         } else if (MORPHO_ISNUMBER(MORPHO_GETARG(args, 0))) {
             return Sparse_mul(v, nargs, args); // Redirect to regular multiplication
         }
@@ -1460,6 +1562,23 @@ value Sparse_divr(vm *v, int nargs, value *args) {
                 sparse_raiseerror(v, err);
             }
         } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+    } else if (nargs==1 && MORPHO_ISCOMPLEXMATRIX(MORPHO_GETARG(args, 0))) {
+        objectcomplexmatrix *b=MORPHO_GETCOMPLEXMATRIX(MORPHO_GETARG(args, 0));
+
+        objectcomplexmatrix *new = object_newcomplexmatrix(b->nrows, b->ncols, false);
+        if (new) {
+            size_t asize=sparse_size(a);
+            objectsparseerror err=sparse_divz(a, b, new);
+            morpho_resizeobject(v, (object *) a, asize, sparse_size(a));
+
+            if (err==SPARSE_OK) {
+                out=MORPHO_OBJECT(new);
+                morpho_bindobjects(v, 1, &out);
+            } else {
+                object_free((object *) new);
+                sparse_raiseerror(v, err);
+            }
+        } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
     }
 
     return out;
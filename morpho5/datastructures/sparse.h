@@ -11,6 +11,7 @@
 #include "object.h"
 #include "morpho.h"
 #include "matrix.h"
+#include "complexmatrix.h"
 
 /* ***************************************
  * Sparse objects
@@ -163,6 +164,9 @@ objectsparseerror sparse_add(objectsparse *a, objectsparse *b, double alpha, dou
 objectsparseerror sparse_mul(objectsparse *a, objectsparse *b, objectsparse *out);
 objectsparseerror sparse_mulsxd(objectsparse *a, objectmatrix *b, objectmatrix *out);
 objectsparseerror sparse_muldxs(objectmatrix *a, objectsparse *b, objectmatrix *out);
+objectsparseerror sparse_mulsxz(objectsparse *a, objectcomplexmatrix *b, objectcomplexmatrix *out);
+objectsparseerror sparse_mulzxs(objectcomplexmatrix *a, objectsparse *b, objectcomplexmatrix *out);
+objectsparseerror sparse_divz(objectsparse *a, objectcomplexmatrix *b, objectcomplexmatrix *out);
 objectsparseerror sparse_transpose(objectsparse *a, objectsparse *out);
 
 void sparse_clear(objectsparse *a);
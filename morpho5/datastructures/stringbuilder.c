@@ -0,0 +1,178 @@
+/** @file stringbuilder.c
+ *  @author T J Atherton
+ *
+ *  @brief Veneer class over the objectstringbuilder type, a mutable string with amortized append
+ */
+
+#include "object.h"
+#include "stringbuilder.h"
+#include "morpho.h"
+#include "builtin.h"
+#include "veneer.h"
+#include "common.h"
+
+/* **********************************************************************
+ * StringBuilder objects
+ * ********************************************************************** */
+
+objecttype objectstringbuildertype;
+
+/** Function object definitions */
+size_t objectstringbuilder_sizefn(object *obj) {
+    return sizeof(objectstringbuilder)+((objectstringbuilder *) obj)->buffer.capacity;
+}
+
+void objectstringbuilder_printfn(object *obj) {
+    objectstringbuilder *sb = (objectstringbuilder *) obj;
+    printf("%.*s", sb->buffer.count, sb->buffer.data);
+}
+
+void objectstringbuilder_freefn(object *obj) {
+    varray_charclear(&((objectstringbuilder *) obj)->buffer);
+}
+
+objecttypedefn objectstringbuilderdefn = {
+    .printfn=objectstringbuilder_printfn,
+    .markfn=NULL,
+    .freefn=objectstringbuilder_freefn,
+    .sizefn=objectstringbuilder_sizefn
+};
+
+/** Creates an empty string builder */
+objectstringbuilder *object_newstringbuilder(void) {
+    objectstringbuilder *new = (objectstringbuilder *) object_new(sizeof(objectstringbuilder), OBJECT_STRINGBUILDER);
+
+    if (new) varray_charinit(&new->buffer);
+
+    return new;
+}
+
+/* **********************************************************************
+ * StringBuilder operations
+ * ********************************************************************* */
+
+/** Appends a value to a string builder, converting it to text as string interpolation does,
+    and informs the VM if the buffer grew */
+void stringbuilder_append(vm *v, objectstringbuilder *sb, value val) {
+    unsigned int capacity = sb->buffer.capacity;
+
+    morpho_printtobuffer(v, val, &sb->buffer);
+
+    if (sb->buffer.capacity!=capacity) morpho_resizeobject(v, (object *) sb, sizeof(objectstringbuilder)+capacity, sizeof(objectstringbuilder)+sb->buffer.capacity);
+}
+
+/** Writes the contents of a string builder to a file without creating an intermediate string */
+bool stringbuilder_write(objectstringbuilder *sb, FILE *f) {
+    return (fwrite(sb->buffer.data, sizeof(char), sb->buffer.count, f)==sb->buffer.count);
+}
+
+/* **********************************************************************
+ * StringBuilder veneer class
+ * ********************************************************************* */
+
+/** Creates a string builder, optionally appending some initial values */
+value stringbuilder_constructor(vm *v, int nargs, value *args) {
+    value out=MORPHO_NIL;
+    objectstringbuilder *new=object_newstringbuilder();
+
+    if (new) {
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+        for (int i=0; i<nargs; i++) stringbuilder_append(v, new, MORPHO_GETARG(args, i));
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+
+    return out;
+}
+
+/** Appends one or more values; returns the string builder so that calls may be chained */
+value StringBuilder_append(vm *v, int nargs, value *args) {
+    objectstringbuilder *slf = MORPHO_GETSTRINGBUILDER(MORPHO_SELF(args));
+
+    for (int i=0; i<nargs; i++) stringbuilder_append(v, slf, MORPHO_GETARG(args, i));
+
+    return MORPHO_SELF(args);
+}
+
+/** Empties a string builder, keeping its storage for reuse */
+value StringBuilder_clear(vm *v, int nargs, value *args) {
+    objectstringbuilder *slf = MORPHO_GETSTRINGBUILDER(MORPHO_SELF(args));
+
+    slf->buffer.count=0;
+
+    return MORPHO_NIL;
+}
+
+/** Counts the number of characters */
+value StringBuilder_count(vm *v, int nargs, value *args) {
+    objectstringbuilder *slf = MORPHO_GETSTRINGBUILDER(MORPHO_SELF(args));
+    int n=0;
+
+    for (unsigned int i=0; i<slf->buffer.count; n++) {
+        i+=morpho_utf8numberofbytes((uint8_t *) slf->buffer.data+i);
+    }
+
+    return MORPHO_INTEGER(n);
+}
+
+/** Converts the contents to a String */
+value StringBuilder_tostring(vm *v, int nargs, value *args) {
+    objectstringbuilder *slf = MORPHO_GETSTRINGBUILDER(MORPHO_SELF(args));
+    value out = object_stringfromvarraychar(&slf->buffer);
+
+    if (MORPHO_ISSTRING(out)) morpho_bindobjects(v, 1, &out);
+    else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+
+    return out;
+}
+
+/** Prints the contents */
+value StringBuilder_print(vm *v, int nargs, value *args) {
+    value self = MORPHO_SELF(args);
+    if (!MORPHO_ISSTRINGBUILDER(self)) return Object_print(v, nargs, args);
+
+    objectstringbuilder_printfn(MORPHO_GETOBJECT(self));
+
+    return MORPHO_NIL;
+}
+
+/** Clones a string builder */
+value StringBuilder_clone(vm *v, int nargs, value *args) {
+    objectstringbuilder *slf = MORPHO_GETSTRINGBUILDER(MORPHO_SELF(args));
+    objectstringbuilder *new = object_newstringbuilder();
+    value out=MORPHO_NIL;
+
+    if (new && (slf->buffer.count==0 || varray_charadd(&new->buffer, slf->buffer.data, slf->buffer.count))) {
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else {
+        if (new) object_free((object *) new);
+        morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+    }
+
+    return out;
+}
+
+MORPHO_BEGINCLASS(StringBuilder)
+MORPHO_METHOD(STRINGBUILDER_APPEND_METHOD, StringBuilder_append, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(STRINGBUILDER_CLEAR_METHOD, StringBuilder_clear, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_COUNT_METHOD, StringBuilder_count, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_TOSTRING_METHOD, StringBuilder_tostring, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_PRINT_METHOD, StringBuilder_print, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_CLONE_METHOD, StringBuilder_clone, BUILTIN_FLAGSEMPTY)
+MORPHO_ENDCLASS
+
+/* **********************************************************************
+ * Initialization
+ * ********************************************************************* */
+
+void stringbuilder_initialize(void) {
+    objectstringbuildertype=object_addtype(&objectstringbuilderdefn);
+
+    builtin_addfunction(STRINGBUILDER_CLASSNAME, stringbuilder_constructor, BUILTIN_FLAGSCONSTRUCTOR);
+
+    objectstring objname = MORPHO_STATICSTRING(OBJECT_CLASSNAME);
+    value objclass = builtin_findclass(MORPHO_OBJECT(&objname));
+
+    value stringbuilderclass=builtin_addclass(STRINGBUILDER_CLASSNAME, MORPHO_GETCLASSDEFINITION(StringBuilder), objclass);
+    object_setveneerclass(OBJECT_STRINGBUILDER, stringbuilderclass);
+}
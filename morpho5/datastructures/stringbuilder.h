@@ -0,0 +1,54 @@
+/** @file stringbuilder.h
+ *  @author T J Atherton
+ *
+ *  @brief Veneer class over the objectstringbuilder type, a mutable string with amortized append
+ */
+
+#ifndef stringbuilder_h
+#define stringbuilder_h
+
+#include <stdio.h>
+#include "veneer.h"
+
+/* -------------------------------------------------------
+ * StringBuilder objects
+ * ------------------------------------------------------- */
+
+extern objecttype objectstringbuildertype;
+#define OBJECT_STRINGBUILDER objectstringbuildertype
+
+/** StringBuilders accumulate text in a growable buffer, so that building a string piece by piece
+    costs time proportional to its final length rather than copying the text built so far on every step. */
+typedef struct {
+    object obj;
+    varray_char buffer;
+} objectstringbuilder;
+
+/** Tests whether an object is a string builder */
+#define MORPHO_ISSTRINGBUILDER(val) object_istype(val, OBJECT_STRINGBUILDER)
+
+/** Gets the object as a string builder */
+#define MORPHO_GETSTRINGBUILDER(val)   ((objectstringbuilder *) MORPHO_GETOBJECT(val))
+
+/** Creates an empty string builder */
+objectstringbuilder *object_newstringbuilder(void);
+
+/* -------------------------------------------------------
+ * StringBuilder class
+ * ------------------------------------------------------- */
+
+#define STRINGBUILDER_CLASSNAME "StringBuilder"
+
+#define STRINGBUILDER_APPEND_METHOD "append"
+#define STRINGBUILDER_CLEAR_METHOD "clear"
+
+/* -------------------------------------------------------
+ * StringBuilder interface
+ * ------------------------------------------------------- */
+
+void stringbuilder_append(vm *v, objectstringbuilder *sb, value val);
+bool stringbuilder_write(objectstringbuilder *sb, FILE *f);
+
+void stringbuilder_initialize(void);
+
+#endif /* stringbuilder_h */
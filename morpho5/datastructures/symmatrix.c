@@ -0,0 +1,632 @@
+/** @file symmatrix.c
+ *  @author T J Atherton
+ *
+ *  @brief Veneer class over the objectsymmatrix type, a symmetric matrix stored in packed form
+ */
+
+#include <string.h>
+#include "object.h"
+#include "matrix.h"
+#include "symmatrix.h"
+#include "morpho.h"
+#include "builtin.h"
+#include "veneer.h"
+#include "common.h"
+
+/* **********************************************************************
+ * Symmetric matrix objects
+ * ********************************************************************** */
+
+objecttype objectsymmatrixtype;
+
+/** Function object definitions */
+size_t objectsymmatrix_sizefn(object *obj) {
+    return sizeof(objectsymmatrix)+sizeof(double)*SYMMATRIX_SIZE(((objectsymmatrix *) obj)->n);
+}
+
+void objectsymmatrix_printfn(object *obj) {
+    printf("<SymmetricMatrix>");
+}
+
+objecttypedefn objectsymmatrixdefn = {
+    .printfn=objectsymmatrix_printfn,
+    .markfn=NULL,
+    .freefn=NULL,
+    .sizefn=objectsymmatrix_sizefn
+};
+
+/** Creates a symmetric matrix */
+objectsymmatrix *object_newsymmatrix(unsigned int n, bool zero) {
+    unsigned int nel = SYMMATRIX_SIZE(n);
+    objectsymmatrix *new = (objectsymmatrix *) object_new(sizeof(objectsymmatrix)+nel*sizeof(double), OBJECT_SYMMATRIX);
+
+    if (new) {
+        new->n=n;
+        new->elements=new->matrixdata;
+        if (zero) memset(new->elements, 0, sizeof(double)*nel);
+    }
+
+    return new;
+}
+
+/** Creates a symmetric matrix from the lower triangle of a square matrix; the upper triangle is ignored */
+objectsymmatrix *object_symmatrixfrommatrix(objectmatrix *m) {
+    if (m->nrows!=m->ncols) return NULL;
+    objectsymmatrix *new = object_newsymmatrix(m->nrows, false);
+
+    if (new) {
+        unsigned int n=m->nrows;
+        for (unsigned int j=0; j<n; j++) {
+            memcpy(new->elements+SYMMATRIX_INDEX(n, j, j), m->elements+j+j*n, sizeof(double)*(n-j));
+        }
+    }
+
+    return new;
+}
+
+/** Creates a full matrix from a symmetric matrix */
+objectmatrix *object_matrixfromsymmatrix(objectsymmatrix *s) {
+    unsigned int n=s->n;
+    objectmatrix *new = object_newmatrix(n, n, false);
+
+    if (new) {
+        for (unsigned int j=0; j<n; j++) {
+            for (unsigned int i=j; i<n; i++) {
+                double val=s->elements[SYMMATRIX_INDEX(n, i, j)];
+                new->elements[i+j*n]=val;
+                new->elements[j+i*n]=val;
+            }
+        }
+    }
+
+    return new;
+}
+
+/** Creates a copy of a symmetric matrix */
+static objectsymmatrix *object_clonesymmatrix(objectsymmatrix *s) {
+    objectsymmatrix *new = object_newsymmatrix(s->n, false);
+    if (new) memcpy(new->elements, s->elements, sizeof(double)*SYMMATRIX_SIZE(s->n));
+    return new;
+}
+
+/* **********************************************************************
+ * Symmetric matrix operations
+ * ********************************************************************* */
+
+/** Gets element (i, j) of a symmetric matrix; indices must be in range */
+double symmatrix_get(objectsymmatrix *a, unsigned int i, unsigned int j) {
+    return (i>=j ? a->elements[SYMMATRIX_INDEX(a->n, i, j)] : a->elements[SYMMATRIX_INDEX(a->n, j, i)]);
+}
+
+/** Accumulates a multiple of another symmetric matrix in place, a + lambda*b -> a */
+objectmatrixerror symmatrix_accumulate(objectsymmatrix *a, double lambda, objectsymmatrix *b) {
+    if (a->n!=b->n) return MATRIX_INCMPTBLDIM;
+    cblas_daxpy(SYMMATRIX_SIZE(a->n), lambda, b->elements, 1, a->elements, 1);
+    return MATRIX_OK;
+}
+
+/** Scales a symmetric matrix in place */
+objectmatrixerror symmatrix_scale(objectsymmatrix *a, double scale) {
+    cblas_dscal(SYMMATRIX_SIZE(a->n), scale, a->elements, 1);
+    return MATRIX_OK;
+}
+
+/** Multiplies a symmetric matrix by a matrix, a * b -> out, applying dspmv to each column of b */
+objectmatrixerror symmatrix_mulmatrix(objectsymmatrix *a, objectmatrix *b, objectmatrix *out) {
+    if (a->n!=b->nrows || out->nrows!=a->n || out->ncols!=b->ncols) return MATRIX_INCMPTBLDIM;
+    for (unsigned int j=0; j<b->ncols; j++) {
+        cblas_dspmv(CblasColMajor, CblasLower, a->n, 1.0, a->elements, b->elements+j*b->nrows, 1, 0.0, out->elements+j*out->nrows, 1);
+    }
+    return MATRIX_OK;
+}
+
+/** Multiplies a matrix by a symmetric matrix, a * b -> out; since b is symmetric each row of the result is b applied to the corresponding row of a */
+objectmatrixerror symmatrix_matrixmul(objectmatrix *a, objectsymmatrix *b, objectmatrix *out) {
+    if (a->ncols!=b->n || out->nrows!=a->nrows || out->ncols!=b->n) return MATRIX_INCMPTBLDIM;
+    for (unsigned int i=0; i<a->nrows; i++) {
+        cblas_dspmv(CblasColMajor, CblasLower, b->n, 1.0, b->elements, a->elements+i, a->nrows, 0.0, out->elements+i, out->nrows);
+    }
+    return MATRIX_OK;
+}
+
+/** Frobenius inner product; each off-diagonal element stored represents two elements of the full matrix */
+objectmatrixerror symmatrix_inner(objectsymmatrix *a, objectsymmatrix *b, double *out) {
+    if (a->n!=b->n) return MATRIX_INCMPTBLDIM;
+    double sum=2.0*cblas_ddot(SYMMATRIX_SIZE(a->n), a->elements, 1, b->elements, 1);
+    for (unsigned int j=0; j<a->n; j++) {
+        unsigned int k=SYMMATRIX_INDEX(a->n, j, j);
+        sum-=a->elements[k]*b->elements[k];
+    }
+    *out=sum;
+    return MATRIX_OK;
+}
+
+/** Solves a.x = b. The matrix is first factorized with a Cholesky decomposition, which succeeds if it is positive definite
+ *  as mass matrices and Gram matrices are; otherwise the Bunch-Kaufman factorization is used.
+ * @returns MATRIX_OK, MATRIX_INCMPTBLDIM, MATRIX_SING if a is singular or MATRIX_ALLOC */
+objectmatrixerror symmatrix_solve(objectsymmatrix *a, objectmatrix *b, objectmatrix *out) {
+    if (a->n!=b->nrows || out->nrows!=b->nrows || out->ncols!=b->ncols) return MATRIX_INCMPTBLDIM;
+    int n=a->n, nrhs=b->ncols, info;
+    unsigned int size=SYMMATRIX_SIZE(a->n);
+
+    double *ap=MORPHO_MALLOC(sizeof(double)*(size ? size : 1));
+    if (!ap) return MATRIX_ALLOC;
+
+    memcpy(ap, a->elements, sizeof(double)*size);
+    if (out!=b) cblas_dcopy(b->nrows*b->ncols, b->elements, 1, out->elements, 1);
+
+#ifdef MORPHO_LINALG_USE_LAPACKE
+    info=LAPACKE_dppsv(LAPACK_COL_MAJOR, 'L', n, nrhs, ap, out->elements, n);
+#else
+    dppsv_("L", &n, &nrhs, ap, out->elements, &n, &info);
+#endif
+
+    if (info>0) { /* Not positive definite: start again from the original matrix and right hand side */
+        int *pivot=MORPHO_MALLOC(sizeof(int)*(n ? n : 1));
+        if (!pivot) { MORPHO_FREE(ap); return MATRIX_ALLOC; }
+
+        memcpy(ap, a->elements, sizeof(double)*size);
+        cblas_dcopy(b->nrows*b->ncols, b->elements, 1, out->elements, 1);
+
+#ifdef MORPHO_LINALG_USE_LAPACKE
+        info=LAPACKE_dspsv(LAPACK_COL_MAJOR, 'L', n, nrhs, ap, pivot, out->elements, n);
+#else
+        dspsv_("L", &n, &nrhs, ap, pivot, out->elements, &n, &info);
+#endif
+        MORPHO_FREE(pivot);
+    }
+
+    MORPHO_FREE(ap);
+    return (info==0 ? MATRIX_OK : (info>0 ? MATRIX_SING : MATRIX_INVLD));
+}
+
+/** Finds the eigenvalues, in ascending order, and optionally the orthonormal eigenvectors of a symmetric matrix
+ * @param[in] a - the matrix
+ * @param[out] w - eigenvalues; must hold a->n values
+ * @param[out] vec - if not NULL, an n x n matrix that receives the eigenvectors as columns */
+objectmatrixerror symmatrix_eigensystem(objectsymmatrix *a, double *w, objectmatrix *vec) {
+    int n=a->n, info;
+    unsigned int size=SYMMATRIX_SIZE(a->n);
+    double *ap=MORPHO_MALLOC(sizeof(double)*(size ? size : 1));
+    if (!ap) return MATRIX_ALLOC;
+    memcpy(ap, a->elements, sizeof(double)*size);
+
+#ifdef MORPHO_LINALG_USE_LAPACKE
+    info=LAPACKE_dspev(LAPACK_COL_MAJOR, (vec ? 'V' : 'N'), 'L', n, ap, w, (vec ? vec->elements : NULL), n);
+#else
+    double work[3*n+1];
+    dspev_((vec ? "V" : "N"), "L", &n, ap, w, (vec ? vec->elements : NULL), &n, work, &info);
+#endif
+
+    MORPHO_FREE(ap);
+    return (info==0 ? MATRIX_OK : (info>0 ? MATRIX_FAILED : MATRIX_INVLD));
+}
+
+/** Sums all elements of the full matrix using Kahan summation */
+double symmatrix_sum(objectsymmatrix *a) {
+    double sum=0.0, c=0.0, y, t;
+
+    for (unsigned int j=0; j<a->n; j++) {
+        for (unsigned int i=j; i<a->n; i++) {
+            double val=a->elements[SYMMATRIX_INDEX(a->n, i, j)];
+            y=(i==j ? val : 2.0*val)-c;
+            t=sum+y;
+            c=(t-sum)-y;
+            sum=t;
+        }
+    }
+    return sum;
+}
+
+/** Frobenius norm */
+double symmatrix_norm(objectsymmatrix *a) {
+    double sum=0.0;
+    symmatrix_inner(a, a, &sum);
+    return sqrt(sum);
+}
+
+/** Trace */
+double symmatrix_trace(objectsymmatrix *a) {
+    double sum=0.0;
+    for (unsigned int j=0; j<a->n; j++) sum+=a->elements[SYMMATRIX_INDEX(a->n, j, j)];
+    return sum;
+}
+
+/** Prints a symmetric matrix in full */
+static void symmatrix_print(objectsymmatrix *m) {
+    for (unsigned int i=0; i<m->n; i++) {
+        printf("[ ");
+        for (unsigned int j=0; j<m->n; j++) {
+            double v=symmatrix_get(m, i, j);
+            printf("%g ", (fabs(v)<MORPHO_EPS ? 0 : v));
+        }
+        printf("]%s", (i<m->n-1 ? "\n" : ""));
+    }
+}
+
+/* **********************************************************************
+ * SymmetricMatrix class
+ * ********************************************************************* */
+
+/** Constructs a SymmetricMatrix */
+value symmatrix_constructor(vm *v, int nargs, value *args) {
+    objectsymmatrix *new=NULL;
+    value out=MORPHO_NIL;
+
+    if (nargs==1 && MORPHO_ISINTEGER(MORPHO_GETARG(args, 0)) &&
+        MORPHO_GETINTEGERVALUE(MORPHO_GETARG(args, 0))>=0) {
+        new=object_newsymmatrix(MORPHO_GETINTEGERVALUE(MORPHO_GETARG(args, 0)), true);
+    } else if (nargs==1 && MORPHO_ISMATRIX(MORPHO_GETARG(args, 0))) {
+        objectmatrix *m=MORPHO_GETMATRIX(MORPHO_GETARG(args, 0));
+        if (m->nrows!=m->ncols) MORPHO_RAISE(v, MATRIX_NOTSQ);
+        new=object_symmatrixfrommatrix(m);
+    } else if (nargs==1 && MORPHO_ISSYMMATRIX(MORPHO_GETARG(args, 0))) {
+        new=object_clonesymmatrix(MORPHO_GETSYMMATRIX(MORPHO_GETARG(args, 0)));
+    } else MORPHO_RAISE(v, SYMMATRIX_CONSTRUCTOR);
+
+    if (new) {
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+
+    return out;
+}
+
+/** Binds a newly created object, or raises an allocation error */
+static value symmatrix_bind(vm *v, object *new) {
+    value out=MORPHO_NIL;
+    if (new) {
+        out=MORPHO_OBJECT(new);
+        morpho_bindobjects(v, 1, &out);
+    } else morpho_runtimeerror(v, ERROR_ALLOCATIONFAILED);
+    return out;
+}
+
+/** Binds the result of an operation that created a full matrix, or frees it and raises the error */
+static value symmatrix_bindresult(vm *v, objectmatrix *new, objectmatrixerror err) {
+    if (new && err!=MATRIX_OK) {
+        object_free((object *) new);
+        matrix_raiseerror(v, err);
+        return MORPHO_NIL;
+    }
+    return symmatrix_bind(v, (object *) new);
+}
+
+/** Gets the matrix element with given indices */
+value SymmetricMatrix_getindex(vm *v, int nargs, value *args) {
+    objectsymmatrix *m=MORPHO_GETSYMMATRIX(MORPHO_SELF(args));
+    unsigned int indx[2]={0,0};
+
+    if (nargs>2) MORPHO_RAISE(v, MATRIX_INVLDNUMINDICES);
+    if (!array_valuelisttoindices(nargs, args+1, indx)) MORPHO_RAISE(v, MATRIX_INVLDINDICES);
+    if (indx[0]>=m->n || indx[1]>=m->n) MORPHO_RAISE(v, MATRIX_INDICESOUTSIDEBOUNDS);
+
+    return MORPHO_FLOAT(symmatrix_get(m, indx[0], indx[1]));
+}
+
+/** Sets the matrix element with given indices; this also sets the transposed element */
+value SymmetricMatrix_setindex(vm *v, int nargs, value *args) {
+    objectsymmatrix *m=MORPHO_GETSYMMATRIX(MORPHO_SELF(args));
+    unsigned int indx[2]={0,0};
+    double val=0.0;
+
+    if (!array_valuelisttoindices(nargs-1, args+1, indx)) MORPHO_RAISE(v, MATRIX_INVLDINDICES);
+    if (indx[0]>=m->n || indx[1]>=m->n) MORPHO_RAISE(v, MATRIX_INDICESOUTSIDEBOUNDS);
+    morpho_valuetofloat(args[nargs], &val);
+
+    unsigned int i=(indx[0]>=indx[1] ? indx[0] : indx[1]), j=(indx[0]>=indx[1] ? indx[1] : indx[0]);
+    m->elements[SYMMATRIX_INDEX(m->n, i, j)]=val;
+
+    return MORPHO_NIL;
+}
+
+/** Prints a symmetric matrix */
+value SymmetricMatrix_print(vm *v, int nargs, value *args) {
+    value self = MORPHO_SELF(args);
+    if (!MORPHO_ISSYMMATRIX(self)) return Object_print(v, nargs, args);
+
+    symmatrix_print(MORPHO_GETSYMMATRIX(self));
+    return MORPHO_NIL;
+}
+
+/** Adds or subtracts a SymmetricMatrix, Matrix or number; sign is applied to the argument and, if right is set, the result is negated so that arg - self is computed */
+static value symmatrix_addsub(vm *v, int nargs, value *args, double sign, bool right) {
+    objectsymmatrix *a=MORPHO_GETSYMMATRIX(MORPHO_SELF(args));
+    double val;
+
+    if (nargs!=1) MORPHO_RAISE(v, SYMMATRIX_ARITHARGS);
+    value arg=MORPHO_GETARG(args, 0);
+
+    if (MORPHO_ISSYMMATRIX(arg)) {
+        objectsymmatrix *b=MORPHO_GETSYMMATRIX(arg);
+        if (a->n!=b->n) MORPHO_RAISE(v, MATRIX_INCOMPATIBLEMATRICES);
+        objectsymmatrix *new=object_clonesymmatrix(a);
+        if (new) symmatrix_accumulate(new, sign, b);
+        if (new && right) symmatrix_scale(new, -1.0);
+        return symmatrix_bind(v, (object *) new);
+    } else if (MORPHO_ISMATRIX(arg)) {
+        objectmatrix *b=MORPHO_GETMATRIX(arg);
+        if (b->nrows!=a->n || b->ncols!=a->n) MORPHO_RAISE(v, MATRIX_INCOMPATIBLEMATRICES);
+        objectmatrix *new=object_matrixfromsymmatrix(a);
+        if (new) matrix_accumulate(new, sign, b);
+        if (new && right) matrix_scale(new, -1.0);
+        return symmatrix_bind(v, (object *) new);
+    } else if (morpho_valuetofloat(arg, &val)) {
+        objectsymmatrix *new=object_clonesymmatrix(a);
+        if (new) {
+            if (right) symmatrix_scale(new, -1.0);
+            for (unsigned int i=0; i<SYMMATRIX_SIZE(a->n); i++) new->elements[i]+=(right ? val : sign*val);
+        }
+        return symmatrix_bind(v, (object *) new);
+    } else MORPHO_RAISE(v, SYMMATRIX_ARITHARGS);
+
+    return MORPHO_NIL;
+}
+
+value SymmetricMatrix_add(vm *v, int nargs, value *args) {
+    return symmatrix_addsub(v, nargs, args, 1.0, false);
+}
+
+/** Right add; adding nil returns a copy so that matrices can be summed starting from nil */
+value SymmetricMatrix_addr(vm *v, int nargs, value *args) {
+    if (nargs==1 && MORPHO_ISNIL(MORPHO_GETARG(args, 0))) return symmatrix_bind(v, (object *) object_clonesymmatrix(MORPHO_GETSYMMATRIX(MORPHO_SELF(args))));
+    return symmatrix_addsub(v, nargs, args, 1.0, false);
+}
+
+value SymmetricMatrix_sub(vm *v, int nargs, value *args) {
+    return symmatrix_addsub(v, nargs, args, -1.0, false);
+}
+
+value SymmetricMatrix_subr(vm *v, int nargs, value *args) {
+    return symmatrix_addsub(v, nargs, args, -1.0, true);
+}
+
+/** Multiplies by a SymmetricMatrix, Matrix or number */
+value SymmetricMatrix_mul(vm *v, int nargs, value *args) {
+    objectsymmatrix *a=MORPHO_GETSYMMATRIX(MORPHO_SELF(args));
+    double scale;
+
+    if (nargs!=1) MORPHO_RAISE(v, SYMMATRIX_ARITHARGS);
+    value arg=MORPHO_GETARG(args, 0);
+
+    if (MORPHO_ISMATRIX(arg)) {
+        objectmatrix *b=MORPHO_GETMATRIX(arg);
+        if (b->nrows!=a->n) MORPHO_RAISE(v, MATRIX_INCOMPATIBLEMATRICES);
+        objectmatrix *new=object_newmatrix(a->n, b->ncols, false);
+        return symmatrix_bindresult(v, new, (new ? symmatrix_mulmatrix(a, b, new) : MATRIX_OK));
+    } else if (MORPHO_ISSYMMATRIX(arg)) {
+        objectsymmatrix *b=MORPHO_GETSYMMATRIX(arg);
+        if (b->n!=a->n) MORPHO_RAISE(v, MATRIX_INCOMPATIBLEMATRICES);
+        objectmatrix *full=object_matrixfromsymmatrix(b);
+        objectmatrix *new=(full ? object_newmatrix(a->n, a->n, false) : NULL);
+        objectmatrixerror err=(new ? symmatrix_mulmatrix(a, full, new) : MATRIX_OK);
+        if (full) object_free((object *) full);
+        return symmatrix_bindresult(v, new, err);
+    } else if (morpho_valuetofloat(arg, &scale)) {
+        objectsymmatrix *new=object_clonesymmatrix(a);
+        if (new) symmatrix_scale(new, scale);
+        return symmatrix_bind(v, (object *) new);
+    } else MORPHO_RAISE(v, SYMMATRIX_ARITHARGS);
+
+    return MORPHO_NIL;
+}
+
+/** Called when multiplying on the right, i.e. by a Matrix or number on the left */
+value SymmetricMatrix_mulr(vm *v, int nargs, value *args) {
+    objectsymmatrix *b=MORPHO_GETSYMMATRIX(MORPHO_SELF(args));
+
+    if (nargs==1 && MORPHO_ISMATRIX(MORPHO_GETARG(args, 0))) {
+        objectmatrix *a=MORPHO_GETMATRIX(MORPHO_GETARG(args, 0));
+        if (a->ncols!=b->n) MORPHO_RAISE(v, MATRIX_INCOMPATIBLEMATRICES);
+        objectmatrix *new=object_newmatrix(a->nrows, b->n, false);
+        return symmatrix_bindresult(v, new, (new ? symmatrix_matrixmul(a, b, new) : MATRIX_OK));
+    } else if (nargs==1 && MORPHO_ISNUMBER(MORPHO_GETARG(args, 0))) {
+        return SymmetricMatrix_mul(v, nargs, args);
+    } else MORPHO_RAISE(v, SYMMATRIX_ARITHARGS);
+
+    return MORPHO_NIL;
+}
+
+/** Divides by a number */
+value SymmetricMatrix_div(vm *v, int nargs, value *args) {
+    double scale;
+
+    if (nargs==1 && morpho_valuetofloat(MORPHO_GETARG(args, 0), &scale)) {
+        if (fabs(scale)<MORPHO_EPS) MORPHO_RAISE(v, VM_DVZR);
+        objectsymmatrix *new=object_clonesymmatrix(MORPHO_GETSYMMATRIX(MORPHO_SELF(args)));
+        if (new) symmatrix_scale(new, 1.0/scale);
+        return symmatrix_bind(v, (object *) new);
+    } else MORPHO_RAISE(v, SYMMATRIX_ARITHARGS);
+
+    return MORPHO_NIL;
+}
+
+/** Called for b/a with a Matrix b; solves a.x = b */
+value SymmetricMatrix_divr(vm *v, int nargs, value *args) {
+    objectsymmatrix *a=MORPHO_GETSYMMATRIX(MORPHO_SELF(args));
+
+    if (nargs==1 && MORPHO_ISMATRIX(MORPHO_GETARG(args, 0))) {
+        objectmatrix *b=MORPHO_GETMATRIX(MORPHO_GETARG(args, 0));
+        if (b->nrows!=a->n) MORPHO_RAISE(v, MATRIX_INCOMPATIBLEMATRICES);
+        objectmatrix *new=object_newmatrix(b->nrows, b->ncols, false);
+        return symmatrix_bindresult(v, new, (new ? symmatrix_solve(a, b, new) : MATRIX_OK));
+    } else MORPHO_RAISE(v, SYMMATRIX_ARITHARGS);
+
+    return MORPHO_NIL;
+}
+
+/** Accumulates a multiple of a SymmetricMatrix in place */
+value SymmetricMatrix_acc(vm *v, int nargs, value *args) {
+    objectsymmatrix *a=MORPHO_GETSYMMATRIX(MORPHO_SELF(args));
+    double lambda;
+
+    if (nargs==2 && morpho_valuetofloat(MORPHO_GETARG(args, 0), &lambda) &&
+        MORPHO_ISSYMMATRIX(MORPHO_GETARG(args, 1))) {
+        objectmatrixerror err=symmatrix_accumulate(a, lambda, MORPHO_GETSYMMATRIX(MORPHO_GETARG(args, 1)));
+        if (err!=MATRIX_OK) matrix_raiseerror(v, err);
+    } else MORPHO_RAISE(v, SYMMATRIX_ARITHARGS);
+
+    return MORPHO_NIL;
+}
+
+/** Frobenius inner product with a SymmetricMatrix */
+value SymmetricMatrix_inner(vm *v, int nargs, value *args) {
+    objectsymmatrix *a=MORPHO_GETSYMMATRIX(MORPHO_SELF(args));
+    double prod=0.0;
+
+    if (nargs==1 && MORPHO_ISSYMMATRIX(MORPHO_GETARG(args, 0))) {
+        objectmatrixerror err=symmatrix_inner(a, MORPHO_GETSYMMATRIX(MORPHO_GETARG(args, 0)), &prod);
+        if (err!=MATRIX_OK) {
+            matrix_raiseerror(v, err);
+            return MORPHO_NIL;
+        }
+    } else MORPHO_RAISE(v, SYMMATRIX_ARITHARGS);
+
+    return MORPHO_FLOAT(prod);
+}
+
+/** Sum of the elements */
+value SymmetricMatrix_sum(vm *v, int nargs, value *args) {
+    return MORPHO_FLOAT(symmatrix_sum(MORPHO_GETSYMMATRIX(MORPHO_SELF(args))));
+}
+
+/** Frobenius norm */
+value SymmetricMatrix_norm(vm *v, int nargs, value *args) {
+    return MORPHO_FLOAT(symmatrix_norm(MORPHO_GETSYMMATRIX(MORPHO_SELF(args))));
+}
+
+/** Trace */
+value SymmetricMatrix_trace(vm *v, int nargs, value *args) {
+    return MORPHO_FLOAT(symmatrix_trace(MORPHO_GETSYMMATRIX(MORPHO_SELF(args))));
+}
+
+/** A symmetric matrix is its own transpose */
+value SymmetricMatrix_clone(vm *v, int nargs, value *args) {
+    return symmatrix_bind(v, (object *) object_clonesymmatrix(MORPHO_GETSYMMATRIX(MORPHO_SELF(args))));
+}
+
+/** Finds the eigenvalues, returned as a List in ascending order, and optionally the eigenvectors */
+static value symmatrix_eigen(vm *v, value self, bool vectors) {
+    objectsymmatrix *a=MORPHO_GETSYMMATRIX(self);
+    unsigned int n=a->n;
+
+    double *w=MORPHO_MALLOC(sizeof(double)*(n ? n : 1));
+    objectmatrix *vec=(vectors ? object_newmatrix(n, n, false) : NULL);
+    objectlist *vals=object_newlist(0, NULL);
+    objectlist *result=(vectors ? object_newlist(0, NULL) : NULL);
+    objectmatrixerror err=MATRIX_ALLOC;
+    value out=MORPHO_NIL;
+
+    if (w && vals && (!vectors || (vec && result))) err=symmatrix_eigensystem(a, w, vec);
+
+    if (err==MATRIX_OK) {
+        for (unsigned int i=0; i<n; i++) list_append(vals, MORPHO_FLOAT(w[i]));
+
+        out=MORPHO_OBJECT(vals);
+        if (vectors) {
+            list_append(result, MORPHO_OBJECT(vals));
+            list_append(result, MORPHO_OBJECT(vec));
+            out=MORPHO_OBJECT(result);
+
+            // Bind the containers together by temporarily appending these to result
+            list_append(result, out);
+            morpho_bindobjects(v, result->val.count, result->val.data);
+            result->val.count=2;
+        } else morpho_bindobjects(v, 1, &out);
+    } else {
+        if (vals) object_free((object *) vals);
+        if (vec) object_free((object *) vec);
+        if (result) object_free((object *) result);
+        matrix_raiseerror(v, err);
+    }
+
+    if (w) MORPHO_FREE(w);
+    return out;
+}
+
+value SymmetricMatrix_eigenvalues(vm *v, int nargs, value *args) {
+    return symmatrix_eigen(v, MORPHO_SELF(args), false);
+}
+
+value SymmetricMatrix_eigensystem(vm *v, int nargs, value *args) {
+    return symmatrix_eigen(v, MORPHO_SELF(args), true);
+}
+
+/** Converts to a full Matrix */
+value SymmetricMatrix_tomatrix(vm *v, int nargs, value *args) {
+    return symmatrix_bind(v, (object *) object_matrixfromsymmatrix(MORPHO_GETSYMMATRIX(MORPHO_SELF(args))));
+}
+
+/** Enumerate protocol; elements of the full matrix are enumerated in column-major order as for Matrix */
+value SymmetricMatrix_enumerate(vm *v, int nargs, value *args) {
+    objectsymmatrix *a=MORPHO_GETSYMMATRIX(MORPHO_SELF(args));
+    value out=MORPHO_NIL;
+
+    if (nargs==1 && MORPHO_ISINTEGER(MORPHO_GETARG(args, 0))) {
+        int i=MORPHO_GETINTEGERVALUE(MORPHO_GETARG(args, 0));
+
+        if (i<0) out=MORPHO_INTEGER(a->n*a->n);
+        else if (i<a->n*a->n) out=MORPHO_FLOAT(symmatrix_get(a, i%a->n, i/a->n));
+    }
+
+    return out;
+}
+
+/** Number of matrix elements */
+value SymmetricMatrix_count(vm *v, int nargs, value *args) {
+    objectsymmatrix *a=MORPHO_GETSYMMATRIX(MORPHO_SELF(args));
+    return MORPHO_INTEGER(a->n*a->n);
+}
+
+/** Matrix dimensions */
+value SymmetricMatrix_dimensions(vm *v, int nargs, value *args) {
+    objectsymmatrix *a=MORPHO_GETSYMMATRIX(MORPHO_SELF(args));
+    value dim[2] = { MORPHO_INTEGER(a->n), MORPHO_INTEGER(a->n) };
+    return symmatrix_bind(v, (object *) object_newlist(2, dim));
+}
+
+MORPHO_BEGINCLASS(SymmetricMatrix)
+MORPHO_METHOD(MORPHO_GETINDEX_METHOD, SymmetricMatrix_getindex, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_SETINDEX_METHOD, SymmetricMatrix_setindex, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_PRINT_METHOD, SymmetricMatrix_print, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_ADD_METHOD, SymmetricMatrix_add, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_ADDR_METHOD, SymmetricMatrix_addr, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_SUB_METHOD, SymmetricMatrix_sub, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_SUBR_METHOD, SymmetricMatrix_subr, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_MUL_METHOD, SymmetricMatrix_mul, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_MULR_METHOD, SymmetricMatrix_mulr, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_DIV_METHOD, SymmetricMatrix_div, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_DIVR_METHOD, SymmetricMatrix_divr, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_ACC_METHOD, SymmetricMatrix_acc, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MATRIX_INNER_METHOD, SymmetricMatrix_inner, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_SUM_METHOD, SymmetricMatrix_sum, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MATRIX_NORM_METHOD, SymmetricMatrix_norm, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MATRIX_TRACE_METHOD, SymmetricMatrix_trace, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MATRIX_TRANSPOSE_METHOD, SymmetricMatrix_clone, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MATRIX_EIGENVALUES_METHOD, SymmetricMatrix_eigenvalues, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MATRIX_EIGENSYSTEM_METHOD, SymmetricMatrix_eigensystem, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(SYMMATRIX_TOMATRIX_METHOD, SymmetricMatrix_tomatrix, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_ENUMERATE_METHOD, SymmetricMatrix_enumerate, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_COUNT_METHOD, SymmetricMatrix_count, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MATRIX_DIMENSIONS_METHOD, SymmetricMatrix_dimensions, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MORPHO_CLONE_METHOD, SymmetricMatrix_clone, BUILTIN_FLAGSEMPTY)
+MORPHO_ENDCLASS
+
+/* **********************************************************************
+ * Initialization
+ * ********************************************************************* */
+
+void symmatrix_initialize(void) {
+    objectsymmatrixtype=object_addtype(&objectsymmatrixdefn);
+
+    builtin_addfunction(SYMMATRIX_CLASSNAME, symmatrix_constructor, BUILTIN_FLAGSCONSTRUCTOR);
+
+    objectstring objname = MORPHO_STATICSTRING(OBJECT_CLASSNAME);
+    value objclass = builtin_findclass(MORPHO_OBJECT(&objname));
+
+    value symmatrixclass=builtin_addclass(SYMMATRIX_CLASSNAME, MORPHO_GETCLASSDEFINITION(SymmetricMatrix), objclass);
+    object_setveneerclass(OBJECT_SYMMATRIX, symmatrixclass);
+
+    morpho_defineerror(SYMMATRIX_CONSTRUCTOR, ERROR_HALT, SYMMATRIX_CONSTRUCTOR_MSG);
+    morpho_defineerror(SYMMATRIX_ARITHARGS, ERROR_HALT, SYMMATRIX_ARITHARGS_MSG);
+}
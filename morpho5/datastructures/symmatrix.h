@@ -0,0 +1,83 @@
+/** @file symmatrix.h
+ *  @author T J Atherton
+ *
+ *  @brief Veneer class over the objectsymmatrix type, a symmetric matrix stored in packed form
+ */
+
+#ifndef symmatrix_h
+#define symmatrix_h
+
+#include <stdio.h>
+#include "veneer.h"
+#include "matrix.h"
+
+/* -------------------------------------------------------
+ * Symmetric matrix objects
+ * ------------------------------------------------------- */
+
+extern objecttype objectsymmatrixtype;
+#define OBJECT_SYMMATRIX objectsymmatrixtype
+
+/** Symmetric matrices store only their lower triangle, column by column, in the packed layout used by the
+    dsp-prefixed BLAS and LAPACK routines; an n x n matrix therefore holds n*(n+1)/2 elements. */
+typedef struct {
+    object obj;
+    unsigned int n;
+    double *elements;
+    double matrixdata[];
+} objectsymmatrix;
+
+/** Tests whether an object is a symmetric matrix */
+#define MORPHO_ISSYMMATRIX(val) object_istype(val, OBJECT_SYMMATRIX)
+
+/** Gets the object as a symmetric matrix */
+#define MORPHO_GETSYMMATRIX(val)   ((objectsymmatrix *) MORPHO_GETOBJECT(val))
+
+/** Number of elements stored for a symmetric matrix of dimension n */
+#define SYMMATRIX_SIZE(n) ((n)*((n)+1)/2)
+
+/** Index of element (i, j), with i>=j, in the packed storage of a symmetric matrix of dimension n */
+#define SYMMATRIX_INDEX(n, i, j) ((i) + (j)*(2*(n)-(j)-1)/2)
+
+/** Creates a symmetric matrix */
+objectsymmatrix *object_newsymmatrix(unsigned int n, bool zero);
+
+/** Creates a symmetric matrix from the lower triangle of a square matrix */
+objectsymmatrix *object_symmatrixfrommatrix(objectmatrix *m);
+
+/** Creates a full matrix from a symmetric matrix */
+objectmatrix *object_matrixfromsymmatrix(objectsymmatrix *s);
+
+/* -------------------------------------------------------
+ * SymmetricMatrix class
+ * ------------------------------------------------------- */
+
+#define SYMMATRIX_CLASSNAME "SymmetricMatrix"
+
+#define SYMMATRIX_TOMATRIX_METHOD "tomatrix"
+
+#define SYMMATRIX_CONSTRUCTOR             "SymMtrxCns"
+#define SYMMATRIX_CONSTRUCTOR_MSG         "SymmetricMatrix() constructor should be called with a dimension, a square Matrix whose lower triangle is copied, or a SymmetricMatrix."
+
+#define SYMMATRIX_ARITHARGS               "SymMtrxArgs"
+#define SYMMATRIX_ARITHARGS_MSG           "SymmetricMatrix arithmetic methods expect a SymmetricMatrix, Matrix or number as their argument."
+
+/* -------------------------------------------------------
+ * SymmetricMatrix interface
+ * ------------------------------------------------------- */
+
+double symmatrix_get(objectsymmatrix *a, unsigned int i, unsigned int j);
+objectmatrixerror symmatrix_accumulate(objectsymmatrix *a, double lambda, objectsymmatrix *b);
+objectmatrixerror symmatrix_scale(objectsymmatrix *a, double scale);
+objectmatrixerror symmatrix_mulmatrix(objectsymmatrix *a, objectmatrix *b, objectmatrix *out);
+objectmatrixerror symmatrix_matrixmul(objectmatrix *a, objectsymmatrix *b, objectmatrix *out);
+objectmatrixerror symmatrix_inner(objectsymmatrix *a, objectsymmatrix *b, double *out);
+objectmatrixerror symmatrix_solve(objectsymmatrix *a, objectmatrix *b, objectmatrix *out);
+objectmatrixerror symmatrix_eigensystem(objectsymmatrix *a, double *w, objectmatrix *vec);
+double symmatrix_sum(objectsymmatrix *a);
+double symmatrix_norm(objectsymmatrix *a);
+double symmatrix_trace(objectsymmatrix *a);
+
+void symmatrix_initialize(void);
+
+#endif /* symmatrix_h */
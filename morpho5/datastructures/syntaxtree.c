@@ -14,6 +14,7 @@ DEFINE_VARRAY(syntaxtreeindx, syntaxtreeindx);
 /** @brief Initialize a syntax tree */
 void syntaxtree_init(syntaxtree *tree) {
     varray_syntaxtreenodeinit(&tree->tree);
+    dictionary_init(&tree->symbols);
     tree->entry=0;
 }
 
@@ -22,14 +23,22 @@ void syntaxtree_clear(syntaxtree *tree) {
 #ifdef MORPHO_DEBUG_LOGGARBAGECOLLECTOR
     printf("--Freeing syntax tree %p.\n",(void *) tree);
 #endif
-    /** Free attached objects */
+    /** Free attached objects; symbols are owned by the symbol table */
     for (unsigned int i=0; i<tree->tree.count; i++) {
         syntaxtreenode *node = &tree->tree.data[i];
         if (MORPHO_ISOBJECT(node->content)) {
+            value sym;
+            if (MORPHO_ISSTRING(node->content) &&
+                dictionary_get(&tree->symbols, node->content, &sym) &&
+                MORPHO_ISSAME(sym, node->content)) continue;
+            
             object_free(MORPHO_GETOBJECT(node->content));
         }
     }
     varray_syntaxtreenodeclear(&tree->tree);
+    
+    dictionary_freecontents(&tree->symbols, true, false);
+    dictionary_clear(&tree->symbols);
 #ifdef MORPHO_DEBUG_LOGGARBAGECOLLECTOR
     printf("------\n");
 #endif
@@ -164,6 +173,28 @@ void syntaxtree_print(syntaxtree *tree) {
 }
 #endif
 
+/** @brief Interns a symbol, so that repeated occurrences share a single string owned by the tree
+ *  @param tree    the syntax tree
+ *  @param symbol  the symbol, which need not be null terminated
+ *  @param length  length of the symbol
+ *  @returns the interned string, or MORPHO_NIL on failure */
+value syntaxtree_internsymbol(syntaxtree *tree, const char *symbol, size_t length) {
+    objectstring key = MORPHO_STATICSTRINGWITHLENGTH((char *) symbol, length);
+    value out=MORPHO_NIL;
+    
+    if (!dictionary_get(&tree->symbols, MORPHO_OBJECT(&key), &out)) {
+        out=object_stringfromcstring(symbol, length);
+        if (MORPHO_ISNIL(out)) return out;
+        
+        if (!dictionary_insert(&tree->symbols, out, out)) {
+            object_free(MORPHO_GETOBJECT(out));
+            out=MORPHO_NIL;
+        }
+    }
+    
+    return out;
+}
+
 /** @brief Adds a node to the syntax tree
  *  @param tree    tree to add to.
  *  @param type    type of node to add
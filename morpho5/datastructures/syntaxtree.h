@@ -10,6 +10,7 @@
 #include <stddef.h>
 #include "value.h"
 #include "varray.h"
+#include "dictionary.h"
 
 typedef ptrdiff_t syntaxtreeindx;
 
@@ -120,12 +121,15 @@ DECLARE_VARRAY(syntaxtreeindx, syntaxtreeindx);
 typedef struct {
     varray_syntaxtreenode tree;
     syntaxtreeindx entry;
+    dictionary symbols; /** Symbols used in the tree, shared between nodes */
 } syntaxtree;
 
 void syntaxtree_init(syntaxtree *tree);
 void syntaxtree_clear(syntaxtree *tree);
 void syntaxtree_print(syntaxtree *tree);
 
+value syntaxtree_internsymbol(syntaxtree *tree, const char *symbol, size_t length);
+
 syntaxtreeindx syntaxtree_addnode(syntaxtree *tree, syntaxtreenodetype type, value content, int line, int posn, syntaxtreeindx left, syntaxtreeindx right);
 
 syntaxtreenode *syntaxtree_nodefromindx(syntaxtree *tree, syntaxtreeindx indx);
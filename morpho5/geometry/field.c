@@ -27,6 +27,7 @@ void objectfield_printfn(object *obj) {
 void objectfield_markfn(object *obj, void *v) {
     objectfield *c = (objectfield *) obj;
     morpho_markvalue(v, c->prototype);
+    if (c->mesh) morpho_markobject(v, (object *) c->mesh);
 }
 
 void objectfield_freefn(object *obj) {
@@ -137,6 +138,7 @@ objectfield *object_newfield(objectmesh *mesh, value prototype, unsigned int *do
         new->data.ncols=1;
         new->data.nrows=size;
         new->data.elements=new->data.matrixdata;
+        new->data.parent=NULL;
         
         if (MORPHO_ISMATRIX(prototype)) {
             objectmatrix *mat = MORPHO_GETMATRIX(prototype);
@@ -224,6 +226,7 @@ bool field_addpool(objectfield *f) {
             for (unsigned int i=0; i<nel; i++) {
                 object_init(&m[i].obj, OBJECT_MATRIX);
                 m[i].elements=f->data.elements+i*f->psize;
+                m[i].parent=NULL;
                 m[i].ncols=prototype->ncols;
                 m[i].nrows=prototype->nrows;
             }
@@ -678,6 +681,30 @@ value Field_acc(vm *v, int nargs, value *args) {
     return MORPHO_NIL;
 }
 
+/** Replaces a field in place by a linear combination of itself and other fields */
+value Field_combine(vm *v, int nargs, value *args) {
+    objectfield *a=MORPHO_GETFIELD(MORPHO_SELF(args));
+    double alpha;
+    
+    if (nargs<1 || nargs%2==0 || !morpho_valuetofloat(MORPHO_GETARG(args, 0), &alpha)) MORPHO_RAISE(v, MATRIX_COMBINEARGS);
+    
+    int n=(nargs-1)/2;
+    double lambda[n+1];
+    objectmatrix *b[n+1];
+    
+    for (int k=0; k<n; k++) {
+        if (!morpho_valuetofloat(MORPHO_GETARG(args, 2*k+1), &lambda[k]) ||
+            !MORPHO_ISFIELD(MORPHO_GETARG(args, 2*k+2))) MORPHO_RAISE(v, MATRIX_COMBINEARGS);
+        objectfield *f=MORPHO_GETFIELD(MORPHO_GETARG(args, 2*k+2));
+        if (!field_compareshape(a, f)) MORPHO_RAISE(v, FIELD_INCOMPATIBLEMATRICES);
+        b[k]=&f->data;
+    }
+    
+    matrix_combine(&a->data, alpha, n, lambda, b);
+    
+    return MORPHO_NIL;
+}
+
 /** Field multiply by a scalar */
 value Field_mul(vm *v, int nargs, value *args) {
     objectfield *a=MORPHO_GETFIELD(MORPHO_SELF(args));
@@ -827,6 +854,7 @@ MORPHO_METHOD(MORPHO_ADDR_METHOD, Field_addr, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(MORPHO_SUB_METHOD, Field_sub, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(MORPHO_SUBR_METHOD, Field_subr, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(MORPHO_ACC_METHOD, Field_acc, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(MATRIX_COMBINE_METHOD, Field_combine, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(MORPHO_MUL_METHOD, Field_mul, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(MORPHO_MULR_METHOD, Field_mul, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(MORPHO_DIV_METHOD, Field_div, BUILTIN_FLAGSEMPTY),
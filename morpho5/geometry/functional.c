@@ -1377,11 +1377,17 @@ void functional_vecscale(unsigned int n, double lambda, double *a, double *out)
 
 /** Calculate the norm of a vector */
 double functional_vecnorm(unsigned int n, double *a) {
+    if (n<=MATRIX_TINYSIZE) return sqrt(functional_vecdot(n, a, a));
     return cblas_dnrm2(n, a, 1);
 }
 
 /** Dot product of two vectors */
 double functional_vecdot(unsigned int n, double *a, double *b) {
+    if (n<=MATRIX_TINYSIZE) {
+        double sum=0.0;
+        for (unsigned int i=0; i<n; i++) sum+=a[i]*b[i];
+        return sum;
+    }
     return cblas_ddot(n, a, 1, b, 1);
 }
 
@@ -12,6 +12,7 @@
 #include "mesh.h"
 #include "field.h"
 #include "selection.h"
+#include "common.h"
 
 /* -------------------------------------------------------
  * Functionals
@@ -285,6 +286,9 @@ value name##_total(vm *v, int nargs, value *args) { \
  * Initialization
  * ------------------------------------------------------- */
 
+/** Worker threads shared by functionals and other parallel maps */
+extern threadpool functional_pool;
+
 void functional_initialize(void);
 void functional_finalize(void);
 
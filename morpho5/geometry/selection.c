@@ -12,6 +12,7 @@
 #include "sparse.h"
 #include "mesh.h"
 #include "selection.h"
+#include "iterator.h"
 
 /* **********************************************************************
  * Selection object definitions
@@ -452,6 +453,45 @@ value Selection_idlistforgrade(vm *v, int nargs, value *args) {
     return out;
 }
 
+/** Generates the i'th selected id of the grade given by the iterator's parameter */
+static bool selection_iditeratorfn(vm *v, objectiterator *it, unsigned int i, value *out) {
+    objectselection *sel = MORPHO_GETSELECTION(it->source);
+    grade g = it->param;
+    unsigned int slot;
+
+    switch (sel->mode) {
+        case SELECT_NONE: return false;
+        case SELECT_ALL:
+            *out=MORPHO_INTEGER(i);
+            return true;
+        case SELECT_SOME:
+            if (g>=sel->ngrades || !dictionary_nthentry(&sel->selected[g], i, &it->cursor, &slot)) return false;
+            *out=sel->selected[g].contents[slot].key;
+            return true;
+    }
+    return false;
+}
+
+/** Get an iterator over the ids selected in a given grade, which avoids building a list of them */
+value Selection_iteridsforgrade(vm *v, int nargs, value *args) {
+    objectselection *sel = MORPHO_GETSELECTION(MORPHO_SELF(args));
+    
+    if (nargs==1 && MORPHO_ISINTEGER(MORPHO_GETARG(args, 0)) && MORPHO_GETINTEGERVALUE(MORPHO_GETARG(args, 0))>=0) {
+        grade g = MORPHO_GETINTEGERVALUE(MORPHO_GETARG(args, 0));
+        unsigned int count=0;
+
+        switch (sel->mode) {
+            case SELECT_NONE: break;
+            case SELECT_ALL: count=mesh_nelementsforgrade(sel->mesh, g); break;
+            case SELECT_SOME: if (g<sel->ngrades) count=sel->selected[g].count; break;
+        }
+
+        return iterator_new(v, MORPHO_SELF(args), count, selection_iditeratorfn, g, 0);
+    } else morpho_runtimeerror(v, SELECTION_GRADEARG);
+    
+    return MORPHO_NIL;
+}
+
 /** Adds a grade to a selection */
 value Selection_addgrade(vm *v, int nargs, value *args) {
     objectselection *sel = MORPHO_GETSELECTION(MORPHO_SELF(args));
@@ -543,6 +583,7 @@ MORPHO_METHOD(SELECTION_ISSELECTEDMETHOD, Selection_isselected, BUILTIN_FLAGSEMP
 MORPHO_METHOD(MORPHO_GETINDEX_METHOD, Selection_isselected, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(MORPHO_SETINDEX_METHOD, Selection_setindex, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(SELECTION_IDLISTFORGRADEMETHOD, Selection_idlistforgrade, BUILTIN_FLAGSEMPTY),
+MORPHO_METHOD(SELECTION_ITERIDSFORGRADEMETHOD, Selection_iteridsforgrade, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(MORPHO_COUNT_METHOD, Selection_count, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(MORPHO_PRINT_METHOD, Selection_print, BUILTIN_FLAGSEMPTY),
 MORPHO_METHOD(MORPHO_UNION_METHOD, Selection_union, BUILTIN_FLAGSEMPTY),
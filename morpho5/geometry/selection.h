@@ -44,6 +44,7 @@ objectselection *object_newselection(objectmesh *mesh);
 #define SELECTION_CLASSNAME "Selection"
 #define SELECTION_ISSELECTEDMETHOD "isselected"
 #define SELECTION_IDLISTFORGRADEMETHOD "idlistforgrade"
+#define SELECTION_ITERIDSFORGRADEMETHOD "iteridsforgrade"
 #define SELECTION_ADDGRADEMETHOD "addgrade"
 #define SELECTION_REMOVEGRADEMETHOD "removegrade"
 
@@ -8,6 +8,7 @@
 #include "cli.h"
 #include "parse.h"
 #include "file.h"
+#include "aot.h"
 
 #define CLI_BUFFERSIZE 1024
 
@@ -288,6 +289,36 @@ void cli(clioptions opt) {
  * Run a file
  * ********************************************************************** */
 
+/** Translates functions in a compiled file to C, writing an extension alongside the file */
+void cli_translate(program *p, const char *in) {
+    const char *base = strrchr(in, '/');
+    base = (base ? base+1 : in);
+    const char *ext = strrchr(base, '.');
+    size_t stemlength = (ext ? (size_t) (ext-base) : strlen(base));
+    size_t dirlength = (size_t) (base-in);
+    
+    char name[stemlength+1];
+    strncpy(name, base, stemlength);
+    name[stemlength]='\0';
+    
+    char outfile[dirlength+stemlength+strlen(AOT_SOURCEEXTENSION)+2];
+    strncpy(outfile, in, dirlength+stemlength);
+    sprintf(outfile+dirlength+stemlength, ".%s", AOT_SOURCEEXTENSION);
+    
+    FILE *f = fopen(outfile, "w");
+    int n=0;
+    if (f) {
+        bool success=aot_translate(p, name, f, &n);
+        fclose(f);
+        if (success) {
+            printf("Translated %i function%s to '%s'.\n", n, (n==1 ? "" : "s"), outfile);
+            return;
+        }
+        remove(outfile);
+    }
+    printf("Could not translate '%s' to C.\n", in);
+}
+
 /** Loads and runs a file. */
 void cli_run(const char *in, clioptions opt) {
     program *p = morpho_newprogram();
@@ -316,6 +347,7 @@ void cli_run(const char *in, clioptions opt) {
                     morpho_disassemble(p, NULL);
                 }
             }
+            if (opt & CLI_TRANSLATE) cli_translate(p, in);
             if (opt & CLI_RUN) {
                 if (opt & CLI_DEBUG) {
                     success=morpho_debug(v, p);
@@ -43,6 +43,7 @@
 #define CLI_DEBUG               (1<<3)
 #define CLI_OPTIMIZE            (1<<4)
 #define CLI_PROFILE             (1<<5)
+#define CLI_TRANSLATE           (1<<6)
 
 typedef unsigned int clioptions;
 
@@ -51,6 +52,7 @@ void cli(clioptions opt);
 
 char *cli_loadsource(const char *in);
 void cli_disassemblewithsrc(program *p, char *src);
+void cli_translate(program *p, const char *in);
 void cli_list(const char *in, int start, int end);
 
 #endif /* cli_h */
@@ -39,6 +39,10 @@ int main(int argc, const char * argv[]) {
                 case 'O': /* Optimize */
                     opt|=CLI_OPTIMIZE;
                     break;
+                case 'c': /* Translate to C only */
+                    opt|=CLI_TRANSLATE;
+                    opt&=~CLI_RUN;
+                    break;
                 case 'p':
 #ifdef MORPHO_PROFILER
                     if (strncmp(option+1, "profile", strlen("profile"))==0) {
@@ -107,6 +107,10 @@ void morpho_freevm(vm *v);
 /* Bind new objects to the virtual machine */
 void morpho_bindobjects(vm *v, int nobj, value *obj);
 
+/* Share a single copy of equal strings */
+value morpho_internstring(vm *v, value str);
+value morpho_internnewstring(vm *v, value str);
+
 /* Interact with the garbage collector in an object definition */
 void morpho_markobject(void *v, object *obj);
 void morpho_markvalue(void *v, value val);
@@ -70,6 +70,7 @@ int morpho_comparevalue (value a, value b) {
                     if (MORPHO_GETOBJECTTYPE(a)!=MORPHO_GETOBJECTTYPE(b)) {
                         return 1; /* Objects of different type are always different */
                     } else if (MORPHO_ISSTRING(a)) {
+                        if (MORPHO_GETOBJECT(a)==MORPHO_GETOBJECT(b)) return EQUAL; /* Includes interned strings */
                         objectstring *astring = MORPHO_GETSTRING(a);
                         objectstring *bstring = MORPHO_GETSTRING(b);
                         size_t len = (astring->length > bstring->length ? astring->length : bstring->length);
@@ -126,6 +126,10 @@ assemblyrule assemblyrules[] ={
     { OP_MUL, "mul", "rA, rB, rC" },
     { OP_DIV, "div", "rA, rB, rC" },
     { OP_POW, "pow", "rA, rB, rC" },
+    { OP_ADDF, "addf", "rA, rB, rC" },
+    { OP_SUBF, "subf", "rA, rB, rC" },
+    { OP_MULF, "mulf", "rA, rB, rC" },
+    { OP_DIVF, "divf", "rA, rB, rC" },
     { OP_NOT, "not", "rA, rB" },
     
     { OP_EQ, "eq ", "rA, rB, rC" },
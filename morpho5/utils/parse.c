@@ -74,6 +74,12 @@ static char lex_advance(lexer *l) {
     return c;
 }
 
+/** @brief Advances the lexer to a later position on the same line */
+static void lex_advanceto(lexer *l, const char *c) {
+    l->posn+=(int) (c - l->current);
+    l->current=c;
+}
+
 /** @brief Returns the previous character */
 static char lex_previous(lexer *l) {
     if (l->current==l->start) return '\0';
@@ -156,7 +162,8 @@ static bool lex_skipmultilinecomment(lexer *l, token *tok, error *err) {
 static bool lex_skipcomment(lexer *l, token *tok, error *err) {
     char c = lex_peekahead(l, 1);
     if (c == '/') {
-        while (lex_peek(l) != '\n' && !lex_isatend(l)) lex_advance(l);
+        const char *eol = strchr(l->current, '\n');
+        lex_advanceto(l, (eol ? eol : l->current + strlen(l->current)));
         return true;
     } else if (c == '*') {
         return lex_skipmultilinecomment(l, tok, err);
@@ -174,8 +181,11 @@ static bool lex_skipwhitespace(lexer *l, token *tok, error *err) {
         switch (lex_peek(l)) {
             case ' ':
             case '\t':
-            case '\r':
-                lex_advance(l);
+            case '\r': {
+                const char *c = l->current+1;
+                while (*c==' ' || *c=='\t' || *c=='\r') c++;
+                lex_advanceto(l, c);
+            }
                 break;
 /*
             case '\n':
@@ -242,6 +252,13 @@ static bool lex_string(lexer *l, token *tok, error *err) {
     return true;
 }
 
+/** @brief Skips over a run of digits */
+static void lex_skipdigits(lexer *l) {
+    const char *c = l->current;
+    while (lex_isdigit(*c)) c++;
+    lex_advanceto(l, c);
+}
+
 /** @brief Lex numbers
  *  @param[in]  l    the lexer
  *  @param[out] tok  token record to fill out
@@ -249,7 +266,7 @@ static bool lex_string(lexer *l, token *tok, error *err) {
  *  @returns true on success, false if an error occurs */
 static bool lex_number(lexer *l, token *tok, error *err) {
     tokentype type=TOKEN_INTEGER;
-    while (lex_isdigit(lex_peek(l))) lex_advance(l);
+    lex_skipdigits(l);
     
     /* Fractional part */
     char next = '\0';
@@ -261,7 +278,7 @@ static bool lex_number(lexer *l, token *tok, error *err) {
                                ) ) {
         type=TOKEN_NUMBER;
         lex_advance(l); /* Consume the '.' */
-        while (lex_isdigit(lex_peek(l))) lex_advance(l);
+        lex_skipdigits(l);
     }
     
     /* Exponent */
@@ -273,7 +290,7 @@ static bool lex_number(lexer *l, token *tok, error *err) {
         if (lex_peek(l) == '+' || lex_peek(l) == '-') lex_advance(l);
         
         /* Exponent digits */
-        while (lex_isdigit(lex_peek(l))) lex_advance(l);
+        lex_skipdigits(l);
     }
     
     /* Imaginary Numbers */
@@ -377,7 +394,9 @@ tokentype lex_symboltype(lexer *l) {
  *  @param[out] err  error struct to fill out on errors
  *  @returns true on success, false if an error occurs */
 static bool lex_symbol(lexer *l, token *tok, error *err) {
-    while (lex_isalpha(lex_peek(l)) || lex_isdigit(lex_peek(l))) lex_advance(l);
+    const char *c = l->current;
+    while (lex_isalpha(*c) || lex_isdigit(*c)) c++;
+    lex_advanceto(l, c);
     
     /* It's a symbol for now... */
     lex_recordtoken(l, lex_symboltype(l), tok);
@@ -717,6 +736,70 @@ static syntaxtreeindx parse_declarationmulti(parser *p, int n, tokentype *end) {
     return current;
 }
 
+/** Powers of ten that are exactly representable as doubles */
+static const double parse_exactpowersoften[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+#define PARSE_MAXEXACTPOWEROFTEN 22
+#define PARSE_MAXEXACTDIGITS 15
+
+/** @brief Converts a numeric token to a double.
+ *  @details Numbers with no more than 15 significant digits and a small decimal exponent are
+ *           exactly representable, and so are correctly rounded by a single multiplication or
+ *           division by an exact power of ten. Anything else is passed to strtod.
+ *  @param[in] start  - start of the token
+ *  @param[in] length - length of the numeric part of the token
+ *  @returns the value */
+double parse_tokentofloat(const char *start, unsigned int length) {
+    const char *c = start, *end = start + length;
+    uint64_t mantissa = 0;
+    int ndigits = 0, exponent = 0;
+    
+    /* Integer part */
+    for (; c<end && lex_isdigit(*c); c++) {
+        if (mantissa==0 && *c=='0') continue; // Leading zeros aren't significant
+        if (++ndigits>PARSE_MAXEXACTDIGITS) goto parse_tokentofloat_slow;
+        mantissa = 10*mantissa + (uint64_t) (*c - '0');
+    }
+    
+    /* Fractional part */
+    if (c<end && *c=='.') {
+        for (c++; c<end && lex_isdigit(*c); c++) {
+            exponent--;
+            if (mantissa==0 && *c=='0') continue;
+            if (++ndigits>PARSE_MAXEXACTDIGITS) goto parse_tokentofloat_slow;
+            mantissa = 10*mantissa + (uint64_t) (*c - '0');
+        }
+    }
+    
+    /* Exponent */
+    if (c<end && (*c=='e' || *c=='E')) {
+        bool negative=false;
+        int e=0;
+        c++;
+        if (c<end && (*c=='+' || *c=='-')) { negative=(*c=='-'); c++; }
+        if (c>=end || !lex_isdigit(*c)) goto parse_tokentofloat_slow;
+        for (; c<end && lex_isdigit(*c); c++) {
+            if (e>2*PARSE_MAXEXACTPOWEROFTEN+PARSE_MAXEXACTDIGITS) goto parse_tokentofloat_slow;
+            e = 10*e + (*c - '0');
+        }
+        exponent += (negative ? -e : e);
+    }
+    
+    if (c!=end) goto parse_tokentofloat_slow;
+    
+    if (mantissa==0) return 0.0;
+    if (exponent<-PARSE_MAXEXACTPOWEROFTEN || exponent>PARSE_MAXEXACTPOWEROFTEN) goto parse_tokentofloat_slow;
+    
+    if (exponent<0) return ((double) mantissa)/parse_exactpowersoften[-exponent];
+    return ((double) mantissa)*parse_exactpowersoften[exponent];
+    
+parse_tokentofloat_slow:
+    return strtod(start, NULL);
+}
+
 /** Parses an integer */
 syntaxtreeindx parse_integer(parser *p) {
     long f = strtol(p->previous.start, NULL, 10);
@@ -725,7 +808,7 @@ syntaxtreeindx parse_integer(parser *p) {
 
 /** Parses a number */
 syntaxtreeindx parse_number(parser *p) {
-    double f = strtod(p->previous.start, NULL);
+    double f = parse_tokentofloat(p->previous.start, p->previous.length);
     return parse_addnode(p, NODE_FLOAT, MORPHO_FLOAT(f), &p->previous, SYNTAXTREE_UNCONNECTED, SYNTAXTREE_UNCONNECTED);
 }
 syntaxtreeindx parse_complex(parser *p) {
@@ -734,7 +817,7 @@ syntaxtreeindx parse_complex(parser *p) {
     if (p->previous.length==2) { // just a bare im symbol
         f = 1;
     } else {
-        f = strtod(p->previous.start,NULL);
+        f = parse_tokentofloat(p->previous.start, p->previous.length-2); // Exclude the 'im' suffix
     }
     value c = MORPHO_OBJECT(object_newcomplex(0,f));
     return parse_addnode(p, NODE_IMAG, c, &p->previous, SYNTAXTREE_UNCONNECTED, SYNTAXTREE_UNCONNECTED);
@@ -841,7 +924,7 @@ static syntaxtreeindx parse_nil(parser *p) {
 
 /** Parses a symbol */
 static syntaxtreeindx parse_symbol(parser *p) {
-    value s = object_stringfromcstring(p->previous.start, p->previous.length);
+    value s = syntaxtree_internsymbol(p->tree, p->previous.start, p->previous.length);
     if (MORPHO_ISNIL(s)) parse_error(p, true, ERROR_ALLOCATIONFAILED, OBJECT_SYMBOLLABEL);
 
     return parse_addnode(p, NODE_SYMBOL, s, &p->previous, SYNTAXTREE_UNCONNECTED, SYNTAXTREE_UNCONNECTED);
@@ -849,7 +932,7 @@ static syntaxtreeindx parse_symbol(parser *p) {
 
 /** Parses a symbol into a value */
 static value parse_symbolasvalue(parser *p) {
-    value s = object_stringfromcstring(p->previous.start, p->previous.length);
+    value s = syntaxtree_internsymbol(p->tree, p->previous.start, p->previous.length);
     if (MORPHO_ISNIL(s)) parse_error(p, true, ERROR_ALLOCATIONFAILED, OBJECT_SYMBOLLABEL);
 
     return s;
@@ -1811,7 +1894,7 @@ bool parse_stringtovaluearray(char *string, unsigned int nmax, value *v, unsigne
             }
                 break;
             case TOKEN_NUMBER: {
-                double f = strtod(tok.start, NULL);
+                double f = parse_tokentofloat(tok.start, tok.length);
                 v[k]=MORPHO_FLOAT((minus ? -f : f)); k++; minus=false;
             }
                 break;
@@ -300,6 +300,8 @@ typedef struct {
 void parse_init(parser *p, lexer *lex, error *err, syntaxtree *tree);
 bool parse(parser *p);
 
+double parse_tokentofloat(const char *start, unsigned int length);
+
 bool parse_stringtovaluearray(char *string, unsigned int nmax, value *v, unsigned int *n, error *err);
 
 #endif /* parse_h */
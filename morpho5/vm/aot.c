@@ -0,0 +1,446 @@
+/** @file aot.c
+ *  @author T J Atherton
+ *
+ *  @brief Ahead of time translation of compiled code to C
+ *  @details Functions defined at the top level of a program that only work with numbers are translated to
+ *           C functions, which are registered as builtin functions by an extension. Once compiled to a
+ *           shared library, the extension can be imported in place of the original module.
+*/
+
+#include <ctype.h>
+
+#include "compile.h"
+#include "vm.h"
+#include "builtin.h"
+#include "aot.h"
+
+/* **********************************************************************
+ * Translator data structure
+ * ********************************************************************** */
+
+typedef struct {
+    program *prog;
+    FILE *out;
+    varray_value functions; /** Functions to translate */
+    varray_value konst; /** Constants that must be resolved when the extension is initialized */
+    varray_value globals; /** Function each global refers to, if it is only ever set to a function, or nil */
+    bool *reached; /** Instructions reached by the function currently considered */
+} translator;
+
+/** Initializes a translator */
+static void aot_init(translator *t, program *p, FILE *out) {
+    t->prog=p;
+    t->out=out;
+    varray_valueinit(&t->functions);
+    varray_valueinit(&t->konst);
+    varray_valueinit(&t->globals);
+    t->reached=MORPHO_MALLOC(sizeof(bool)*(p->code.count+1));
+}
+
+/** Clears a translator */
+static void aot_clear(translator *t) {
+    varray_valueclear(&t->functions);
+    varray_valueclear(&t->konst);
+    varray_valueclear(&t->globals);
+    if (t->reached) MORPHO_FREE(t->reached);
+}
+
+/** Finds the index of a function to be translated */
+static bool aot_findfunction(translator *t, value fn, unsigned int *indx) {
+    return varray_valuefindsame(&t->functions, fn, indx);
+}
+
+/* **********************************************************************
+ * Selecting functions to translate
+ * ********************************************************************** */
+
+/** Identifies instructions reached from the entry point of a function
+ * @returns false if an instruction falls outside the program */
+static bool aot_reach(translator *t, objectfunction *func) {
+    instructionindx n = t->prog->code.count;
+    for (instructionindx i=0; i<n; i++) t->reached[i]=false;
+
+    varray_value worklist;
+    varray_valueinit(&worklist);
+    varray_valuewrite(&worklist, MORPHO_INTEGER(func->entry));
+
+    bool success=true;
+    while (worklist.count>0) {
+        instructionindx i = MORPHO_GETINTEGERVALUE(worklist.data[--worklist.count]);
+
+        for (;;) {
+            if (i<0 || i>=n) { success=false; break; }
+            if (t->reached[i]) break;
+            t->reached[i]=true;
+
+            instruction instr = t->prog->code.data[i];
+            int op = DECODE_OP(instr);
+            if (op==OP_B) {
+                i+=DECODE_sBx(instr)+1;
+            } else if (op==OP_BIF || op==OP_BIFF) {
+                varray_valuewrite(&worklist, MORPHO_INTEGER(i+DECODE_sBx(instr)+1));
+                i++;
+            } else if (op==OP_RETURN || op==OP_END) {
+                break;
+            } else i++;
+        }
+    }
+
+    varray_valueclear(&worklist);
+    return success;
+}
+
+/** Finds globals that hold a function; top level functions are stored in globals by the global code */
+static void aot_findglobals(translator *t) {
+    objectfunction *global = t->prog->global;
+    int nstores[t->prog->nglobals+1];
+    
+    for (unsigned int i=0; i<t->prog->nglobals; i++) {
+        varray_valuewrite(&t->globals, MORPHO_NIL);
+        nstores[i]=0;
+    }
+    
+    for (instructionindx i=0; i<t->prog->code.count; i++) { // Count stores to each global anywhere in the program
+        instruction instr = t->prog->code.data[i];
+        if (DECODE_OP(instr)==OP_SGL && DECODE_Bx(instr)<t->prog->nglobals) nstores[DECODE_Bx(instr)]++;
+    }
+    
+    aot_reach(t, global);
+    for (instructionindx i=1; i<t->prog->code.count; i++) { // Identify stores of function constants in the global code
+        instruction instr = t->prog->code.data[i], prev = t->prog->code.data[i-1];
+        if (!t->reached[i] || !t->reached[i-1] ||
+            DECODE_OP(instr)!=OP_SGL || DECODE_OP(prev)!=OP_LCT ||
+            DECODE_A(instr)!=DECODE_A(prev)) continue;
+        
+        indx g = DECODE_Bx(instr), k = DECODE_Bx(prev);
+        if (g<t->prog->nglobals && nstores[g]==1 &&
+            k<global->konst.count && MORPHO_ISFUNCTION(global->konst.data[k])) {
+            t->globals.data[g]=global->konst.data[k];
+        }
+    }
+}
+
+/** Finds the function a global refers to, if any */
+static value aot_globalfunction(translator *t, indx g) {
+    return (g<t->globals.count ? t->globals.data[g] : MORPHO_NIL);
+}
+
+/** Checks whether a constant can be used by a translated function
+ * @param[out] reason - reason why the constant can't be used */
+static bool aot_isconstantsupported(translator *t, value val, char **reason) {
+    unsigned int k;
+    if (MORPHO_ISBUILTINFUNCTION(val)) {
+        // Only builtins that always return a number from numbers; others, like sqrt, may return an object depending on the value of the argument
+        if (MORPHO_GETBUILTINFUNCTION(val)->flags & BUILTIN_FLAGSNUMERIC) return true;
+        *reason="calls builtin functions that may not return a number"; return false;
+    }
+    if (MORPHO_ISINTEGER(val) || MORPHO_ISFLOAT(val) ||
+        MORPHO_ISBOOL(val) || MORPHO_ISNIL(val) ||
+        aot_findfunction(t, val, &k)) return true;
+    *reason="uses constants other than numbers or numerical functions";
+    return false;
+}
+
+/** Checks whether a function can be translated given the current set of candidates
+ * @param[out] reason - reason why the function can't be translated */
+static bool aot_cantranslate(translator *t, objectfunction *func, char **reason) {
+    if (func->nupvalues>0 || func->prototype.count>0) { *reason="uses closures"; return false; }
+    if (func->varg>=0 || func->opt.count>0) { *reason="has optional or variadic parameters"; return false; }
+    if (func->klass) { *reason="is a method"; return false; }
+    if (!aot_reach(t, func)) { *reason="has malformed code"; return false; }
+
+    for (instructionindx i=0; i<t->prog->code.count; i++) {
+        if (!t->reached[i]) continue;
+        instruction instr = t->prog->code.data[i];
+
+        switch (DECODE_OP(instr)) {
+            case OP_NOP: case OP_MOV:
+            case OP_ADD: case OP_SUB: case OP_MUL: case OP_DIV: case OP_POW:
+            case OP_ADDF: case OP_SUBF: case OP_MULF: case OP_DIVF:
+            case OP_EQ: case OP_NEQ: case OP_LT: case OP_LE: case OP_NOT:
+            case OP_B: case OP_BIF: case OP_BIFF:
+            case OP_CALL: case OP_RETURN:
+                break;
+            case OP_LCT:
+            {
+                indx k = DECODE_Bx(instr);
+                if (k>=func->konst.count) { *reason="has malformed code"; return false; }
+                if (!aot_isconstantsupported(t, func->konst.data[k], reason)) return false;
+            }
+                break;
+            case OP_LGL:
+            {
+                unsigned int k;
+                if (!aot_findfunction(t, aot_globalfunction(t, DECODE_Bx(instr)), &k)) {
+                    *reason="uses global variables"; return false;
+                }
+            }
+                break;
+            case OP_SGL:
+                *reason="uses global variables"; return false;
+            default:
+                *reason="uses objects"; return false;
+        }
+    }
+
+    return true;
+}
+
+/** Selects the functions to translate; functions that call a function that can't be translated are removed until no more are */
+static void aot_selectfunctions(translator *t) {
+    objectfunction *global = t->prog->global;
+
+    for (unsigned int i=0; i<global->konst.count; i++) {
+        value k = global->konst.data[i];
+        if (MORPHO_ISFUNCTION(k)) varray_valuewrite(&t->functions, k);
+    }
+
+    bool changed;
+    do {
+        changed=false;
+        for (unsigned int i=0; i<t->functions.count; i++) {
+            char *reason;
+            if (!aot_cantranslate(t, MORPHO_GETFUNCTION(t->functions.data[i]), &reason)) {
+                fprintf(t->out, "/* Function '%s' not translated: %s. */\n",
+                        MORPHO_GETCSTRING(MORPHO_GETFUNCTION(t->functions.data[i])->name), reason);
+                for (unsigned int j=i+1; j<t->functions.count; j++) t->functions.data[j-1]=t->functions.data[j];
+                t->functions.count--;
+                changed=true;
+                break;
+            }
+        }
+    } while (changed);
+}
+
+/* **********************************************************************
+ * Writing C
+ * ********************************************************************** */
+
+/** Writes a constant as a C expression */
+static void aot_writeconstant(translator *t, value val) {
+    if (MORPHO_ISINTEGER(val)) {
+        fprintf(t->out, "MORPHO_INTEGER(%i)", MORPHO_GETINTEGERVALUE(val));
+    } else if (MORPHO_ISFLOAT(val)) {
+        fprintf(t->out, "MORPHO_FLOAT(%a)", MORPHO_GETFLOATVALUE(val));
+    } else if (MORPHO_ISBOOL(val)) {
+        fprintf(t->out, "MORPHO_BOOL(%s)", (MORPHO_GETBOOLVALUE(val) ? "true" : "false"));
+    } else if (MORPHO_ISNIL(val)) {
+        fprintf(t->out, "MORPHO_NIL");
+    } else {
+        unsigned int k;
+        if (!varray_valuefindsame(&t->konst, val, &k)) UNREACHABLE("Constant not collected before translation.");
+        fprintf(t->out, "aot_konst[%u]", k);
+    }
+}
+
+/** Writes the header of the extension */
+static void aot_writeheader(translator *t, const char *name) {
+    fprintf(t->out,
+            "/* Translated from '%s' by morpho5. Build as a shared library against the morpho headers,\n"
+            " * which 'make install' copies to /usr/local/include/morpho by default, e.g. cc -shared -fPIC -I/usr/local/include/morpho %s.c -o %s.so\n"
+            " * place it in the '%s' folder of a morpho resource directory, and use 'import %s' in place of the original module. */\n\n"
+            "#include <math.h>\n"
+            "#include \"morpho.h\"\n"
+            "#include \"builtin.h\"\n"
+            "#include \"common.h\"\n"
+            "#include \"aot.h\"\n\n",
+            name, name, name, MORPHO_EXTENSIONSDIR, name);
+}
+
+/** Finds constants used by the translated functions that must be resolved at initialization */
+static void aot_collectconstants(translator *t) {
+    for (unsigned int i=0; i<t->functions.count; i++) {
+        objectfunction *func = MORPHO_GETFUNCTION(t->functions.data[i]);
+        aot_reach(t, func);
+        
+        for (instructionindx j=0; j<t->prog->code.count; j++) {
+            instruction instr = t->prog->code.data[j];
+            if (!t->reached[j]) continue;
+            
+            value val;
+            if (DECODE_OP(instr)==OP_LCT) val = func->konst.data[DECODE_Bx(instr)];
+            else if (DECODE_OP(instr)==OP_LGL) val = aot_globalfunction(t, DECODE_Bx(instr));
+            else continue;
+            
+            unsigned int k;
+            if (MORPHO_ISOBJECT(val) &&
+                !varray_valuefindsame(&t->konst, val, &k)) varray_valuewrite(&t->konst, val);
+        }
+    }
+}
+
+/** Writes helpers used by translated functions */
+static void aot_writehelpers(translator *t) {
+    fprintf(t->out,
+            "#define AOT_ISNUMBER(x) (MORPHO_ISFLOAT(x) || MORPHO_ISINTEGER(x))\n"
+            "#define AOT_TOFLOAT(x) (MORPHO_ISFLOAT(x) ? MORPHO_GETFLOATVALUE(x) : (double) MORPHO_GETINTEGERVALUE(x))\n"
+            "#define AOT_ERROR(fn) { morpho_runtimeerror(v, AOT_NONNUMERICAL, fn); return MORPHO_NIL; }\n\n"
+            "/* Integer operands give an integer result, as in the VM */\n"
+            "#define AOT_ARITH(out, l, r, op, fn) \\\n"
+            "    if (MORPHO_ISINTEGER(l) && MORPHO_ISINTEGER(r)) out = MORPHO_INTEGER(MORPHO_GETINTEGERVALUE(l) op MORPHO_GETINTEGERVALUE(r)); \\\n"
+            "    else if (AOT_ISNUMBER(l) && AOT_ISNUMBER(r)) out = MORPHO_FLOAT(AOT_TOFLOAT(l) op AOT_TOFLOAT(r)); \\\n"
+            "    else AOT_ERROR(fn)\n\n"
+            "#define AOT_FLOATARITH(out, l, r, expr, fn) \\\n"
+            "    if (AOT_ISNUMBER(l) && AOT_ISNUMBER(r)) { double x=AOT_TOFLOAT(l), y=AOT_TOFLOAT(r); out = MORPHO_FLOAT(expr); } \\\n"
+            "    else AOT_ERROR(fn)\n\n"
+            "#define AOT_COMPARE(out, l, r, test, fn) \\\n"
+            "    if (AOT_ISNUMBER(l) && AOT_ISNUMBER(r)) { value x=l, y=r; MORPHO_CMPPROMOTETYPE(x, y); out = MORPHO_BOOL(morpho_comparevalue(x, y) test); } \\\n"
+            "    else AOT_ERROR(fn)\n\n"
+            "static value aot_konst[%u];\n\n", t->konst.count>0 ? t->konst.count : 1);
+}
+
+/** Writes a single instruction */
+static void aot_writeinstruction(translator *t, objectfunction *func, instruction instr, instructionindx i, const char *fname) {
+    FILE *out = t->out;
+    int a=DECODE_A(instr), b=DECODE_B(instr), c=DECODE_C(instr);
+
+    switch (DECODE_OP(instr)) {
+        case OP_NOP: break;
+        case OP_MOV: fprintf(out, "    r[%i]=r[%i];\n", a, b); break;
+        case OP_LCT:
+            fprintf(out, "    r[%i]=", a);
+            aot_writeconstant(t, func->konst.data[DECODE_Bx(instr)]);
+            fprintf(out, ";\n");
+            break;
+        case OP_LGL:
+            fprintf(out, "    r[%i]=", a);
+            aot_writeconstant(t, aot_globalfunction(t, DECODE_Bx(instr)));
+            fprintf(out, ";\n");
+            break;
+        case OP_ADD: fprintf(out, "    AOT_ARITH(r[%i], r[%i], r[%i], +, \"%s\");\n", a, b, c, fname); break;
+        case OP_SUB: fprintf(out, "    AOT_ARITH(r[%i], r[%i], r[%i], -, \"%s\");\n", a, b, c, fname); break;
+        case OP_MUL: fprintf(out, "    AOT_ARITH(r[%i], r[%i], r[%i], *, \"%s\");\n", a, b, c, fname); break;
+        case OP_DIV: fprintf(out, "    AOT_FLOATARITH(r[%i], r[%i], r[%i], x/y, \"%s\");\n", a, b, c, fname); break;
+        case OP_POW: fprintf(out, "    AOT_FLOATARITH(r[%i], r[%i], r[%i], pow(x, y), \"%s\");\n", a, b, c, fname); break;
+        case OP_ADDF: fprintf(out, "    r[%i]=MORPHO_FLOAT(MORPHO_GETFLOATVALUE(r[%i]) + MORPHO_GETFLOATVALUE(r[%i]));\n", a, b, c); break;
+        case OP_SUBF: fprintf(out, "    r[%i]=MORPHO_FLOAT(MORPHO_GETFLOATVALUE(r[%i]) - MORPHO_GETFLOATVALUE(r[%i]));\n", a, b, c); break;
+        case OP_MULF: fprintf(out, "    r[%i]=MORPHO_FLOAT(MORPHO_GETFLOATVALUE(r[%i]) * MORPHO_GETFLOATVALUE(r[%i]));\n", a, b, c); break;
+        case OP_DIVF: fprintf(out, "    r[%i]=MORPHO_FLOAT(MORPHO_GETFLOATVALUE(r[%i]) / MORPHO_GETFLOATVALUE(r[%i]));\n", a, b, c); break;
+        case OP_EQ: fprintf(out, "    { value x=r[%i], y=r[%i]; MORPHO_CMPPROMOTETYPE(x, y); r[%i]=MORPHO_BOOL(morpho_comparevalue(x, y)==0); }\n", b, c, a); break;
+        case OP_NEQ: fprintf(out, "    { value x=r[%i], y=r[%i]; MORPHO_CMPPROMOTETYPE(x, y); r[%i]=MORPHO_BOOL(morpho_comparevalue(x, y)!=0); }\n", b, c, a); break;
+        case OP_LT: fprintf(out, "    AOT_COMPARE(r[%i], r[%i], r[%i], >0, \"%s\");\n", a, b, c, fname); break;
+        case OP_LE: fprintf(out, "    AOT_COMPARE(r[%i], r[%i], r[%i], >=0, \"%s\");\n", a, b, c, fname); break;
+        case OP_NOT: fprintf(out, "    r[%i]=MORPHO_BOOL(MORPHO_ISBOOL(r[%i]) ? !MORPHO_GETBOOLVALUE(r[%i]) : MORPHO_ISNIL(r[%i]));\n", a, b, b, b); break;
+        case OP_B: fprintf(out, "    goto L%li;\n", (long) (i+DECODE_sBx(instr)+1)); break;
+        case OP_BIF: fprintf(out, "    if (MORPHO_ISTRUE(r[%i])) goto L%li;\n", a, (long) (i+DECODE_sBx(instr)+1)); break;
+        case OP_BIFF: fprintf(out, "    if (MORPHO_ISFALSE(r[%i])) goto L%li;\n", a, (long) (i+DECODE_sBx(instr)+1)); break;
+        case OP_CALL:
+            fprintf(out,
+                    "    if (!MORPHO_ISBUILTINFUNCTION(r[%i])) { morpho_runtimeerror(v, VM_UNCALLABLE); return MORPHO_NIL; }\n"
+                    "    r[%i]=(MORPHO_GETBUILTINFUNCTION(r[%i])->function) (v, %i, &r[%i]);\n"
+                    "    if (!ERROR_SUCCEEDED(*morpho_geterror(v))) return MORPHO_NIL;\n"
+                    "    if (MORPHO_ISOBJECT(r[%i])) { morpho_bindobjects(v, 1, &r[%i]); AOT_ERROR(\"%s\"); }\n", a, a, a, b, a, a, a, fname);
+            break;
+        case OP_RETURN:
+            if (a>0) fprintf(out, "    return r[%i];\n", b);
+            else fprintf(out, "    return MORPHO_NIL;\n");
+            break;
+        default:
+            UNREACHABLE("Untranslatable instruction selected for translation.");
+    }
+}
+
+/** Writes a translated function */
+static void aot_writefunction(translator *t, unsigned int indx) {
+    objectfunction *func = MORPHO_GETFUNCTION(t->functions.data[indx]);
+    char *fname = MORPHO_GETCSTRING(func->name);
+    int nregs = (func->nregs>func->nargs ? func->nregs : func->nargs+1);
+
+    aot_reach(t, func);
+
+    // Identify branch destinations to label
+    instructionindx n = t->prog->code.count;
+    bool label[n+1];
+    for (instructionindx i=0; i<=n; i++) label[i]=false;
+    for (instructionindx i=0; i<n; i++) {
+        if (!t->reached[i]) continue;
+        instruction instr = t->prog->code.data[i];
+        int op = DECODE_OP(instr);
+        if (op==OP_B || op==OP_BIF || op==OP_BIFF) label[i+DECODE_sBx(instr)+1]=true;
+    }
+
+    fprintf(t->out, "/* fn %s */\n", fname);
+    fprintf(t->out, "static value aot_fn%u(vm *v, int nargs, value *args) {\n", indx);
+    fprintf(t->out, "    value r[%i];\n", nregs);
+    fprintf(t->out, "    if (nargs!=%i) { morpho_runtimeerror(v, VM_INVALIDARGS, %i, nargs); return MORPHO_NIL; }\n", func->nargs, func->nargs);
+    fprintf(t->out, "    for (int i=0; i<=nargs; i++) r[i]=args[i];\n");
+    fprintf(t->out, "    for (int i=nargs+1; i<%i; i++) r[i]=MORPHO_NIL;\n", nregs);
+
+    // The entry point may not come first, so jump to it
+    fprintf(t->out, "    goto L%li;\n", (long) func->entry);
+    label[func->entry]=true;
+
+    for (instructionindx i=0; i<n; i++) {
+        if (!t->reached[i]) continue;
+        if (label[i]) fprintf(t->out, "L%li:\n", (long) i);
+        aot_writeinstruction(t, func, t->prog->code.data[i], i, fname);
+    }
+    fprintf(t->out, "}\n\n");
+}
+
+/** Writes the initializer that registers translated functions with morpho */
+static void aot_writeinitializer(translator *t, const char *name) {
+    fprintf(t->out, "void %s_initialize(void) {\n", name);
+    for (unsigned int i=0; i<t->functions.count; i++) {
+        objectfunction *func = MORPHO_GETFUNCTION(t->functions.data[i]);
+        fprintf(t->out, "    builtin_addfunction(\"%s\", aot_fn%u, BUILTIN_FLAGSEMPTY);\n", MORPHO_GETCSTRING(func->name), i);
+    }
+
+    // Functions are resolved by name once all have been registered
+    for (unsigned int k=0; k<t->konst.count; k++) {
+        value val = t->konst.data[k];
+        value label = (MORPHO_ISBUILTINFUNCTION(val) ? MORPHO_GETBUILTINFUNCTION(val)->name : MORPHO_GETFUNCTION(val)->name);
+        fprintf(t->out, "    { objectstring label = MORPHO_STATICSTRING(\"%s\"); aot_konst[%u]=builtin_findfunction(MORPHO_OBJECT(&label)); }\n", MORPHO_GETCSTRING(label), k);
+    }
+    fprintf(t->out, "}\n\n");
+
+    fprintf(t->out, "void %s_finalize(void) {\n}\n", name);
+}
+
+/* **********************************************************************
+ * Interface
+ * ********************************************************************** */
+
+/** Translates functions in a program to C, writing an extension to a file
+ * @param[in] p - the program to translate
+ * @param[in] name - name of the extension; must be a valid C identifier
+ * @param[in] out - file to write to
+ * @param[out] ntranslated - number of functions translated
+ * @returns true on success */
+bool aot_translate(program *p, const char *name, FILE *out, int *ntranslated) {
+    translator t;
+
+    for (const char *c=name; *c!='\0'; c++) if (!(isalnum(*c) || *c=='_')) return false;
+
+    aot_init(&t, p, out);
+    if (!t.reached) return false;
+
+    aot_writeheader(&t, name);
+    aot_findglobals(&t);
+    aot_selectfunctions(&t);
+    aot_collectconstants(&t);
+    aot_writehelpers(&t);
+
+    for (unsigned int i=0; i<t.functions.count; i++) {
+        fprintf(out, "static value aot_fn%u(vm *v, int nargs, value *args);\n", i);
+    }
+    fprintf(out, "\n");
+    for (unsigned int i=0; i<t.functions.count; i++) aot_writefunction(&t, i);
+    aot_writeinitializer(&t, name);
+
+    if (ntranslated) *ntranslated=t.functions.count;
+    aot_clear(&t);
+
+    return true;
+}
+
+/* **********************************************************************
+ * Initialization/Finalization
+ * ********************************************************************** */
+
+void aot_initialize(void) {
+    morpho_defineerror(AOT_NONNUMERICAL, ERROR_HALT, AOT_NONNUMERICAL_MSG);
+}
+
+void aot_finalize(void) {
+}
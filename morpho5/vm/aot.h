@@ -0,0 +1,32 @@
+/** @file aot.h
+ *  @author T J Atherton
+ *
+ *  @brief Ahead of time translation of compiled code to C
+*/
+
+#ifndef aot_h
+#define aot_h
+
+#include <stdio.h>
+#include "morpho.h"
+
+/* **********************************************************************
+ * Errors raised by translated code
+ * ********************************************************************** */
+
+#define AOT_NONNUMERICAL                  "AotNnNmrcl"
+#define AOT_NONNUMERICAL_MSG              "Compiled function '%s' can only work with numbers."
+
+/* **********************************************************************
+ * Interface
+ * ********************************************************************** */
+
+/** The extension to use for translated source files */
+#define AOT_SOURCEEXTENSION "c"
+
+bool aot_translate(program *p, const char *name, FILE *out, int *ntranslated);
+
+void aot_initialize(void);
+void aot_finalize(void);
+
+#endif /* aot_h */
@@ -6,6 +6,7 @@
 
 #include <stdarg.h>
 #include <string.h>
+#include <sys/stat.h>
 #include "compile.h"
 #include "error.h"
 #include "vm.h"
@@ -16,6 +17,8 @@
 #include "builtin.h"
 #include "cmplx.h"
 #include "optimize.h"
+#include "aot.h"
+#include "functional.h"
 
 /** Base class for instances */
 static objectclass *baseclass;
@@ -3263,6 +3266,102 @@ void compiler_copyglobals(compiler *src, compiler *dest, dictionary *compare) {
     }
 }
 
+/* -------------------------------------------------------
+ * Module source cache
+ * ------------------------------------------------------- */
+
+DEFINE_VARRAY(modulesource, modulesource *)
+
+/** Sources of files imported during this process, keyed by resolved path; values index into compiler_modulesources */
+static dictionary compiler_modulecache;
+static varray_modulesource compiler_modulesources;
+
+/** Finds the cache entry for a file, creating one if necessary
+ * @param[in] fname - the file name, relative to the working directory
+ * @returns the cache entry or NULL on failure */
+static modulesource *compiler_modulesourcefor(char *fname) {
+    modulesource *out = NULL;
+    varray_char path;
+    varray_charinit(&path);
+    file_relativepath(fname, &path);
+
+    objectstring key = MORPHO_STATICSTRING(path.data);
+    value indx;
+    if (dictionary_get(&compiler_modulecache, MORPHO_OBJECT(&key), &indx)) {
+        out = compiler_modulesources.data[MORPHO_GETINTEGERVALUE(indx)];
+    } else {
+        value pathstring = object_stringfromcstring(path.data, strlen(path.data));
+        out = MORPHO_MALLOC(sizeof(modulesource));
+
+        if (out && MORPHO_ISSTRING(pathstring)) {
+            out->path=MORPHO_GETCSTRING(pathstring);
+            out->mtime=0;
+            out->size=0;
+            out->status=MODULESOURCE_UNLOADED;
+            varray_charinit(&out->src);
+
+            int i=varray_modulesourcewrite(&compiler_modulesources, out);
+            dictionary_insert(&compiler_modulecache, pathstring, MORPHO_INTEGER(i));
+        } else {
+            if (out) MORPHO_FREE(out);
+            morpho_freeobject(pathstring);
+            out=NULL;
+        }
+    }
+
+    varray_charclear(&path);
+    return out;
+}
+
+/** Brings a cached module source up to date, reading the file if it is new or has changed since it was last read.
+ *  Only touches the entry passed, so may be run on a worker thread. */
+static bool compiler_refreshmodulesource(void *arg) {
+    modulesource *m = (modulesource *) arg;
+    struct stat st;
+
+    if (stat(m->path, &st)!=0) {
+        m->status=MODULESOURCE_NOTFOUND;
+        return false;
+    }
+
+    if (m->status==MODULESOURCE_LOADED &&
+        m->mtime==st.st_mtime &&
+        m->size==st.st_size) return true;
+
+    FILE *f = fopen(m->path, "r");
+    if (!f) {
+        m->status=MODULESOURCE_NOTFOUND;
+        return false;
+    }
+
+    m->src.count=0;
+    if (file_readintovarray(f, &m->src)) {
+        m->status=MODULESOURCE_LOADED;
+        m->mtime=st.st_mtime;
+        m->size=st.st_size;
+    } else m->status=MODULESOURCE_READFAILED;
+
+    fclose(f);
+    return (m->status==MODULESOURCE_LOADED);
+}
+
+/** Frees the module source cache */
+static void compiler_clearmodulecache(void) {
+    for (unsigned int i=0; i<compiler_modulesources.count; i++) {
+        varray_charclear(&compiler_modulesources.data[i]->src);
+        MORPHO_FREE(compiler_modulesources.data[i]);
+    }
+    varray_modulesourceclear(&compiler_modulesources);
+
+    /* Keys own the path strings referred to by each entry */
+    dictionary_freecontents(&compiler_modulecache, true, false);
+    dictionary_clear(&compiler_modulecache);
+}
+
+/* -------------------------------------------------------
+ * Import
+ * ------------------------------------------------------- */
+
 /** Searches for a module with given name, returns the file name for inclusion. */
 bool compiler_findmodule(char *name, varray_char *fname) {
     char *ext[] = { MORPHO_EXTENSION, "" };
@@ -3281,6 +3380,57 @@ bool compiler_findmodule(char *name, varray_char *fname) {
     return success;
 }
 
+/** Reads the files imported by a newly parsed syntax tree on the workers of the functional threadpool, so that they are cached by the time they are compiled. */
+static void compiler_prefetchimports(compiler *c) {
+    if (morpho_threadnumber()<1) return;
+
+    compiler *root = c;
+    while (root->parent!=NULL) root=root->parent;
+
+    varray_modulesource fetch;
+    varray_modulesourceinit(&fetch);
+    varray_char filename;
+    varray_charinit(&filename);
+
+    for (unsigned int i=0; i<c->tree.tree.count; i++) {
+        syntaxtreenode *node = c->tree.tree.data+i;
+        if (node->type!=NODE_IMPORT) continue;
+
+        syntaxtreenode *module = compiler_getnode(c, node->left);
+        char *fname=NULL;
+        if (!module) continue;
+
+        if (module->type==NODE_SYMBOL) {
+            if (compiler_findmodule(MORPHO_GETCSTRING(module->content), &filename)) fname=filename.data;
+        } else if (module->type==NODE_STRING) {
+            fname=MORPHO_GETCSTRING(module->content);
+        }
+        if (!fname) continue;
+
+        /* Files already imported by this program are skipped, and may be in use by an enclosing compiler */
+        objectstring chkmodname = MORPHO_STATICSTRING(fname);
+        if (dictionary_get(&root->modules, MORPHO_OBJECT(&chkmodname), NULL)) continue;
+
+        modulesource *m = compiler_modulesourcefor(fname);
+        if (m) {
+            bool dup=false;
+            for (unsigned int j=0; j<fetch.count; j++) if (fetch.data[j]==m) dup=true;
+            if (!dup) varray_modulesourcewrite(&fetch, m);
+        }
+    }
+
+    /* A single file is read when it is imported */
+    if (fetch.count>1) {
+        for (unsigned int i=0; i<fetch.count; i++) {
+            threadpool_add_task(&functional_pool, compiler_refreshmodulesource, fetch.data[i]);
+        }
+        threadpool_fence(&functional_pool);
+    }
+
+    varray_charclear(&filename);
+    varray_modulesourceclear(&fetch);
+}
+
 /** Import a module */
 static codeinfo compiler_import(compiler *c, syntaxtreenode *node, registerindx reqout) {
     varray_char filename;
@@ -3289,7 +3439,7 @@ static codeinfo compiler_import(compiler *c, syntaxtreenode *node, registerindx
     dictionary fordict;
     char *fname=NULL;
     unsigned int start=0, end=0;
-    FILE *f = NULL;
+    modulesource *msrc = NULL;
 
     dictionary_init(&fordict);
     varray_charinit(&filename);
@@ -3331,32 +3481,27 @@ static codeinfo compiler_import(compiler *c, syntaxtreenode *node, registerindx
             }
         }
 
-        if (fname) f=file_openrelative(fname, "r");
+        if (fname) msrc=compiler_modulesourcefor(fname);
         else goto compiler_import_cleanup;
 
-        if (f) {
+        if (msrc && compiler_refreshmodulesource(msrc)) {
             value modname=object_stringfromcstring(fname, strlen(fname));
             dictionary_insert(&root->modules, modname, MORPHO_NIL);
 
-            /* Read in source */
-            varray_char src;
-            varray_charinit(&src);
-            if (!file_readintovarray(f, &src)) {
-                compiler_error(c, module, COMPILE_IMPORTFLD, fname);
-                goto compiler_import_cleanup;
-            }
+            /* Source is owned by the cache */
+            char *src = msrc->src.data;
 
             /* Remember the initial position of the code */
             start=c->out->code.count;
 
             /* Set up the compiler */
             compiler cc;
-            compiler_init(src.data, c->out, &cc);
+            compiler_init(src, c->out, &cc);
             compiler_setmodule(&cc, modname);
             debug_setmodule(&c->out->annotations, modname);
             cc.parent=c; /* Ensures global variables can be found */
 
-            morpho_compile(src.data, &cc, false, &c->err);
+            morpho_compile(src, &cc, false, &c->err);
 
             if (ERROR_SUCCEEDED(c->err)) {
                 compiler_stripend(c);
@@ -3370,13 +3515,12 @@ static codeinfo compiler_import(compiler *c, syntaxtreenode *node, registerindx
             compiler_clear(&cc);
 
             end=c->out->code.count;
-
-            varray_charclear(&src);
+        } else if (msrc && msrc->status==MODULESOURCE_READFAILED) {
+            compiler_error(c, module, COMPILE_IMPORTFLD, fname);
         } else compiler_error(c, module, COMPILE_FILENOTFOUND, fname);
     }
 
 compiler_import_cleanup:
-    if (f) fclose(f);
     varray_charclear(&filename);
     dictionary_clear(&fordict);
 
@@ -3472,6 +3616,7 @@ bool morpho_compile(char *in, compiler *c, bool opt, error *err) {
         }
 #endif
 
+        compiler_prefetchimports(c);
         compiler_tobytecode(c, out);
         if (ERROR_SUCCEEDED(c->err)) {
             compiler_setfunctionregistercount(c);
@@ -3524,6 +3669,10 @@ void morpho_setbaseclass(value klss) {
 void compile_initialize(void) {
     _selfsymbol=builtin_internsymbolascstring("self");
 
+    dictionary_init(&compiler_modulecache);
+    varray_modulesourceinit(&compiler_modulesources);
+    aot_initialize();
+
     /* Lex errors */
     morpho_defineerror(COMPILE_UNTERMINATEDCOMMENT, ERROR_LEX, COMPILE_UNTERMINATEDCOMMENT_MSG);
     morpho_defineerror(COMPILE_UNTERMINATEDSTRING, ERROR_LEX, COMPILE_UNTERMINATEDSTRING_MSG);
@@ -3602,4 +3751,6 @@ void compile_initialize(void) {
 /** Finalizes the compiler */
 void compile_finalize(void) {
     optimize_finalize();
+    aot_finalize();
+    compiler_clearmodulecache();
 }
@@ -9,6 +9,8 @@
 
 #define MORPHO_CORE
 
+#include <sys/types.h>
+#include <time.h>
 #include "core.h"
 #include "syntaxtree.h"
 #include "parse.h"
@@ -176,6 +178,29 @@ typedef struct {
 
 DECLARE_VARRAY(forwardreference, forwardreference)
 
+/* -------------------------------------------------------
+ * Module sources
+ * ------------------------------------------------------- */
+
+/** Status of a cached module source */
+typedef enum {
+    MODULESOURCE_UNLOADED, /* Not yet read */
+    MODULESOURCE_LOADED,   /* Source was read successfully */
+    MODULESOURCE_NOTFOUND, /* File could not be opened */
+    MODULESOURCE_READFAILED /* File was opened but could not be read */
+} modulesourcestatus;
+
+/** Module source, cached across compilers by resolved path and modification time */
+typedef struct {
+    char *path; /** Resolved path to the file */
+    time_t mtime; /** Modification time when the source was read */
+    off_t size; /** Size of the file when the source was read */
+    modulesourcestatus status; /** Status of the source */
+    varray_char src; /** The source itself */
+} modulesource;
+
+DECLARE_VARRAY(modulesource, modulesource *)
+
 /* -------------------------------------------------------
  * Function types
  * ------------------------------------------------------- */
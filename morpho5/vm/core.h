@@ -265,6 +265,7 @@ struct svm {
     callframe *errfp; /** Record frame pointer when an error occured */
 
     object *objects; /** Linked list of objects */
+    dictionary strings; /** Weak table of interned strings */
     graylist gray; /** Graylist for garbage collection */
     size_t bound; /** Estimated size of bound bytes */
     size_t nextgc; /** Next garbage collection threshold */
@@ -30,6 +30,18 @@ OPCODE(DIV)
 /** Raise to a power */
 OPCODE(POW)
 
+/** Add two registers known to contain Floats */
+OPCODE(ADDF)
+
+/** Subtract two registers known to contain Floats */
+OPCODE(SUBF)
+
+/** Multiply two registers known to contain Floats */
+OPCODE(MULF)
+
+/** Divide two registers known to contain Floats */
+OPCODE(DIVF)
+
 /** Comparison test */
 OPCODE(EQ)
 
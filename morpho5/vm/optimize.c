@@ -7,6 +7,7 @@
 #include "optimize.h"
 #include "debug.h"
 #include "vm.h"
+#include "builtin.h"
 
 DEFINE_VARRAY(codeblock, codeblock);
 DEFINE_VARRAY(codeblockindx, codeblockindx);
@@ -41,6 +42,7 @@ void optimize_initcodeblock(codeblock *block, objectfunction *func, instructioni
 void optimize_clearcodeblock(codeblock *block) {
     varray_codeblockindxclear(&block->src);
     dictionary_clear(&block->retain);
+    if (block->reg) MORPHO_FREE(block->reg);
 }
 
 /** Sets the current block */
@@ -126,9 +128,22 @@ void optimize_globalcontents(optimizer *opt, indx ix, returntype type, indx id)
     }
 }
 
+/** Identifies the class of instances described by a type, if any */
+objectclass *optimize_typeclass(value type) {
+    if (!MORPHO_ISOBJECT(type) || OPTIMIZER_ISAMBIGUOUS(type)) return NULL;
+    if (MORPHO_ISCLASS(type)) return MORPHO_GETCLASS(type);
+    return object_getveneerclass(MORPHO_GETOBJECTTYPE(type));
+}
+
 /** Decides whether two types match */
 bool optimize_matchtype(value t1, value t2) {
-    return MORPHO_ISSAME(t1, t2);
+    if (MORPHO_ISNIL(t1) || MORPHO_ISNIL(t2)) return false;
+    if (MORPHO_ISINTEGER(t1)) return MORPHO_ISINTEGER(t2);
+    if (MORPHO_ISFLOAT(t1)) return MORPHO_ISFLOAT(t2);
+    if (MORPHO_ISBOOL(t1)) return MORPHO_ISBOOL(t2);
+    
+    objectclass *k1 = optimize_typeclass(t1);
+    return (k1 && k1==optimize_typeclass(t2));
 }
 
 /** Updates a globals type  */
@@ -211,26 +226,55 @@ void optimize_reginvalidate(optimizer *opt, returntype type, indx id) {
 }
 
 /** Sets the type of value in a register */
-void optimize_regsettype(optimizer *opt, registerindx reg, value value) {
-    opt->reg[reg].type=value;
+void optimize_regsettype(optimizer *opt, registerindx reg, value type) {
+    // Captured registers may be changed by any closure that is called, so we never assign them a type
+    opt->reg[reg].type=(opt->captured[reg] ? MORPHO_NIL : type);
+}
+
+/** Checks whether a type is numerical */
+static inline bool optimize_isnumerictype(value type) {
+    return (MORPHO_ISINTEGER(type) || MORPHO_ISFLOAT(type));
 }
 
 /** Resolves the type of value produced by an arithmetic instruction */
-void optimize_resolvearithmetictype(optimizer *opt) {
-    registerindx a=DECODE_A(opt->current);
+value optimize_resolvearithmetictype(optimizer *opt) {
     registerindx b=DECODE_B(opt->current);
     registerindx c=DECODE_C(opt->current);
     value ta = MORPHO_NIL, tb = opt->reg[b].type, tc = opt->reg[c].type;
     
     if (MORPHO_ISINTEGER(tb) && MORPHO_ISINTEGER(tc)) {
-        ta = MORPHO_INTEGER(1);
-    } else if ((MORPHO_ISINTEGER(tb) && MORPHO_ISFLOAT(tc)) ||
-               (MORPHO_ISFLOAT(tb) && MORPHO_ISINTEGER(tc)) ||
-               (MORPHO_ISFLOAT(tb) && MORPHO_ISFLOAT(tc))) {
+        // Division and powers of integers always produce floats in the VM
+        ta = (opt->op==OP_DIV || opt->op==OP_POW ? MORPHO_FLOAT(1.0) : MORPHO_INTEGER(1));
+    } else if (optimize_isnumerictype(tb) && optimize_isnumerictype(tc)) {
         ta = MORPHO_FLOAT(1.0);
     }
     
-    optimize_regsettype(opt, a, ta);
+    return ta;
+}
+
+bool optimize_findconstant(optimizer *opt, registerindx reg, indx *out);
+
+/** Resolves the type of value returned by a call to a builtin function */
+value optimize_resolvecalltype(optimizer *opt, registerindx rfn, int nargs) {
+    indx kindx;
+    if (!optimize_findconstant(opt, rfn, &kindx) ||
+        !opt->func || kindx>=opt->func->konst.count) return MORPHO_NIL; // Register state may be stale while the control flow graph is built
+    
+    value fn = opt->func->konst.data[kindx];
+    if (!MORPHO_ISBUILTINFUNCTION(fn)) return MORPHO_NIL;
+    objectbuiltinfunction *f = MORPHO_GETBUILTINFUNCTION(fn);
+    
+    if (f->flags & BUILTIN_FLAGSNUMERIC) {
+        for (int i=0; i<nargs; i++) if (!optimize_isnumerictype(opt->reg[rfn+i+1].type)) return MORPHO_NIL;
+        return MORPHO_FLOAT(1.0);
+    }
+    
+    return MORPHO_NIL;
+}
+
+/** Forgets the types of registers that a call may overwrite */
+void optimize_regclobber(optimizer *opt, registerindx reg) {
+    for (registerindx i=reg; i<opt->maxreg; i++) opt->reg[i].type=MORPHO_NIL;
 }
 
 /** Gets the type of value in a register if known */
@@ -374,6 +418,15 @@ bool optimize_atend(optimizer *opt) {
 void optimize_setfunction(optimizer *opt, objectfunction *func) {
     opt->maxreg=func->nregs;
     opt->func=func;
+    
+    // Identify registers captured by closures created in this function
+    for (unsigned int i=0; i<MORPHO_MAXARGS; i++) opt->captured[i]=false;
+    for (unsigned int i=0; i<func->prototype.count; i++) {
+        varray_upvalue *v = &func->prototype.data[i];
+        for (unsigned int j=0; j<v->count; j++) {
+            if (v->data[j].islocal && v->data[j].reg<MORPHO_MAXARGS) opt->captured[v->data[j].reg]=true;
+        }
+    }
 }
 
 /** Indicates no overwrite takes place */
@@ -593,11 +646,18 @@ void optimize_track(optimizer *opt) {
         case OP_MUL:
         case OP_DIV:
         case OP_POW:
+        case OP_ADDF:
+        case OP_SUBF:
+        case OP_MULF:
+        case OP_DIVF:
+        {
+            value type = optimize_resolvearithmetictype(opt); // Resolve before the output overwrites an operand
             optimize_reguse(opt, DECODE_B(instr));
             optimize_reguse(opt, DECODE_C(instr));
             optimize_regoverwrite(opt, DECODE_A(instr));
             optimize_regcontents(opt, DECODE_A(instr), VALUE, REGISTER_UNALLOCATED);
-            optimize_resolvearithmetictype(opt);
+            optimize_regsettype(opt, DECODE_A(instr), type);
+        }
             break;
         case OP_EQ:
         case OP_NEQ:
@@ -623,13 +683,16 @@ void optimize_track(optimizer *opt) {
         {
             registerindx a = DECODE_A(instr);
             registerindx b = DECODE_B(instr);
+            value type = optimize_resolvecalltype(opt, a, b);
             optimize_reguse(opt, a);
             for (unsigned int i=0; i<b; i++) {
                 optimize_reguse(opt, a+i+1);
                 opt->reg[a+i+1].contains=NOTHING; // call uses and overwrites arguments.
             }
+            optimize_regclobber(opt, a+1);
             optimize_regoverwrite(opt, DECODE_A(instr));
             optimize_regcontents(opt, DECODE_A(instr), VALUE, REGISTER_UNALLOCATED);
+            optimize_regsettype(opt, a, type);
         }
             break;
         case OP_INVOKE:
@@ -643,6 +706,7 @@ void optimize_track(optimizer *opt) {
                 optimize_reguse(opt, a+i+1);
                 opt->reg[a+i+1].contains=NOTHING; // invoke uses and overwrites arguments.
             }
+            optimize_regclobber(opt, a+1);
             optimize_regoverwrite(opt, a);
             optimize_regcontents(opt, a, VALUE, REGISTER_UNALLOCATED);
         }
@@ -656,7 +720,7 @@ void optimize_track(optimizer *opt) {
             optimize_regoverwrite(opt, a);
             optimize_useglobal(opt, DECODE_Bx(instr));
             optimize_regcontents(opt, a, GLOBAL, DECODE_Bx(instr));
-            optimize_regsettype(opt, DECODE_A(instr), optimize_getglobaltype(opt, DECODE_Bx(instr)));
+            // Global types are only complete once every store has been seen, so they aren't propagated
         }
             break;
         case OP_SGL:
@@ -1317,6 +1381,192 @@ bool optimize_constant_folding(optimizer *opt) {
     return false;
 }
 
+/** Evaluates calls to pure builtin functions with constant arguments */
+bool optimize_pure_call_folding(optimizer *opt) {
+    instruction instr=opt->current;
+    registerindx a=DECODE_A(instr);
+    int nargs=DECODE_B(instr);
+    indx fn;
+    
+    if (!optimize_findconstant(opt, a, &fn)) return false;
+    value f = opt->func->konst.data[fn];
+    if (!MORPHO_ISBUILTINFUNCTION(f) ||
+        !(MORPHO_GETBUILTINFUNCTION(f)->flags & BUILTIN_FLAGSPURE)) return false;
+    
+    // A program that loads the function and its arguments and calls it
+    instruction ilist[nargs+3];
+    ilist[0]=ENCODE_LONG(OP_LCT, 0, (instruction) fn);
+    for (int i=0; i<nargs; i++) {
+        indx k;
+        if (!optimize_findconstant(opt, a+i+1, &k)) return false;
+        ilist[i+1]=ENCODE_LONG(OP_LCT, (i+1), (instruction) k);
+    }
+    ilist[nargs+1]=ENCODE_DOUBLE(OP_CALL, 0, nargs);
+    ilist[nargs+2]=ENCODE_BYTE(OP_END);
+    
+    value out;
+    indx nkonst;
+    if (optimize_evaluateprogram(opt, ilist, 0, &out) &&
+        optimize_addconstant(opt, out, &nkonst)) {
+        optimize_replaceinstruction(opt, ENCODE_LONG(OP_LCT, a, (unsigned int) nkonst));
+        return true;
+    }
+    
+    return false;
+}
+
+/** Checks whether a function can be called at compile time as part of a constant construction */
+static bool optimize_isconstantcallable(value f) {
+    if (MORPHO_ISINVOCATION(f)) { // Clones of prototypes made by earlier constant constructions
+        value method = MORPHO_GETINVOCATION(f)->method;
+        return (MORPHO_ISBUILTINFUNCTION(method) &&
+                MORPHO_ISSTRING(MORPHO_GETBUILTINFUNCTION(method)->name) &&
+                strcmp(MORPHO_GETCSTRING(MORPHO_GETBUILTINFUNCTION(method)->name), MORPHO_CLONE_METHOD)==0);
+    }
+    
+    return (MORPHO_ISBUILTINFUNCTION(f) &&
+            (MORPHO_GETBUILTINFUNCTION(f)->flags & (BUILTIN_FLAGSPURE | BUILTIN_FLAGSCONSTRUCTOR)));
+}
+
+#define OPTIMIZER_UNDEFINED -1 // Register not written by the construction
+#define OPTIMIZER_DEFINED -2   // Register holds the result of a call made by the construction
+
+/** Checks whether the instructions that set up a call to a constructor only build its arguments from constants, using constructors and pure builtins.
+ * @param[in] opt - the optimizer
+ * @param[in] start - instruction that loads the constructor
+ * @param[in] reg - register containing the constructor
+ * @param[in] nargs - number of arguments passed to the constructor
+ * @param[out] out - replacements for the instructions after start; only loads of constants into registers that outlive the call are kept
+ * @returns true if the construction can be evaluated at compile time */
+bool optimize_isconstantconstruction(optimizer *opt, instructionindx start, registerindx reg, int nargs, instruction *out) {
+    indx konst[opt->maxreg]; // Constant, if any, contained in each register
+    instructionindx writer[opt->maxreg]; // Instruction that loaded the constant
+    for (registerindx i=0; i<opt->maxreg; i++) {
+        konst[i]=OPTIMIZER_UNDEFINED;
+        writer[i]=INSTRUCTIONINDX_EMPTY;
+    }
+    
+    for (instructionindx i=start+1; i<optimizer_currentindx(opt); i++) {
+        instruction instr = optimize_fetchinstructionat(opt, i);
+        registerindx a = DECODE_A(instr);
+        out[i-start-1]=ENCODE_BYTE(OP_NOP);
+        
+        if (DECODE_OP(instr)==OP_NOP) continue;
+        if (a<=reg || a>=opt->maxreg) return false;
+        
+        switch (DECODE_OP(instr)) {
+            case OP_LCT:
+                konst[a]=DECODE_Bx(instr);
+                writer[a]=i;
+                break;
+            case OP_MOV:
+            {
+                registerindx b=DECODE_B(instr);
+                if (b<=reg || b>=opt->maxreg || konst[b]<0) return false;
+                konst[a]=konst[b];
+                writer[a]=i;
+            }
+                break;
+            case OP_CALL:
+            {
+                int n=DECODE_B(instr);
+                if (konst[a]<0 || a+n>=opt->maxreg ||
+                    !optimize_isconstantcallable(opt->func->konst.data[konst[a]])) return false;
+                for (registerindx j=a+1; j<=a+n; j++) if (konst[j]==OPTIMIZER_UNDEFINED) return false;
+                
+                // The call consumes its arguments
+                konst[a]=OPTIMIZER_DEFINED;
+                writer[a]=INSTRUCTIONINDX_EMPTY;
+                for (registerindx j=a+1; j<=a+n; j++) {
+                    konst[j]=OPTIMIZER_UNDEFINED;
+                    writer[j]=INSTRUCTIONINDX_EMPTY;
+                }
+            }
+                break;
+            default:
+                return false;
+        }
+    }
+    
+    // Every argument must be supplied, and every call result consumed, by the construction
+    if (reg+nargs>=opt->maxreg) return false;
+    for (registerindx j=reg+1; j<opt->maxreg; j++) {
+        if (j<=reg+nargs) {
+            if (konst[j]==OPTIMIZER_UNDEFINED) return false;
+        } else if (konst[j]==OPTIMIZER_DEFINED) {
+            return false;
+        } else if (writer[j]!=INSTRUCTIONINDX_EMPTY) { // Later code may rely on the constant
+            out[writer[j]-start-1]=ENCODE_LONG(OP_LCT, j, (unsigned int) konst[j]);
+        }
+    }
+    
+    return true;
+}
+
+/** Evaluates calls to constructors of mutable builtin objects, e.g. Matrix, whose arguments are built only from constants.
+ *  The object is constructed once and kept as a prototype; the call is replaced by a call to the prototype's clone method. */
+bool optimize_constant_construction(optimizer *opt) {
+    instruction instr=opt->current;
+    registerindx a=DECODE_A(instr);
+    indx fn;
+    
+    if (!optimize_findconstant(opt, a, &fn) ||
+        opt->reg[a].contains!=CONSTANT ||
+        opt->reg[a].block!=opt->currentblock ||
+        opt->reg[a].iix==INSTRUCTIONINDX_EMPTY) return false;
+    
+    value f = opt->func->konst.data[fn];
+    if (!MORPHO_ISBUILTINFUNCTION(f) ||
+        !(MORPHO_GETBUILTINFUNCTION(f)->flags & BUILTIN_FLAGSCONSTRUCTOR)) return false;
+    
+    instructionindx start=opt->reg[a].iix;
+    instruction load=optimize_fetchinstructionat(opt, start);
+    if (DECODE_OP(load)!=OP_LCT || DECODE_A(load)!=a) return false;
+    
+    instructionindx n=optimizer_currentindx(opt)-start+1; // Instructions that set up and make the call
+    instruction ilist[n+1], rep[n];
+    if (!optimize_isconstantconstruction(opt, start, a, DECODE_B(instr), rep)) return false;
+    
+    for (instructionindx i=0; i<n; i++) ilist[i]=optimize_fetchinstructionat(opt, start+i);
+    ilist[n]=ENCODE_BYTE(OP_END);
+    
+    value proto=MORPHO_NIL, clone=MORPHO_NIL;
+    objectstring clonelabel = MORPHO_STATICSTRING(MORPHO_CLONE_METHOD);
+    
+    if (!optimize_evaluateprogram(opt, ilist, a, &proto) ||
+        !MORPHO_ISOBJECT(proto)) return false;
+    
+    objectinvocation *inv = NULL;
+    if (morpho_lookupmethod(proto, MORPHO_OBJECT(&clonelabel), &clone)) {
+        inv = object_newinvocation(proto, clone);
+    }
+    
+    indx nkonst;
+    if (!inv || !optimize_addconstant(opt, MORPHO_OBJECT(inv), &nkonst)) {
+        if (inv) object_free((object *) inv);
+        morpho_freeobject(proto);
+        return false;
+    }
+    program_bindobject(opt->out, MORPHO_GETOBJECT(proto));
+    
+    // Load the bound clone method in place of the constructor and remove the setup
+    optimize_replaceinstructionat(opt, start, ENCODE_LONG(OP_LCT, a, (unsigned int) nkonst));
+    for (instructionindx i=start+1; i<optimizer_currentindx(opt); i++) {
+        optimize_replaceinstructionat(opt, i, rep[i-start-1]);
+    }
+    optimize_replaceinstruction(opt, ENCODE_DOUBLE(OP_CALL, a, 0));
+    
+    // Forget register contents set up by the removed instructions
+    for (registerindx i=a+1; i<opt->maxreg; i++) {
+        if (opt->reg[i].block==opt->currentblock &&
+            opt->reg[i].iix>start && opt->reg[i].iix<optimizer_currentindx(opt)) {
+            optimize_regcontents(opt, i, NOTHING, REGISTER_UNALLOCATED);
+        }
+    }
+    
+    return true;
+}
+
 /** Deletes unused globals  */
 bool optimize_unused_global(optimizer *opt) {
     indx gid=DECODE_Bx(opt->current);
@@ -1349,6 +1599,26 @@ bool optimize_constant_global(optimizer *opt) {
 }
 
 
+/** Replaces arithmetic on registers proven to contain Floats with unchecked instructions */
+bool optimize_arithmetic_specialization(optimizer *opt) {
+    int op;
+    switch (opt->op) {
+        case OP_ADD: op=OP_ADDF; break;
+        case OP_SUB: op=OP_SUBF; break;
+        case OP_MUL: op=OP_MULF; break;
+        case OP_DIV: op=OP_DIVF; break;
+        default: return false;
+    }
+    
+    instruction instr=opt->current;
+    if (MORPHO_ISFLOAT(optimize_getregtype(opt, DECODE_B(instr))) &&
+        MORPHO_ISFLOAT(optimize_getregtype(opt, DECODE_C(instr)))) {
+        optimize_replaceinstruction(opt, ENCODE(op, DECODE_A(instr), DECODE_B(instr), DECODE_C(instr)));
+    }
+    
+    return false;
+}
+
 /** Tracks information written to a global */
 bool optimize_storeglobal_trackcontents(optimizer *opt) {
     registerindx rix = DECODE_A(opt->current);
@@ -1386,6 +1656,9 @@ optimizationstrategy secondpass[] = {
     { OP_ANY, optimize_register_replacement },
     { OP_ANY, optimize_subexpression_elimination },
     { OP_ANY, optimize_constant_folding },          // Must be in second pass for correct data flow
+    { OP_CALL, optimize_pure_call_folding },
+    { OP_CALL, optimize_constant_construction },
+    { OP_ANY, optimize_arithmetic_specialization }, // Types are only reliable once data flow is established
     { OP_LCT, optimize_duplicate_loadconst },
     { OP_LGL, optimize_duplicate_loadglobal },
     { OP_LGL, optimize_constant_global },           // Second pass to ensure all sgls have been seen
@@ -1416,6 +1689,33 @@ void optimize_showregisterstateforblock(optimizer *opt, codeblockindx handle) {
 #endif
 }
 
+/** Merges register types from the parents of a block; a type survives only if every parent agrees on it.
+ *  Parents that haven't been processed yet are skipped, so types are only reliable once
+ *  optimize_inferencepass has iterated the control flow graph to a fixed point. A register whose
+ *  contents a processed parent doesn't know (e.g. a parameter) has no type. */
+void optimize_restoreregistertypes(optimizer *opt, codeblockindx handle) {
+    codeblock *block = optimize_getblock(opt, handle);
+    
+    for (registerindx j=0; j<opt->maxreg; j++) {
+        value type = MORPHO_NIL;
+        bool first=true;
+        
+        if (!block->isroot) for (unsigned int i=0; i<block->src.count; i++) {
+            codeblock *src = optimize_getblock(opt, block->src.data[i]);
+            if (!src->reg) continue;
+            if (j>=src->nreg || src->reg[j].contains==NOTHING) { type=MORPHO_NIL; break; }
+            
+            if (first) type=src->reg[j].type;
+            else if (!optimize_matchtype(type, src->reg[j].type)) type=MORPHO_NIL;
+            first=false;
+            
+            if (MORPHO_ISNIL(type)) break;
+        }
+        
+        optimize_regsettype(opt, j, type);
+    }
+}
+
 /** Restores register info from the parents of a block */
 void optimize_restoreregisterstate(optimizer *opt, codeblockindx handle) {
     codeblock *block = optimize_getblock(opt, handle);
@@ -1455,6 +1755,8 @@ void optimize_restoreregisterstate(optimizer *opt, codeblockindx handle) {
         if (src->nreg>opt->maxreg) opt->maxreg=src->nreg;
     }
     
+    optimize_restoreregistertypes(opt, handle);
+    
 #ifdef MORPHO_DEBUG_LOGOPTIMIZER
         printf("Combined register state:\n");
         optimize_regshow(opt);
@@ -1519,6 +1821,71 @@ void optimize_optimizeblock(optimizer *opt, codeblockindx block, optimizationstr
 #endif
 }
 
+/* **********************************************************************
+ * Type inference
+ * ********************************************************************** */
+
+/** Checks whether the register types saved in a block differ from the current register state */
+bool optimize_typeschanged(optimizer *opt, codeblockindx handle) {
+    codeblock *block = optimize_getblock(opt, handle);
+    if (!block->reg) return true;
+    
+    for (registerindx i=0; i<opt->maxreg && i<block->nreg; i++) {
+        value t1=block->reg[i].type, t2=opt->reg[i].type;
+        if (MORPHO_ISNIL(t1)!=MORPHO_ISNIL(t2) ||
+            (!MORPHO_ISNIL(t1) && !optimize_matchtype(t1, t2))) return true;
+    }
+    
+    return false;
+}
+
+/** Tracks register types through a block, returning true if they changed since the last visit */
+bool optimize_inferblock(optimizer *opt, codeblockindx handle) {
+    instructionindx start=optimize_getstart(opt, handle),
+                    end=optimize_getend(opt, handle);
+    
+    optimize_setcurrentblock(opt, handle);
+    optimize_setfunction(opt, optimize_getfunction(opt, handle));
+    optimize_restart(opt, start);
+    optimize_restoreregisterstate(opt, handle);
+    
+    for (;
+        optimizer_currentindx(opt)<=end;
+        optimize_advance(opt)) {
+        optimize_fetch(opt);
+        optimize_track(opt);
+        optimize_overwrite(opt, false);
+    }
+    
+    bool changed=optimize_typeschanged(opt, handle);
+    optimize_saveregisterstatetoblock(opt, handle);
+    return changed;
+}
+
+/** Infers register types by iterating over the control flow graph until they no longer change.
+ *  Blocks start out unprocessed, so a loop carried type survives if every path into the loop agrees on it. */
+void optimize_inferencepass(optimizer *opt) {
+    varray_codeblockindx worklist;
+    varray_codeblockindxinit(&worklist);
+    
+    for (unsigned int i=0; i<opt->cfgraph.count; i++) {
+        codeblock *block = optimize_getblock(opt, i);
+        if (block->reg) MORPHO_FREE(block->reg);
+        block->reg=NULL;
+        block->nreg=0;
+        if (block->isroot) varray_codeblockindxwrite(&worklist, i);
+    }
+    
+    while (worklist.count>0) {
+        codeblockindx current;
+        if (!varray_codeblockindxpop(&worklist, &current)) UNREACHABLE("Unexpectedly empty worklist in optimizer");
+        
+        if (optimize_inferblock(opt, current)) optimize_desttoworklist(opt, current, &worklist);
+    }
+    
+    varray_codeblockindxclear(&worklist);
+}
+
 /* **********************************************************************
  * Check for unused instructions
  * ********************************************************************** */
@@ -1736,6 +2103,7 @@ bool optimize(program *prog) {
     
     optimize_buildcontrolflowgraph(&opt);
     for (int i=0; i<2; i++) {
+        if (i>0) optimize_inferencepass(&opt); // Establish types before they are used to transform code
         optimization_pass(&opt, pass[i]);
     }
     optimize_layoutblocks(&opt);
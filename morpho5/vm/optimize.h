@@ -23,7 +23,7 @@ typedef struct {
     int used;             // Count how many times this has been used in the block
     instructionindx iix;  // Instruction that last wrote to this register
     codeblockindx block;  // Which block was responsible for the write?
-    value type;           // Type checking
+    value type;           // Type checking; a representative value, or a class for instances of that class
 } reginfo;
 
 /** Keep track of global contents */
@@ -84,6 +84,7 @@ typedef struct {
     varray_codeblock cfgraph; // Control flow graph
     
     reginfo reg[MORPHO_MAXARGS];
+    bool captured[MORPHO_MAXARGS]; // Registers captured as upvalues in the current function
     globalinfo *globals;
     
     vm *v;                   // We keep a VM to do things like constant folding etc.
@@ -13,6 +13,8 @@
 #include "morpho.h"
 #include "debug.h"
 #include "profile.h"
+#include "matrix.h"
+#include "field.h"
 
 value initselector = MORPHO_NIL;
 value indexselector = MORPHO_NIL;
@@ -179,6 +181,7 @@ static void vm_init(vm *v) {
     v->current=NULL;
     v->instructions=NULL;
     v->objects=NULL;
+    dictionary_init(&v->strings);
     v->openupvalues=NULL;
     v->fp=NULL;
     v->fpmax=&v->frame[MORPHO_CALLFRAMESTACKSIZE-1]; // Last valid value of v->fp
@@ -201,12 +204,22 @@ static void vm_init(vm *v) {
     varray_vminit(&v->subkernels);
 }
 
+/** Empties the table of interned strings; strings held elsewhere, e.g. as program constants, may outlive it */
+static void vm_clearstrings(vm *v) {
+    for (unsigned int i=0; i<v->strings.capacity; i++) {
+        value key=v->strings.contents[i].key;
+        if (!MORPHO_ISNIL(key)) MORPHO_GETSTRING(key)->interned=false;
+    }
+    dictionary_clear(&v->strings);
+}
+
 /** Clears a virtual machine */
 static void vm_clear(vm *v) {
     varray_valueclear(&v->stack);
     varray_valueclear(&v->globals);
     varray_valueclear(&v->tlvars);
     vm_graylistclear(&v->gray);
+    vm_clearstrings(v);
     vm_freeobjects(v);
     varray_vmclear(&v->subkernels);
 }
@@ -275,6 +288,12 @@ void vm_unbindobject(vm *v, value obj) {
             if (e->next==ob) { e->next=ob->next; break; }
         }
     }
+    // An unbound string may outlive this VM, so it can no longer be regarded as interned
+    if (MORPHO_ISSTRING(obj) && MORPHO_ISINTERNEDSTRING(obj)) {
+        dictionary_remove(&v->strings, obj);
+        MORPHO_GETSTRING(obj)->interned=false;
+    }
+    
     // Correct estimate of bound size.
     if (ob->status!=OBJECT_ISUNMANAGED) {
         v->bound-=object_size(ob);
@@ -462,6 +481,26 @@ void vm_gctrace(vm *v) {
     }
 }
 
+/** Remove strings that weren't reached from the table of interned strings; this must happen
+    after tracing and before the sweep frees them */
+void vm_gcpurgestrings(vm *v) {
+    dictionary *dict=&v->strings;
+    varray_value dead;
+    varray_valueinit(&dead);
+
+    /* Removal may shrink and rehash the table, so collect the dead keys before removing any */
+    for (unsigned int i=0; i<dict->capacity; i++) {
+        value key=dict->contents[i].key;
+        if (!MORPHO_ISNIL(key) && MORPHO_GETOBJECT(key)->status!=OBJECT_ISMARKED) {
+            MORPHO_GETSTRING(key)->interned=false;
+            varray_valuewrite(&dead, key);
+        }
+    }
+
+    for (unsigned int i=0; i<dead.count; i++) dictionary_remove(dict, dead.data[i]);
+    varray_valueclear(&dead);
+}
+
 /** Go through the VM's object list and free all unmarked objects */
 void vm_gcsweep(vm *v) {
     object *prev=NULL;
@@ -523,6 +562,7 @@ void vm_collectgarbage(vm *v) {
 #endif
         vm_gcmarkroots(vc);
         vm_gctrace(vc);
+        vm_gcpurgestrings(vc);
         vm_gcsweep(vc);
 
         if (vc->bound>init) {
@@ -845,6 +885,60 @@ static inline bool vm_invoke(vm *v, value obj, value method, int nargs, value *a
     return false;
 }
 
+/** Converts a list of index values to nonnegative integers without the conversions done by array_valuelisttoindices; returns false if any index is not a nonnegative integer */
+static inline bool vm_integerindices(unsigned int nindx, value *indx, unsigned int *out) {
+    for (unsigned int i=0; i<nindx; i++) {
+        if (!MORPHO_ISINTEGER(indx[i])) return false;
+        int ix=MORPHO_GETINTEGERVALUE(indx[i]);
+        if (ix<0) return false;
+        out[i]=(unsigned int) ix;
+    }
+    return true;
+}
+
+/** Fast path for indexing a Matrix or Field with integer indices that avoids a veneer method call.
+ *  @returns true if the element was retrieved; otherwise the caller should invoke the getindex method, which handles slices and raises errors. */
+static inline bool vm_getindex(value obj, unsigned int nindx, value *indx, value *out) {
+    unsigned int ix[3]={0,0,0};
+    if (nindx>3 || !vm_integerindices(nindx, indx, ix)) return false;
+
+    if (MORPHO_ISMATRIX(obj)) {
+        objectmatrix *m=MORPHO_GETMATRIX(obj);
+        if (nindx>2 || ix[0]>=m->nrows || ix[1]>=m->ncols) return false;
+        *out=MORPHO_FLOAT(m->elements[ix[1]*m->nrows+ix[0]]);
+        return true;
+    } else if (MORPHO_ISFIELD(obj)) {
+        objectfield *f=MORPHO_GETFIELD(obj);
+        if (!f->dof || nindx<1) return false;
+        grade g = (nindx>1 ? ix[0] : MESH_GRADE_VERTEX);
+        if (nindx==1) while (g<f->ngrades && f->dof[g]==0) g++;
+        if (g>=f->ngrades) return false;
+        return field_getelement(f, g, (nindx>1 ? ix[1] : ix[0]), ix[2], out);
+    }
+    return false;
+}
+
+/** Fast path for setting an element of a Matrix or Field with integer indices to a number.
+ *  @returns true if the element was set; otherwise the caller should invoke the setindex method */
+static inline bool vm_setindex(value obj, unsigned int nindx, value *indx, value val) {
+    unsigned int ix[3]={0,0,0};
+    if (nindx>3 || !MORPHO_ISNUMBER(val) || !vm_integerindices(nindx, indx, ix)) return false;
+
+    if (MORPHO_ISMATRIX(obj)) {
+        objectmatrix *m=MORPHO_GETMATRIX(obj);
+        if (nindx>2 || ix[0]>=m->nrows || ix[1]>=m->ncols) return false;
+        return morpho_valuetofloat(val, &m->elements[ix[1]*m->nrows+ix[0]]);
+    } else if (MORPHO_ISFIELD(obj)) {
+        objectfield *f=MORPHO_GETFIELD(obj);
+        if (!f->dof || nindx<1 || !MORPHO_ISNIL(f->prototype)) return false;
+        grade g = (nindx>1 ? ix[0] : MESH_GRADE_VERTEX);
+        if (nindx==1) while (g<f->ngrades && f->dof[g]==0) g++;
+        if (g>=f->ngrades) return false;
+        return field_setelement(f, g, (nindx>1 ? ix[1] : ix[0]), ix[2], val);
+    }
+    return false;
+}
+
 /** @brief   Executes a sequence of code
  *  @param   v       The virtual machine to use
  *  @param   rstart  Starting register pointer
@@ -1174,6 +1268,27 @@ bool morpho_interpret(vm *v, value *rstart, instructionindx istart) {
             OPERROR("Exponentiate")
             DISPATCH();
 
+        /* Unchecked arithmetic; the optimizer only emits these if both operands are proven to be Floats */
+        CASE_CODE(ADDF):
+            a=DECODE_A(bc); b=DECODE_B(bc); c=DECODE_C(bc);
+            reg[a] = MORPHO_FLOAT( MORPHO_GETFLOATVALUE(reg[b]) + MORPHO_GETFLOATVALUE(reg[c]));
+            DISPATCH();
+
+        CASE_CODE(SUBF):
+            a=DECODE_A(bc); b=DECODE_B(bc); c=DECODE_C(bc);
+            reg[a] = MORPHO_FLOAT( MORPHO_GETFLOATVALUE(reg[b]) - MORPHO_GETFLOATVALUE(reg[c]));
+            DISPATCH();
+
+        CASE_CODE(MULF):
+            a=DECODE_A(bc); b=DECODE_B(bc); c=DECODE_C(bc);
+            reg[a] = MORPHO_FLOAT( MORPHO_GETFLOATVALUE(reg[b]) * MORPHO_GETFLOATVALUE(reg[c]));
+            DISPATCH();
+
+        CASE_CODE(DIVF):
+            a=DECODE_A(bc); b=DECODE_B(bc); c=DECODE_C(bc);
+            reg[a] = MORPHO_FLOAT( MORPHO_GETFLOATVALUE(reg[b]) / MORPHO_GETFLOATVALUE(reg[c]));
+            DISPATCH();
+
 
         CASE_CODE(NOT):
             a=DECODE_A(bc); b=DECODE_B(bc);
@@ -1390,9 +1505,19 @@ callfunction: // Jump here if an instruction becomes a call
                     VERROR(VM_CLASSLACKSPROPERTY, p);
                 }
             } else if (MORPHO_ISOBJECT(left)) {
-                /* If it's an object, it may have a veneer class */
+                /* If it's an object, it may have properties of its own or a veneer class */
+                objecttypedefn *defn = object_getdefn(MORPHO_GETOBJECT(left));
                 objectclass *klass = object_getveneerclass(MORPHO_GETOBJECTTYPE(left));
-                if (klass) {
+                if (defn->getpropertyfn &&
+                    (defn->getpropertyfn) (MORPHO_GETOBJECT(left), right, &left)) {
+                    /* As for an instance, a property is called if it holds something callable */
+                    if (MORPHO_ISFUNCTION(left) || MORPHO_ISCLOSURE(left) || MORPHO_ISBUILTINFUNCTION(left) || MORPHO_ISINVOCATION(left)) {
+                        reg[a]=left;
+                        goto callfunction;
+                    } else {
+                        ERROR(VM_UNCALLABLE);
+                    }
+                } else if (klass) {
                     value ifunc;
                     if (dictionary_getintern(&klass->methods, right, &ifunc)) {
                         if (MORPHO_ISBUILTINFUNCTION(ifunc)) {
@@ -1561,9 +1686,12 @@ callfunction: // Jump here if an instruction becomes a call
                     VERROR(VM_CLASSLACKSPROPERTY, p);
                 }
             } else if (MORPHO_ISOBJECT(left)) {
-                /* If it's an object, it may have a veneer class */
+                /* If it's an object, it may have properties of its own or a veneer class */
+                objecttypedefn *defn = object_getdefn(MORPHO_GETOBJECT(left));
                 objectclass *klass = object_getveneerclass(MORPHO_GETOBJECTTYPE(left));
-                if (klass) {
+                if (defn->getpropertyfn &&
+                    (defn->getpropertyfn) (MORPHO_GETOBJECT(left), right, &reg[a])) {
+                } else if (klass) {
                     value ifunc;
                     if (dictionary_get(&klass->methods, right, &ifunc)) {
                         objectinvocation *bound=object_newinvocation(left, ifunc);
@@ -1593,6 +1721,13 @@ callfunction: // Jump here if an instruction becomes a call
                 objectinstance *instance = MORPHO_GETINSTANCE(left);
                 left = reg[b];
                 dictionary_insertintern(&instance->fields, left, right);
+            } else if (MORPHO_ISOBJECT(left) &&
+                       object_getdefn(MORPHO_GETOBJECT(left))->setpropertyfn) {
+                char *err = (object_getdefn(MORPHO_GETOBJECT(left))->setpropertyfn) (MORPHO_GETOBJECT(left), reg[b], right);
+                if (err) {
+                    char *p = (MORPHO_ISSTRING(reg[b]) ? MORPHO_GETCSTRING(reg[b]) : "");
+                    VERROR(err, p);
+                }
             } else {
                 ERROR(VM_NOTANOBJECT);
             }
@@ -1620,7 +1755,7 @@ callfunction: // Jump here if an instruction becomes a call
         						vm_bindobject(v, reg[b]);
         					} else  ERROR(VM_NONNUMINDX);
         				}
-            } else {
+            } else if (!vm_getindex(left, c-b+1, &reg[b], &reg[b])) {
                 if (!vm_invoke(v, left, indexselector, c-b+1, &reg[b], &reg[b])) {
                     ERROR(VM_NOTINDEXABLE);
                 }
@@ -1639,7 +1774,7 @@ callfunction: // Jump here if an instruction becomes a call
                 if (!array_valuelisttoindices(ndim, &reg[b], indx)) ERROR(VM_NONNUMINDX);
                 objectarrayerror err=array_setelement(MORPHO_GETARRAY(left), ndim, indx, reg[c]);
                 if (err!=ARRAY_OK) ERROR( array_error(err) );
-            } else {
+            } else if (!vm_setindex(left, c-b, &reg[b], reg[c])) {
                 if (!vm_invoke(v, left, setindexselector, c-b+1, &reg[b], &right)) {
                     ERROR(VM_NOTINDEXABLE);
                 }
@@ -1820,6 +1955,43 @@ void morpho_freevm(vm *v) {
     MORPHO_FREE(v);
 }
 
+/** Adds a string to a VM's table of interned strings, or finds an equal string already there */
+static value vm_internstring(vm *v, value str) {
+    if (v->parent || MORPHO_ISINTERNEDSTRING(str) ||
+        MORPHO_GETSTRINGLENGTH(str)>MORPHO_INTERNMAXLENGTH) return str;
+    
+    value out=dictionary_intern(&v->strings, str);
+    if (MORPHO_ISNIL(out)) return str;
+    
+    MORPHO_GETSTRING(out)->interned=true;
+    
+    return out;
+}
+
+/** @brief Interns a string so that equal strings passed through this function share a single object
+ *  @details The table of interned strings is weak: it doesn't keep strings alive, and strings are removed
+ *           from it when collected. Subkernels don't intern strings, as the table belongs to the parent VM,
+ *           and neither are strings longer than MORPHO_INTERNMAXLENGTH, which are unlikely to recur.
+ *           Only strings bound to v are interned, so a string is only ever held in the table of the VM
+ *           that owns it; others, e.g. program constants, are returned unchanged.
+ *  @param v      the virtual machine
+ *  @param str  a value, e.g. a key about to be stored in a collection
+ *  @returns an equal string that was previously interned, or str itself. */
+value morpho_internstring(vm *v, value str) {
+    if (!MORPHO_ISSTRING(str) || !morpho_ismanagedobject(MORPHO_GETOBJECT(str))) return str;
+    return vm_internstring(v, str);
+}
+
+/** @brief Interns a newly created string that the caller will bind to v
+ *  @param v      the virtual machine
+ *  @param str  a new, unbound string
+ *  @returns an equal string that was previously interned, or str itself. If the result differs from str
+ *           the caller should free str. */
+value morpho_internnewstring(vm *v, value str) {
+    if (!MORPHO_ISSTRING(str)) return str;
+    return vm_internstring(v, str);
+}
+
 /** Returns a VM's error block */
 error *morpho_geterror(vm *v) {
     return &v->err;
@@ -1865,6 +2037,9 @@ void morpho_bindobjects(vm *v, int nobj, value *obj) {
         }
     }
 
+    /* Subkernels never collect garbage, and share their globals with the parent so mustn't grow them */
+    if (v->parent) return;
+
     /* Check if size triggers garbage collection */
 #ifndef MORPHO_DEBUG_STRESSGARBAGECOLLECTOR
     if (v->bound>v->nextgc)
@@ -2073,7 +2248,7 @@ bool vm_subkernels(vm *v, int nkernels, vm **subkernels) {
     int nk=0;
     
     /* Check for unused subkernels */
-    for (int i=0; i<v->subkernels.count; i++) {
+    for (int i=0; i<v->subkernels.count && nk<nkernels; i++) {
         vm *kernel=v->subkernels.data[i];
         if (!kernel->parent) { // Check whether subkernel is unused
             subkernels[nk]=kernel;
@@ -0,0 +1,28 @@
+#!/bin/sh
+# Translates numeric.morpho in the folder given as the first argument with the interpreter under test,
+# named by $MORPHO5 or found on the PATH as test.py does. The translation is built as an extension and
+# imported in place of the module if a C compiler and the morpho headers are available; otherwise the
+# interpreted module, installed alongside it, is imported, so the results are the same either way.
+
+morpho=${MORPHO5:-morpho5}
+cd "$1" || exit 1
+
+"$morpho" -O -c numeric.morpho
+grep 'not translated' numeric.c
+
+# Headers are found in the source tree that holds the interpreter, or where 'make install' puts them
+bindir=$(dirname "$(command -v "$morpho")")
+include=""
+for d in "$bindir" "$bindir/builtin" "$bindir/datastructures" "$bindir/geometry" "$bindir/interface" \
+         "$bindir/utils" "$bindir/vm" "$bindir/../include/morpho"; do
+    if [ -d "$d" ]; then include="$include -I$d"; fi
+done
+
+mkdir -p ext/lib ext/share/modules
+cp numeric.morpho ext/share/modules/numeric.morpho
+echo "$(pwd)/ext" > ext/.morphopackages
+if command -v "${CC:-cc}" >/dev/null 2>&1; then
+    "${CC:-cc}" -shared -fPIC $include numeric.c -o ext/lib/numeric.so 2>/dev/null
+fi
+
+HOME="$(pwd)/ext" "$morpho" main.morpho
@@ -6,6 +6,8 @@
 # are piped to a file and the output is compared with expectations
 # extracted from the input file.
 # Expectations are coded into comments in the input file as follows:
+# A test may also ask to be run with extra interpreter options, e.g.
+#   // args: -O
 
 # import necessary modules
 import os, glob, sys
@@ -80,6 +82,10 @@ def findexpected(str):
         out = findvalue(str) # or something else?
     return out
 
+# Find any extra command line options for the interpreter
+def findargs(str):
+    return rx.findall(r'// args: ?(.*)', str)
+
 # Works out what we expect from the input file
 def getexpect(filepath):
     # Load the file
@@ -94,6 +100,14 @@ def getexpect(filepath):
         out = []
     return out
 
+# Works out what options the input file should be run with
+def getargs(filepath):
+    file_object = open(filepath, 'r')
+    lines = file_object.readlines()
+    file_object.close()
+    out = reduce(operator.concat, list(map(findargs, lines)), [])
+    return ' '.join(out)
+
 # Gets the output generated
 def getoutput(filepath):
     # Load the file
@@ -126,8 +140,8 @@ def test(file,testLog,CI):
     #Get the expected output
     expected=getexpect(file)
 
-    # Run the test
-    os.system(command + ' ' +file + ' > ' + tmp)
+    # Run the test with any options it requests
+    os.system(command + ' ' + getargs(file) + ' ' + file + ' > ' + tmp)
 
     # If we produced output
     if os.path.exists(tmp):